@@ -0,0 +1,30 @@
+#ifndef ARDUINOSTUB_ADS1X15_H
+#define ARDUINOSTUB_ADS1X15_H
+
+// Stand-in for robtillaart/ADS1X15. Conversions return the raw value set with arduino_stub::setAdcReading().
+
+#include "ArduinoStub.h"
+#include "Wire.h"
+
+class ADS1115 {
+  public:
+    explicit ADS1115(uint8_t address = 0x48, TwoWire *wire = &Wire) {}
+    bool begin() { return true; }
+    bool isConnected() { return true; }
+    void setGain(uint8_t gain) {}
+    void setDataRate(uint8_t dataRate) {}
+    void setMode(uint8_t mode) {}
+    void setComparatorQueConvert(uint8_t mode) {}
+    void setComparatorThresholdLow(int16_t low) {}
+    void setComparatorThresholdHigh(int16_t high) {}
+    int16_t readADC(uint8_t pin = 0);
+    // Continuous mode: the conversion register always holds the current reading
+    void requestADC(uint8_t pin = 0) { this->pin = pin; }
+    bool isReady() { return true; }
+    int16_t getValue();
+
+  private:
+    uint8_t pin = 0;
+};
+
+#endif // ARDUINOSTUB_ADS1X15_H
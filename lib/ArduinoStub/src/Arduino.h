@@ -0,0 +1,7 @@
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Native builds resolve <Arduino.h> to the host stand-in.
+#include "ArduinoStub.h"
+
+#endif // ARDUINO_H
@@ -0,0 +1,232 @@
+#include "ArduinoStub.h"
+#include "esp_timer.h"
+
+HardwareSerial Serial;
+
+struct esp_timer {
+    esp_timer_cb_t callback;
+    void *arg;
+    uint64_t due;
+    uint64_t period;
+    bool armed;
+};
+
+namespace {
+uint64_t currentMicros = 0;
+uint8_t pinLevels[arduino_stub::PIN_COUNT] = {};
+uint32_t pinMillivolts[arduino_stub::PIN_COUNT] = {};
+bool serialOutput = true;
+int logLevel = ARDUHAL_LOG_LEVEL_INFO;
+const char LOG_LEVEL_CHARS[] = {'N', 'E', 'W', 'I', 'D', 'V'};
+std::vector<esp_timer_handle_t> timers;
+
+// Moves the clock to us, firing the timers due on the way in deadline order
+void advanceTo(uint64_t us) {
+    while (true) {
+        esp_timer_handle_t next = nullptr;
+        for (esp_timer_handle_t timer : timers) {
+            if (timer->armed && timer->due <= us && (next == nullptr || timer->due < next->due)) {
+                next = timer;
+            }
+        }
+        if (next == nullptr) {
+            break;
+        }
+        currentMicros = std::max(currentMicros, next->due);
+        if (next->period > 0) {
+            next->due += next->period;
+        } else {
+            next->armed = false;
+        }
+        next->callback(next->arg);
+    }
+    currentMicros = std::max(currentMicros, us);
+}
+} // namespace
+
+unsigned long millis() { return static_cast<unsigned long>(currentMicros / 1000ULL); }
+
+unsigned long micros() { return static_cast<unsigned long>(currentMicros); }
+
+void delay(uint32_t ms) { advanceTo(currentMicros + static_cast<uint64_t>(ms) * 1000ULL); }
+
+void delayMicroseconds(uint32_t us) { advanceTo(currentMicros + us); }
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < arduino_stub::PIN_COUNT && (mode & PULLUP)) {
+        pinLevels[pin] = HIGH;
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+    if (pin < arduino_stub::PIN_COUNT) {
+        pinLevels[pin] = val ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) { return pin < arduino_stub::PIN_COUNT ? pinLevels[pin] : LOW; }
+
+uint32_t analogReadMilliVolts(uint8_t pin) { return pin < arduino_stub::PIN_COUNT ? pinMillivolts[pin] : 0; }
+
+void attachInterruptArg(uint8_t, void (*)(void *), void *, int) {}
+
+void detachInterrupt(uint8_t) {}
+
+size_t HardwareSerial::printf(const char *format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (len <= 0) {
+        return 0;
+    }
+    size_t written = std::min(static_cast<size_t>(len), sizeof(buffer) - 1);
+    if (serialOutput) {
+        fwrite(buffer, 1, written, stdout);
+    }
+    return written;
+}
+
+size_t HardwareSerial::print(const char *str) {
+    size_t len = strlen(str);
+    if (serialOutput) {
+        fwrite(str, 1, len, stdout);
+    }
+    return len;
+}
+
+size_t HardwareSerial::println(const char *str) { return print(str) + print("\n"); }
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (serialOutput) {
+        fputc(c, stdout);
+    }
+    return 1;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *pxCreatedTask) {
+    if (pxCreatedTask != nullptr) {
+        *pxCreatedTask = nullptr;
+    }
+    return pdPASS;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask, BaseType_t) {
+    return xTaskCreate(pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask);
+}
+
+void vTaskDelete(TaskHandle_t) {}
+
+void vTaskDelay(TickType_t xTicksToDelay) { delay(xTicksToDelay * portTICK_PERIOD_MS); }
+
+BaseType_t xTaskDelayUntil(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement) {
+    *pxPreviousWakeTime += xTimeIncrement;
+    uint64_t wakeMicros = static_cast<uint64_t>(*pxPreviousWakeTime) * portTICK_PERIOD_MS * 1000ULL;
+    if (wakeMicros <= currentMicros) {
+        return pdFALSE;
+    }
+    advanceTo(wakeMicros);
+    return pdTRUE;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t, TickType_t xTicksToWait) {
+    vTaskDelay(xTicksToWait);
+    return 0;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t *pxHigherPriorityTaskWoken) {
+    if (pxHigherPriorityTaskWoken != nullptr) {
+        *pxHigherPriorityTaskWoken = pdFALSE;
+    }
+}
+
+TickType_t xTaskGetTickCount() { return static_cast<TickType_t>(millis() / portTICK_PERIOD_MS); }
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle) {
+    if (create_args == nullptr || create_args->callback == nullptr || out_handle == nullptr) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_handle = new esp_timer{create_args->callback, create_args->arg, 0, 0, false};
+    timers.push_back(*out_handle);
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+    if (timer->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *timer = {timer->callback, timer->arg, currentMicros + timeout_us, 0, true};
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period) {
+    if (timer->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *timer = {timer->callback, timer->arg, currentMicros + period, period, true};
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+    if (!timer->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timer->armed = false;
+    return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+    if (timer->armed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    timers.erase(std::remove(timers.begin(), timers.end(), timer), timers.end());
+    delete timer;
+    return ESP_OK;
+}
+
+int64_t esp_timer_get_time() { return static_cast<int64_t>(currentMicros); }
+
+namespace arduino_stub {
+
+uint64_t nowMicros() { return currentMicros; }
+
+void setMicros(uint64_t us) { currentMicros = us; }
+
+void advanceMicros(uint64_t us) { advanceTo(currentMicros + us); }
+
+uint8_t getPinLevel(uint8_t pin) { return pin < PIN_COUNT ? pinLevels[pin] : LOW; }
+
+void setPinLevel(uint8_t pin, uint8_t level) {
+    if (pin < PIN_COUNT) {
+        pinLevels[pin] = level ? HIGH : LOW;
+    }
+}
+
+void setPinMillivolts(uint8_t pin, uint32_t millivolts) {
+    if (pin < PIN_COUNT) {
+        pinMillivolts[pin] = millivolts;
+    }
+}
+
+void setSerialOutput(bool enabled) { serialOutput = enabled; }
+
+void setLogLevel(int level) { logLevel = level; }
+
+void log(int level, const char *tag, const char *format, ...) {
+    if (level > logLevel) {
+        return;
+    }
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (!serialOutput) {
+        return;
+    }
+    fprintf(stdout, "[%6lu][%c][%s] %s\n", millis(), LOG_LEVEL_CHARS[std::clamp(level, 0, 5)], tag, buffer);
+}
+
+} // namespace arduino_stub
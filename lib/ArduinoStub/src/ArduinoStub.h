@@ -0,0 +1,118 @@
+#ifndef ARDUINOSTUB_H
+#define ARDUINOSTUB_H
+
+// Minimal Linux stand-in for the parts of the Arduino-ESP32 core used by the controller libraries.
+// Time is simulated: it only moves when delay(), vTaskDelay() or arduino_stub::advanceMicros() is called,
+// which keeps native benchmarks and simulations deterministic.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifndef PI
+#define PI 3.1415926535897932384626433832795
+#endif
+#define HALF_PI 1.5707963267948966192313216916398
+#define TWO_PI 6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define LOW 0x0
+#define HIGH 0x1
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define PULLUP 0x04
+#define INPUT_PULLUP 0x05
+#define PULLDOWN 0x08
+#define INPUT_PULLDOWN 0x09
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define F(string_literal) (string_literal)
+#define IRAM_ATTR
+
+#define ARDUHAL_LOG_LEVEL_NONE 0
+#define ARDUHAL_LOG_LEVEL_ERROR 1
+#define ARDUHAL_LOG_LEVEL_WARN 2
+#define ARDUHAL_LOG_LEVEL_INFO 3
+#define ARDUHAL_LOG_LEVEL_DEBUG 4
+#define ARDUHAL_LOG_LEVEL_VERBOSE 5
+
+#define ESP_LOGE(tag, format, ...) arduino_stub::log(ARDUHAL_LOG_LEVEL_ERROR, tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) arduino_stub::log(ARDUHAL_LOG_LEVEL_WARN, tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) arduino_stub::log(ARDUHAL_LOG_LEVEL_INFO, tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) arduino_stub::log(ARDUHAL_LOG_LEVEL_DEBUG, tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...) arduino_stub::log(ARDUHAL_LOG_LEVEL_VERBOSE, tag, format, ##__VA_ARGS__)
+
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+uint32_t analogReadMilliVolts(uint8_t pin);
+// Interrupts are never raised on the host, the simulated peripherals are polled
+void attachInterruptArg(uint8_t pin, void (*handler)(void *), void *arg, int mode);
+void detachInterrupt(uint8_t pin);
+
+class HardwareSerial {
+  public:
+    void begin(unsigned long baud) {}
+    size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char *str);
+    size_t println(const char *str = "");
+    size_t write(uint8_t c);
+};
+
+extern HardwareSerial Serial;
+
+namespace arduino_stub {
+
+constexpr uint8_t PIN_COUNT = 64;
+
+// Simulated clock
+uint64_t nowMicros();
+void setMicros(uint64_t us);
+void advanceMicros(uint64_t us);
+
+// Simulated GPIO, lets a host-side plant observe outputs and drive inputs
+uint8_t getPinLevel(uint8_t pin);
+void setPinLevel(uint8_t pin, uint8_t level);
+void setPinMillivolts(uint8_t pin, uint32_t millivolts);
+
+// Simulated peripherals (MAX31855, ADS1115, PSM)
+void setThermocoupleTemperature(float celsius);
+float getThermocoupleTemperature();
+void setAdcReading(uint8_t channel, int16_t raw);
+int16_t getAdcReading(uint8_t channel);
+float getPumpDuty();
+void setMainsFrequency(long hz);
+long getMainsFrequency();
+
+// Output control. Enabled log levels and Serial are still formatted when output is muted, so benchmarks
+// keep paying the same formatting cost the firmware does.
+void setSerialOutput(bool enabled);
+void setLogLevel(int level);
+void log(int level, const char *tag, const char *format, ...) __attribute__((format(printf, 3, 4)));
+
+} // namespace arduino_stub
+
+#endif // ARDUINOSTUB_H
@@ -0,0 +1,23 @@
+#ifndef ARDUINOSTUB_MAX31855_H
+#define ARDUINOSTUB_MAX31855_H
+
+// Stand-in for robtillaart/MAX31855. The reported temperature comes from arduino_stub::setThermocoupleTemperature().
+
+#include "ArduinoStub.h"
+
+#define STATUS_OK 0x00
+#define STATUS_NO_COMMUNICATION 0x80
+
+class MAX31855 {
+  public:
+    MAX31855(uint8_t select, uint8_t miso, uint8_t clock) {}
+    void begin() {}
+    void setSPIspeed(uint32_t speed) {}
+    uint8_t read();
+    float getTemperature() const { return temperature; }
+
+  private:
+    float temperature = 0.0f;
+};
+
+#endif // ARDUINOSTUB_MAX31855_H
@@ -0,0 +1,22 @@
+#ifndef ARDUINOSTUB_PSM_H
+#define ARDUINOSTUB_PSM_H
+
+// Stand-in for the pulse skip modulation library driving the pump triac.
+// The last value set is exposed as a 0..1 duty through arduino_stub::getPumpDuty().
+
+#include "ArduinoStub.h"
+
+class PSM {
+  public:
+    PSM(uint8_t sensePin, uint8_t controlPin, uint16_t range, int mode = RISING, uint8_t divider = 1,
+        uint8_t interruptMinTimeDiff = 0);
+    void set(uint16_t value);
+    uint16_t getValue() const { return value; }
+    long cps();
+
+  private:
+    uint16_t range;
+    uint16_t value = 0;
+};
+
+#endif // ARDUINOSTUB_PSM_H
@@ -0,0 +1,57 @@
+#include "ADS1X15.h"
+#include "MAX31855.h"
+#include "PSM.h"
+#include "SPI.h"
+#include "Wire.h"
+
+TwoWire Wire;
+TwoWire Wire1;
+SPIClass SPI;
+
+namespace {
+float thermocoupleTemperature = 20.0f;
+int16_t adcReadings[4] = {};
+float pumpDuty = 0.0f;
+long mainsFrequency = 50;
+} // namespace
+
+uint8_t MAX31855::read() {
+    temperature = thermocoupleTemperature;
+    return STATUS_OK;
+}
+
+int16_t ADS1115::readADC(uint8_t pin) { return arduino_stub::getAdcReading(pin); }
+
+int16_t ADS1115::getValue() { return arduino_stub::getAdcReading(pin); }
+
+PSM::PSM(uint8_t, uint8_t, uint16_t range, int, uint8_t, uint8_t) : range(range) {}
+
+void PSM::set(uint16_t value) {
+    this->value = std::min(value, range);
+    pumpDuty = range > 0 ? static_cast<float>(this->value) / static_cast<float>(range) : 0.0f;
+}
+
+// The sense input counts both mains half-waves, which DimmedPump divides back down
+long PSM::cps() { return mainsFrequency * 2; }
+
+namespace arduino_stub {
+
+void setThermocoupleTemperature(float celsius) { thermocoupleTemperature = celsius; }
+
+float getThermocoupleTemperature() { return thermocoupleTemperature; }
+
+void setAdcReading(uint8_t channel, int16_t raw) {
+    if (channel < 4) {
+        adcReadings[channel] = raw;
+    }
+}
+
+int16_t getAdcReading(uint8_t channel) { return channel < 4 ? adcReadings[channel] : 0; }
+
+float getPumpDuty() { return pumpDuty; }
+
+void setMainsFrequency(long hz) { mainsFrequency = hz; }
+
+long getMainsFrequency() { return mainsFrequency; }
+
+} // namespace arduino_stub
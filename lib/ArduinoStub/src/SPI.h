@@ -0,0 +1,13 @@
+#ifndef ARDUINOSTUB_SPI_H
+#define ARDUINOSTUB_SPI_H
+
+#include "ArduinoStub.h"
+
+class SPIClass {
+  public:
+    void begin() {}
+};
+
+extern SPIClass SPI;
+
+#endif // ARDUINOSTUB_SPI_H
@@ -0,0 +1,14 @@
+#ifndef ARDUINOSTUB_WIRE_H
+#define ARDUINOSTUB_WIRE_H
+
+#include "ArduinoStub.h"
+
+class TwoWire {
+  public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif // ARDUINOSTUB_WIRE_H
@@ -0,0 +1,36 @@
+#ifndef ARDUINOSTUB_ESP_TIMER_H
+#define ARDUINOSTUB_ESP_TIMER_H
+
+#include <cstdint>
+
+// High resolution timers on the simulated clock. Callbacks run from whatever moves the clock (delay(), vTaskDelay(),
+// arduino_stub::advanceMicros()), each one with the clock set to its own deadline.
+
+using esp_err_t = int;
+
+#define ESP_OK 0
+#define ESP_FAIL -1
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+
+using esp_timer_cb_t = void (*)(void *arg);
+using esp_timer_handle_t = struct esp_timer *;
+
+enum esp_timer_dispatch_t { ESP_TIMER_TASK };
+
+struct esp_timer_create_args_t {
+    esp_timer_cb_t callback;
+    void *arg;
+    esp_timer_dispatch_t dispatch_method;
+    const char *name;
+    bool skip_unhandled_events;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *create_args, esp_timer_handle_t *out_handle);
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us);
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t period);
+esp_err_t esp_timer_stop(esp_timer_handle_t timer);
+esp_err_t esp_timer_delete(esp_timer_handle_t timer);
+int64_t esp_timer_get_time();
+
+#endif // ARDUINOSTUB_ESP_TIMER_H
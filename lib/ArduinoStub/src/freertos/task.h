@@ -0,0 +1,25 @@
+#ifndef ARDUINOSTUB_FREERTOS_TASK_H
+#define ARDUINOSTUB_FREERTOS_TASK_H
+
+#include "FreeRTOS.h"
+
+// Tasks are never started on the host. Peripherals expose their loop() methods, and native
+// programs call them directly on the simulated clock instead of running the FreeRTOS loop tasks.
+
+using TaskHandle_t = void *;
+using xTaskHandle = TaskHandle_t;
+using TaskFunction_t = void (*)(void *);
+
+BaseType_t xTaskCreate(TaskFunction_t pxTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+                       UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask);
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t pxTaskCode, const char *pcName, uint32_t usStackDepth, void *pvParameters,
+                                   UBaseType_t uxPriority, TaskHandle_t *pxCreatedTask, BaseType_t xCoreID);
+void vTaskDelete(TaskHandle_t xTask);
+void vTaskDelay(TickType_t xTicksToDelay);
+BaseType_t xTaskDelayUntil(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement);
+TickType_t xTaskGetTickCount();
+// Nothing notifies on the host, a take waits out its timeout
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+
+#endif // ARDUINOSTUB_FREERTOS_TASK_H
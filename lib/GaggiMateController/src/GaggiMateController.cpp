@@ -1,6 +1,7 @@
 #include "GaggiMateController.h"
 #include "utilities.h"
 #include <Arduino.h>
+#include <Trace/Trace.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <peripherals/DimmedPump.h>
@@ -20,19 +21,32 @@ void GaggiMateController::setup() {
     detectBoard();
     detectAddon();
 
+    // Binary trace frames share the console port, the ESP_LOG lines around them are skipped by the decoder
+    trace::setLevel(static_cast<TraceLevel>(TRACE_DEFAULT_LEVEL));
+    trace::startDrainTask([](const uint8_t *data, size_t length) { Serial.write(data, length); });
+
     this->thermocouple = new Max31855Thermocouple(
         _config.maxCsPin, _config.maxMisoPin, _config.maxSckPin, [this](float temperature) { /* noop */ },
         [this]() { thermalRunawayShutdown(); });
     this->heater = new Heater(
         this->thermocouple, _config.heaterPin, [this]() { thermalRunawayShutdown(); },
-        [this](float Kp, float Ki, float Kd) { _ble.sendAutotuneResult(Kp, Ki, Kd); });
+        [this](bool success, float Kp, float Ki, float Kd) { _ble.sendAutotuneResult(success, Kp, Ki, Kd); },
+        [this](AutotuneState state, float temperature) { _ble.sendAutotuneProgress(static_cast<int>(state), temperature); });
     this->valve = new SimpleRelay(_config.valvePin, _config.valveOn);
     this->alt = new SimpleRelay(_config.altPin, _config.altOn);
     if (_config.capabilites.pressure) {
-        pressureSensor = new PressureSensor(_config.pressureSda, _config.pressureScl, [this](float pressure) { /* noop */ });
+        pressureSensor = new PressureSensor(
+            _config.pressureSda, _config.pressureScl, [this](float pressure) { /* noop */ }, 16.0f, 0.5f, 4.5f,
+            _config.pressureAlertPin);
     }
     if (_config.capabilites.dimming) {
-        pump = new DimmedPump(_config.pumpPin, _config.pumpSensePin, pressureSensor);
+        auto dimmedPump = new DimmedPump(_config.pumpPin, _config.pumpSensePin, pressureSensor);
+        if (_config.capabilites.pressure) {
+            // Stream every control tick to clients that speak the binary protocol
+            sensorQueue = xQueueCreate(SENSOR_STREAM_QUEUE_LENGTH, sizeof(SensorSample));
+            dimmedPump->setTickCallback([this]() { queueSensorSample(); });
+        }
+        pump = dimmedPump;
     } else {
         pump = new SimplePump(_config.pumpPin, _config.pumpOn, _config.capabilites.ssrPump ? 1000.0f : 5000.0f);
     }
@@ -74,10 +88,11 @@ void GaggiMateController::setup() {
     // Initialize last ping time
     lastPingTime = millis();
 
-    _ble.registerOutputControlCallback([this](bool valve, float pumpSetpoint, float heaterSetpoint) {
+    _ble.registerOutputControlCallback([this](bool valve, float pumpSetpoint, float heaterSetpoint, float heatLoad) {
         this->pump->setPower(pumpSetpoint);
         this->valve->set(valve);
         this->heater->setSetpoint(heaterSetpoint);
+        this->heater->setHeatLoad(heatLoad);
         if (!_config.capabilites.dimming) {
             return;
         }
@@ -85,9 +100,10 @@ void GaggiMateController::setup() {
         dimmedPump->setValveState(valve);
     });
     _ble.registerAdvancedOutputControlCallback(
-        [this](bool valve, float heaterSetpoint, bool pressureTarget, float pressure, float flow) {
+        [this](bool valve, float heaterSetpoint, bool pressureTarget, float pressure, float flow, float heatLoad) {
             this->valve->set(valve);
             this->heater->setSetpoint(heaterSetpoint);
+            this->heater->setHeatLoad(heatLoad);
             if (!_config.capabilites.dimming) {
                 return;
             }
@@ -132,8 +148,28 @@ void GaggiMateController::loop() {
     if ((now - lastPingTime) / 1000 > PING_TIMEOUT_SECONDS) {
         handlePingTimeout();
     }
+    handleConsoleInput();
+    if (sensorQueue != nullptr && _ble.isBinaryProtocol()) {
+        streamSensorData();
+        delay(SENSOR_STREAM_INTERVAL_MS);
+        return;
+    }
     sendSensorData();
-    delay(250);
+    delay(SENSOR_SEND_INTERVAL_MS);
+}
+
+void GaggiMateController::handleConsoleInput() {
+    // "T<level>" from scripts/decode_trace.py, anything else is ignored
+    while (Serial.available() >= 2) {
+        if (Serial.read() != 'T') {
+            continue;
+        }
+        const int level = Serial.read() - '0';
+        if (level >= static_cast<int>(TraceLevel::OFF) && level <= static_cast<int>(TraceLevel::VERBOSE)) {
+            trace::setLevel(static_cast<TraceLevel>(level));
+            ESP_LOGI(LOG_TAG, "Trace level %d", level);
+        }
+    }
 }
 
 void GaggiMateController::registerBoardConfig(ControllerConfig config) { configs.push_back(config); }
@@ -166,6 +202,7 @@ void GaggiMateController::handlePingTimeout() {
     ESP_LOGE(LOG_TAG, "Ping timeout detected. Turning off heater and pump for safety.\n");
     // Turn off the heater and pump as a safety measure
     this->heater->setSetpoint(0);
+    this->heater->setHeatLoad(0);
     this->pump->setPower(0);
     this->valve->set(false);
     this->alt->set(false);
@@ -175,12 +212,44 @@ void GaggiMateController::thermalRunawayShutdown() {
     ESP_LOGE(LOG_TAG, "Thermal runaway detected! Turning off heater and pump!\n");
     // Turn off the heater and pump immediately
     this->heater->setSetpoint(0);
+    this->heater->setHeatLoad(0);
     this->pump->setPower(0);
     this->valve->set(false);
     this->alt->set(false);
     _ble.sendError(ERROR_CODE_RUNAWAY);
 }
 
+void GaggiMateController::queueSensorSample() {
+    if (!_ble.isBinaryProtocol()) {
+        return;
+    }
+    auto dimmedPump = static_cast<DimmedPump *>(pump);
+    SensorSample sample{
+        .timestamp = millis(),
+        .temperature = thermocouple->read(),
+        .pressure = pressureSensor->getPressure(),
+        .puckFlow = dimmedPump->getPuckFlow(),
+        .pumpFlow = dimmedPump->getPumpFlow(),
+        .puckResistance = dimmedPump->getPuckResistance(),
+    };
+    // Runs on the pump task, drop the sample rather than delay the control loop
+    xQueueSend(sensorQueue, &sample, 0);
+}
+
+void GaggiMateController::streamSensorData() {
+    SensorSample sample{};
+    while (xQueueReceive(sensorQueue, &sample, 0) == pdTRUE) {
+        sensorBatch[sensorBatchCount++] = sample;
+        if (sensorBatchCount < sensorBatch.size()) {
+            continue;
+        }
+        _ble.sendSensorBatch(sensorBatch.data(), sensorBatchCount);
+        sensorBatchCount = 0;
+        auto dimmedPump = static_cast<DimmedPump *>(pump);
+        _ble.sendVolumetricMeasurement(dimmedPump->getCoffeeVolume());
+    }
+}
+
 void GaggiMateController::sendSensorData() {
     if (_config.capabilites.pressure) {
         auto dimmedPump = static_cast<DimmedPump *>(pump);
@@ -10,10 +10,23 @@
 #include <peripherals/PressureSensor.h>
 #include <peripherals/Pump.h>
 #include <peripherals/SimpleRelay.h>
+#include <array>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 #include <vector>
 
 constexpr double PING_TIMEOUT_SECONDS = 20.0;
 
+constexpr unsigned long SENSOR_SEND_INTERVAL_MS = 250;  // CSV clients and boards without a pump control tick
+constexpr unsigned long SENSOR_STREAM_INTERVAL_MS = 30; // Queue drain interval while streaming
+constexpr size_t SENSOR_STREAM_BATCH_SIZE = 4;          // Samples per notification, ~120 ms at the 30 ms pump tick
+constexpr size_t SENSOR_STREAM_QUEUE_LENGTH = 16;
+
+// Trace level at boot, see Trace.h. Sending "T<level>" on the console port changes it at runtime.
+#ifndef TRACE_DEFAULT_LEVEL
+#define TRACE_DEFAULT_LEVEL 0
+#endif
+
 constexpr int DETECT_EN_PIN = 40;
 constexpr int DETECT_VALUE_PIN = 11;
 
@@ -33,6 +46,9 @@ class GaggiMateController {
     void startPidAutotune(void);
     void stopPidAutotune(void);
     void sendSensorData(void);
+    void queueSensorSample(void);
+    void streamSensorData(void);
+    void handleConsoleInput(void);
 
     ControllerConfig _config = ControllerConfig{};
     NimBLEServerController _ble;
@@ -53,6 +69,10 @@ class GaggiMateController {
     String _version;
     unsigned long lastPingTime = 0;
 
+    QueueHandle_t sensorQueue = nullptr;
+    std::array<SensorSample, SENSOR_STREAM_BATCH_SIZE> sensorBatch{};
+    size_t sensorBatchCount = 0;
+
     const char *LOG_TAG = "GaggiMateController";
 };
 
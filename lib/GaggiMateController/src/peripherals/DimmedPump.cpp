@@ -1,6 +1,7 @@
 #include "DimmedPump.h"
 
-#include <GaggiMateController.h>
+#include <Trace/Trace.h>
+#include <algorithm>
 
 DimmedPump::DimmedPump(uint8_t ssr_pin, uint8_t sense_pin, PressureSensor *pressure_sensor)
     : _ssr_pin(ssr_pin), _sense_pin(sense_pin), _psm(_sense_pin, _ssr_pin, 100, FALLING, 2, 4), _pressureSensor(pressure_sensor),
@@ -21,6 +22,10 @@ void DimmedPump::loop() {
     updatePower();
     // _currentFlow = 0.1f * _pressureController.getPumpFlowRate() + 0.9f * _currentFlow;
     _currentFlow = _pressureController.getPumpFlowRate();
+    trace::record(TraceEvent::PUMP_TICK, static_cast<int>(_mode), _currentPressure, _power, _currentFlow);
+    if (_tickCallback != nullptr) {
+        _tickCallback();
+    }
 }
 
 void DimmedPump::setPower(float setpoint) {
@@ -81,6 +86,8 @@ void DimmedPump::setPressureTarget(float targetPressure, float flowLimit) {
 
 void DimmedPump::setValveState(bool open) { _valveStatus = open; }
 
+void DimmedPump::setTickCallback(const pump_tick_callback_t &callback) { _tickCallback = callback; }
+
 void DimmedPump::setPumpFlowCoeff(float oneBarFlow, float nineBarFlow) {
     _pressureController.setPumpFlowCoeff(oneBarFlow, nineBarFlow);
 }
@@ -6,6 +6,8 @@
 #include "Pump.h"
 #include <Arduino.h>
 
+using pump_tick_callback_t = std::function<void()>;
+
 class DimmedPump : public Pump {
   public:
     enum class ControlMode { POWER, PRESSURE, FLOW };
@@ -30,6 +32,7 @@ class DimmedPump : public Pump {
     void stop();
     void fullPower();
     void setValveState(bool open);
+    void setTickCallback(const pump_tick_callback_t &callback);
 
   private:
     uint8_t _ssr_pin;
@@ -51,6 +54,7 @@ class DimmedPump : public Pump {
     int _cps = MAX_FREQ;
 
     float _opvPressure = 0.0f;
+    pump_tick_callback_t _tickCallback = nullptr;
 
     static constexpr float BASE_FLOW_RATE = 0.25f;
     static constexpr float MAX_PRESSURE = 15.0f;
@@ -1,18 +1,33 @@
 #include "Heater.h"
 #include <Arduino.h>
+#include <Trace/Trace.h>
 #include <algorithm>
 
 Heater::Heater(TemperatureSensor *sensor, uint8_t heaterPin, const heater_error_callback_t &error_callback,
-               const pid_result_callback_t &pid_callback)
-    : sensor(sensor), heaterPin(heaterPin), taskHandle(nullptr), error_callback(error_callback), pid_callback(pid_callback) {
+               const pid_result_callback_t &pid_callback, const autotune_progress_callback_t &progress_callback)
+    : sensor(sensor), heaterPin(heaterPin), taskHandle(nullptr), error_callback(error_callback), pid_callback(pid_callback),
+      progress_callback(progress_callback) {
 
     simplePid = new SimplePID(&output, &temperature, &setpoint);
     autotuner = new Autotune();
 }
 
+Heater::~Heater() {
+    if (taskHandle != nullptr) {
+        vTaskDelete(taskHandle);
+    }
+    for (esp_timer_handle_t timer : {windowTimer, offTimer}) {
+        if (timer != nullptr) {
+            esp_timer_stop(timer);
+            esp_timer_delete(timer);
+        }
+    }
+}
+
 void Heater::setup() {
     pinMode(heaterPin, OUTPUT);
     setupPid();
+    setupOutput();
     xTaskCreate(loopTask, "Heater::loop", configMINIMAL_STACK_SIZE * 4, this, 1, &taskHandle);
 }
 
@@ -24,6 +39,15 @@ void Heater::setupPid() {
     simplePid->reset();
 }
 
+void Heater::setupOutput() {
+    const esp_timer_create_args_t windowArgs = {onWindowStart, this, ESP_TIMER_TASK, "Heater::window", true};
+    const esp_timer_create_args_t offArgs = {onSwitchOff, this, ESP_TIMER_TASK, "Heater::off", false};
+    esp_timer_create(&windowArgs, &windowTimer);
+    esp_timer_create(&offArgs, &offTimer);
+    windowStart = esp_timer_get_time();
+    esp_timer_start_periodic(windowTimer, HEATER_WINDOW_US);
+}
+
 void Heater::setupAutotune(int goal, int windowSize) {
     autotuner->setWindowsize(windowSize);
     autotuner->setEpsilon(0.1f);
@@ -33,15 +57,18 @@ void Heater::setupAutotune(int goal, int windowSize) {
 }
 
 void Heater::loop() {
-    if (!sensor->isErrorState() && autotuning) {
+    if (autotuneRequested) {
+        autotuneRequested = false;
+        startAutotune();
+    }
+    if (autotuning) {
         loopAutotune();
         return;
     }
 
     if (sensor->isErrorState() || setpoint <= 0.0f) {
         simplePid->setMode(SimplePID::Control::manual);
-        digitalWrite(heaterPin, LOW);
-        relayStatus = false;
+        setOutput(0.0f);
         temperature = sensor->read();
         return;
     }
@@ -57,6 +84,13 @@ void Heater::setSetpoint(float setpoint) {
     }
 }
 
+void Heater::setHeatLoad(float flow) {
+    if (heatLoad != flow) {
+        heatLoad = flow;
+        ESP_LOGV(LOG_TAG, "Set heat load %.2f ml/s", flow);
+    }
+}
+
 void Heater::setTunings(float Kp, float Ki, float Kd) {
     if (simplePid->getKp() != Kp || simplePid->getKi() != Ki || simplePid->getKd() != Kd) {
         simplePid->setControllerPIDGains(Kp, Ki, Kd, 0.0f);
@@ -65,50 +99,90 @@ void Heater::setTunings(float Kp, float Ki, float Kd) {
     }
 }
 
+// Runs on the caller's task, the heater task picks the request up on its next tick
 void Heater::autotune(int goal, int windowSize) {
-    setupAutotune(goal, windowSize);
+    autotuneGoal = goal;
+    autotuneWindowSize = windowSize;
+    autotuneRequested = true;
+}
+
+void Heater::startAutotune() {
+    setupAutotune(autotuneGoal, autotuneWindowSize);
+    simplePid->setMode(SimplePID::Control::manual);
+    autotuneTicks = 0;
+    autotuneState = autotuner->getState();
     autotuning = true;
+    ESP_LOGI(LOG_TAG, "Autotune started: goal=%d, window=%d", autotuneGoal, autotuneWindowSize);
+    if (progress_callback) {
+        progress_callback(autotuneState, sensor->read());
+    }
 }
 
 void Heater::loopPid() {
-    softPwm(TUNER_OUTPUT_SPAN);
     temperature = sensor->read();
+    // The brew water is known before the boiler cools down, the PID only has to correct what the model gets wrong
+    const float feedForward = heatLoadOutput();
+    simplePid->setDisturbanceFeedForward(feedForward);
     if (simplePid->update()) {
+        setOutput(output);
         plot(output, 1.0f, 1);
+    } else if (feedForward != appliedFeedForward) {
+        // The PID runs once per window, a new heat load goes to the relay right away
+        output = std::clamp(output + feedForward - appliedFeedForward, 0.0f, TUNER_OUTPUT_SPAN);
+        setOutput(output);
     }
+    appliedFeedForward = feedForward;
 }
 
+// One step per heater window, the relay stays at the step's output in between
 void Heater::loopAutotune() {
-    simplePid->setMode(SimplePID::Control::manual);
-    autotuner->reset();
-    long microseconds;
-    long loopInterval = (static_cast<long>(TUNER_OUTPUT_SPAN) - 1L) * 1000L;
-    while (!autotuner->isFinished()) {
-        microseconds = micros();
-        temperature = sensor->read();
-        output = 0.0f;
-        if (autotuner->maxPowerOn) {
-            output = TUNER_OUTPUT_SPAN;
-        }
-        ESP_LOGI(LOG_TAG, "Autotuner Cycle: Temperature=%.2f", temperature);
-        autotuner->update(temperature, millis() / 1000.0f);
-        while (micros() - microseconds < loopInterval) {
-            softPwm(TUNER_OUTPUT_SPAN);
-            vTaskDelay(1 / portTICK_PERIOD_MS);
-        }
-        if (temperature > MAX_AUTOTUNE_TEMP) {
-            output = 0.0f;
-            autotuning = false;
-            softPwm(TUNER_OUTPUT_SPAN);
-            pid_callback(0, 0, 0);
-            return;
-        }
+    temperature = sensor->read();
+    if (sensor->isErrorState() || temperature > MAX_AUTOTUNE_TEMP) {
+        ESP_LOGE(LOG_TAG, "Autotune aborted at %.2f°C", temperature);
+        finishAutotune(false);
+        return;
     }
+    if (autotuneTicks++ % AUTOTUNE_STEP_TICKS != 0) {
+        return;
+    }
+
+    autotuner->update(temperature, millis() / 1000.0f);
+    const AutotuneState state = autotuner->getState();
+    trace::record(TraceEvent::AUTOTUNE_STEP, static_cast<uint8_t>(state), temperature, autotuner->getLastSlope(),
+                  autotuner->maxPowerOn ? TUNER_OUTPUT_SPAN : 0.0f);
+    if (state != autotuneState) {
+        autotuneState = state;
+        ESP_LOGI(LOG_TAG, "Autotune step %d at %.2f°C, slope %.3f°C/s", static_cast<int>(state), temperature,
+                 autotuner->getLastSlope());
+    }
+    if (progress_callback) {
+        progress_callback(state, temperature);
+    }
+    if (autotuner->isFinished()) {
+        finishAutotune(state == AutotuneState::DONE);
+        return;
+    }
+    output = autotuner->maxPowerOn ? TUNER_OUTPUT_SPAN : 0.0f;
+    setOutput(output);
+}
+
+void Heater::finishAutotune(bool success) {
     output = 0.0f;
     autotuning = false;
-    softPwm(TUNER_OUTPUT_SPAN);
+    setOutput(output);
+    if (progress_callback) {
+        progress_callback(success ? AutotuneState::DONE : AutotuneState::FAILED, temperature);
+    }
 
-    pid_callback(autotuner->getKp() * 1000.0f, autotuner->getKi() * 1000.0f, autotuner->getKd() * 1000.0f);
+    if (!success) {
+        // Hand the current gains back with the failure, the display stops waiting and keeps its settings
+        ESP_LOGE(LOG_TAG, "Autotuning failed, keeping Kp=%.4f, Ki=%.4f, Kd=%.4f", simplePid->getKp(), simplePid->getKi(),
+                 simplePid->getKd());
+        pid_callback(false, simplePid->getKp(), simplePid->getKi(), simplePid->getKd());
+        return;
+    }
+
+    pid_callback(true, autotuner->getKp() * 1000.0f, autotuner->getKi() * 1000.0f, autotuner->getKd() * 1000.0f);
 
     setTunings(autotuner->getKp() * 1000.0f, autotuner->getKi() * 1000.0f, autotuner->getKd() * 1000.0f);
 
@@ -118,29 +192,42 @@ void Heater::loopAutotune() {
              autotuner->getSystemGain(), autotuner->getCrossoverFreq() / 2);
 }
 
-float Heater::softPwm(uint32_t windowSize) {
-    // software PWM timer
-    unsigned long msNow = millis();
-    if (msNow - windowStartTime >= windowSize) {
-        windowStartTime = msNow;
+float Heater::heatLoadOutput() const {
+    const float temperatureRise = std::max(setpoint - HEATER_INLET_TEMPERATURE, 0.0f);
+    const float power = std::max(heatLoad, 0.0f) * HEATER_WATER_HEAT_CAPACITY * temperatureRise; // W
+    return power / HEATER_RATED_POWER * TUNER_OUTPUT_SPAN;
+}
+
+// A new output moves the off edge of the running window, the relay follows right away instead of at the next window
+void Heater::setOutput(float onTime) {
+    const auto onTimeUs = static_cast<int64_t>(std::clamp(onTime, 0.0f, TUNER_OUTPUT_SPAN) * 1000.0f);
+    portENTER_CRITICAL(&outputLock);
+    const bool changed = onTimeUs != this->onTimeUs;
+    if (changed) {
+        this->onTimeUs = onTimeUs;
+        applyOnTime(esp_timer_get_time() - windowStart);
+    }
+    portEXIT_CRITICAL(&outputLock);
+    if (changed) {
+        trace::record(TraceEvent::HEATER_OUTPUT, onTime, temperature, setpoint, heatLoad);
     }
-    float optimumOutput = output;
+}
 
-    // PWM relay output
-    if (!relayStatus && static_cast<unsigned long>(optimumOutput) > (msNow - windowStartTime)) {
-        if (msNow > nextSwitchTime) {
-            nextSwitchTime = msNow;
-            relayStatus = true;
-            digitalWrite(heaterPin, HIGH);
-        }
-    } else if (relayStatus && static_cast<unsigned long>(optimumOutput) < (msNow - windowStartTime)) {
-        if (msNow > nextSwitchTime) {
-            nextSwitchTime = msNow;
-            relayStatus = false;
-            digitalWrite(heaterPin, LOW);
-        }
+// Caller holds outputLock, elapsed is the time already spent in the current window
+void Heater::applyOnTime(int64_t elapsed) {
+    esp_timer_stop(offTimer);
+    const bool on = onTimeUs > elapsed;
+    switchRelay(on);
+    if (on && onTimeUs < HEATER_WINDOW_US) {
+        esp_timer_start_once(offTimer, onTimeUs - elapsed);
+    }
+}
+
+void Heater::switchRelay(bool on) {
+    if (on != relayStatus) {
+        relayStatus = on;
+        digitalWrite(heaterPin, on ? HIGH : LOW);
     }
-    return optimumOutput;
 }
 
 void Heater::plot(float optimumOutput, float outputScale, uint8_t everyNth) {
@@ -156,6 +243,21 @@ void Heater::loopTask(void *arg) {
     auto *heater = static_cast<Heater *>(arg);
     while (true) {
         heater->loop();
-        xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(10));
+        xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(HEATER_LOOP_INTERVAL_MS));
     }
 }
+
+void Heater::onWindowStart(void *arg) {
+    auto *heater = static_cast<Heater *>(arg);
+    portENTER_CRITICAL(&heater->outputLock);
+    heater->windowStart = esp_timer_get_time();
+    heater->applyOnTime(0);
+    portEXIT_CRITICAL(&heater->outputLock);
+}
+
+void Heater::onSwitchOff(void *arg) {
+    auto *heater = static_cast<Heater *>(arg);
+    portENTER_CRITICAL(&heater->outputLock);
+    heater->switchRelay(false);
+    portEXIT_CRITICAL(&heater->outputLock);
+}
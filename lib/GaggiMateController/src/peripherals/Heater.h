@@ -4,34 +4,56 @@
 #include "Max31855Thermocouple.h"
 #include "TemperatureSensor.h"
 #include <SimplePID/SimplePID.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <functional>
 
 enum class PIDLibrary { Legacy, Nimrod };
 
 constexpr float MAX_AUTOTUNE_TEMP = 125.0f;
-constexpr float TUNER_OUTPUT_SPAN = 1000.0f;
+constexpr float TUNER_OUTPUT_SPAN = 1000.0f;                                         // PID output range, on time in ms
+constexpr int64_t HEATER_WINDOW_US = static_cast<int64_t>(TUNER_OUTPUT_SPAN) * 1000; // relay PWM window
+constexpr uint32_t HEATER_LOOP_INTERVAL_MS = 100;                                    // PID task period
+
+// Autotune takes one sample per relay window
+constexpr uint32_t AUTOTUNE_STEP_TICKS = static_cast<uint32_t>(TUNER_OUTPUT_SPAN) / HEATER_LOOP_INTERVAL_MS;
+
+// Heat load feedforward, the power that brings the planned brew water from the reservoir to the setpoint
+constexpr float HEATER_RATED_POWER = 1370.0f;        // W, boiler element
+constexpr float HEATER_INLET_TEMPERATURE = 20.0f;    // °C, reservoir water entering the boiler
+constexpr float HEATER_WATER_HEAT_CAPACITY = 4.186f; // J/(ml·K)
 
 using heater_error_callback_t = std::function<void()>;
-using pid_result_callback_t = std::function<void(float Kp, float Ki, float Kd)>;
+// A failed autotune reports the gains still in use
+using pid_result_callback_t = std::function<void(bool success, float Kp, float Ki, float Kd)>;
+using autotune_progress_callback_t = std::function<void(AutotuneState state, float temperature)>;
 
 class Heater {
   public:
     Heater(TemperatureSensor *sensor, uint8_t heaterPin, const heater_error_callback_t &error_callback,
-           const pid_result_callback_t &pid_callback);
+           const pid_result_callback_t &pid_callback, const autotune_progress_callback_t &progress_callback = nullptr);
+    ~Heater();
     void setup();
     void loop();
 
     void setSetpoint(float setpoint);
+    void setHeatLoad(float flow); // ml/s the display plans to draw through the boiler
     void setTunings(float Kp, float Ki, float Kd);
     void autotune(int goal, int windowSize);
 
   private:
     void setupPid();
     void setupAutotune(int goal, int windowSize);
+    void startAutotune();
+    void finishAutotune(bool success);
+    void setupOutput();
     void loopPid();
     void loopAutotune();
-    float softPwm(uint32_t windowSize);
+    float heatLoadOutput() const;
+    void setOutput(float onTime);
+    void applyOnTime(int64_t elapsed);
+    void switchRelay(bool on);
     void plot(float optimumOutput, float outputScale, uint8_t everyNth);
     void setTuningGoal(float percent);
     TemperatureSensor *sensor;
@@ -42,25 +64,40 @@ class Heater {
 
     heater_error_callback_t error_callback;
     pid_result_callback_t pid_callback;
+    autotune_progress_callback_t progress_callback;
 
     float temperature = 0.0f;
     float output = 0.0f;
     float setpoint = 0.0f;
+    float heatLoad = 0.0f;
+    float appliedFeedForward = 0.0f; // heat load share of output
     float Kp = 2.4;
     float Ki = 40;
     float Kd = 10;
     int plotCount = 0;
 
+    // Output stage: the window timer switches the relay on at the start of every window and arms the off timer for the
+    // on time, the relay is never polled
+    esp_timer_handle_t windowTimer = nullptr;
+    esp_timer_handle_t offTimer = nullptr;
+    portMUX_TYPE outputLock = portMUX_INITIALIZER_UNLOCKED;
+    int64_t onTimeUs = 0;
+    int64_t windowStart = 0; // esp_timer_get_time() at the start of the current window
     bool relayStatus = false;
-    unsigned long windowStartTime = 0;
-    unsigned long nextSwitchTime = 0;
 
     // Autotune variables
     bool startup = true;
     bool autotuning = false;
+    volatile bool autotuneRequested = false; // set from the BLE task, started by the heater task
+    int autotuneGoal = 0;
+    int autotuneWindowSize = 0;
+    uint32_t autotuneTicks = 0;
+    AutotuneState autotuneState = AutotuneState::BASELINE;
 
     const char *LOG_TAG = "Heater";
     static void loopTask(void *arg);
+    static void onWindowStart(void *arg);
+    static void onSwitchOff(void *arg);
 };
 
 #endif // HEATER_H
@@ -1,38 +1,73 @@
 #include "PressureSensor.h"
 #include "Wire.h"
+#include <Trace/Trace.h>
+
+static_assert((PRESSURE_RING_SIZE & (PRESSURE_RING_SIZE - 1)) == 0, "PRESSURE_RING_SIZE must be a power of two");
 
 PressureSensor::PressureSensor(uint8_t sda_pin, uint8_t scl_pin, const pressure_callback_t &callback, float pressure_scale,
-                               float voltage_floor, float voltage_ceil)
-    : _sda_pin(sda_pin), _scl_pin(scl_pin), _pressure_scale(pressure_scale), _callback(callback), taskHandle(nullptr) {
+                               float voltage_floor, float voltage_ceil, uint8_t alert_pin)
+    : _sda_pin(sda_pin), _scl_pin(scl_pin), _alert_pin(alert_pin), _pressure_scale(pressure_scale), _callback(callback),
+      taskHandle(nullptr) {
     _adc_floor = static_cast<int16_t>(voltage_floor / ADC_STEP);
     _pressure_adc_range = (voltage_ceil - voltage_floor) / ADC_STEP;
     _pressure_step = pressure_scale / _pressure_adc_range;
 }
 
 void PressureSensor::setup() {
-    Wire1.begin(_sda_pin, _scl_pin);
-    ESP_LOGV(LOG_TAG, "Initializing pressure sensor on SDA: %d, SCL: %d", _sda_pin, _scl_pin);
+    Wire1.begin(_sda_pin, _scl_pin, PRESSURE_I2C_CLOCK);
+    ESP_LOGV(LOG_TAG, "Initializing pressure sensor on SDA: %d, SCL: %d, ALERT: %d", _sda_pin, _scl_pin, _alert_pin);
     delay(100);
     ads = new ADS1115(0x48, &Wire1);
     if (!ads->begin()) {
         ESP_LOGE(LOG_TAG, "Failed to initialize ADS1115");
     }
     ads->setGain(0);
-    ads->setDataRate(4);
+    ads->setDataRate(PRESSURE_DATA_RATE);
     ads->setMode(0);
-    ads->readADC(0);
-    xTaskCreate(loopTask, "Heater::loop", configMINIMAL_STACK_SIZE * 4, this, 1, &taskHandle);
+    if (_alert_pin != 0) {
+        // High threshold negative and low threshold positive turn ALERT into a data ready pulse after every conversion
+        ads->setComparatorThresholdHigh(static_cast<int16_t>(0x8000));
+        ads->setComparatorThresholdLow(0x0000);
+        ads->setComparatorQueConvert(0);
+    }
+    // The conversions run from here on, loop() only fetches the latest result
+    ads->requestADC(0);
+    configureFilter(_filterType);
+    xTaskCreate(loopTask, "PressureSensor::loop", configMINIMAL_STACK_SIZE * 4, this, 1, &taskHandle);
+    if (_alert_pin != 0) {
+        pinMode(_alert_pin, INPUT_PULLUP);
+        attachInterruptArg(_alert_pin, onDataReady, this, FALLING);
+    }
 }
 
 void PressureSensor::loop() {
-    if (ads->isConnected()) {
-        int16_t reading = ads->readADC();
-        reading = reading - _adc_floor;
-        float pressure = reading * _pressure_step;
-        _raw_pressure = pressure;
-        _pressure = 0.05f * pressure + 0.95f * _pressure;
-        _raw_pressure = std::clamp(_raw_pressure, 0.0f, _pressure_scale);
-        _pressure = std::clamp(_pressure, 0.0f, _pressure_scale);
+    if (_filterType != _filter.getType()) {
+        configureFilter(_filterType);
+    }
+    if (!ads->isConnected()) {
+        return;
+    }
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&_readyLock);
+    int64_t timestamp = _readyTime;
+    portEXIT_CRITICAL(&_readyLock);
+    if (_alert_pin == 0 || timestamp <= _lastSampleTime) {
+        timestamp = now; // polled, or the data ready edge was missed
+    }
+    int16_t reading = ads->getValue();
+    reading = reading - _adc_floor;
+    const float pressure = std::clamp(reading * _pressure_step, 0.0f, _pressure_scale);
+    const float dt = _sampleCount > 0 ? static_cast<float>(timestamp - _lastSampleTime) / 1e6f : 0.0f;
+    _lastSampleTime = timestamp;
+    addSample(timestamp, pressure);
+
+    _raw_pressure = std::clamp(_filter.update(pressure, dt), 0.0f, _pressure_scale);
+    const float alpha = _sampleCount > 1 ? dt / (PRESSURE_DISPLAY_TIME_CONSTANT + dt) : 1.0f;
+    _pressure = std::clamp(_pressure + alpha * (pressure - _pressure), 0.0f, _pressure_scale);
+    trace::record(TraceEvent::PRESSURE_SAMPLE, pressure, _raw_pressure, _filter.getRate(), dt * 1000.0f);
+
+    if (now - _lastCallbackTime >= PRESSURE_CALLBACK_INTERVAL_MS * 1000LL) {
+        _lastCallbackTime = now;
         ESP_LOGV(LOG_TAG, "ADC Reading: %d, Pressure Reading: %f, Pressure Step: %f, Floor: %d", reading, _pressure,
                  _pressure_step, _adc_floor);
         _callback(_pressure);
@@ -44,11 +79,68 @@ void PressureSensor::setScale(float pressure_scale) {
     _pressure_step = pressure_scale / _pressure_adc_range;
 }
 
+void PressureSensor::setFilter(PressureFilterType type) { _filterType = type; }
+
+size_t PressureSensor::getSamples(PressureSample *out, size_t maxSamples, int64_t since) const {
+    portENTER_CRITICAL(&_sampleLock);
+    size_t first = _sampleCount - std::min(_sampleCount, PRESSURE_RING_SIZE);
+    while (first < _sampleCount && _samples[first & (PRESSURE_RING_SIZE - 1)].timestamp <= since) {
+        first++;
+    }
+    if (_sampleCount - first > maxSamples) {
+        first = _sampleCount - maxSamples;
+    }
+    size_t copied = 0;
+    for (size_t i = first; i < _sampleCount; i++) {
+        out[copied++] = _samples[i & (PRESSURE_RING_SIZE - 1)];
+    }
+    portEXIT_CRITICAL(&_sampleLock);
+    return copied;
+}
+
+void PressureSensor::addSample(int64_t timestamp, float pressure) {
+    portENTER_CRITICAL(&_sampleLock);
+    _samples[_sampleCount & (PRESSURE_RING_SIZE - 1)] = {timestamp, pressure};
+    _sampleCount++;
+    portEXIT_CRITICAL(&_sampleLock);
+}
+
+void PressureSensor::configureFilter(PressureFilterType type) {
+    switch (type) {
+    case PressureFilterType::NONE:
+        _filter.setNone();
+        break;
+    case PressureFilterType::LOW_PASS:
+        _filter.setLowPass(PRESSURE_LOW_PASS_CUTOFF, 1000.0f / PRESSURE_SAMPLE_INTERVAL_MS);
+        break;
+    case PressureFilterType::KALMAN:
+        _filter.setKalman(PRESSURE_KALMAN_MEASUREMENT_NOISE, PRESSURE_KALMAN_RATE_NOISE);
+        break;
+    }
+}
+
 [[noreturn]] void PressureSensor::loopTask(void *arg) {
     TickType_t lastWake = xTaskGetTickCount();
     auto *sensor = static_cast<PressureSensor *>(arg);
     while (true) {
+        if (sensor->_alert_pin != 0) {
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(PRESSURE_READY_TIMEOUT_MS));
+        } else {
+            xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(PRESSURE_SAMPLE_INTERVAL_MS));
+        }
         sensor->loop();
-        xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(PRESSURE_READ_INTERVAL_MS));
+    }
+}
+
+void IRAM_ATTR PressureSensor::onDataReady(void *arg) {
+    auto *sensor = static_cast<PressureSensor *>(arg);
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL_ISR(&sensor->_readyLock);
+    sensor->_readyTime = now;
+    portEXIT_CRITICAL_ISR(&sensor->_readyLock);
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(sensor->taskHandle, &higherPriorityTaskWoken);
+    if (higherPriorityTaskWoken) {
+        portYIELD_FROM_ISR();
     }
 }
@@ -3,27 +3,61 @@
 
 #include <ADS1X15.h>
 #include <Arduino.h>
+#include <PressureFilter/PressureFilter.h>
+#include <esp_timer.h>
 
-constexpr int PRESSURE_READ_INTERVAL_MS = 30;
 constexpr float ADC_STEP = 6.144f / 32767.0f;
+// ADS1115 in continuous conversion at 250 SPS, the pump tick sees the average of seven fresh samples
+constexpr uint8_t PRESSURE_DATA_RATE = 5;
+constexpr int PRESSURE_SAMPLE_INTERVAL_MS = 4;
+// Longest wait for the data ready edge before the conversion register is read anyway
+constexpr int PRESSURE_READY_TIMEOUT_MS = 3 * PRESSURE_SAMPLE_INTERVAL_MS;
+constexpr int PRESSURE_CALLBACK_INTERVAL_MS = 30;
+constexpr uint32_t PRESSURE_I2C_CLOCK = 400000;
+constexpr size_t PRESSURE_RING_SIZE = 64; // samples, a power of two
+
+// Time constant of the displayed pressure (s), what the old 0.05 EMA at 30 ms amounted to
+constexpr float PRESSURE_DISPLAY_TIME_CONSTANT = 0.6f;
+constexpr float PRESSURE_LOW_PASS_CUTOFF = 20.0f;          // Hz
+constexpr float PRESSURE_KALMAN_MEASUREMENT_NOISE = 0.03f; // bar
+constexpr float PRESSURE_KALMAN_RATE_NOISE = 60.0f;        // bar/s per √s
 
 using pressure_callback_t = std::function<void(float)>;
 
+struct PressureSample {
+    int64_t timestamp; // µs, end of the conversion
+    float pressure;    // bar, unfiltered
+};
+
 class PressureSensor {
   public:
+    // alert_pin is the ADS1115 ALERT/RDY line, 0 when it is not wired and the conversions are polled instead
     PressureSensor(uint8_t sda_pin, uint8_t scl_pin, const pressure_callback_t &callback, float pressure_scale = 16.0f,
-                   float voltage_floor = 0.5, float voltage_ceil = 4.5);
+                   float voltage_floor = 0.5, float voltage_ceil = 4.5, uint8_t alert_pin = 0);
     ~PressureSensor() = default;
 
     void setup();
+    // Takes the latest conversion, once per sample interval or data ready edge
     void loop();
+    // Smoothed for the display
     inline float getPressure() const { return _pressure; };
+    // Low latency filtered pressure for the pump controller
     inline float getRawPressure() const { return _raw_pressure; };
+    inline float getPressureRate() const { return _filter.getRate(); };
     void setScale(float pressure_scale);
+    // Applied by the sampling task before its next sample
+    void setFilter(PressureFilterType type);
+
+    // Copies up to maxSamples of the newest samples taken after since, oldest first. Safe from any task.
+    size_t getSamples(PressureSample *out, size_t maxSamples, int64_t since = 0) const;
 
   private:
+    void addSample(int64_t timestamp, float pressure);
+    void configureFilter(PressureFilterType type);
+
     uint8_t _sda_pin;
     uint8_t _scl_pin;
+    uint8_t _alert_pin;
     float _pressure = 0.0f;
     float _raw_pressure = 0.0f;
     float _pressure_adc_range;
@@ -34,8 +68,20 @@ class PressureSensor {
     pressure_callback_t _callback;
     xTaskHandle taskHandle;
 
+    PressureFilter _filter;
+    volatile PressureFilterType _filterType = PressureFilterType::KALMAN;
+    PressureSample _samples[PRESSURE_RING_SIZE] = {};
+    size_t _sampleCount = 0; // total written, the ring holds the last PRESSURE_RING_SIZE
+    mutable portMUX_TYPE _sampleLock = portMUX_INITIALIZER_UNLOCKED;
+    int64_t _lastSampleTime = 0;
+    int64_t _lastCallbackTime = 0;
+    // Set by the data ready interrupt. A 64 bit load is two loads on the ESP32, both sides take the lock.
+    int64_t _readyTime = 0;
+    portMUX_TYPE _readyLock = portMUX_INITIALIZER_UNLOCKED;
+
     const char *LOG_TAG = "PressureSensor";
-    static void loopTask(void *arg);
+    [[noreturn]] static void loopTask(void *arg);
+    static void onDataReady(void *arg);
 };
 
 #endif // PRESSURESENSOR_H
@@ -3,6 +3,7 @@
 #include "ControllerConfig.h"
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <BinaryProtocol.h>
 
 inline String make_system_info(ControllerConfig config, String version) {
     JsonDocument doc;
@@ -13,6 +14,7 @@ inline String make_system_info(ControllerConfig config, String version) {
     capabilities["dm"] = config.capabilites.dimming;
     capabilities["led"] = config.capabilites.ledControls;
     capabilities["tof"] = config.capabilites.tof;
+    capabilities["bin"] = BINARY_PROTOCOL_VERSION;
     doc["cp"] = capabilities;
     return doc.as<String>();
 }
@@ -3,84 +3,77 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
-#include <numeric>
 
 Autotune::Autotune() {};
 
 void Autotune::reset() {
-    values.clear();
-    times.clear();
-    slopes.clear();
-    slopeTimes.clear();
+    temperatures.reset(N);
+    slopes.reset(N);
+    state = AutotuneState::BASELINE;
     currentConfirmations = 0;
-    reactionDetected = false;
-    maxSlopeFound = false;
-    finished = false;
     initialSlope = 0.0f;
+    lastSlope = 0.0f;
     maxPowerOn = false;
 }
 
 void Autotune::update(float temperature, float currentTime) {
-    // Check if the autotune process is finished
-    if (finished)
+    if (isFinished())
         return;
-    if (values.empty())
+    if (temperatures.getCount() == 0)
         initialTemp = temperature;
 
-    values.push_back(temperature); // Store the temperature value
-    times.push_back(currentTime);  // Store the associated time stamp
-
-    if (values.size() > N) { // Check if we have enough data points to analyze
-        std::deque<float> local_times(times.end() - N, times.end());
-        std::deque<float> local_values(values.end() - N, values.end());
-        float slope = computeSlope(local_times, local_values);
-
-        if (!reactionDetected) {
-            if (slope > initialSlope + epsilon) {
-                currentConfirmations++;
-                if (currentConfirmations >= requiredConfirmations) {
-                    reactionDetected = true;
-                    reactionTime = times[times.size() - requiredConfirmations];
-                }
-            } else {
-                // Waiting for the reaction to be detected
-                currentConfirmations = 0;
-                if (currentTime - startPowerOnTime > maxTimeOut_s)
-                    finished = true;
+    temperatures.push(currentTime, temperature);
+    if (!temperatures.isFull())
+        return; // Not enough data points to compute the slope yet
+    const float slope = temperatures.getSlope();
+    lastSlope = slope;
+
+    switch (state) {
+    case AutotuneState::BASELINE:
+        // Slope of the system at rest, the reaction is measured against it
+        initialSlope = slope;
+        maxPowerOn = true; // Now we can start to heat up the system
+        startPowerOnTime = currentTime;
+        state = AutotuneState::WAIT_REACTION;
+        break;
+    case AutotuneState::WAIT_REACTION:
+        if (slope > initialSlope + epsilon) {
+            if (currentConfirmations == 0)
+                firstConfirmationTime = currentTime;
+            currentConfirmations++;
+            if (currentConfirmations >= requiredConfirmations) {
+                reactionTime = firstConfirmationTime;
+                state = AutotuneState::MEASURE_SLOPE;
             }
         } else {
-            slopes.push_back(slope);
-            slopeTimes.push_back(currentTime);
-
-            if (slopes.size() >= N) {
-                float slopeOfSlope = computeSlope(slopeTimes, slopes);
-                if (slopeOfSlope < 0.05 && !maxSlopeFound && temperature > initialTemp + 10) {
-                    auto maxIt = std::max_element(slopes.begin(), slopes.end());
-                    system_gain = *maxIt;
-                    maxSlopeTime = slopeTimes[std::distance(slopes.begin(), maxIt)];
-
-                    maxSlopeFound = true;
-                    finished = true;
-
-                    system_pure_delay = reactionTime - startPowerOnTime;
-                    computeControllerGains(system_pure_delay, system_gain);
+            // Waiting for the reaction to be detected
+            currentConfirmations = 0;
+            if (currentTime - startPowerOnTime > maxTimeOut_s)
+                state = AutotuneState::FAILED;
+        }
+        break;
+    case AutotuneState::MEASURE_SLOPE:
+        slopes.push(currentTime, slope);
+        if (slopes.isFull()) {
+            const float slopeOfSlope = slopes.getSlope();
+            if (slopeOfSlope < 0.05 && temperature > initialTemp + 10) {
+                size_t maxIndex = 0;
+                for (size_t i = 1; i < slopes.getCount(); i++) {
+                    if (slopes.getY(i) > slopes.getY(maxIndex))
+                        maxIndex = i;
                 }
-                slopes.pop_front();
-                slopeTimes.pop_front();
+                system_gain = slopes.getY(maxIndex);
+                maxSlopeTime = slopes.getX(maxIndex);
+
+                system_pure_delay = reactionTime - startPowerOnTime;
+                computeControllerGains(system_pure_delay, system_gain);
+                state = AutotuneState::DONE;
             }
         }
-        values.pop_front();
-        times.pop_front();
-    } else {
-        // Not enough data points yet, wait for more, but if we have enough data points
-        // to compute the slope, we can compute it and store it
-        if (values.size() == N) {
-            std::deque<float> local_times(times.end() - N, times.end());
-            std::deque<float> local_values(values.end() - N, values.end());
-            initialSlope = computeSlope(local_times, local_values);
-            maxPowerOn = true; // Now we can start to heat up the system
-            startPowerOnTime = currentTime;
-        }
+        break;
+    case AutotuneState::DONE:
+    case AutotuneState::FAILED:
+        break;
     }
 }
 
@@ -118,38 +111,64 @@ void Autotune::computeControllerGains(float delay, float gain) {
     Kff = kff;
 }
 
-float Autotune::computeSlope(const std::deque<float> &x, const std::deque<float> &y) {
+void RegressionWindow::reset(unsigned int windowSize) {
+    size = windowSize;
+    head = 0;
+    count = 0;
+    sumX = sumY = sumXX = sumXY = 0.0;
+}
+
+void RegressionWindow::push(float x, float y) {
+    if (count == 0)
+        origin = x;
+    const double dx = x - origin;
+    if (count == size) {
+        // Replace the oldest point
+        const double oldX = xs[head] - origin;
+        const double oldY = ys[head];
+        sumX -= oldX;
+        sumY -= oldY;
+        sumXX -= oldX * oldX;
+        sumXY -= oldX * oldY;
+        xs[head] = x;
+        ys[head] = y;
+        head = (head + 1) % size;
+    } else {
+        const size_t index = (head + count) % size;
+        xs[index] = x;
+        ys[index] = y;
+        count++;
+    }
+    sumX += dx;
+    sumY += y;
+    sumXX += dx * dx;
+    sumXY += dx * y;
+}
+
+float RegressionWindow::getSlope() const {
     // Calculate the slope of the line using the least squares method
     // Goal is to find the slope of the line that best fits the data points cloud
     // rather thand performing a pure derivative and filtering it
     // This is a more robust method to find the derivative of a noisy heavily quantified signal
-    int n = x.size();
-    if (n < 2)
+    if (count < 2)
         return 0.0f;
-
-    float sum_x = std::accumulate(x.begin(), x.end(), 0.0f);
-    float sum_y = std::accumulate(y.begin(), y.end(), 0.0f);
-    float sum_xx = 0.0f, sum_xy = 0.0f;
-
-    for (int i = 0; i < n; ++i) {
-        sum_xx += x[i] * x[i];
-        sum_xy += x[i] * y[i];
-    }
-
-    float denom = n * sum_xx - sum_x * sum_x;
-    if (denom == 0.0f)
+    const double n = static_cast<double>(count);
+    const double denom = n * sumXX - sumX * sumX;
+    if (denom == 0.0)
         return 0.0f;
-
-    return (n * sum_xy - sum_x * sum_y) / denom;
+    return static_cast<float>((n * sumXY - sumX * sumY) / denom);
 }
 
+float RegressionWindow::getX(size_t i) const { return xs[(head + i) % size]; }
+float RegressionWindow::getY(size_t i) const { return ys[(head + i) % size]; }
+
 void Autotune::setupAutotune(unsigned int windowSize, float slopeThreshold, unsigned int confirmationCount) {
-    N = windowSize;
+    setWindowsize(windowSize);
     epsilon = slopeThreshold;
     requiredConfirmations = confirmationCount;
 }
 
-void Autotune::setWindowsize(unsigned int size) { N = size; }
+void Autotune::setWindowsize(unsigned int size) { N = std::clamp(size, 2u, AUTOTUNE_MAX_WINDOW); }
 
 void Autotune::setEpsilon(float eps) { epsilon = eps; }
 
@@ -157,7 +176,7 @@ void Autotune::setRequiredConfirmations(unsigned int confirmations) { requiredCo
 
 void Autotune::setTimeOut(float timeOut) { maxTimeOut_s = timeOut; }
 
-bool Autotune::isFinished() const { return finished; }
+bool Autotune::isFinished() const { return state == AutotuneState::DONE || state == AutotuneState::FAILED; }
 float Autotune::getKp() const { return Kp; }
 float Autotune::getKi() const { return Ki; }
 float Autotune::getKd() const { return Kd; }
@@ -1,21 +1,58 @@
 #pragma once
 
-#include <deque>
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+constexpr unsigned int AUTOTUNE_MAX_WINDOW = 32; // largest moving window, the buffers are sized for it
+
+// Steps of a tuning run, update() moves through them one sample at a time
+enum class AutotuneState : uint8_t {
+    BASELINE,      // heater off, filling the first window to measure the resting slope
+    WAIT_REACTION, // full power, waiting for the temperature to rise faster than at rest
+    MEASURE_SLOPE, // waiting for the heating rate to stop increasing
+    DONE,          // gains computed
+    FAILED,        // no reaction before the timeout
+};
+
+// Least squares slope over the last points, kept as running sums so a new point costs the same for any window size.
+// x is taken relative to the first point so the sums keep their precision on a long uptime.
+class RegressionWindow {
+  public:
+    void reset(unsigned int size);
+    void push(float x, float y);
+
+    bool isFull() const { return count == size; }
+    size_t getCount() const { return count; }
+    float getSlope() const;
+    float getX(size_t i) const; // i = 0 is the oldest point
+    float getY(size_t i) const;
+
+  private:
+    float xs[AUTOTUNE_MAX_WINDOW] = {};
+    float ys[AUTOTUNE_MAX_WINDOW] = {};
+    unsigned int size = AUTOTUNE_MAX_WINDOW;
+    size_t head = 0; // oldest point
+    size_t count = 0;
+    float origin = 0.0f;
+    double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+};
 
 class Autotune {
   public:
     Autotune();
 
     void reset();
+    // One step of the run, called once per heater window. Never blocks and never allocates.
     void update(float temperature, float currentTime);
 
+    AutotuneState getState() const { return state; }
     bool isFinished() const;
 
     float getKp() const;
     float getKi() const;
     float getKd() const;
     float getKff() const;
+    float getLastSlope() const { return lastSlope; }
     void setupAutotune(unsigned int windowSize, float slopeThreshold, unsigned int confirmationCount);
     void setWindowsize(unsigned int size);
     void setEpsilon(float eps);
@@ -29,7 +66,6 @@ class Autotune {
     float getCrossoverFreq() const { return cross_freq; };
 
   private:
-    float computeSlope(const std::deque<float> &x, const std::deque<float> &y);
     void computeControllerGains(float system_pure_delay, float system_gain);
 
     unsigned int N = 4;   // Size of the moving window to compute the derivative of temperature
@@ -37,15 +73,18 @@ class Autotune {
     unsigned int requiredConfirmations =
         3; // Number consecutive detection of rising temperature to consider the reaction detected
     float tuningPercentage = 50;
-    std::deque<float> values, times, slopes, slopeTimes;
-    float initialTemp; // Autotune starting point temperature
+    RegressionWindow temperatures; // temperature over time
+    RegressionWindow slopes;       // heating rate over time, once the reaction is detected
+    float initialTemp = 0.0f;      // Autotune starting point temperature
 
-    unsigned int currentConfirmations;
-    bool reactionDetected, maxSlopeFound, finished;
+    AutotuneState state = AutotuneState::BASELINE;
+    unsigned int currentConfirmations = 0;
+    float firstConfirmationTime = 0.0f;
+    float lastSlope = 0.0f;
 
     float reactionTime = -1.0f, maxSlope = -1.0f, maxSlopeTime = -1.0f, startPowerOnTime = -1.0f;
-    float Kp, Ki, Kd, Kff;
-    float initialSlope;
+    float Kp = 0.0f, Ki = 0.0f, Kd = 0.0f, Kff = 0.0f;
+    float initialSlope = 0.0f;
     float maxTimeOut_s = 20; // (s) Maximum time to wait for the reaction to be detected before giving up
 
     float system_pure_delay = 0.0f;
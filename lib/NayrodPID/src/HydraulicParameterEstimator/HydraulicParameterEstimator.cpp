@@ -1,4 +1,5 @@
 #include "HydraulicParameterEstimator.h"
+#include "Matrix3.h"
 #include <cmath>
 #ifdef ARDUINO
 #include <Arduino.h>
@@ -28,7 +29,7 @@ HydraulicParameterEstimator::HydraulicParameterEstimator(float dt_)
     float sigmaQin = 0.7f;        // ml/s incertitude pompe
     float kDrift = 0.1f;          // ml/s/√bar/s (puck change lent)
     float qOutDrift = 0.3f;       // ml/s²
-    float pressureNoise = 0.002f; // bar RMS bruit capteur
+    float pressureNoise = 0.02f;  // bar RMS bruit capteur
 
     setPhysicalNoises(sigmaQin, kDrift, qOutDrift, pressureNoise);
 
@@ -65,7 +66,8 @@ void HydraulicParameterEstimator::reset() {
     Vin_cum = 0.0f;
 }
 
-bool HydraulicParameterEstimator::hasConverged() { return P_cov[1][1] < 1e-16f; }
+// k variance settles around 7e-4 with the drift above, 1e-2 is a standard deviation of 0.1 ml/s/√bar
+bool HydraulicParameterEstimator::hasConverged() { return P_cov[1][1] < 1e-2f; }
 float HydraulicParameterEstimator::getEffectiveCompliance(float Vin) {
     // Paramètres à tuner
     const float Vfill = 3.5f;     // mL volume variation C
@@ -99,57 +101,29 @@ bool HydraulicParameterEstimator::update(float Q_in, float P_meas) {
     float k_pred = kk;
     float Qout_pred = kk * sqrtP;
 
-    float X_pred[3] = {P_pred, k_pred, Qout_pred};
-
     // Jacobian F
     float dPdP = 1.0f;
     float dPdQout = -dt / C_eff;
     float dQoutdP = (kk > 0.0f) ? (0.5f * kk / sqrtP) : 0.0f;
     float dQoutdk = sqrtP;
 
-    float F[3][3] = {{dPdP, 0.0f, dPdQout}, {0.0f, 1.0f, 0.0f}, {dQoutdP, dQoutdk, 0.0f}};
+    const float F[3][3] = {{dPdP, 0.0f, dPdQout}, {0.0f, 1.0f, 0.0f}, {dQoutdP, dQoutdk, 0.0f}};
 
     // covariance prédite
-    float P_pred_cov[3][3] = {0};
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j) {
-            for (int k = 0; k < 3; ++k)
-                for (int l = 0; l < 3; ++l)
-                    P_pred_cov[i][j] += F[i][k] * P_cov[k][l] * F[j][l];
-            P_pred_cov[i][j] += Qk[i][j];
-        }
+    float P_pred_cov[3][3];
+    mat3::propagate(F, P_cov, Qk, P_pred_cov);
 
     // === Correction ===
-    float H[3] = {1.0f, 0.0f, 0.0f}; // mesure: P
-    float S = 0.0f;
-    for (int i = 0; i < 3; ++i)
-        S += H[i] * P_pred_cov[i][0];
-    S += meas_noise_var;
-
-    float K_gain[3];
-    for (int i = 0; i < 3; ++i)
-        K_gain[i] = P_pred_cov[i][0] / S;
-
-    float innov = P_meas - X_pred[0];
-
-    for (int i = 0; i < 3; ++i)
-        X_state[i] = X_pred[i] + K_gain[i] * innov;
-
-    // Joseph form
-    float I_KH[3][3];
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            I_KH[i][j] = (i == j ? 1.0f : 0.0f) - K_gain[i] * H[j];
-
-    float temp[3][3] = {0};
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            for (int k = 0; k < 3; ++k)
-                temp[i][j] += I_KH[i][k] * P_pred_cov[k][j];
-
-    for (int i = 0; i < 3; ++i)
-        for (int j = 0; j < 3; ++j)
-            P_cov[i][j] = temp[i][j];
+    // mesure: P, H = [1 0 0]
+    const float S = P_pred_cov[0][0] + meas_noise_var;
+    const float K_gain[3] = {P_pred_cov[0][0] / S, P_pred_cov[1][0] / S, P_pred_cov[2][0] / S};
+
+    const float innov = P_meas - P_pred;
+    X_state[0] = P_pred + K_gain[0] * innov;
+    X_state[1] = k_pred + K_gain[1] * innov;
+    X_state[2] = Qout_pred + K_gain[2] * innov;
+
+    mat3::correctFirst(P_pred_cov, K_gain, P_cov);
 
     K_est = fmaxf(X_state[1], 0.0f);
 
@@ -1,7 +1,6 @@
 #ifndef HYDRAULICPARAMETERESTIMATOR_H
 #define HYDRAULICPARAMETERESTIMATOR_H
 
-#include <deque>
 #include <math.h>
 
 class HydraulicParameterEstimator {
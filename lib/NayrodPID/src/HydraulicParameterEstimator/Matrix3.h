@@ -0,0 +1,55 @@
+#ifndef MATRIX3_H
+#define MATRIX3_H
+
+// Fixed size 3x3 kernels for the hydraulic EKF. Fully unrolled and working on scalars, the covariance step runs in the
+// pump task every tick and the generic loops cost four nested loops and a temporary matrix per product.
+namespace mat3 {
+
+// out = A * P * A^T + Q for symmetric P and Q, only the upper triangle is computed. out must not alias P.
+inline void propagate(const float (&A)[3][3], const float (&P)[3][3], const float (&Q)[3][3], float (&out)[3][3]) {
+    // Rows of A * P
+    const float r00 = A[0][0] * P[0][0] + A[0][1] * P[1][0] + A[0][2] * P[2][0];
+    const float r01 = A[0][0] * P[0][1] + A[0][1] * P[1][1] + A[0][2] * P[2][1];
+    const float r02 = A[0][0] * P[0][2] + A[0][1] * P[1][2] + A[0][2] * P[2][2];
+    const float r10 = A[1][0] * P[0][0] + A[1][1] * P[1][0] + A[1][2] * P[2][0];
+    const float r11 = A[1][0] * P[0][1] + A[1][1] * P[1][1] + A[1][2] * P[2][1];
+    const float r12 = A[1][0] * P[0][2] + A[1][1] * P[1][2] + A[1][2] * P[2][2];
+    const float r20 = A[2][0] * P[0][0] + A[2][1] * P[1][0] + A[2][2] * P[2][0];
+    const float r21 = A[2][0] * P[0][1] + A[2][1] * P[1][1] + A[2][2] * P[2][1];
+    const float r22 = A[2][0] * P[0][2] + A[2][1] * P[1][2] + A[2][2] * P[2][2];
+
+    out[0][0] = r00 * A[0][0] + r01 * A[0][1] + r02 * A[0][2] + Q[0][0];
+    out[0][1] = r00 * A[1][0] + r01 * A[1][1] + r02 * A[1][2] + Q[0][1];
+    out[0][2] = r00 * A[2][0] + r01 * A[2][1] + r02 * A[2][2] + Q[0][2];
+    out[1][1] = r10 * A[1][0] + r11 * A[1][1] + r12 * A[1][2] + Q[1][1];
+    out[1][2] = r10 * A[2][0] + r11 * A[2][1] + r12 * A[2][2] + Q[1][2];
+    out[2][2] = r20 * A[2][0] + r21 * A[2][1] + r22 * A[2][2] + Q[2][2];
+    out[1][0] = out[0][1];
+    out[2][0] = out[0][2];
+    out[2][1] = out[1][2];
+}
+
+// out = (I - K * e0^T) * P, the covariance correction after measuring the first state with gain K = P[:, 0] / S.
+// The result stays symmetric for that gain, only the upper triangle is computed. out may alias P.
+inline void correctFirst(const float (&P)[3][3], const float (&K)[3], float (&out)[3][3]) {
+    const float p00 = P[0][0];
+    const float p01 = P[0][1];
+    const float p02 = P[0][2];
+    const float p11 = P[1][1];
+    const float p12 = P[1][2];
+    const float p22 = P[2][2];
+
+    out[0][0] = p00 - K[0] * p00;
+    out[0][1] = p01 - K[0] * p01;
+    out[0][2] = p02 - K[0] * p02;
+    out[1][1] = p11 - K[1] * p01;
+    out[1][2] = p12 - K[1] * p02;
+    out[2][2] = p22 - K[2] * p02;
+    out[1][0] = out[0][1];
+    out[2][0] = out[0][2];
+    out[2][1] = out[1][2];
+}
+
+} // namespace mat3
+
+#endif // MATRIX3_H
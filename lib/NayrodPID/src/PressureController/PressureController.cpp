@@ -1,5 +1,6 @@
 #include "PressureController.h"
 #include "SimpleKalmanFilter/SimpleKalmanFilter.h"
+#include "Trace/Trace.h"
 #include <algorithm>
 #include <math.h>
 
@@ -16,7 +17,8 @@ void PressureController::applyLowPassFilter(float *filteredValue, float rawValue
 }
 
 PressureController::PressureController(float dt, float *rawPressureSetpoint, float *rawFlowSetpoint, float *sensorOutput,
-                                       float *controllerOutput, int *valveStatus) {
+                                       float *controllerOutput, int *valveStatus)
+    : _hydraulicEstimator(dt) {
     this->_rawPressureSetpoint = rawPressureSetpoint;
     this->_rawFlowSetpoint = rawFlowSetpoint;
     this->_rawPressure = sensorOutput;
@@ -75,6 +77,7 @@ void PressureController::update(ControlMode mode) {
         *_ctrlOutput = getPumpDutyCycleForPressure();
     }
     virtualScale();
+    trace::record(TraceEvent::PRESSURE_UPDATE, *_rawPressureSetpoint, *_rawFlowSetpoint, _filteredPressureSensor, *_ctrlOutput);
 }
 
 float PressureController::pumpFlowModel(float alpha) const {
@@ -117,6 +120,7 @@ void PressureController::setPumpFlowPolyCoeffs(float a, float b, float c, float
 }
 
 void PressureController::tare() {
+    _hydraulicEstimator.reset();
     _coffeeOutput = 0.0f;
     _pumpVolume = 0.0f;
     _puckSaturationVolume = 0.0f;
@@ -141,6 +145,10 @@ void PressureController::virtualScale() {
     float flowRaw = _pumpFlowRate - effectiveCompliance * _filteredPressureDerivative;
 
     applyLowPassFilter(&_waterThroughPuckFlowRate, flowRaw, 0.3f, _dt);
+    // The EKF works on the raw pressure and carries its own compliance model, it runs whenever water reaches the puck
+    if (*_valveStatus == 1 && *_rawPressure > 0.8f) {
+        _hydraulicEstimator.update(_pumpFlowRate, *_rawPressure);
+    }
     if (_waterThroughPuckFlowRate > 0.0f && *_valveStatus == 1 && _filteredPressureSensor > 0.8f) {
         _puckCounter++;
         _puckSaturationVolume += _waterThroughPuckFlowRate * _dt;
@@ -172,25 +180,32 @@ void PressureController::virtualScale() {
         would just nee to pass all the state to true.
         */
 
-        if (_puckConductanceDerivative < -0.5f && float(_puckCounter) * _dt > 1.0f) // Puck conductivity is decreasing fast
-            _puckState[0] = true;
+        if (!_puckState[0] && _puckConductanceDerivative < -0.5f && float(_puckCounter) * _dt > 1.0f) {
+            _puckState[0] = true; // Puck conductivity is decreasing fast
+            trace::record(TraceEvent::PUCK_STATE, 0, _puckConductance, _puckConductanceDerivative, _puckSaturationVolume);
+        }
 
         int timeStamp = 0;
         if (_puckState[0] && _puckConductanceDerivative > -0.1f && !_puckState[1]) { // Puck conductivity is settling down
             _puckState[1] = true;
             timeStamp = _puckCounter;
+            trace::record(TraceEvent::PUCK_STATE, 1, _puckConductance, _puckConductanceDerivative, _puckSaturationVolume);
         }
 
         _puckResistance = 1.0 / _puckConductance;
         if (_puckState[1]) {
+            // Once the EKF has settled its puck flow and conductance replace the compliance based estimate
+            const bool useEstimator = _hydraulicEstimator.hasConverged() && _hydraulicEstimator.getResistance() > 0.0f;
+            const float puckFlow = useEstimator ? _hydraulicEstimator.getQout() : _waterThroughPuckFlowRate;
+            const float puckResistance = useEstimator ? 1.0f / _hydraulicEstimator.getResistance() : 1.0f / _puckConductance;
             if (_puckCounter == timeStamp) { // Intialise values
-                _coffeeFlowRate =
-                    _waterThroughPuckFlowRate; // Initiate the flow immediatly to the instantaneous flow to not waist time
-                _puckResistance = 1.0f / _puckConductance; // Same for the puck resistance
+                _coffeeFlowRate = puckFlow;       // Initiate the flow immediatly to the instantaneous flow to not waist time
+                _puckResistance = puckResistance; // Same for the puck resistance
             }
-            applyLowPassFilter(&_puckResistance, 1.0f / _puckConductance, 0.1f, _dt); // Filter for cosmetic purpose
-            // Reset the puck flow rate to avoid slow decay filter response by using the raw flow value for coffee flow
-            applyLowPassFilter(&_coffeeFlowRate, _waterThroughPuckFlowRate, 0.2f, _dt);
+            applyLowPassFilter(&_puckResistance, puckResistance, 0.1f, _dt); // Filter for cosmetic purpose
+            // Reset the puck flow rate to avoid slow decay filter response by using the raw flow value for coffee flow,
+            // the EKF output is smoothed already and only gets a light filter
+            applyLowPassFilter(&_coffeeFlowRate, puckFlow, useEstimator ? 1.0f : 0.2f, _dt);
             // Account for missed drops (WIP)
             if (!_puckState[2]) {
                 float timeMissedDrops = 2.0f; // First drop occured X second ago
@@ -203,9 +218,8 @@ void PressureController::virtualScale() {
                 _coffeeOutput += _coffeeFlowRate * _dt;
             }
         }
-        // ESP_LOGI("","%d;\t %1.3e;\t %1.3e;\t %1.3e;\t %1.3e;\t %1.3e", millis(),_puckConductance, _puckConductanceDerivative,
-        // _waterThroughPuckFlowRate, _coffeeFlowRate, _puckResistance);
     }
+    trace::record(TraceEvent::VIRTUAL_SCALE, _pumpFlowRate, getCoffeeFlowRate(), _puckResistance, _coffeeOutput);
 }
 
 float PressureController::getPumpDutyCycleForPressure() {
@@ -270,5 +284,5 @@ void PressureController::reset() {
     _puckState[1] = false;
     _puckState[2] = false;
     _puckCounter = 0;
-    ESP_LOGI("", "RESET");
+    trace::record(TraceEvent::PRESSURE_RESET, _filteredPressureSensor);
 }
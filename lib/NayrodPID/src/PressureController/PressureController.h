@@ -5,6 +5,7 @@
 static constexpr float M_PI = 3.14159265358979323846f;
 #endif
 
+#include "HydraulicParameterEstimator/HydraulicParameterEstimator.h"
 #include "SimpleKalmanFilter/SimpleKalmanFilter.h"
 #include <algorithm>
 
@@ -101,6 +102,7 @@ class PressureController {
     int _puckCounter = 0;
     float exportPumpFlowRate = 0.0f; // To disociate the exported value from the internal because of filtering (cosmetic) purpose
     SimpleKalmanFilter *_pressureKalmanFilter;
+    HydraulicParameterEstimator _hydraulicEstimator; // EKF on [P, k, Qout] fed with the raw pressure
 };
 
 #endif // PRESSURE_CONTROLLER_H
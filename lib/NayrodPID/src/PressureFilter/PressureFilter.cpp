@@ -0,0 +1,97 @@
+#include "PressureFilter.h"
+#include <math.h>
+
+namespace {
+// Rate variance after a reset, large enough for the first samples of a ramp to set the rate
+constexpr float INITIAL_RATE_VARIANCE = 100.0f; // (bar/s)²
+} // namespace
+
+void PressureFilter::setNone() {
+    type = PressureFilterType::NONE;
+    initialized = false;
+}
+
+void PressureFilter::setLowPass(float cutoffHz, float sampleRateHz) {
+    type = PressureFilterType::LOW_PASS;
+    initialized = false;
+    // Bilinear transform with the cutoff prewarped, Q = 1/√2
+    const float k = tanf(static_cast<float>(M_PI) * cutoffHz / sampleRateHz);
+    const float norm = 1.0f / (1.0f + static_cast<float>(M_SQRT2) * k + k * k);
+    b0 = k * k * norm;
+    b1 = 2.0f * b0;
+    b2 = b0;
+    a1 = 2.0f * (k * k - 1.0f) * norm;
+    a2 = (1.0f - static_cast<float>(M_SQRT2) * k + k * k) * norm;
+    rateCutoffHz = cutoffHz;
+}
+
+void PressureFilter::setKalman(float measurementNoise, float rateNoise) {
+    type = PressureFilterType::KALMAN;
+    initialized = false;
+    measurementVariance = measurementNoise * measurementNoise;
+    rateNoiseDensity = rateNoise * rateNoise;
+}
+
+void PressureFilter::reset(float value) {
+    pressure = value;
+    rate = 0.0f;
+    x1 = x2 = y1 = y2 = value;
+    p00 = measurementVariance;
+    p01 = 0.0f;
+    p11 = INITIAL_RATE_VARIANCE;
+    initialized = true;
+}
+
+float PressureFilter::update(float value, float dt) {
+    if (!initialized) {
+        reset(value);
+        return pressure;
+    }
+    switch (type) {
+    case PressureFilterType::NONE:
+        rate = dt > 0.0f ? (value - pressure) / dt : rate;
+        pressure = value;
+        break;
+    case PressureFilterType::LOW_PASS:
+        updateLowPass(value, dt);
+        break;
+    case PressureFilterType::KALMAN:
+        updateKalman(value, dt);
+        break;
+    }
+    return pressure;
+}
+
+void PressureFilter::updateLowPass(float input, float dt) {
+    const float output = b0 * input + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+    x2 = x1;
+    x1 = input;
+    y2 = y1;
+    y1 = output;
+    if (dt > 0.0f) {
+        // Slope of the output, smoothed once more so the controllers do not differentiate the residual noise
+        const float alpha = 1.0f - expf(-2.0f * static_cast<float>(M_PI) * rateCutoffHz * dt);
+        rate += alpha * ((output - pressure) / dt - rate);
+    }
+    pressure = output;
+}
+
+void PressureFilter::updateKalman(float measurement, float dt) {
+    if (dt > 0.0f) {
+        // Predict with the rate as a random walk, white noise on its derivative
+        pressure += rate * dt;
+        const float q = rateNoiseDensity;
+        p00 += dt * (2.0f * p01 + dt * p11) + q * dt * dt * dt / 3.0f;
+        p01 += dt * p11 + q * dt * dt / 2.0f;
+        p11 += q * dt;
+    }
+    const float innovationVariance = p00 + measurementVariance;
+    const float k0 = p00 / innovationVariance;
+    const float k1 = p01 / innovationVariance;
+    const float innovation = measurement - pressure;
+    pressure += k0 * innovation;
+    rate += k1 * innovation;
+    p11 -= k1 * p01;
+    p00 -= k0 * p00;
+    p01 -= k0 * p01;
+}
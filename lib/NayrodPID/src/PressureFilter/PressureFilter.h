@@ -0,0 +1,51 @@
+#ifndef PRESSUREFILTER_H
+#define PRESSUREFILTER_H
+
+#include <cstdint>
+
+// Low latency filter for the sampled pump pressure. Runs once per ADC conversion, much faster than the controllers
+// reading it, so it can smooth the sensor noise without the lag of a slow single pole filter.
+enum class PressureFilterType : uint8_t {
+    NONE,     // last sample as is
+    LOW_PASS, // 2nd order Butterworth at a fixed sample rate
+    KALMAN,   // constant rate model, tracks a ramp without a steady lag and estimates its slope
+};
+
+class PressureFilter {
+  public:
+    void setNone();
+    void setLowPass(float cutoffHz, float sampleRateHz);
+    // measurementNoise: sensor noise per sample (bar RMS), rateNoise: how fast the ramp rate may change (bar/s per √s)
+    void setKalman(float measurementNoise, float rateNoise);
+
+    void reset(float pressure);
+    // dt is the time since the previous sample (s), the low pass filter assumes its design sample rate instead
+    float update(float pressure, float dt);
+
+    PressureFilterType getType() const { return type; }
+    float getPressure() const { return pressure; }
+    float getRate() const { return rate; } // bar/s
+    // Estimate dt seconds after the last sample, the sample age is no extra lag for the controllers
+    float predict(float dt) const { return pressure + rate * dt; }
+
+  private:
+    void updateLowPass(float input, float dt);
+    void updateKalman(float measurement, float dt);
+
+    PressureFilterType type = PressureFilterType::NONE;
+    bool initialized = false;
+    float pressure = 0.0f;
+    float rate = 0.0f;
+
+    // Butterworth biquad, direct form I
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+    float x1 = 0.0f, x2 = 0.0f, y1 = 0.0f, y2 = 0.0f;
+    float rateCutoffHz = 0.0f;
+
+    // Kalman covariance of [pressure, rate]
+    float measurementVariance = 0.0f;
+    float rateNoiseDensity = 0.0f;
+    float p00 = 0.0f, p01 = 0.0f, p11 = 0.0f;
+};
+
+#endif // PRESSUREFILTER_H
@@ -1,4 +1,5 @@
 #include "SimplePID.h"
+#include "Trace/Trace.h"
 #include <Arduino.h>
 #include <algorithm>
 #include <cmath>
@@ -41,7 +42,8 @@ bool SimplePID::update() {
 
     if (isFeedForwardActive)
         FFOut = setpointDerivative * gainFF;
-    Serial.printf("%.2f\t %.2f\t %.2f\t %.2f\n", *setpointTarget, setpointFiltered, setpointDerivative, *sensorOutput);
+    FFOut += disturbanceFeedForward;
+    trace::record(TraceEvent::PID_UPDATE, *setpointTarget, setpointFiltered, setpointDerivative, *sensorOutput);
 
     float deltaTime = 1.0f / ctrl_freq_sampling; // Time step in seconds
 
@@ -64,7 +66,6 @@ bool SimplePID::update() {
     bool isSaturated = (sumPID < ctrlOutputLimits[0] || sumPID > ctrlOutputLimits[1]); // Check if the output is saturated
     bool isSameSign =
         ((error > 0 && sumPID > 0) || (error < 0 && sumPID < 0)); // Check if the error and output have the same sign
-    // Serial.printf("OutputPID: %.2f, Integ out: %.2f\n", sumPIDsat, Iout);
     if (isSaturated && isSameSign) {
         // Serial.printf("Antiwindup clamping: %.2f\n", feedback_integralState);
         feedback_integralState -=
@@ -75,8 +76,8 @@ bool SimplePID::update() {
         sumPIDsat = constrain(sumPID, ctrlOutputLimits[0], ctrlOutputLimits[1]);
     }
 
-    // Serial.printf("Pout: %.2f, Iout: %.2f, Dout: %.2f, FFOut: %.2f, OutputPID: %.2f, SumPID: %.2f\n", Pout, Iout, Dout, FFOut,
-    // sumPIDsat, sumPID); Update previous values for next iteration
+    trace::record(TraceEvent::PID_OUTPUT, Pout, Iout, Dout, sumPIDsat);
+    // Update previous values for next iteration
     prevError = error;
     prevOutput = sumPIDsat;
 
@@ -1,6 +1,7 @@
 #ifndef SIMPLE_PID_H
 #define SIMPLE_PID_H
 #include <cmath>
+#include <cstdint>
 #include <deque>
 #include <vector>
 // #define PI 3.14159265358979323846
@@ -26,6 +27,8 @@ class SimplePID {
     void setManualOutput(float output = 0.0f);
     void computeSetpointDelay(float systemDelay);
     void activateFeedForward(bool flag);
+    // Output added to the next updates on top of the setpoint feedforward, for a disturbance known before it is measured
+    void setDisturbanceFeedForward(float output) { disturbanceFeedForward = output; };
 
     enum class Control : uint8_t { manual, automatic }; // controller mode
     void setMode(Control mode);
@@ -57,6 +60,7 @@ class SimplePID {
     float setpointFilterFreq = 0.005f;            // Setpoint filter frequency
     float setpointRatelimits[2] = {-INFINITY, 2}; // Setpoint rate limits {lower, upper}
     bool isFeedForwardActive = false;             // Flag to activate/deactivate the feedforward control
+    float disturbanceFeedForward = 0.0f;          // Output for a known disturbance, added to the setpoint feedforward
 
     // feedback controler
     float ctrlOutputLimits[2] = {-INFINITY, INFINITY}; // Control output limits {lower, upper}
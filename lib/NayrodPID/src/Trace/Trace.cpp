@@ -0,0 +1,161 @@
+#include "Trace.h"
+#include <cstring>
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <ArduinoStub.h>
+#endif
+
+namespace trace {
+
+std::atomic<uint32_t> activeEvents{0};
+
+namespace {
+
+// Bounded queue after Vyukov: a slot is free for position p while its sequence is p and holds the record of position p
+// once its sequence is p + 1. Producers claim positions with a CAS on head, the drain task is the only consumer.
+struct Slot {
+    std::atomic<uint32_t> sequence;
+    TraceRecord record;
+};
+
+Slot ring[TRACE_RING_CAPACITY];
+std::atomic<uint32_t> head{0};
+uint32_t tail = 0; // drain task only
+std::atomic<uint32_t> droppedRecords{0};
+uint32_t reportedDrops = 0; // drain task only
+std::atomic<uint8_t> level{static_cast<uint8_t>(TraceLevel::OFF)};
+std::atomic<uint32_t> categories{TRACE_ALL_CATEGORIES};
+
+static_assert((TRACE_RING_CAPACITY & (TRACE_RING_CAPACITY - 1)) == 0, "TRACE_RING_CAPACITY must be a power of two");
+
+struct RingInit {
+    RingInit() {
+        for (size_t i = 0; i < TRACE_RING_CAPACITY; i++) {
+            ring[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+} ringInit;
+
+void updateActiveEvents() {
+    const auto current = level.load(std::memory_order_relaxed);
+    const uint32_t categoryMask = categories.load(std::memory_order_relaxed);
+    uint32_t events = 0;
+    for (size_t i = 0; i < TRACE_EVENT_COUNT; i++) {
+        const bool levelEnabled = static_cast<uint8_t>(TRACE_EVENT_LEVELS[i]) <= current;
+        const bool categoryEnabled = (categoryMask >> static_cast<uint8_t>(TRACE_EVENT_CATEGORIES[i])) & 1u;
+        if (levelEnabled && categoryEnabled) {
+            events |= 1u << i;
+        }
+    }
+    activeEvents.store(events, std::memory_order_relaxed);
+}
+
+void emit(const trace_sink_t &sink, const TraceRecord &record) {
+    uint8_t frame[TRACE_FRAME_SIZE];
+    sink(frame, encodeFrame(frame, record));
+}
+
+struct DrainTask {
+    trace_sink_t sink;
+    uint32_t intervalMs;
+};
+
+[[noreturn]] void drainTask(void *arg) {
+    const auto *task = static_cast<DrainTask *>(arg);
+    TickType_t lastWake = xTaskGetTickCount();
+    while (true) {
+        drain(task->sink);
+        xTaskDelayUntil(&lastWake, pdMS_TO_TICKS(task->intervalMs));
+    }
+}
+
+} // namespace
+
+void setLevel(TraceLevel newLevel) {
+    level.store(static_cast<uint8_t>(newLevel), std::memory_order_relaxed);
+    updateActiveEvents();
+}
+
+void setCategories(uint32_t mask) {
+    categories.store(mask, std::memory_order_relaxed);
+    updateActiveEvents();
+}
+
+TraceLevel getLevel() { return static_cast<TraceLevel>(level.load(std::memory_order_relaxed)); }
+
+void write(TraceEvent event, const float *values, uint8_t count) {
+    const auto timestamp = static_cast<uint32_t>(micros());
+    uint32_t position = head.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+        slot = &ring[position & (TRACE_RING_CAPACITY - 1)];
+        const uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<int32_t>(sequence - position);
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            droppedRecords.fetch_add(1, std::memory_order_relaxed); // the drain has not freed this slot yet
+            return;
+        } else {
+            position = head.load(std::memory_order_relaxed);
+        }
+    }
+    TraceRecord &record = slot->record;
+    record.timestamp = timestamp;
+    record.event = static_cast<uint8_t>(event);
+    record.count = count;
+    record.sequence = static_cast<uint16_t>(position);
+    memcpy(record.values, values, sizeof(record.values));
+    slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+size_t drain(const trace_sink_t &sink, size_t maxRecords) {
+    const uint32_t dropped = droppedRecords.load(std::memory_order_relaxed);
+    if (dropped != reportedDrops) {
+        TraceRecord record{};
+        record.timestamp = static_cast<uint32_t>(micros());
+        record.event = static_cast<uint8_t>(TraceEvent::TRACE_DROPPED);
+        record.count = 1;
+        record.sequence = static_cast<uint16_t>(tail);
+        record.values[0] = static_cast<float>(dropped - reportedDrops);
+        reportedDrops = dropped;
+        emit(sink, record);
+    }
+
+    size_t drained = 0;
+    while (drained < maxRecords) {
+        Slot &slot = ring[tail & (TRACE_RING_CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) {
+            break; // empty, or the producer of this position is still writing
+        }
+        const TraceRecord record = slot.record;
+        slot.sequence.store(tail + TRACE_RING_CAPACITY, std::memory_order_release);
+        tail++;
+        drained++;
+        emit(sink, record);
+    }
+    return drained;
+}
+
+size_t encodeFrame(uint8_t *buffer, const TraceRecord &record) {
+    buffer[0] = TRACE_SYNC_0;
+    buffer[1] = TRACE_SYNC_1;
+    memcpy(buffer + 2, &record, sizeof(record));
+    uint8_t checksum = 0;
+    for (size_t i = 0; i < sizeof(record); i++) {
+        checksum ^= buffer[2 + i];
+    }
+    buffer[2 + sizeof(record)] = checksum;
+    return TRACE_FRAME_SIZE;
+}
+
+void startDrainTask(const trace_sink_t &sink, uint32_t intervalMs) {
+    // Lives as long as the task, which never ends
+    auto *task = new DrainTask{sink, intervalMs};
+    xTaskCreate(drainTask, "Trace::drain", configMINIMAL_STACK_SIZE * 3, task, tskIDLE_PRIORITY + 1, nullptr);
+}
+
+} // namespace trace
@@ -0,0 +1,106 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Binary trace of the controller internals. Recording an event is a mask test and a few stores into a lock-free ring,
+// nothing is formatted and nothing waits on the UART, so the control loops can be traced at full rate during a shot.
+// A low priority drain task frames the records for a sink (the serial port on the controller) and
+// scripts/decode_trace.py turns them back into text or CSV on the host, reading the event table below.
+
+enum class TraceLevel : uint8_t { OFF, ERROR, INFO, DEBUG, VERBOSE };
+
+enum class TraceCategory : uint8_t { TRACE, HEATER, PRESSURE, PUMP };
+
+// X(id, category, level, "comma separated names of up to TRACE_MAX_VALUES float fields")
+#define TRACE_EVENT_LIST(X)                                                                                                      \
+    X(TRACE_DROPPED, TRACE, ERROR, "records")                                                                                    \
+    X(PID_UPDATE, HEATER, DEBUG, "setpoint,filtered,derivative,input")                                                           \
+    X(PID_OUTPUT, HEATER, DEBUG, "p,i,d,output")                                                                                 \
+    X(HEATER_OUTPUT, HEATER, DEBUG, "on_time,temperature,setpoint,heat_load")                                                    \
+    X(AUTOTUNE_STEP, HEATER, INFO, "state,temperature,slope,output")                                                             \
+    X(PRESSURE_UPDATE, PRESSURE, VERBOSE, "pressure_setpoint,flow_setpoint,pressure,output")                                     \
+    X(PRESSURE_RESET, PRESSURE, INFO, "pressure")                                                                                \
+    X(PRESSURE_SAMPLE, PRESSURE, VERBOSE, "raw,filtered,rate,interval_ms")                                                       \
+    X(VIRTUAL_SCALE, PRESSURE, VERBOSE, "pump_flow,puck_flow,resistance,coffee")                                                 \
+    X(PUCK_STATE, PRESSURE, INFO, "state,conductance,derivative,volume")                                                         \
+    X(PUMP_TICK, PUMP, VERBOSE, "mode,pressure,power,flow")
+
+#define TRACE_EVENT_ENUM(id, category, level, fields) id,
+#define TRACE_EVENT_CATEGORY(id, category, level, fields) TraceCategory::category,
+#define TRACE_EVENT_LEVEL(id, category, level, fields) TraceLevel::level,
+
+enum class TraceEvent : uint8_t { TRACE_EVENT_LIST(TRACE_EVENT_ENUM) COUNT };
+
+constexpr size_t TRACE_EVENT_COUNT = static_cast<size_t>(TraceEvent::COUNT);
+constexpr TraceCategory TRACE_EVENT_CATEGORIES[TRACE_EVENT_COUNT] = {TRACE_EVENT_LIST(TRACE_EVENT_CATEGORY)};
+constexpr TraceLevel TRACE_EVENT_LEVELS[TRACE_EVENT_COUNT] = {TRACE_EVENT_LIST(TRACE_EVENT_LEVEL)};
+
+#undef TRACE_EVENT_ENUM
+#undef TRACE_EVENT_CATEGORY
+#undef TRACE_EVENT_LEVEL
+
+static_assert(TRACE_EVENT_COUNT <= 32, "the active event mask is a uint32_t");
+
+constexpr size_t TRACE_MAX_VALUES = 4;
+constexpr size_t TRACE_RING_CAPACITY = 256; // records, a power of two
+constexpr uint32_t TRACE_ALL_CATEGORIES = 0xFFFFFFFF;
+
+// Frame on the wire: two sync bytes, the record as laid out in memory (little endian) and the XOR of the record bytes.
+// The sync bytes are not ASCII, log lines on the same port are skipped by the decoder.
+constexpr uint8_t TRACE_SYNC_0 = 0xA5;
+constexpr uint8_t TRACE_SYNC_1 = 0x5A;
+
+struct TraceRecord {
+    uint32_t timestamp; // µs
+    uint8_t event;
+    uint8_t count;     // values used
+    uint16_t sequence; // ring position, gaps on the host are frames lost on the wire
+    float values[TRACE_MAX_VALUES];
+};
+
+static_assert(sizeof(TraceRecord) == 24, "the decoder expects 24 byte records");
+
+constexpr size_t TRACE_FRAME_SIZE = 2 + sizeof(TraceRecord) + 1;
+
+using trace_sink_t = std::function<void(const uint8_t *data, size_t length)>;
+
+namespace trace {
+
+extern std::atomic<uint32_t> activeEvents; // bit per TraceEvent, derived from the level and the category mask
+
+void setLevel(TraceLevel level);
+void setCategories(uint32_t mask); // bit per TraceCategory
+TraceLevel getLevel();
+
+inline bool enabled(TraceEvent event) {
+    return (activeEvents.load(std::memory_order_relaxed) >> static_cast<uint8_t>(event)) & 1u;
+}
+
+// Safe from any task, never blocks. Records are dropped and counted while the ring is full.
+void write(TraceEvent event, const float *values, uint8_t count);
+
+template <typename... Values> inline void record(TraceEvent event, Values... values) {
+    static_assert(sizeof...(Values) <= TRACE_MAX_VALUES, "too many trace values");
+    if (!enabled(event)) {
+        return;
+    }
+    const float data[TRACE_MAX_VALUES] = {static_cast<float>(values)...};
+    write(event, data, sizeof...(Values));
+}
+
+// Single consumer. Frames up to maxRecords records into the sink, a TRACE_DROPPED record goes first when records were
+// lost since the last drain. Returns the number of records taken from the ring.
+size_t drain(const trace_sink_t &sink, size_t maxRecords = TRACE_RING_CAPACITY);
+
+size_t encodeFrame(uint8_t *buffer, const TraceRecord &record);
+
+// Drains every intervalMs on a task of its own, the sink may block without holding up the producers
+void startDrainTask(const trace_sink_t &sink, uint32_t intervalMs = 50);
+
+} // namespace trace
+
+#endif // TRACE_H
@@ -0,0 +1,234 @@
+#ifndef BINARYPROTOCOL_H
+#define BINARYPROTOCOL_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed layout binary frames for the high rate characteristics (sensor data and output control).
+//
+// Every frame starts with a 4 byte header: type, protocol version and a little endian sequence number. Values are
+// little endian int16 fixed point with the scales below. Type bytes are below 0x20, so a frame can never be mistaken for
+// the CSV format it replaces, which always starts with a digit or a minus sign. Both sides keep accepting CSV, the
+// controller advertises support through the "bin" capability and switches its notifications to binary once the
+// display writes a binary control frame.
+
+constexpr uint8_t BINARY_PROTOCOL_VERSION = 1;
+
+constexpr uint8_t BINARY_FRAME_SENSOR = 0x01;
+constexpr uint8_t BINARY_FRAME_OUTPUT_CONTROL = 0x02;
+constexpr uint8_t BINARY_FRAME_SENSOR_BATCH = 0x03;
+
+constexpr size_t BINARY_HEADER_SIZE = 4;
+constexpr size_t BINARY_SENSOR_FRAME_SIZE = BINARY_HEADER_SIZE + 5 * sizeof(int16_t);
+// Output control frames of earlier builds end before the heat load field, they still decode with no heat load
+constexpr size_t BINARY_OUTPUT_CONTROL_BASE_SIZE = BINARY_HEADER_SIZE + 1 + 4 * sizeof(int16_t);
+constexpr size_t BINARY_OUTPUT_CONTROL_FRAME_SIZE = BINARY_OUTPUT_CONTROL_BASE_SIZE + sizeof(int16_t);
+
+// Sensor batch: header, uint32 timestamp of the first sample in ms, sample count, then per sample a uint16 offset in ms
+// from the first sample followed by the five sensor fields. Nine samples fit the 125 byte payload of a 128 byte MTU,
+// the smallest one negotiated between a display and a controller of this firmware generation.
+constexpr size_t BINARY_SENSOR_BATCH_HEADER_SIZE = BINARY_HEADER_SIZE + sizeof(uint32_t) + 1;
+constexpr size_t BINARY_SENSOR_BATCH_SAMPLE_SIZE = sizeof(uint16_t) + 5 * sizeof(int16_t);
+constexpr size_t BINARY_SENSOR_BATCH_MAX_SAMPLES = 9;
+constexpr size_t BINARY_SENSOR_BATCH_MAX_SIZE =
+    BINARY_SENSOR_BATCH_HEADER_SIZE + BINARY_SENSOR_BATCH_MAX_SAMPLES * BINARY_SENSOR_BATCH_SAMPLE_SIZE;
+
+// Fixed point scales, value = raw / scale
+constexpr float BINARY_SCALE_TEMPERATURE = 100.0f; // 0.01 °C, ±327 °C
+constexpr float BINARY_SCALE_PRESSURE = 1000.0f;   // 0.001 bar, ±32 bar
+constexpr float BINARY_SCALE_FLOW = 1000.0f;       // 0.001 ml/s, ±32 ml/s
+constexpr float BINARY_SCALE_RESISTANCE = 100.0f;  // saturates, INT16_MAX means no measurable flow
+constexpr float BINARY_SCALE_SETPOINT = 10.0f;     // 0.1 % pump power, 0.1 °C boiler setpoint
+constexpr float BINARY_SCALE_TARGET = 100.0f;      // 0.01 bar, 0.01 ml/s
+
+constexpr uint8_t BINARY_CONTROL_FLAG_VALVE = 1 << 0;
+constexpr uint8_t BINARY_CONTROL_FLAG_ADVANCED = 1 << 1;
+constexpr uint8_t BINARY_CONTROL_FLAG_PRESSURE_TARGET = 1 << 2;
+
+struct SensorFrame {
+    uint16_t sequence;
+    float temperature;
+    float pressure;
+    float puckFlow;
+    float pumpFlow;
+    float puckResistance;
+};
+
+// One reading of the controller's control tick, timestamp in ms on the sender's clock
+struct SensorSample {
+    uint32_t timestamp;
+    float temperature;
+    float pressure;
+    float puckFlow;
+    float pumpFlow;
+    float puckResistance;
+};
+
+struct OutputControlFrame {
+    uint16_t sequence;
+    bool advanced;
+    bool valve;
+    bool pressureTarget;
+    float pumpSetpoint; // simple mode only
+    float boilerSetpoint;
+    float pressure; // advanced mode only
+    float flow;     // advanced mode only
+    float heatLoad; // ml/s of cold water the display expects to draw through the boiler
+};
+
+namespace binary_protocol {
+
+inline int16_t toFixed(float value, float scale) {
+    if (std::isnan(value)) {
+        return 0;
+    }
+    float scaled = std::round(value * scale);
+    if (scaled >= static_cast<float>(INT16_MAX)) {
+        return INT16_MAX;
+    }
+    if (scaled <= static_cast<float>(INT16_MIN)) {
+        return INT16_MIN;
+    }
+    return static_cast<int16_t>(scaled);
+}
+
+inline float fromFixed(int16_t raw, float scale) { return static_cast<float>(raw) / scale; }
+
+inline void writeInt16(uint8_t *buffer, size_t offset, int16_t value) {
+    auto raw = static_cast<uint16_t>(value);
+    buffer[offset] = static_cast<uint8_t>(raw & 0xFF);
+    buffer[offset + 1] = static_cast<uint8_t>(raw >> 8);
+}
+
+inline int16_t readInt16(const uint8_t *buffer, size_t offset) {
+    return static_cast<int16_t>(static_cast<uint16_t>(buffer[offset]) | static_cast<uint16_t>(buffer[offset + 1]) << 8);
+}
+
+inline uint16_t readUint16(const uint8_t *buffer, size_t offset) { return static_cast<uint16_t>(readInt16(buffer, offset)); }
+
+inline void writeHeader(uint8_t *buffer, uint8_t type, uint16_t sequence) {
+    buffer[0] = type;
+    buffer[1] = BINARY_PROTOCOL_VERSION;
+    writeInt16(buffer, 2, static_cast<int16_t>(sequence));
+}
+
+inline bool isBinaryFrame(const uint8_t *data, size_t length) { return length >= BINARY_HEADER_SIZE && data[0] < 0x20; }
+
+inline bool checkHeader(const uint8_t *data, size_t length, uint8_t type, size_t size) {
+    return length >= size && data[0] == type && data[1] == BINARY_PROTOCOL_VERSION;
+}
+
+inline size_t encodeSensorFrame(uint8_t *buffer, const SensorFrame &frame) {
+    writeHeader(buffer, BINARY_FRAME_SENSOR, frame.sequence);
+    writeInt16(buffer, 4, toFixed(frame.temperature, BINARY_SCALE_TEMPERATURE));
+    writeInt16(buffer, 6, toFixed(frame.pressure, BINARY_SCALE_PRESSURE));
+    writeInt16(buffer, 8, toFixed(frame.puckFlow, BINARY_SCALE_FLOW));
+    writeInt16(buffer, 10, toFixed(frame.pumpFlow, BINARY_SCALE_FLOW));
+    writeInt16(buffer, 12, toFixed(frame.puckResistance, BINARY_SCALE_RESISTANCE));
+    return BINARY_SENSOR_FRAME_SIZE;
+}
+
+inline bool decodeSensorFrame(const uint8_t *data, size_t length, SensorFrame &frame) {
+    if (!checkHeader(data, length, BINARY_FRAME_SENSOR, BINARY_SENSOR_FRAME_SIZE)) {
+        return false;
+    }
+    frame.sequence = readUint16(data, 2);
+    frame.temperature = fromFixed(readInt16(data, 4), BINARY_SCALE_TEMPERATURE);
+    frame.pressure = fromFixed(readInt16(data, 6), BINARY_SCALE_PRESSURE);
+    frame.puckFlow = fromFixed(readInt16(data, 8), BINARY_SCALE_FLOW);
+    frame.pumpFlow = fromFixed(readInt16(data, 10), BINARY_SCALE_FLOW);
+    int16_t resistance = readInt16(data, 12);
+    frame.puckResistance = resistance == INT16_MAX ? INFINITY : fromFixed(resistance, BINARY_SCALE_RESISTANCE);
+    return true;
+}
+
+inline size_t encodeSensorBatchFrame(uint8_t *buffer, uint16_t sequence, const SensorSample *samples, size_t count) {
+    if (count > BINARY_SENSOR_BATCH_MAX_SAMPLES) {
+        count = BINARY_SENSOR_BATCH_MAX_SAMPLES;
+    }
+    uint32_t baseTimestamp = count > 0 ? samples[0].timestamp : 0;
+    writeHeader(buffer, BINARY_FRAME_SENSOR_BATCH, sequence);
+    writeInt16(buffer, 4, static_cast<int16_t>(baseTimestamp & 0xFFFF));
+    writeInt16(buffer, 6, static_cast<int16_t>(baseTimestamp >> 16));
+    buffer[8] = static_cast<uint8_t>(count);
+    size_t offset = BINARY_SENSOR_BATCH_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        const SensorSample &sample = samples[i];
+        uint32_t delta = sample.timestamp - baseTimestamp;
+        writeInt16(buffer, offset, static_cast<int16_t>(delta > UINT16_MAX ? UINT16_MAX : delta));
+        writeInt16(buffer, offset + 2, toFixed(sample.temperature, BINARY_SCALE_TEMPERATURE));
+        writeInt16(buffer, offset + 4, toFixed(sample.pressure, BINARY_SCALE_PRESSURE));
+        writeInt16(buffer, offset + 6, toFixed(sample.puckFlow, BINARY_SCALE_FLOW));
+        writeInt16(buffer, offset + 8, toFixed(sample.pumpFlow, BINARY_SCALE_FLOW));
+        writeInt16(buffer, offset + 10, toFixed(sample.puckResistance, BINARY_SCALE_RESISTANCE));
+        offset += BINARY_SENSOR_BATCH_SAMPLE_SIZE;
+    }
+    return offset;
+}
+
+// Returns the number of samples written to samples, 0 for a malformed frame
+inline size_t decodeSensorBatchFrame(const uint8_t *data, size_t length, uint16_t &sequence, SensorSample *samples,
+                                     size_t maxSamples) {
+    if (!checkHeader(data, length, BINARY_FRAME_SENSOR_BATCH, BINARY_SENSOR_BATCH_HEADER_SIZE)) {
+        return 0;
+    }
+    size_t count = data[8];
+    if (count > maxSamples || length < BINARY_SENSOR_BATCH_HEADER_SIZE + count * BINARY_SENSOR_BATCH_SAMPLE_SIZE) {
+        return 0;
+    }
+    sequence = readUint16(data, 2);
+    uint32_t baseTimestamp = static_cast<uint32_t>(readUint16(data, 4)) | static_cast<uint32_t>(readUint16(data, 6)) << 16;
+    size_t offset = BINARY_SENSOR_BATCH_HEADER_SIZE;
+    for (size_t i = 0; i < count; i++) {
+        SensorSample &sample = samples[i];
+        sample.timestamp = baseTimestamp + readUint16(data, offset);
+        sample.temperature = fromFixed(readInt16(data, offset + 2), BINARY_SCALE_TEMPERATURE);
+        sample.pressure = fromFixed(readInt16(data, offset + 4), BINARY_SCALE_PRESSURE);
+        sample.puckFlow = fromFixed(readInt16(data, offset + 6), BINARY_SCALE_FLOW);
+        sample.pumpFlow = fromFixed(readInt16(data, offset + 8), BINARY_SCALE_FLOW);
+        int16_t resistance = readInt16(data, offset + 10);
+        sample.puckResistance = resistance == INT16_MAX ? INFINITY : fromFixed(resistance, BINARY_SCALE_RESISTANCE);
+        offset += BINARY_SENSOR_BATCH_SAMPLE_SIZE;
+    }
+    return count;
+}
+
+inline size_t encodeOutputControlFrame(uint8_t *buffer, const OutputControlFrame &frame) {
+    writeHeader(buffer, BINARY_FRAME_OUTPUT_CONTROL, frame.sequence);
+    uint8_t flags = 0;
+    if (frame.valve)
+        flags |= BINARY_CONTROL_FLAG_VALVE;
+    if (frame.advanced)
+        flags |= BINARY_CONTROL_FLAG_ADVANCED;
+    if (frame.pressureTarget)
+        flags |= BINARY_CONTROL_FLAG_PRESSURE_TARGET;
+    buffer[4] = flags;
+    writeInt16(buffer, 5, toFixed(frame.pumpSetpoint, BINARY_SCALE_SETPOINT));
+    writeInt16(buffer, 7, toFixed(frame.boilerSetpoint, BINARY_SCALE_SETPOINT));
+    writeInt16(buffer, 9, toFixed(frame.pressure, BINARY_SCALE_TARGET));
+    writeInt16(buffer, 11, toFixed(frame.flow, BINARY_SCALE_TARGET));
+    writeInt16(buffer, 13, toFixed(frame.heatLoad, BINARY_SCALE_TARGET));
+    return BINARY_OUTPUT_CONTROL_FRAME_SIZE;
+}
+
+inline bool decodeOutputControlFrame(const uint8_t *data, size_t length, OutputControlFrame &frame) {
+    if (!checkHeader(data, length, BINARY_FRAME_OUTPUT_CONTROL, BINARY_OUTPUT_CONTROL_BASE_SIZE)) {
+        return false;
+    }
+    frame.sequence = readUint16(data, 2);
+    uint8_t flags = data[4];
+    frame.valve = (flags & BINARY_CONTROL_FLAG_VALVE) != 0;
+    frame.advanced = (flags & BINARY_CONTROL_FLAG_ADVANCED) != 0;
+    frame.pressureTarget = (flags & BINARY_CONTROL_FLAG_PRESSURE_TARGET) != 0;
+    frame.pumpSetpoint = fromFixed(readInt16(data, 5), BINARY_SCALE_SETPOINT);
+    frame.boilerSetpoint = fromFixed(readInt16(data, 7), BINARY_SCALE_SETPOINT);
+    frame.pressure = fromFixed(readInt16(data, 9), BINARY_SCALE_TARGET);
+    frame.flow = fromFixed(readInt16(data, 11), BINARY_SCALE_TARGET);
+    frame.heatLoad = length >= BINARY_OUTPUT_CONTROL_FRAME_SIZE ? fromFixed(readInt16(data, 13), BINARY_SCALE_TARGET) : 0.0f;
+    return true;
+}
+
+} // namespace binary_protocol
+
+#endif // BINARYPROTOCOL_H
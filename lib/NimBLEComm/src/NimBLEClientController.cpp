@@ -8,7 +8,7 @@ NimBLEClientController::NimBLEClientController() : client(nullptr) {}
 void NimBLEClientController::initClient() {
     NimBLEDevice::init("GPBLC");
     NimBLEDevice::setPower(ESP_PWR_LVL_P9); // Set to maximum power
-    NimBLEDevice::setMTU(128);
+    NimBLEDevice::setMTU(247); // Largest ATT MTU that fits a single data length extended packet
     client = NimBLEDevice::createClient();
     client->setClientCallbacks(this);
     if (client == nullptr)
@@ -40,10 +40,18 @@ void NimBLEClientController::registerSteamBtnCallback(const brew_callback_t &cal
 
 void NimBLEClientController::registerSensorCallback(const sensor_read_callback_t &callback) { sensorCallback = callback; }
 
-void NimBLEClientController::registerAutotuneResultCallback(const pid_control_callback_t &callback) {
+void NimBLEClientController::registerSensorBatchCallback(const sensor_batch_callback_t &callback) {
+    sensorBatchCallback = callback;
+}
+
+void NimBLEClientController::registerAutotuneResultCallback(const autotune_result_callback_t &callback) {
     autotuneResultCallback = callback;
 }
 
+void NimBLEClientController::registerAutotuneProgressCallback(const autotune_progress_callback_t &callback) {
+    autotuneProgressCallback = callback;
+}
+
 void NimBLEClientController::registerVolumetricMeasurementCallback(const float_callback_t &callback) {
     volumetricMeasurementCallback = callback;
 }
@@ -125,6 +133,12 @@ bool NimBLEClientController::connectToServer() {
                                                       std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
     }
 
+    autotuneProgressChar = pRemoteService->getCharacteristic(NimBLEUUID(AUTOTUNE_PROGRESS_UUID));
+    if (autotuneProgressChar != nullptr && autotuneProgressChar->canNotify()) {
+        autotuneProgressChar->subscribe(true, std::bind(&NimBLEClientController::notifyCallback, this, std::placeholders::_1,
+                                                        std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
+    }
+
     sensorChar = pRemoteService->getCharacteristic(NimBLEUUID(SENSOR_DATA_UUID));
     if (sensorChar != nullptr && sensorChar->canNotify()) {
         sensorChar->subscribe(true, std::bind(&NimBLEClientController::notifyCallback, this, std::placeholders::_1,
@@ -151,25 +165,56 @@ bool NimBLEClientController::connectToServer() {
 }
 
 void NimBLEClientController::sendAdvancedOutputControl(bool valve, float boilerSetpoint, bool pressureTarget, float pressure,
-                                                       float flow) {
-    if (client->isConnected() && outputControlChar != nullptr) {
-        char str[30];
-        snprintf(str, sizeof(str), "%d,%d,%.1f,%.1f,%d,%.2f,%.2f", 1, valve ? 1 : 0, 100.0f, boilerSetpoint,
-                 pressureTarget ? 1 : 0, pressure, flow);
+                                                       float flow, float heatLoad) {
+    if (client->isConnected() && outputControlChar != nullptr && binaryProtocol) {
+        writeOutputControl(OutputControlFrame{.advanced = true,
+                                              .valve = valve,
+                                              .pressureTarget = pressureTarget,
+                                              .pumpSetpoint = 100.0f,
+                                              .boilerSetpoint = boilerSetpoint,
+                                              .pressure = pressure,
+                                              .flow = flow,
+                                              .heatLoad = heatLoad});
+    } else if (client->isConnected() && outputControlChar != nullptr) {
+        char str[40];
+        snprintf(str, sizeof(str), "%d,%d,%.1f,%.1f,%d,%.2f,%.2f,%.2f", 1, valve ? 1 : 0, 100.0f, boilerSetpoint,
+                 pressureTarget ? 1 : 0, pressure, flow, heatLoad);
         _lastOutputControl = String(str);
         outputControlChar->writeValue(_lastOutputControl, false);
     }
 }
 
-void NimBLEClientController::sendOutputControl(bool valve, float pumpSetpoint, float boilerSetpoint) {
-    if (client->isConnected() && outputControlChar != nullptr) {
-        char str[30];
-        snprintf(str, sizeof(str), "%d,%d,%.1f,%.1f", 0, valve ? 1 : 0, pumpSetpoint, boilerSetpoint);
+void NimBLEClientController::sendOutputControl(bool valve, float pumpSetpoint, float boilerSetpoint, float heatLoad) {
+    if (client->isConnected() && outputControlChar != nullptr && binaryProtocol) {
+        writeOutputControl(OutputControlFrame{.advanced = false,
+                                              .valve = valve,
+                                              .pressureTarget = false,
+                                              .pumpSetpoint = pumpSetpoint,
+                                              .boilerSetpoint = boilerSetpoint,
+                                              .pressure = 0.0f,
+                                              .flow = 0.0f,
+                                              .heatLoad = heatLoad});
+    } else if (client->isConnected() && outputControlChar != nullptr) {
+        char str[40];
+        snprintf(str, sizeof(str), "%d,%d,%.1f,%.1f,%.2f", 0, valve ? 1 : 0, pumpSetpoint, boilerSetpoint, heatLoad);
         _lastOutputControl = String(str);
         outputControlChar->writeValue(_lastOutputControl, false);
     }
 }
 
+void NimBLEClientController::writeOutputControl(const OutputControlFrame &frame) {
+    uint8_t data[BINARY_OUTPUT_CONTROL_FRAME_SIZE];
+    OutputControlFrame sequenced = frame;
+    sequenced.sequence = outputControlSequence++;
+    size_t length = binary_protocol::encodeOutputControlFrame(data, sequenced);
+    outputControlChar->writeValue(data, length, false);
+}
+
+void NimBLEClientController::setBinaryProtocol(bool enabled) {
+    ESP_LOGI(LOG_TAG, "Using %s protocol for sensor data and output control", enabled ? "binary" : "CSV");
+    binaryProtocol = enabled;
+}
+
 void NimBLEClientController::sendPidSettings(const String &pid) {
     if (pidControlChar != nullptr && client->isConnected()) {
         pidControlChar->writeValue(pid);
@@ -240,7 +285,7 @@ void NimBLEClientController::onDisconnect(NimBLEClient *pServer) {
 }
 
 // Notification callback
-void NimBLEClientController::notifyCallback(NimBLERemoteCharacteristic *pRemoteCharacteristic, uint8_t *pData, size_t,
+void NimBLEClientController::notifyCallback(NimBLERemoteCharacteristic *pRemoteCharacteristic, uint8_t *pData, size_t length,
                                             bool) const {
     if (pRemoteCharacteristic->getUUID().equals(NimBLEUUID(ERROR_CHAR_UUID))) {
         int errorCode = atoi((char *)pData);
@@ -263,7 +308,9 @@ void NimBLEClientController::notifyCallback(NimBLERemoteCharacteristic *pRemoteC
             steamBtnCallback(steamButtonStatus);
         }
     }
-    if (pRemoteCharacteristic->getUUID().equals(NimBLEUUID(SENSOR_DATA_UUID))) {
+    if (pRemoteCharacteristic->getUUID().equals(NimBLEUUID(SENSOR_DATA_UUID)) && binary_protocol::isBinaryFrame(pData, length)) {
+        onBinarySensorData(pData, length);
+    } else if (pRemoteCharacteristic->getUUID().equals(NimBLEUUID(SENSOR_DATA_UUID))) {
         String data = String((char *)pData);
         float temperature = get_token(data, 0, ',').toFloat();
         float pressure = get_token(data, 1, ',').toFloat();
@@ -285,7 +332,19 @@ void NimBLEClientController::notifyCallback(NimBLERemoteCharacteristic *pRemoteC
             float Kp = get_token(settings, 0, ',').toFloat();
             float Ki = get_token(settings, 1, ',').toFloat();
             float Kd = get_token(settings, 2, ',').toFloat();
-            autotuneResultCallback(Kp, Ki, Kd);
+            // Controllers without the flag only report successful runs
+            String flag = get_token(settings, 3, ',');
+            bool success = flag.length() == 0 || flag.toInt() != 0;
+            autotuneResultCallback(success, Kp, Ki, Kd);
+        }
+    }
+    if (pRemoteCharacteristic->getUUID().equals(NimBLEUUID(AUTOTUNE_PROGRESS_UUID))) {
+        String progress = String((char *)pData);
+        ESP_LOGV(LOG_TAG, "autotune progress: %s", progress.c_str());
+        if (autotuneProgressCallback != nullptr) {
+            int state = get_token(progress, 0, ',').toInt();
+            float temperature = get_token(progress, 1, ',').toFloat();
+            autotuneProgressCallback(state, temperature);
         }
     }
     if (pRemoteCharacteristic->getUUID().equals(NimBLEUUID(VOLUMETRIC_MEASUREMENT_UUID))) {
@@ -303,3 +362,52 @@ void NimBLEClientController::notifyCallback(NimBLERemoteCharacteristic *pRemoteC
         }
     }
 }
+
+void NimBLEClientController::onBinarySensorData(const uint8_t *data, size_t length) const {
+    if (data[0] == BINARY_FRAME_SENSOR_BATCH) {
+        onBinarySensorBatch(data, length);
+        return;
+    }
+    SensorFrame frame{};
+    if (!binary_protocol::decodeSensorFrame(data, length, frame)) {
+        ESP_LOGW(LOG_TAG, "Dropping unsupported sensor frame: type=%d, version=%d, length=%d", data[0], data[1],
+                 static_cast<int>(length));
+        return;
+    }
+    if (frame.sequence != nextSensorSequence) {
+        ESP_LOGD(LOG_TAG, "Missed %d sensor frames", static_cast<uint16_t>(frame.sequence - nextSensorSequence));
+    }
+    nextSensorSequence = frame.sequence + 1;
+    ESP_LOGV(LOG_TAG,
+             "Received binary sensor data #%d: temperature=%.2f, pressure=%.3f, puck_flow=%.3f, pump_flow=%.3f, "
+             "puck_resistance=%.2f",
+             frame.sequence, frame.temperature, frame.pressure, frame.puckFlow, frame.pumpFlow, frame.puckResistance);
+    if (sensorCallback != nullptr) {
+        sensorCallback(frame.temperature, frame.pressure, frame.puckFlow, frame.pumpFlow, frame.puckResistance);
+    }
+}
+
+void NimBLEClientController::onBinarySensorBatch(const uint8_t *data, size_t length) const {
+    SensorSample samples[BINARY_SENSOR_BATCH_MAX_SAMPLES];
+    uint16_t sequence = 0;
+    size_t count = binary_protocol::decodeSensorBatchFrame(data, length, sequence, samples, BINARY_SENSOR_BATCH_MAX_SAMPLES);
+    if (count == 0) {
+        ESP_LOGW(LOG_TAG, "Dropping malformed sensor batch: version=%d, length=%d", data[1], static_cast<int>(length));
+        return;
+    }
+    if (sequence != nextSensorSequence) {
+        ESP_LOGD(LOG_TAG, "Missed %d sensor frames", static_cast<uint16_t>(sequence - nextSensorSequence));
+    }
+    nextSensorSequence = sequence + 1;
+    ESP_LOGV(LOG_TAG, "Received sensor batch #%d with %d samples over %d ms", sequence, static_cast<int>(count),
+             static_cast<int>(samples[count - 1].timestamp - samples[0].timestamp));
+    if (sensorBatchCallback != nullptr) {
+        sensorBatchCallback(samples, count);
+        return;
+    }
+    // Without a batch consumer only the latest state is of interest
+    const SensorSample &latest = samples[count - 1];
+    if (sensorCallback != nullptr) {
+        sensorCallback(latest.temperature, latest.pressure, latest.puckFlow, latest.pumpFlow, latest.puckResistance);
+    }
+}
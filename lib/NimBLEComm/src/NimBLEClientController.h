@@ -10,9 +10,11 @@ class NimBLEClientController : public NimBLEAdvertisedDeviceCallbacks, NimBLECli
     void initClient();
     bool connectToServer();
 
-    void sendAdvancedOutputControl(bool valve, float boilerSetpoint, bool pressureTarget, float pressure, float flow);
+    // heatLoad is the water flow (ml/s) expected through the boiler, the controller heats ahead of it
+    void sendAdvancedOutputControl(bool valve, float boilerSetpoint, bool pressureTarget, float pressure, float flow,
+                                   float heatLoad = 0.0f);
 
-    void sendOutputControl(bool valve, float pumpSetpoint, float boilerSetpoint);
+    void sendOutputControl(bool valve, float pumpSetpoint, float boilerSetpoint, float heatLoad = 0.0f);
     void sendAltControl(bool pinState);
     void sendPing();
     void sendAutotune(int testTime, int samples);
@@ -20,6 +22,7 @@ class NimBLEClientController : public NimBLEAdvertisedDeviceCallbacks, NimBLECli
     void sendPumpModelCoeffs(const String &pumpModelCoeffs);
     void setPressureScale(float scale);
     void sendLedControl(uint8_t channel, uint8_t brightness);
+    void setBinaryProtocol(bool enabled);
     bool isReadyForConnection() const;
     bool isConnected();
     void scan();
@@ -28,7 +31,9 @@ class NimBLEClientController : public NimBLEAdvertisedDeviceCallbacks, NimBLECli
     void registerBrewBtnCallback(const brew_callback_t &callback);
     void registerSteamBtnCallback(const steam_callback_t &callback);
     void registerSensorCallback(const sensor_read_callback_t &callback);
-    void registerAutotuneResultCallback(const pid_control_callback_t &callback);
+    void registerSensorBatchCallback(const sensor_batch_callback_t &callback);
+    void registerAutotuneResultCallback(const autotune_result_callback_t &callback);
+    void registerAutotuneProgressCallback(const autotune_progress_callback_t &callback);
     void registerVolumetricMeasurementCallback(const float_callback_t &callback);
     void registerTofMeasurementCallback(const int_callback_t &callback);
     std::string readInfo() const;
@@ -48,6 +53,7 @@ class NimBLEClientController : public NimBLEAdvertisedDeviceCallbacks, NimBLECli
     NimBLERemoteCharacteristic *errorChar = nullptr;
     NimBLERemoteCharacteristic *autotuneChar = nullptr;
     NimBLERemoteCharacteristic *autotuneResultChar = nullptr;
+    NimBLERemoteCharacteristic *autotuneProgressChar = nullptr;
     NimBLERemoteCharacteristic *brewBtnChar = nullptr;
     NimBLERemoteCharacteristic *steamBtnChar = nullptr;
     NimBLERemoteCharacteristic *infoChar = nullptr;
@@ -64,12 +70,17 @@ class NimBLEClientController : public NimBLEAdvertisedDeviceCallbacks, NimBLECli
     remote_err_callback_t remoteErrorCallback = nullptr;
     brew_callback_t brewBtnCallback = nullptr;
     steam_callback_t steamBtnCallback = nullptr;
-    pid_control_callback_t autotuneResultCallback = nullptr;
+    autotune_result_callback_t autotuneResultCallback = nullptr;
+    autotune_progress_callback_t autotuneProgressCallback = nullptr;
     sensor_read_callback_t sensorCallback = nullptr;
+    sensor_batch_callback_t sensorBatchCallback = nullptr;
     float_callback_t volumetricMeasurementCallback = nullptr;
     int_callback_t tofMeasurementCallback = nullptr;
 
     String _lastOutputControl = "";
+    bool binaryProtocol = false;
+    uint16_t outputControlSequence = 0;
+    mutable uint16_t nextSensorSequence = 0;
 
     // BLEAdvertisedDeviceCallbacks override
     void onResult(NimBLEAdvertisedDevice *advertisedDevice) override;
@@ -79,6 +90,9 @@ class NimBLEClientController : public NimBLEAdvertisedDeviceCallbacks, NimBLECli
 
     // Notification callback
     void notifyCallback(NimBLERemoteCharacteristic *pRemoteCharacteristic, uint8_t *pData, size_t length, bool isNotify) const;
+    void onBinarySensorData(const uint8_t *data, size_t length) const;
+    void onBinarySensorBatch(const uint8_t *data, size_t length) const;
+    void writeOutputControl(const OutputControlFrame &frame);
 
     const char *LOG_TAG = "NimBLEClientController";
 };
@@ -1,6 +1,7 @@
 #ifndef NIMBLECOMM_H
 #define NIMBLECOMM_H
 
+#include "BinaryProtocol.h"
 #include <Arduino.h>
 #include <NimBLEDevice.h>
 
@@ -11,6 +12,7 @@
 #define ERROR_CHAR_UUID "d6676ec7-820c-41de-820d-95620749003b"
 #define AUTOTUNE_CHAR_UUID "d54df381-69b6-4531-b1cc-dde7766bbaf4"
 #define AUTOTUNE_RESULT_UUID "7f61607a-2817-4354-9b94-d49c057fc879"
+#define AUTOTUNE_PROGRESS_UUID "977471f0-967c-443b-bff9-b6cff63403f4"
 #define PID_CONTROL_CHAR_UUID "d448c469-3e1d-4105-b5b8-75bf7d492fad"
 #define PUMP_MODEL_COEFFS_CHAR_UUID "e448c469-3e1d-4105-b5b8-75bf7d492fae"
 #define BREW_BTN_UUID "a29eb137-b33e-45a4-b1fc-15eb04e8ab39"
@@ -37,6 +39,10 @@ using pump_model_coeffs_callback_t = std::function<void(float a, float b, float
 using ping_callback_t = std::function<void()>;
 using remote_err_callback_t = std::function<void(int errorCode)>;
 using autotune_callback_t = std::function<void(int testTime, int samples)>;
+// A failed run carries the gains in use before the run
+using autotune_result_callback_t = std::function<void(bool success, float Kp, float Ki, float Kd)>;
+// state is the controller's AutotuneState
+using autotune_progress_callback_t = std::function<void(int state, float temperature)>;
 using brew_callback_t = std::function<void(bool brewButtonStatus)>;
 using steam_callback_t = std::function<void(bool steamButtonStatus)>;
 using void_callback_t = std::function<void()>;
@@ -44,11 +50,12 @@ using void_callback_t = std::function<void()>;
 // New combined callbacks
 using float_callback_t = std::function<void(float val)>;
 using int_callback_t = std::function<void(int val)>;
-using simple_output_callback_t = std::function<void(bool valve, float pumpSetpoint, float boilerSetpoint)>;
-using advanced_output_callback_t =
-    std::function<void(bool valve, float boilerSetpoint, bool pressureTarget, float pumpPressure, float pumpFlow)>;
+using simple_output_callback_t = std::function<void(bool valve, float pumpSetpoint, float boilerSetpoint, float heatLoad)>;
+using advanced_output_callback_t = std::function<void(bool valve, float boilerSetpoint, bool pressureTarget, float pumpPressure,
+                                                      float pumpFlow, float heatLoad)>;
 using sensor_read_callback_t =
     std::function<void(float temperature, float pressure, float puckFlow, float pumpFlow, float puckResistance)>;
+using sensor_batch_callback_t = std::function<void(const SensorSample *samples, size_t count)>;
 using led_control_callback_t = std::function<void(uint8_t channel, uint8_t brightness)>;
 
 struct SystemCapabilities {
@@ -56,6 +63,7 @@ struct SystemCapabilities {
     bool pressure;
     bool ledControl;
     bool tof;
+    bool binaryProtocol;
 };
 
 struct SystemInfo {
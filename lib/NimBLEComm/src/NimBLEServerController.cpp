@@ -6,7 +6,7 @@ void NimBLEServerController::initServer(const String infoString) {
     this->infoString = infoString;
     NimBLEDevice::init("GPBLS");
     NimBLEDevice::setPower(ESP_PWR_LVL_P9); // Set to maximum power
-    NimBLEDevice::setMTU(128);
+    NimBLEDevice::setMTU(247); // Largest ATT MTU that fits a single data length extended packet
 
     // Create BLE Server
     NimBLEServer *pServer = NimBLEDevice::createServer();
@@ -42,6 +42,7 @@ void NimBLEServerController::initServer(const String infoString) {
     autotuneChar = pService->createCharacteristic(AUTOTUNE_CHAR_UUID, NIMBLE_PROPERTY::WRITE);
     autotuneChar->setCallbacks(this); // Use this class as the callback handler
     autotuneResultChar = pService->createCharacteristic(AUTOTUNE_RESULT_UUID, NIMBLE_PROPERTY::NOTIFY);
+    autotuneProgressChar = pService->createCharacteristic(AUTOTUNE_PROGRESS_UUID, NIMBLE_PROPERTY::NOTIFY);
 
     // Brew button Characteristic (Server notifies client of brew button)
     brewBtnChar = pService->createCharacteristic(BREW_BTN_UUID, NIMBLE_PROPERTY::NOTIFY);
@@ -81,7 +82,13 @@ void NimBLEServerController::initServer(const String infoString) {
 
 void NimBLEServerController::sendSensorData(float temperature, float pressure, float puckFlow, float pumpFlow,
                                             float puckResistance) {
-    if (deviceConnected && sensorChar != nullptr) {
+    if (deviceConnected && sensorChar != nullptr && binaryProtocol) {
+        uint8_t frame[BINARY_SENSOR_FRAME_SIZE];
+        size_t length = binary_protocol::encodeSensorFrame(
+            frame, SensorFrame{sensorSequence++, temperature, pressure, puckFlow, pumpFlow, puckResistance});
+        sensorChar->setValue(frame, length);
+        sensorChar->notify();
+    } else if (deviceConnected && sensorChar != nullptr) {
         char str[30];
         snprintf(str, sizeof(str), "%.3f,%.3f,%.3f,%.3f,%.3f", temperature, pressure, puckFlow, pumpFlow, puckResistance);
         sensorChar->setValue(str);
@@ -89,6 +96,16 @@ void NimBLEServerController::sendSensorData(float temperature, float pressure, f
     }
 }
 
+void NimBLEServerController::sendSensorBatch(const SensorSample *samples, size_t count) {
+    if (!isBinaryProtocol() || sensorChar == nullptr || count == 0) {
+        return;
+    }
+    uint8_t frame[BINARY_SENSOR_BATCH_MAX_SIZE];
+    size_t length = binary_protocol::encodeSensorBatchFrame(frame, sensorSequence++, samples, count);
+    sensorChar->setValue(frame, length);
+    sensorChar->notify();
+}
+
 void NimBLEServerController::sendError(int errorCode) {
     if (deviceConnected) {
         // Send temperature notification to the client
@@ -119,15 +136,25 @@ void NimBLEServerController::sendSteamBtnState(bool steamButtonStatus) {
     }
 }
 
-void NimBLEServerController::sendAutotuneResult(float Kp, float Ki, float Kd) {
+void NimBLEServerController::sendAutotuneResult(bool success, float Kp, float Ki, float Kd) {
     if (deviceConnected) {
-        char pidStr[30];
-        snprintf(pidStr, sizeof(pidStr), "%.3f,%.3f,%.3f", Kp, Ki, Kd);
+        // The success flag goes last, displays reading only the gains keep working
+        char pidStr[40];
+        snprintf(pidStr, sizeof(pidStr), "%.3f,%.3f,%.3f,%d", Kp, Ki, Kd, success ? 1 : 0);
         autotuneResultChar->setValue(pidStr);
         autotuneResultChar->notify();
     }
 }
 
+void NimBLEServerController::sendAutotuneProgress(int state, float temperature) {
+    if (deviceConnected) {
+        char progressStr[16];
+        snprintf(progressStr, sizeof(progressStr), "%d,%.2f", state, temperature);
+        autotuneProgressChar->setValue(progressStr);
+        autotuneProgressChar->notify();
+    }
+}
+
 void NimBLEServerController::sendVolumetricMeasurement(float value) {
     if (deviceConnected) {
         char data[8];
@@ -184,6 +211,7 @@ void NimBLEServerController::onConnect(NimBLEServer *pServer) {
 void NimBLEServerController::onDisconnect(NimBLEServer *pServer) {
     ESP_LOGI(LOG_TAG, "Client disconnected.");
     deviceConnected = false;
+    binaryProtocol = false; // The next client negotiates again
     pServer->startAdvertising(); // Restart advertising so clients can reconnect
 }
 
@@ -191,25 +219,33 @@ void NimBLEServerController::onWrite(NimBLECharacteristic *pCharacteristic) {
     ESP_LOGV(LOG_TAG, "Write received!");
 
     if (pCharacteristic->getUUID().equals(NimBLEUUID(OUTPUT_CONTROL_UUID))) {
-        auto control = String(pCharacteristic->getValue().c_str());
+        NimBLEAttValue value = pCharacteristic->getValue();
+        if (binary_protocol::isBinaryFrame(value.data(), value.length())) {
+            onBinaryOutputControl(value.data(), value.length());
+            return;
+        }
+        binaryProtocol = false;
+        auto control = String(value.c_str());
         uint8_t type = get_token(control, 0, ',').toInt();
         uint8_t valve = get_token(control, 1, ',').toInt();
         float boilerSetpoint = get_token(control, 3, ',').toFloat();
         if (type == 0) {
             float pumpSetpoint = get_token(control, 2, ',').toFloat();
-            ESP_LOGV(LOG_TAG, "Received output control: type=%d, valve=%d, pump=%.1f, boiler=%.1f", type, valve, pumpSetpoint,
-                     boilerSetpoint);
+            float heatLoad = get_token(control, 4, ',').toFloat();
+            ESP_LOGV(LOG_TAG, "Received output control: type=%d, valve=%d, pump=%.1f, boiler=%.1f, heat_load=%.2f", type, valve,
+                     pumpSetpoint, boilerSetpoint, heatLoad);
             if (outputControlCallback != nullptr) {
-                outputControlCallback(valve == 1, pumpSetpoint, boilerSetpoint);
+                outputControlCallback(valve == 1, pumpSetpoint, boilerSetpoint, heatLoad);
             }
         } else if (type == 1) {
             bool pressureTarget = get_token(control, 4, ',').toInt() == 1;
             float pumpPressure = get_token(control, 5, ',').toFloat();
             float pumpFlow = get_token(control, 6, ',').toFloat();
+            float heatLoad = get_token(control, 7, ',').toFloat();
             ESP_LOGV(LOG_TAG, "Received advanced output control: type=%d, valve=%d, pressure_target=%d, pressure=%.1f, flow=%.1f",
                      type, valve, pressureTarget, pumpPressure, pumpFlow);
             if (advancedControlCallback != nullptr) {
-                advancedControlCallback(valve == 1, boilerSetpoint, pressureTarget, pumpPressure, pumpFlow);
+                advancedControlCallback(valve == 1, boilerSetpoint, pressureTarget, pumpPressure, pumpFlow, heatLoad);
             }
         }
     } else if (pCharacteristic->getUUID().equals(NimBLEUUID(ALT_CONTROL_CHAR_UUID))) {
@@ -273,3 +309,28 @@ void NimBLEServerController::onWrite(NimBLECharacteristic *pCharacteristic) {
         }
     }
 }
+
+void NimBLEServerController::onBinaryOutputControl(const uint8_t *data, size_t length) {
+    OutputControlFrame frame{};
+    if (!binary_protocol::decodeOutputControlFrame(data, length, frame)) {
+        ESP_LOGW(LOG_TAG, "Dropping unsupported output control frame: type=%d, version=%d, length=%d", data[0], data[1],
+                 static_cast<int>(length));
+        return;
+    }
+    // A client writing binary frames can decode them too
+    binaryProtocol = true;
+    if (!frame.advanced) {
+        ESP_LOGV(LOG_TAG, "Received binary output control #%d: valve=%d, pump=%.1f, boiler=%.1f", frame.sequence, frame.valve,
+                 frame.pumpSetpoint, frame.boilerSetpoint);
+        if (outputControlCallback != nullptr) {
+            outputControlCallback(frame.valve, frame.pumpSetpoint, frame.boilerSetpoint, frame.heatLoad);
+        }
+    } else {
+        ESP_LOGV(LOG_TAG, "Received binary advanced output control #%d: valve=%d, pressure_target=%d, pressure=%.2f, flow=%.2f",
+                 frame.sequence, frame.valve, frame.pressureTarget, frame.pressure, frame.flow);
+        if (advancedControlCallback != nullptr) {
+            advancedControlCallback(frame.valve, frame.boilerSetpoint, frame.pressureTarget, frame.pressure, frame.flow,
+                                    frame.heatLoad);
+        }
+    }
+}
@@ -10,10 +10,13 @@ class NimBLEServerController : public NimBLEServerCallbacks, public NimBLECharac
     NimBLEServerController();
     void initServer(String infoString);
     void sendSensorData(float temperature, float pressure, float puckFlow, float pumpFlow, float puckResistance);
+    void sendSensorBatch(const SensorSample *samples, size_t count);
+    bool isBinaryProtocol() const { return deviceConnected && binaryProtocol; }
     void sendError(int errorCode);
     void sendBrewBtnState(bool brewButtonStatus);
     void sendSteamBtnState(bool steamButtonStatus);
-    void sendAutotuneResult(float Kp, float Ki, float Kd);
+    void sendAutotuneResult(bool success, float Kp, float Ki, float Kd);
+    void sendAutotuneProgress(int state, float temperature);
     void sendVolumetricMeasurement(float value);
     void sendTofMeasurement(int value);
     void registerOutputControlCallback(const simple_output_callback_t &callback);
@@ -30,6 +33,8 @@ class NimBLEServerController : public NimBLEServerCallbacks, public NimBLECharac
 
   private:
     bool deviceConnected = false;
+    bool binaryProtocol = false;
+    uint16_t sensorSequence = 0;
     String infoString = "";
     NimBLECharacteristic *outputControlChar = nullptr;
     NimBLECharacteristic *pressureScaleChar = nullptr;
@@ -40,6 +45,7 @@ class NimBLEServerController : public NimBLEServerCallbacks, public NimBLECharac
     NimBLECharacteristic *errorChar = nullptr;
     NimBLECharacteristic *autotuneChar = nullptr;
     NimBLECharacteristic *autotuneResultChar = nullptr;
+    NimBLECharacteristic *autotuneProgressChar = nullptr;
     NimBLECharacteristic *brewBtnChar = nullptr;
     NimBLECharacteristic *steamBtnChar = nullptr;
     NimBLECharacteristic *infoChar = nullptr;
@@ -67,6 +73,8 @@ class NimBLEServerController : public NimBLEServerCallbacks, public NimBLECharac
     // BLECharacteristicCallbacks overrides
     void onWrite(NimBLECharacteristic *pCharacteristic) override;
 
+    void onBinaryOutputControl(const uint8_t *data, size_t length);
+
     BLE_OTA_DFU ota_dfu_ble;
 
     const char *LOG_TAG = "NimBLEClientController";
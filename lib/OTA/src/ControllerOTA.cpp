@@ -1,10 +1,26 @@
 #include "ControllerOTA.h"
 #include <HTTPClient.h>
 #include <SPIFFS.h>
+#include <esp_rom_crc.h>
+#include <memory>
+
+namespace {
+void writeUint32(uint8_t *out, uint32_t value) {
+    out[0] = value & 0xFF;
+    out[1] = (value >> 8) & 0xFF;
+    out[2] = (value >> 16) & 0xFF;
+    out[3] = (value >> 24) & 0xFF;
+}
+
+uint32_t readUint32(const uint8_t *in) { return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24); }
+} // namespace
 
 void ControllerOTA::init(NimBLEClient *client, const ctr_progress_callback_t &progress_callback) {
     this->client = client;
     progressCallback = progress_callback;
+    if (streamReplies == nullptr) {
+        streamReplies = xQueueCreate(4, sizeof(OtaStreamReply));
+    }
     NimBLERemoteService *pRemoteService = client->getService(NimBLEUUID(SERVICE_OTA_BLE_UUID));
     rxChar = pRemoteService->getCharacteristic(NimBLEUUID(CHARACTERISTIC_OTA_BL_UUID_RX));
     txChar = pRemoteService->getCharacteristic(NimBLEUUID(CHARACTERISTIC_OTA_BL_UUID_TX));
@@ -14,21 +30,191 @@ void ControllerOTA::init(NimBLEClient *client, const ctr_progress_callback_t &pr
     }
 }
 
-void ControllerOTA::update(WiFiClientSecure &wifi_client, const String &release_url) {
+bool ControllerOTA::update(WiFiClientSecure &wifi_client, const String &release_url) {
+    if (probeStreamSupport() >= OTA_STREAM_VERSION) {
+        ESP_LOGI("ControllerOTA", "Controller supports streaming updates");
+        resumable = false;
+        for (uint8_t attempt = 0; attempt < OTA_STREAM_ATTEMPTS && client->isConnected(); attempt++) {
+            if (streamUpdate(wifi_client, release_url, resumable)) {
+                ESP_LOGI("ControllerOTA", "Controller update finished");
+                return true;
+            }
+            ESP_LOGW("ControllerOTA", "Streaming attempt %d of %d failed", attempt + 1, OTA_STREAM_ATTEMPTS);
+        }
+        return false;
+    }
+
     if (SPIFFS.exists("/board-firmware.bin")) {
         ESP_LOGI("ControllerOTA", "Removing previous update file");
         SPIFFS.remove("/board-firmware.bin");
     }
     if (!downloadFile(wifi_client, release_url)) {
         ESP_LOGE("ControllerOTA", "Download of firmware file failed");
+        return false;
     }
     File file = SPIFFS.open("/board-firmware.bin", FILE_READ);
     runUpdate(file, file.size());
     file.close();
+    return true;
 }
 
-bool ControllerOTA::downloadFile(WiFiClientSecure &wifi_client, const String &release_url) {
+uint8_t ControllerOTA::probeStreamSupport() {
+    // Controllers answer 0xFD with 0xAA and their transfer mode, streaming capable ones append OTA_STREAM_VERSION
+    lastSignal = 0x00;
+    streamVersion = 0;
+    uint8_t probe[] = {0xFD};
+    sendData(probe, 1);
+    unsigned long start = millis();
+    while (lastSignal != 0xAA && millis() - start < OTA_STREAM_REPLY_TIMEOUT_MS && client->isConnected()) {
+        delay(10);
+    }
+    lastSignal = 0x00;
+    return streamVersion;
+}
+
+bool ControllerOTA::streamUpdate(WiFiClientSecure &wifi_client, const String &release_url, bool resume) {
     HTTPClient http;
+    if (!openDownload(http, wifi_client, release_url)) {
+        return false;
+    }
+    const uint32_t size = http.getSize();
+    WiFiClient *tcp = http.getStreamPtr();
+
+    uint8_t begin[6] = {OTA_STREAM_BEGIN};
+    writeUint32(begin + 1, size);
+    begin[5] = resume ? OTA_STREAM_FLAG_RESUME : 0;
+    OtaStreamReply reply;
+    if (!sendStreamCommand(begin, sizeof(begin), OTA_STREAM_BEGIN, reply, OTA_STREAM_REPLY_TIMEOUT_MS) ||
+        reply.status != OTA_STREAM_STATUS_OK || reply.window == 0 || reply.offset > size) {
+        ESP_LOGE("ControllerOTA", "Controller did not accept a %u byte update", size);
+        http.end();
+        return false;
+    }
+    const uint16_t windowSize = std::min(OTA_STREAM_WINDOW_SIZE, reply.window);
+    std::unique_ptr<uint8_t[]> window(new (std::nothrow) uint8_t[windowSize]);
+    if (!window) {
+        ESP_LOGE("ControllerOTA", "Not enough memory for a %u byte window", windowSize);
+        http.end();
+        return false;
+    }
+
+    // Skip what the controller flashed in an earlier attempt, as long as it is a prefix of this image
+    uint32_t offset = 0;
+    uint32_t crc = 0;
+    while (offset < reply.offset) {
+        uint16_t length = std::min<uint32_t>(windowSize, reply.offset - offset);
+        if (!fillBuffer(*tcp, window.get(), length)) {
+            http.end();
+            return false;
+        }
+        crc = esp_rom_crc32_le(crc, window.get(), length);
+        offset += length;
+    }
+    if (crc != reply.crc) {
+        ESP_LOGW("ControllerOTA", "Controller holds a different partial image, starting over");
+        resumable = false;
+        http.end();
+        return false;
+    }
+    if (offset > 0) {
+        ESP_LOGI("ControllerOTA", "Resuming controller update at %u / %u bytes", offset, size);
+    }
+    ESP_LOGI("ControllerOTA", "Streaming %u bytes in %u byte windows, MTU %u", size, windowSize, client->getMTU());
+    notifyStreamProgress(offset, size);
+
+    while (offset < size) {
+        uint16_t length = std::min<uint32_t>(windowSize, size - offset);
+        if (!fillBuffer(*tcp, window.get(), length)) {
+            http.end();
+            return false;
+        }
+        uint32_t windowCrc = esp_rom_crc32_le(crc, window.get(), length);
+        if (!streamWindow(window.get(), offset, length, windowCrc)) {
+            http.end();
+            return false;
+        }
+        offset += length;
+        crc = windowCrc;
+        resumable = true;
+        notifyStreamProgress(offset, size);
+    }
+    http.end();
+
+    uint8_t finish[5] = {OTA_STREAM_FINISH};
+    writeUint32(finish + 1, crc);
+    if (!sendStreamCommand(finish, sizeof(finish), OTA_STREAM_FINISH, reply, OTA_STREAM_INSTALL_TIMEOUT_MS) ||
+        reply.status != OTA_STREAM_STATUS_OK) {
+        ESP_LOGE("ControllerOTA", "Controller rejected the update image");
+        resumable = false;
+        return false;
+    }
+    return true;
+}
+
+bool ControllerOTA::streamWindow(const uint8_t *window, uint32_t offset, uint16_t length, uint32_t crc) {
+    const uint16_t packetSize = std::min<uint16_t>(client->getMTU() - 3, OTA_STREAM_MAX_PACKET_SIZE);
+    const uint16_t payloadSize = packetSize - OTA_STREAM_DATA_HEADER_SIZE;
+    uint8_t packet[OTA_STREAM_MAX_PACKET_SIZE];
+    packet[0] = OTA_STREAM_DATA;
+
+    for (uint8_t retry = 0; retry < OTA_STREAM_WINDOW_RETRIES; retry++) {
+        for (uint16_t sent = 0; sent < length;) {
+            uint16_t chunk = std::min<uint16_t>(payloadSize, length - sent);
+            writeUint32(packet + 1, offset + sent);
+            memcpy(packet + OTA_STREAM_DATA_HEADER_SIZE, window + sent, chunk);
+            // Without response the whole window is in flight, NimBLE refuses writes while its buffers are full
+            unsigned long start = millis();
+            while (!rxChar->writeValue(packet, chunk + OTA_STREAM_DATA_HEADER_SIZE, false)) {
+                if (!client->isConnected() || millis() - start > OTA_STREAM_REPLY_TIMEOUT_MS) {
+                    ESP_LOGE("ControllerOTA", "Failed to send data at offset %u", offset + sent);
+                    return false;
+                }
+                delay(2);
+            }
+            sent += chunk;
+        }
+
+        uint8_t commit[9] = {OTA_STREAM_COMMIT};
+        writeUint32(commit + 1, offset + length);
+        writeUint32(commit + 5, crc);
+        OtaStreamReply reply;
+        if (!sendStreamCommand(commit, sizeof(commit), OTA_STREAM_COMMIT, reply, OTA_STREAM_REPLY_TIMEOUT_MS)) {
+            ESP_LOGE("ControllerOTA", "No acknowledgement for offset %u", offset + length);
+            return false;
+        }
+        if (reply.status == OTA_STREAM_STATUS_OK && reply.offset == offset + length) {
+            return true;
+        }
+        if (reply.status != OTA_STREAM_STATUS_RESEND || reply.offset != offset) {
+            ESP_LOGE("ControllerOTA", "Controller aborted the transfer at offset %u (status %d)", reply.offset, reply.status);
+            return false;
+        }
+        ESP_LOGW("ControllerOTA", "Resending window at offset %u", offset);
+    }
+    return false;
+}
+
+bool ControllerOTA::sendStreamCommand(uint8_t *data, uint16_t len, uint8_t command, OtaStreamReply &reply, uint32_t timeout) {
+    if (rxChar == nullptr || streamReplies == nullptr) {
+        return false;
+    }
+    xQueueReset(streamReplies);
+    if (!rxChar->writeValue(data, len, true)) {
+        return false;
+    }
+    unsigned long start = millis();
+    while (millis() - start < timeout) {
+        if (xQueueReceive(streamReplies, &reply, pdMS_TO_TICKS(100)) == pdTRUE && reply.command == command) {
+            return true;
+        }
+        if (!client->isConnected()) {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool ControllerOTA::openDownload(HTTPClient &http, WiFiClientSecure &wifi_client, const String &release_url) const {
     if (!http.begin(wifi_client, release_url)) {
         ESP_LOGE("ControllerOTA", "Failed to start http client");
         return false;
@@ -48,7 +234,7 @@ bool ControllerOTA::downloadFile(WiFiClientSecure &wifi_client, const String &re
         return false;
     }
 
-    if (len == 0) {
+    if (len <= 0) {
         ESP_LOGE("ControllerOTA", "Could not fetch firmware");
         http.end();
         return false;
@@ -62,6 +248,16 @@ bool ControllerOTA::downloadFile(WiFiClientSecure &wifi_client, const String &re
         http.end();
         return false;
     }
+    return true;
+}
+
+bool ControllerOTA::downloadFile(WiFiClientSecure &wifi_client, const String &release_url) {
+    HTTPClient http;
+    if (!openDownload(http, wifi_client, release_url)) {
+        return false;
+    }
+    int len = http.getSize();
+    WiFiClient *tcp = http.getStreamPtr();
 
     File file = SPIFFS.open("/board-firmware.bin", FILE_WRITE, true);
 
@@ -132,7 +328,7 @@ void ControllerOTA::sendData(uint8_t *data, uint16_t len) const {
     delay(50);
 }
 
-void ControllerOTA::fillBuffer(Stream &in, uint8_t *buffer, uint16_t len) const {
+bool ControllerOTA::fillBuffer(Stream &in, uint8_t *buffer, uint16_t len) const {
     size_t bufferLen = 0;
     size_t bytesToRead = len;
     size_t toRead = 0;
@@ -144,7 +340,7 @@ void ControllerOTA::fillBuffer(Stream &in, uint8_t *buffer, uint16_t len) const
                 timeout_failures++;
                 if (timeout_failures >= 300) {
                     ESP_LOGE("ControllerOTA", "Failed to read data from stream");
-                    return;
+                    return false;
                 }
                 ESP_LOGW("ControllerOTA", "Failed to read data from stream. Request %d bytes", bytesToRead);
                 delay(100);
@@ -155,6 +351,7 @@ void ControllerOTA::fillBuffer(Stream &in, uint8_t *buffer, uint16_t len) const
         toRead = 0;
     }
     ESP_LOGV("ControllerOTA", "Read %d bytes", bufferLen);
+    return true;
 }
 
 void ControllerOTA::notifyUpdate() const {
@@ -162,6 +359,11 @@ void ControllerOTA::notifyUpdate() const {
     progressCallback(static_cast<int>(progress));
 }
 
+void ControllerOTA::notifyStreamProgress(uint32_t offset, uint32_t size) const {
+    double progress = (static_cast<double>(offset) / static_cast<double>(size)) * 100.0;
+    progressCallback(static_cast<int>(progress));
+}
+
 void ControllerOTA::sendPart(Stream &in, uint32_t totalSize) const {
     uint8_t partData[MTU + 2];
     uint8_t buffer[MTU];
@@ -201,11 +403,27 @@ void ControllerOTA::sendPart(Stream &in, uint32_t totalSize) const {
 }
 
 void ControllerOTA::onReceive(NimBLERemoteCharacteristic *pRemoteCharacteristic, uint8_t *pData, size_t length, bool isNotify) {
+    if (length == 0) {
+        return;
+    }
+    if (pData[0] >= OTA_STREAM_BEGIN && pData[0] <= OTA_STREAM_FINISH) {
+        OtaStreamReply reply;
+        reply.command = pData[0];
+        reply.status = length > 1 ? pData[1] : OTA_STREAM_STATUS_ERROR;
+        reply.offset = length >= 6 ? readUint32(pData + 2) : 0;
+        reply.crc = length >= 10 ? readUint32(pData + 6) : 0;
+        reply.window = length >= 12 ? pData[10] | (pData[11] << 8) : 0;
+        if (streamReplies != nullptr) {
+            xQueueSend(streamReplies, &reply, 0);
+        }
+        return;
+    }
     lastSignal = pData[0];
     ESP_LOGI("ControllerOTA", "Received signal 0x%x", lastSignal);
     switch (lastSignal) {
     case 0xAA:
-        ESP_LOGI("ControllerOTA", "Starting transfer, only slow mode supported as of yet");
+        streamVersion = length >= 3 ? pData[2] : 0;
+        ESP_LOGI("ControllerOTA", "Controller transfer mode %d, streaming version %d", length >= 2 ? pData[1] : 0, streamVersion);
         break;
     case 0xF1:
         ESP_LOGI("ControllerOTA", "Next part requested");
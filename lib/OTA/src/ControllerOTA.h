@@ -2,6 +2,7 @@
 #define CONTROLLEROTA_H
 
 #include <Arduino.h>
+#include <HTTPClient.h>
 #include <NimBLEDevice.h>
 #include <WiFiClientSecure.h>
 
@@ -12,23 +13,64 @@ constexpr char CHARACTERISTIC_OTA_BL_UUID_TX[] = "fe590003-54ae-4a28-9f74-dfccb2
 constexpr uint16_t MTU = 120;
 constexpr uint16_t PART_SIZE = 19000;
 
+// Streaming transfer, mirrors ble_ota_dfu.hpp (keep in sync). Used when the controller answers 0xFD with
+// OTA_STREAM_VERSION in its third byte, older controllers only know the SPIFFS staged slow mode above.
+// All values little endian.
+//   0xE0 begin   size u32, flags u8              -> 0xE0 status u8, offset u32, crc u32, window u16
+//   0xE1 data    offset u32, payload             written without response, as many as fit the window
+//   0xE2 commit  end offset u32, crc u32         -> 0xE2 status u8, offset u32
+//   0xE3 finish  crc u32                         -> 0xE3 status u8, once the image is verified
+// crc is the crc32 of the image from its start up to the offset. The controller only flashes a window after its commit
+// checked out and always answers with the offset it has flashed up to, the transfer resumes from there.
+constexpr uint8_t OTA_STREAM_VERSION = 1;
+constexpr uint8_t OTA_STREAM_BEGIN = 0xE0;
+constexpr uint8_t OTA_STREAM_DATA = 0xE1;
+constexpr uint8_t OTA_STREAM_COMMIT = 0xE2;
+constexpr uint8_t OTA_STREAM_FINISH = 0xE3;
+constexpr uint8_t OTA_STREAM_FLAG_RESUME = 0x01;
+constexpr uint8_t OTA_STREAM_STATUS_OK = 0x00;
+constexpr uint8_t OTA_STREAM_STATUS_RESEND = 0x01;
+constexpr uint8_t OTA_STREAM_STATUS_ERROR = 0x02;
+constexpr size_t OTA_STREAM_DATA_HEADER_SIZE = 5;
+
+constexpr uint16_t OTA_STREAM_WINDOW_SIZE = 8192;    // upper bound, the controller may ask for less
+constexpr uint16_t OTA_STREAM_MAX_PACKET_SIZE = 244; // ATT payload of the largest MTU we negotiate
+constexpr uint32_t OTA_STREAM_REPLY_TIMEOUT_MS = 3000;
+constexpr uint32_t OTA_STREAM_INSTALL_TIMEOUT_MS = 30000;
+constexpr uint8_t OTA_STREAM_WINDOW_RETRIES = 5;
+constexpr uint8_t OTA_STREAM_ATTEMPTS = 3;
+
 using ctr_progress_callback_t = std::function<void(int progress)>;
 
+struct OtaStreamReply {
+    uint8_t command = 0;
+    uint8_t status = OTA_STREAM_STATUS_ERROR;
+    uint32_t offset = 0;
+    uint32_t crc = 0;
+    uint16_t window = 0;
+};
+
 class ControllerOTA {
   public:
     ControllerOTA() = default;
     ~ControllerOTA() = default;
     void init(NimBLEClient *client, const ctr_progress_callback_t &progress_callback);
 
-    void update(WiFiClientSecure &wifi_client, const String &release_url);
+    bool update(WiFiClientSecure &wifi_client, const String &release_url);
 
   private:
+    uint8_t probeStreamSupport();
+    bool streamUpdate(WiFiClientSecure &wifi_client, const String &release_url, bool resume);
+    bool streamWindow(const uint8_t *window, uint32_t offset, uint16_t length, uint32_t crc);
+    bool sendStreamCommand(uint8_t *data, uint16_t len, uint8_t command, OtaStreamReply &reply, uint32_t timeout);
+    bool openDownload(HTTPClient &http, WiFiClientSecure &wifi_client, const String &release_url) const;
     bool downloadFile(WiFiClientSecure &wifi_client, const String &release_url);
     void runUpdate(Stream &in, uint32_t size);
     void sendPart(Stream &in, uint32_t totalSize) const;
     void sendData(uint8_t *data, uint16_t len) const;
-    void fillBuffer(Stream &in, uint8_t *buffer, uint16_t len) const;
+    bool fillBuffer(Stream &in, uint8_t *buffer, uint16_t len) const;
     void notifyUpdate() const;
+    void notifyStreamProgress(uint32_t offset, uint32_t size) const;
     void onReceive(NimBLERemoteCharacteristic *pRemoteCharacteristic, uint8_t *pData, size_t length, bool isNotify);
 
     NimBLEClient *client = nullptr;
@@ -37,8 +79,12 @@ class ControllerOTA {
 
     ctr_progress_callback_t progressCallback = nullptr;
 
+    QueueHandle_t streamReplies = nullptr;
+
     bool interrupted = false;
     uint8_t lastSignal = 0x00;
+    uint8_t streamVersion = 0;
+    bool resumable = false; // the controller holds a verified prefix of the image being streamed
     uint32_t currentPart = 0;
     uint32_t fileParts = 0;
 };
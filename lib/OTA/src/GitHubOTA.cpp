@@ -81,8 +81,11 @@ void GitHubOTA::update(bool controller, bool display) {
         ESP_LOGI(TAG, "Controller update is required, running firmware update.");
         this->phase = PHASE_CONTROLLER_FW;
         this->_phase_callback(PHASE_CONTROLLER_FW);
-        _controller_ota.update(_wifi_client, _latest_url + _controller_firmware_name);
-        ESP_LOGI(TAG, "Controller update successful. Restarting...\n");
+        if (_controller_ota.update(_wifi_client, _latest_url + _controller_firmware_name)) {
+            ESP_LOGI(TAG, "Controller update successful. Restarting...\n");
+        } else {
+            ESP_LOGE(TAG, "Controller update failed\n");
+        }
         updateExecuted = true;
     }
 
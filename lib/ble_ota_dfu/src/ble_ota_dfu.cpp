@@ -1,9 +1,35 @@
 /* Copyright 2022 Vincent Stragier */
 #include "ble_ota_dfu.hpp"
+#include <esp_rom_crc.h>
 
 QueueHandle_t start_update_queue;
 QueueHandle_t update_uploading_queue;
 
+static uint32_t read_uint32_le(const uint8_t *data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static void write_uint32_le(uint8_t *data, uint32_t value) {
+    data[0] = value & 0xFF;
+    data[1] = (value >> 8) & 0xFF;
+    data[2] = (value >> 16) & 0xFF;
+    data[3] = (value >> 24) & 0xFF;
+}
+
+// Finalizes an image that was streamed into the OTA partition, returns true when it verified and will boot
+static bool install_streamed_update(BLE_OTA_DFU *OTA_DFU_BLE) {
+    ESP_LOGI(TAG, "Verifying streamed update");
+    bool success = Update.end();
+    if (!success) {
+        ESP_LOGE(TAG, "Streamed update failed. Error #: %d", Update.getError());
+    }
+    uint8_t result[12] = {OTA_STREAM_FINISH, success ? OTA_STREAM_STATUS_OK : OTA_STREAM_STATUS_ERROR};
+    if (OTA_DFU_BLE->connected()) {
+        OTA_DFU_BLE->send_OTA_DFU(result, sizeof(result));
+    }
+    return success;
+}
+
 void task_install_update(void *parameters) {
     FS file_system = FLASH;
     const char path[] = "/update.bin";
@@ -14,10 +40,24 @@ void task_install_update(void *parameters) {
 
     // Wait for the upload to be completed
     bool start_update = false;
-    xQueuePeek(start_update_queue, &start_update, portMAX_DELAY);
-    while (!start_update) {
-        delay(500);
+    while (true) {
         xQueuePeek(start_update_queue, &start_update, portMAX_DELAY);
+        while (!start_update) {
+            delay(500);
+            xQueuePeek(start_update_queue, &start_update, portMAX_DELAY);
+        }
+        if (!OTA_DFU_BLE->stream_install) {
+            break;
+        }
+        if (install_streamed_update(OTA_DFU_BLE)) {
+            ESP_LOGI(TAG, "Rebooting ESP32: complete OTA update");
+            delay(1000);
+            ESP.restart();
+        }
+        // Rejected image, wait for the next transfer
+        OTA_DFU_BLE->stream_install = false;
+        start_update = false;
+        xQueueOverwrite(start_update_queue, &start_update);
     }
 
     ESP_LOGE(TAG, "Starting OTA update");
@@ -150,6 +190,104 @@ uint16_t BLEOverTheAirDeviceFirmwareUpdate::write_binary(fs::FS *file_system, co
     }
 }
 
+void BLEOverTheAirDeviceFirmwareUpdate::stream_reply(uint8_t command, uint8_t status) {
+    uint8_t reply[12] = {command, status};
+    write_uint32_le(reply + 2, stream_committed);
+    write_uint32_le(reply + 6, stream_crc);
+    reply[10] = OTA_STREAM_WINDOW_SIZE & 0xFF;
+    reply[11] = OTA_STREAM_WINDOW_SIZE >> 8;
+    OTA_DFU_BLE->send_OTA_DFU(reply, sizeof(reply));
+}
+
+void BLEOverTheAirDeviceFirmwareUpdate::stream_begin(const uint8_t *data, uint16_t length) {
+    if (length < 6) {
+        stream_reply(OTA_STREAM_BEGIN, OTA_STREAM_STATUS_ERROR);
+        return;
+    }
+    uint32_t size = read_uint32_le(data + 1);
+    bool resume = data[5] & OTA_STREAM_FLAG_RESUME;
+    stream_window_length = 0;
+    stream_window_valid = true;
+
+    if (resume && stream_active && size == stream_size && Update.isRunning()) {
+        ESP_LOGI(TAG, "Resuming streamed update at %u / %u bytes", stream_committed, size);
+        stream_reply(OTA_STREAM_BEGIN, OTA_STREAM_STATUS_OK);
+        return;
+    }
+
+    if (Update.isRunning()) {
+        Update.abort();
+    }
+    stream_active = false;
+    stream_size = size;
+    stream_committed = 0;
+    stream_crc = 0;
+    if (!Update.begin(size)) {
+        ESP_LOGE(TAG, "Not enough space for a %u byte streamed update", size);
+        stream_reply(OTA_STREAM_BEGIN, OTA_STREAM_STATUS_ERROR);
+        return;
+    }
+    stream_active = true;
+    ESP_LOGI(TAG, "Receiving %u byte streamed update", size);
+    stream_reply(OTA_STREAM_BEGIN, OTA_STREAM_STATUS_OK);
+}
+
+void BLEOverTheAirDeviceFirmwareUpdate::stream_data(const uint8_t *data, uint16_t length) {
+    if (!stream_active || !stream_window_valid || length <= OTA_STREAM_DATA_HEADER_SIZE) {
+        return;
+    }
+    uint32_t offset = read_uint32_le(data + 1);
+    uint16_t payload = length - OTA_STREAM_DATA_HEADER_SIZE;
+    if (offset != stream_committed + stream_window_length || stream_window_length + payload > OTA_STREAM_WINDOW_SIZE) {
+        // Lost or repeated packet, the commit asks for the whole window again
+        stream_window_valid = false;
+        return;
+    }
+    memcpy(updater[0] + stream_window_length, data + OTA_STREAM_DATA_HEADER_SIZE, payload);
+    stream_window_length += payload;
+}
+
+void BLEOverTheAirDeviceFirmwareUpdate::stream_commit(const uint8_t *data, uint16_t length) {
+    if (!stream_active || length < 9) {
+        stream_reply(OTA_STREAM_COMMIT, OTA_STREAM_STATUS_ERROR);
+        return;
+    }
+    uint32_t end = read_uint32_le(data + 1);
+    uint32_t crc = read_uint32_le(data + 5);
+    if (!stream_window_valid || stream_committed + stream_window_length != end ||
+        esp_rom_crc32_le(stream_crc, updater[0], stream_window_length) != crc) {
+        ESP_LOGW(TAG, "Window at %u failed verification, requesting it again", stream_committed);
+        stream_window_length = 0;
+        stream_window_valid = true;
+        stream_reply(OTA_STREAM_COMMIT, OTA_STREAM_STATUS_RESEND);
+        return;
+    }
+    if (Update.write(updater[0], stream_window_length) != stream_window_length) {
+        ESP_LOGE(TAG, "Writing streamed update failed. Error #: %d", Update.getError());
+        Update.abort();
+        stream_active = false;
+        stream_reply(OTA_STREAM_COMMIT, OTA_STREAM_STATUS_ERROR);
+        return;
+    }
+    stream_committed = end;
+    stream_crc = crc;
+    stream_window_length = 0;
+    stream_reply(OTA_STREAM_COMMIT, OTA_STREAM_STATUS_OK);
+}
+
+void BLEOverTheAirDeviceFirmwareUpdate::stream_finish(const uint8_t *data, uint16_t length) {
+    if (!stream_active || length < 5 || stream_committed != stream_size || read_uint32_le(data + 1) != stream_crc) {
+        ESP_LOGE(TAG, "Streamed update incomplete: %u / %u bytes", stream_committed, stream_size);
+        stream_reply(OTA_STREAM_FINISH, OTA_STREAM_STATUS_ERROR);
+        return;
+    }
+    // Update.end() verifies the whole image, leave that to the install task instead of blocking the BLE host
+    stream_active = false;
+    OTA_DFU_BLE->stream_install = true;
+    bool start_update = true;
+    xQueueOverwrite(start_update_queue, &start_update);
+}
+
 void BLEOverTheAirDeviceFirmwareUpdate::onNotify(BLECharacteristic *pCharacteristic) {
 #ifdef DEBUG_BLE_OTA_DFU_TX
     // uint8_t *pData;
@@ -272,13 +410,29 @@ void BLEOverTheAirDeviceFirmwareUpdate::onWrite(BLECharacteristic *pCharacterist
                 FLASH.remove("/update.bin");
             }
 
-            // Send mode ("fast" or "slow")
-            uint8_t mode[] = {0xAA, FASTMODE};
-            OTA_DFU_BLE->pCharacteristic_BLE_OTA_DFU_TX->setValue(mode, 2);
+            // Send mode ("fast" or "slow") and the supported streaming version
+            uint8_t mode[] = {0xAA, FASTMODE, OTA_STREAM_VERSION};
+            OTA_DFU_BLE->pCharacteristic_BLE_OTA_DFU_TX->setValue(mode, 3);
             OTA_DFU_BLE->pCharacteristic_BLE_OTA_DFU_TX->notify();
             delay(10);
         } break;
 
+        case OTA_STREAM_BEGIN:
+            stream_begin(pData, len);
+            break;
+
+        case OTA_STREAM_DATA:
+            stream_data(pData, len);
+            break;
+
+        case OTA_STREAM_COMMIT:
+            stream_commit(pData, len);
+            break;
+
+        case OTA_STREAM_FINISH:
+            stream_finish(pData, len);
+            break;
+
             // Keep track of the received file and of the expected file sizes
         case 0xFE:
             received_file_size = 0;
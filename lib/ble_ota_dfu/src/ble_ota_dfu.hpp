@@ -36,6 +36,24 @@ constexpr char CHARACTERISTIC_OTA_BL_UUID_TX[] =
 constexpr bool FORMAT_FLASH_IF_MOUNT_FAILED = true;
 constexpr uint32_t UPDATER_SIZE = 20000;
 
+// Streaming transfer, mirrors ControllerOTA.h on the display (keep in sync).
+// Data goes straight into the OTA partition through Update, nothing is staged
+// in FLASH. Each window is buffered in updater[0] and only flashed once its
+// commit crc matches, so the transfer can resume from the committed offset.
+constexpr uint8_t OTA_STREAM_VERSION = 1;
+constexpr uint8_t OTA_STREAM_BEGIN = 0xE0;
+constexpr uint8_t OTA_STREAM_DATA = 0xE1;
+constexpr uint8_t OTA_STREAM_COMMIT = 0xE2;
+constexpr uint8_t OTA_STREAM_FINISH = 0xE3;
+constexpr uint8_t OTA_STREAM_FLAG_RESUME = 0x01;
+constexpr uint8_t OTA_STREAM_STATUS_OK = 0x00;
+constexpr uint8_t OTA_STREAM_STATUS_RESEND = 0x01;
+constexpr uint8_t OTA_STREAM_STATUS_ERROR = 0x02;
+constexpr size_t OTA_STREAM_DATA_HEADER_SIZE = 5;
+constexpr uint16_t OTA_STREAM_WINDOW_SIZE = 16384;
+static_assert(OTA_STREAM_WINDOW_SIZE <= UPDATER_SIZE,
+              "stream window must fit the updater buffer");
+
 /* Dummy class */
 class BLE_OTA_DFU;
 
@@ -50,6 +68,20 @@ private:
   uint32_t received_file_size = 0;
   uint32_t expected_file_size = 0;
 
+  // Streaming transfer
+  bool stream_active = false;
+  bool stream_window_valid = true;
+  uint32_t stream_size = 0;
+  uint32_t stream_committed = 0;
+  uint32_t stream_crc = 0;
+  uint16_t stream_window_length = 0;
+
+  void stream_begin(const uint8_t *data, uint16_t length);
+  void stream_data(const uint8_t *data, uint16_t length);
+  void stream_commit(const uint8_t *data, uint16_t length);
+  void stream_finish(const uint8_t *data, uint16_t length);
+  void stream_reply(uint8_t command, uint8_t status);
+
 public:
   friend class BLE_OTA_DFU;
   BLE_OTA_DFU *OTA_DFU_BLE;
@@ -65,6 +97,9 @@ private:
   BLEServer *pServer = nullptr;
   BLEService *pServiceOTA = nullptr;
   BLECharacteristic *pCharacteristic_BLE_OTA_DFU_TX = nullptr;
+  // Set once a streamed image is complete, the install task then only has to
+  // finalize Update instead of flashing update.bin
+  bool stream_install = false;
   friend class BLEOverTheAirDeviceFirmwareUpdate;
 
 public:
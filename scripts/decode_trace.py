@@ -0,0 +1,116 @@
+"""Decodes the controller's binary trace (lib/NayrodPID/src/Trace).
+
+Reads frames from a capture file or straight from the controller's serial port and prints one line per record, or a CSV
+of a single event. The event table is read from Trace.h, so new events need no change here. Text between the frames,
+the ESP_LOG output on the same port, is skipped.
+
+    python3 scripts/decode_trace.py capture.bin
+    python3 scripts/decode_trace.py /dev/ttyUSB0 --level=debug
+    python3 scripts/decode_trace.py capture.bin --event=PUMP_TICK --csv > pump.csv
+
+Reading a serial port needs pyserial. --level sends the "T<level>" console command before reading.
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HEADER = os.path.join(ROOT, "lib", "NayrodPID", "src", "Trace", "Trace.h")
+
+SYNC = b"\xa5\x5a"
+RECORD = struct.Struct("<IBBH4f")
+FRAME_SIZE = len(SYNC) + RECORD.size + 1
+LEVELS = ["off", "error", "info", "debug", "verbose"]
+
+
+def read_events(path):
+    """Returns [(name, [field, ...])] in TraceEvent order."""
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    start = text.index("#define TRACE_EVENT_LIST(X)")
+    body = text[start : text.index("\n\n", start)]
+    return [(name, fields.split(",")) for name, fields in re.findall(r'X\((\w+),\s*\w+,\s*\w+,\s*"([^"]*)"\)', body)]
+
+
+def frames(stream):
+    """Yields decoded records, resynchronising on the sync bytes after text or a bad checksum."""
+    buffer = b""
+    while True:
+        chunk = stream.read(4096)
+        if not chunk:
+            return
+        buffer += chunk
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                buffer = buffer[-1:]
+                break
+            if len(buffer) - start < FRAME_SIZE:
+                buffer = buffer[start:]
+                break
+            payload = buffer[start + len(SYNC) : start + FRAME_SIZE - 1]
+            checksum = 0
+            for byte in payload:
+                checksum ^= byte
+            if checksum != buffer[start + FRAME_SIZE - 1]:
+                buffer = buffer[start + 1 :]
+                continue
+            buffer = buffer[start + FRAME_SIZE :]
+            yield RECORD.unpack(payload)
+
+
+def open_input(path, level, baud):
+    if not os.path.exists(path) or os.path.isfile(path):
+        return open(path, "rb")
+    import serial  # noqa: PLC0415, only needed for live capture
+
+    port = serial.Serial(path, baud, timeout=1)
+    if level is not None:
+        port.write(f"T{LEVELS.index(level)}".encode())
+    return port
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("input", help="capture file or serial port")
+    parser.add_argument("--event", help="only print this event")
+    parser.add_argument("--csv", action="store_true", help="CSV of the --event records")
+    parser.add_argument("--level", choices=LEVELS, help="set the trace level of a live controller first")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+    if args.csv and not args.event:
+        parser.error("--csv needs --event")
+
+    events = read_events(HEADER)
+    names = [name for name, _ in events]
+    if args.event and args.event not in names:
+        parser.error(f"unknown event {args.event}, one of {', '.join(names)}")
+    if args.csv:
+        print(",".join(["time_us", "sequence"] + events[names.index(args.event)][1]))
+
+    last_sequence = None
+    with open_input(args.input, args.level, args.baud) as stream:
+        for timestamp, event, count, sequence, *values in frames(stream):
+            if last_sequence is not None and sequence != (last_sequence + 1) & 0xFFFF and event != 0:
+                print(f"# {(sequence - last_sequence - 1) & 0xFFFF} frames lost on the wire", file=sys.stderr)
+            if event != 0:
+                last_sequence = sequence
+            if event >= len(events):
+                print(f"# unknown event {event}, Trace.h does not match the firmware", file=sys.stderr)
+                continue
+            name, fields = events[event]
+            if args.event and name != args.event:
+                continue
+            values = values[:count]
+            if args.csv:
+                print(",".join([str(timestamp), str(sequence)] + [f"{v:.6g}" for v in values]))
+            else:
+                pairs = " ".join(f"{field}={value:.6g}" for field, value in zip(fields, values))
+                print(f"{timestamp / 1e6:12.6f} {name} {pairs}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,184 @@
+"""Generates the timezone tables from scripts/zones.txt.
+
+Writes src/display/core/zones.h, a sorted name table with binary search lookups over NUL separated string pools, and
+web/src/config/zones.js, the list the settings page offers. Runs as a PlatformIO pre script and standalone:
+
+    python3 scripts/generate_zones.py
+
+Files are only rewritten when their content changes, so an unchanged table does not trigger a rebuild.
+"""
+
+import os
+
+try:
+    Import("env")  # noqa: F821, provided by PlatformIO
+    ROOT = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE = os.path.join(ROOT, "scripts", "zones.txt")
+HEADER = os.path.join(ROOT, "src", "display", "core", "zones.h")
+WEB = os.path.join(ROOT, "web", "src", "config", "zones.js")
+
+FALLBACK_TZ = "GMT0"
+INDICES_PER_LINE = 16
+
+
+def read_zones(path):
+    zones = {}
+    with open(path, encoding="utf-8") as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            parts = line.split()
+            if len(parts) != 2:
+                raise ValueError(f"{path}:{number}: expected '<name> <posix tz>'")
+            name, posix = parts
+            if name in zones:
+                raise ValueError(f"{path}:{number}: duplicate zone {name}")
+            zones[name] = posix
+    # Byte order, the same order strcmp sorts in
+    return sorted(zones.items(), key=lambda zone: zone[0].encode())
+
+
+def build_pool(strings):
+    offsets = {}
+    size = 0
+    for string in strings:
+        offsets[string] = size
+        size += len(string.encode()) + 1
+    if size > 0xFFFF:
+        raise ValueError("string pool does not fit 16 bit offsets")
+    return offsets
+
+
+def pool_literal(strings, indent="    "):
+    return "\n".join(f'{indent}"{string}\\0"' for string in strings)
+
+
+def render_header(zones):
+    names = [name for name, _ in zones]
+    posix_strings = sorted({posix for _, posix in zones}, key=str.encode)
+    name_offsets = build_pool(names)
+    posix_offsets = build_pool(posix_strings)
+    by_posix = sorted(range(len(zones)), key=lambda i: (zones[i][1].encode(), zones[i][0].encode()))
+
+    entries = "\n".join(
+        f"    {{{name_offsets[name]}, {posix_offsets[posix]}}}, // {name}" for name, posix in zones
+    )
+    index_lines = []
+    for start in range(0, len(by_posix), INDICES_PER_LINE):
+        index_lines.append("    " + " ".join(f"{i}," for i in by_posix[start:start + INDICES_PER_LINE]))
+
+    return f"""#ifndef ZONES_H
+#define ZONES_H
+
+// Generated by scripts/generate_zones.py from scripts/zones.txt, do not edit.
+
+#include "Arduino.h"
+#include <pgmspace.h>
+
+// Tables are inline variables, every translation unit that includes this header shares one copy.
+
+// {len(posix_strings)} distinct POSIX TZ strings in byte order, NUL separated
+inline constexpr char TZ_POOL[] PROGMEM =
+{pool_literal(posix_strings)};
+
+// IANA zone names in byte order, NUL separated
+inline constexpr char ZONE_NAME_POOL[] PROGMEM =
+{pool_literal(names)};
+
+typedef struct {{
+    uint16_t name; // offset into ZONE_NAME_POOL
+    uint16_t tz;   // offset into TZ_POOL
+}} zone_entry_t;
+
+static constexpr size_t ZONE_COUNT = {len(zones)};
+
+// Sorted by name
+inline constexpr zone_entry_t ZONES[ZONE_COUNT] PROGMEM = {{
+{entries}
+}};
+
+// Zone indices sorted by TZ string and then name, zones sharing a TZ string are adjacent
+inline constexpr uint16_t ZONES_BY_TZ[ZONE_COUNT] PROGMEM = {{
+{chr(10).join(index_lines)}
+}};
+
+static const char FALLBACK_TZ[] PROGMEM = "{FALLBACK_TZ}";
+
+inline const char *timezone_name(size_t index) {{ return ZONE_NAME_POOL + ZONES[index].name; }}
+
+inline const char *timezone_posix(size_t index) {{ return TZ_POOL + ZONES[index].tz; }}
+
+// Index of the zone with this IANA name, -1 if there is none
+inline int find_timezone(const char *name) {{
+    size_t low = 0;
+    size_t high = ZONE_COUNT;
+    while (low < high) {{
+        size_t mid = (low + high) / 2;
+        int cmp = strcmp(name, timezone_name(mid));
+        if (cmp == 0) {{
+            return static_cast<int>(mid);
+        }}
+        if (cmp < 0) {{
+            high = mid;
+        }} else {{
+            low = mid + 1;
+        }}
+    }}
+    return -1;
+}}
+
+// Reverse lookup for the settings: index of the alphabetically first zone using this POSIX TZ string, -1 if none does
+inline int find_timezone_by_posix(const char *posix) {{
+    size_t low = 0;
+    size_t high = ZONE_COUNT;
+    while (low < high) {{
+        size_t mid = (low + high) / 2;
+        if (strcmp(timezone_posix(ZONES_BY_TZ[mid]), posix) < 0) {{
+            low = mid + 1;
+        }} else {{
+            high = mid;
+        }}
+    }}
+    if (low < ZONE_COUNT && strcmp(timezone_posix(ZONES_BY_TZ[low]), posix) == 0) {{
+        return ZONES_BY_TZ[low];
+    }}
+    return -1;
+}}
+
+inline const char *resolve_timezone(const String &time_zone_label) {{
+    int index = find_timezone(time_zone_label.c_str());
+    return index < 0 ? FALLBACK_TZ : timezone_posix(index);
+}}
+
+#endif // ZONES_H
+"""
+
+
+def render_web(zones):
+    names = "\n".join(f"  '{name}'," for name, _ in zones)
+    return f"""// Generated by scripts/generate_zones.py from scripts/zones.txt, do not edit.
+export const timezones = [
+{names}
+];
+"""
+
+
+def write_if_changed(path, content):
+    try:
+        with open(path, encoding="utf-8") as f:
+            if f.read() == content:
+                return
+    except FileNotFoundError:
+        pass
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(content)
+    print(f"Generated {os.path.relpath(path, ROOT)}")
+
+
+zone_list = read_zones(SOURCE)
+write_if_changed(HEADER, render_header(zone_list))
+write_if_changed(WEB, render_web(zone_list))
@@ -15,6 +15,7 @@
 #include <display/plugins/HomekitPlugin.h>
 #include <display/plugins/LedControlPlugin.h>
 #include <display/plugins/MQTTPlugin.h>
+#include <display/plugins/RuntimeStatsPlugin.h>
 #include <display/plugins/ShotHistoryPlugin.h>
 #include <display/plugins/SmartGrindPlugin.h>
 #include <display/plugins/WebUIPlugin.h>
@@ -51,6 +52,7 @@ void Controller::setup() {
     }
     pluginManager->registerPlugin(new WebUIPlugin());
     pluginManager->registerPlugin(&ShotHistory);
+    pluginManager->registerPlugin(&RuntimeStats);
     pluginManager->registerPlugin(&BLEScales);
     pluginManager->registerPlugin(new LedControlPlugin());
     pluginManager->registerPlugin(new AutoWakeupPlugin());
@@ -58,7 +60,7 @@ void Controller::setup() {
 
     pluginManager->on("profiles:profile:save", [this](Event const &event) {
         String id = event.getString("id");
-        if (id == profileManager->getSelectedProfile().id) {
+        if (id == profileManager->getSelectedProfile()->id) {
             this->handleProfileUpdate();
         }
     });
@@ -82,7 +84,7 @@ void Controller::connect() {
     if (initialized)
         return;
     lastPing = millis();
-    pluginManager->trigger("controller:startup");
+    pluginManager->trigger(EventId::CONTROLLER_STARTUP);
 
     setupWifi();
     setupBluetooth();
@@ -97,15 +99,28 @@ void Controller::setupBluetooth() {
     clientController.initClient();
     clientController.registerSensorCallback(
         [this](const float temp, const float pressure, const float puckFlow, const float pumpFlow, const float puckResistance) {
-            onTempRead(temp);
-            this->pressure = pressure;
-            this->currentPuckFlow = puckFlow;
-            this->currentPumpFlow = pumpFlow;
-            pluginManager->trigger("boiler:pressure:change", "value", pressure);
-            pluginManager->trigger("pump:puck-flow:change", "value", puckFlow);
-            pluginManager->trigger("pump:flow:change", "value", pumpFlow);
-            pluginManager->trigger("pump:puck-resistance:change", "value", puckResistance);
+            sensorSamples.push(SensorSample{
+                .timestamp = millis(),
+                .temperature = temp - static_cast<float>(settings.getTemperatureOffset()),
+                .pressure = pressure,
+                .puckFlow = puckFlow,
+                .pumpFlow = pumpFlow,
+                .puckResistance = puckResistance,
+            });
+            onSensorRead(temp, pressure, puckFlow, pumpFlow, puckResistance);
         });
+    clientController.registerSensorBatchCallback([this](const SensorSample *samples, const size_t count) {
+        // Map the controller clock onto ours, the newest sample was taken right before the notification was sent
+        uint32_t clockOffset = millis() - samples[count - 1].timestamp;
+        for (size_t i = 0; i < count; i++) {
+            SensorSample sample = samples[i];
+            sample.timestamp += clockOffset;
+            sample.temperature -= static_cast<float>(settings.getTemperatureOffset());
+            sensorSamples.push(sample);
+        }
+        const SensorSample &latest = samples[count - 1];
+        onSensorRead(latest.temperature, latest.pressure, latest.puckFlow, latest.pumpFlow, latest.puckResistance);
+    });
     clientController.registerBrewBtnCallback([this](const int brewButtonStatus) { handleBrewButton(brewButtonStatus); });
     clientController.registerSteamBtnCallback([this](const int steamButtonStatus) { handleSteamButton(steamButtonStatus); });
     clientController.registerRemoteErrorCallback([this](const int error) {
@@ -113,26 +128,38 @@ void Controller::setupBluetooth() {
             this->error = error;
             deactivate();
             setMode(MODE_STANDBY);
-            pluginManager->trigger(F("controller:error"));
+            pluginManager->trigger(EventId::CONTROLLER_ERROR);
             ESP_LOGE(LOG_TAG, "Received error %d", error);
         }
     });
-    clientController.registerAutotuneResultCallback([this](const float Kp, const float Ki, const float Kd) {
-        ESP_LOGI(LOG_TAG, "Received new autotune values: %.3f, %.3f, %.3f", Kp, Ki, Kd);
-        char pid[30];
-        snprintf(pid, sizeof(pid), "%.3f,%.3f,%.3f", Kp, Ki, Kd);
-        settings.setPid(String(pid));
-        pluginManager->trigger("controller:autotune:result");
+    clientController.registerAutotuneResultCallback([this](const bool success, const float Kp, const float Ki, const float Kd) {
+        if (success) {
+            ESP_LOGI(LOG_TAG, "Received new autotune values: %.3f, %.3f, %.3f", Kp, Ki, Kd);
+            char pid[30];
+            snprintf(pid, sizeof(pid), "%.3f,%.3f,%.3f", Kp, Ki, Kd);
+            settings.setPid(String(pid));
+        } else {
+            ESP_LOGW(LOG_TAG, "Autotune failed, keeping the PID settings");
+        }
+        pluginManager->trigger(EventId::CONTROLLER_AUTOTUNE_RESULT, "success", success ? 1 : 0);
         autotuning = false;
     });
+    clientController.registerAutotuneProgressCallback([this](const int state, const float temperature) {
+        ESP_LOGV(LOG_TAG, "Autotune state %d at %.2f", state, temperature);
+        Event event;
+        event.id = EventId::CONTROLLER_AUTOTUNE_PROGRESS;
+        event.setInt("state", state);
+        event.setFloat("temperature", temperature);
+        pluginManager->post(event, EventPriority::UI);
+    });
     clientController.registerVolumetricMeasurementCallback(
         [this](const float value) { onVolumetricMeasurement(value, VolumetricMeasurementSource::FLOW_ESTIMATION); });
     clientController.registerTofMeasurementCallback([this](const int value) {
         tofDistance = value;
         ESP_LOGV(LOG_TAG, "Received new TOF distance: %d", value);
-        pluginManager->trigger("controller:tof:change", "value", value);
+        pluginManager->post(EventId::CONTROLLER_TOF_CHANGE, "value", value, EventPriority::TELEMETRY);
     });
-    pluginManager->trigger("controller:bluetooth:init");
+    pluginManager->trigger(EventId::CONTROLLER_BLUETOOTH_INIT);
 }
 
 void Controller::setupInfos() {
@@ -152,8 +179,10 @@ void Controller::setupInfos() {
                                     .pressure = doc["cp"]["ps"].as<bool>(),
                                     .ledControl = doc["cp"]["led"].as<bool>(),
                                     .tof = doc["cp"]["tof"].as<bool>(),
+                                    .binaryProtocol = doc["cp"]["bin"].as<int>() == BINARY_PROTOCOL_VERSION,
                                 }};
     }
+    clientController.setBinaryProtocol(systemInfo.capabilities.binaryProtocol);
 }
 
 void Controller::setupWifi() {
@@ -173,12 +202,13 @@ void Controller::setupWifi() {
         if (WiFi.status() == WL_CONNECTED) {
             ESP_LOGI(LOG_TAG, "Connected to %s with IP address %s", settings.getWifiSsid().c_str(),
                      WiFi.localIP().toString().c_str());
-            WiFi.onEvent([this](WiFiEvent_t, WiFiEventInfo_t) { pluginManager->trigger("controller:wifi:connect", "AP", 0); },
-                         WiFiEvent_t::ARDUINO_EVENT_WIFI_STA_GOT_IP);
+            WiFi.onEvent(
+                [this](WiFiEvent_t, WiFiEventInfo_t) { pluginManager->trigger(EventId::CONTROLLER_WIFI_CONNECT, "AP", 0); },
+                WiFiEvent_t::ARDUINO_EVENT_WIFI_STA_GOT_IP);
             WiFi.onEvent(
                 [this](WiFiEvent_t, WiFiEventInfo_t info) {
                     ESP_LOGI(LOG_TAG, "Lost WiFi connection. Reason: %d", info.wifi_sta_disconnected.reason);
-                    pluginManager->trigger("controller:wifi:disconnect");
+                    pluginManager->trigger(EventId::CONTROLLER_WIFI_DISCONNECT);
                 },
                 WiFiEvent_t::ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
         } else {
@@ -199,7 +229,7 @@ void Controller::setupWifi() {
     pluginManager->on("ota:update:start", [this](Event const &) { this->updating = true; });
     pluginManager->on("ota:update:end", [this](Event const &) { this->updating = false; });
 
-    pluginManager->trigger("controller:wifi:connect", "AP", isApConnection ? 1 : 0);
+    pluginManager->trigger(EventId::CONTROLLER_WIFI_CONNECT, "AP", isApConnection ? 1 : 0);
 }
 
 void Controller::loop() {
@@ -212,7 +242,7 @@ void Controller::loop() {
     if (clientController.isReadyForConnection()) {
         clientController.connectToServer();
         setupInfos();
-        pluginManager->trigger("controller:bluetooth:connect");
+        pluginManager->trigger(EventId::CONTROLLER_BLUETOOTH_CONNECT);
         if (!loaded) {
             loaded = true;
             if (settings.getStartupMode() == MODE_STANDBY)
@@ -223,7 +253,7 @@ void Controller::loop() {
             clientController.sendPidSettings(settings.getPid());
             clientController.sendPumpModelCoeffs(settings.getPumpModelCoeffs());
 
-            pluginManager->trigger("controller:ready");
+            pluginManager->trigger(EventId::CONTROLLER_READY);
         }
     }
 
@@ -275,6 +305,7 @@ void Controller::loop() {
                 }
             }
         }
+        publishProcessSnapshot();
         lastProgress = now;
     }
 
@@ -313,7 +344,7 @@ void Controller::autotune(int testTime, int samples) {
     }
     autotuning = true;
     clientController.sendAutotune(testTime, samples);
-    pluginManager->trigger("controller:autotune:start");
+    pluginManager->trigger(EventId::CONTROLLER_AUTOTUNE_START);
 }
 
 void Controller::startProcess(Process *process) {
@@ -321,7 +352,7 @@ void Controller::startProcess(Process *process) {
         return;
     processCompleted = false;
     this->currentProcess = process;
-    pluginManager->trigger("controller:process:start");
+    pluginManager->trigger(EventId::CONTROLLER_PROCESS_START);
     updateLastAction();
 }
 
@@ -333,7 +364,7 @@ float Controller::getTargetTemp() const {
             auto brewProcess = static_cast<BrewProcess *>(currentProcess);
             return brewProcess->getTemperature();
         }
-        return profileManager->getSelectedProfile().temperature;
+        return profileManager->getSelectedProfile()->temperature;
     case MODE_STEAM:
         return settings.getTargetSteamTemp();
     case MODE_WATER:
@@ -344,7 +375,7 @@ float Controller::getTargetTemp() const {
 }
 
 void Controller::setTargetTemp(float temperature) {
-    pluginManager->trigger("boiler:targetTemperature:change", "value", temperature);
+    pluginManager->trigger(EventId::BOILER_TARGET_TEMPERATURE_CHANGE, "value", temperature);
     switch (mode) {
     case MODE_BREW:
     case MODE_GRIND:
@@ -376,13 +407,13 @@ void Controller::setPumpModelCoeffs(void) {
 int Controller::getTargetDuration() const { return settings.getTargetDuration(); }
 
 void Controller::setTargetDuration(int duration) {
-    Event event = pluginManager->trigger("controller:targetDuration:change", "value", duration);
+    Event event = pluginManager->trigger(EventId::CONTROLLER_TARGET_DURATION_CHANGE, "value", duration);
     settings.setTargetDuration(event.getInt("value"));
     updateLastAction();
 }
 
 void Controller::setTargetVolume(int volume) {
-    Event event = pluginManager->trigger("controller:targetVolume:change", "value", volume);
+    Event event = pluginManager->trigger(EventId::CONTROLLER_TARGET_VOLUME_CHANGE, "value", volume);
     settings.setTargetVolume(event.getInt("value"));
     updateLastAction();
 }
@@ -390,13 +421,13 @@ void Controller::setTargetVolume(int volume) {
 int Controller::getTargetGrindDuration() const { return settings.getTargetGrindDuration(); }
 
 void Controller::setTargetGrindDuration(int duration) {
-    Event event = pluginManager->trigger("controller:grindDuration:change", "value", duration);
+    Event event = pluginManager->trigger(EventId::CONTROLLER_GRIND_DURATION_CHANGE, "value", duration);
     settings.setTargetGrindDuration(event.getInt("value"));
     updateLastAction();
 }
 
 void Controller::setTargetGrindVolume(double volume) {
-    Event event = pluginManager->trigger("controller:grindVolume:change", "value", static_cast<float>(volume));
+    Event event = pluginManager->trigger(EventId::CONTROLLER_GRIND_VOLUME_CHANGE, "value", static_cast<float>(volume));
     settings.setTargetGrindVolume(event.getFloat("value"));
     updateLastAction();
 }
@@ -483,6 +514,10 @@ void Controller::updateControl() {
         targetTemp = targetTemp + static_cast<float>(settings.getTemperatureOffset());
     }
     clientController.sendAltControl(isActive() && currentProcess->isAltRelayActive());
+    float heatLoad = 0.0f;
+    if (isActive() && currentProcess->getType() == MODE_BREW) {
+        heatLoad = static_cast<BrewProcess *>(currentProcess)->getPlannedFlow();
+    }
     if (isActive() && systemInfo.capabilities.pressure) {
         if (currentProcess->getType() == MODE_STEAM) {
             targetPressure = settings.getSteamPumpCutoff();
@@ -495,7 +530,7 @@ void Controller::updateControl() {
             if (brewProcess->isAdvancedPump()) {
                 clientController.sendAdvancedOutputControl(brewProcess->isRelayActive(), targetTemp,
                                                            brewProcess->getPumpTarget() == PumpTarget::PUMP_TARGET_PRESSURE,
-                                                           brewProcess->getPumpPressure(), brewProcess->getPumpFlow());
+                                                           brewProcess->getPumpPressure(), brewProcess->getPumpFlow(), heatLoad);
                 targetPressure = brewProcess->getPumpPressure();
                 targetFlow = brewProcess->getPumpFlow();
                 return;
@@ -505,7 +540,37 @@ void Controller::updateControl() {
     targetPressure = 0.0f;
     targetFlow = 0.0f;
     clientController.sendOutputControl(isActive() && currentProcess->isRelayActive(),
-                                       isActive() ? currentProcess->getPumpValue() : 0, targetTemp);
+                                       isActive() ? currentProcess->getPumpValue() : 0, targetTemp, heatLoad);
+}
+
+void Controller::publishProcessSnapshot() {
+    ProcessSnapshot snapshot;
+    Process *process = currentProcess != nullptr ? currentProcess : lastProcess;
+    if (process != nullptr) {
+        snapshot.present = true;
+        snapshot.current = process == currentProcess;
+        snapshot.active = process->isActive();
+        snapshot.type = process->getType();
+    }
+    if (snapshot.type == MODE_BREW) {
+        const auto *brew = static_cast<BrewProcess *>(process);
+        const Phase &phase = brew->currentPhase;
+        snapshot.target = brew->target;
+        snapshot.brewPhase = phase.phase == PhaseType::PHASE_TYPE_BREW;
+        snapshot.phaseVolumetric = phase.hasVolumetricTarget();
+        snapshot.phaseVolumetricTarget = phase.getVolumetricTarget().value;
+        snapshot.setPhaseName(phase.name.c_str());
+        snapshot.advancedPump = brew->isAdvancedPump();
+        snapshot.pumpPressure = brew->getPumpPressure();
+        snapshot.currentVolume = brew->currentVolume;
+        snapshot.brewVolume = brew->getBrewVolume();
+        snapshot.processStarted = brew->processStarted;
+        snapshot.currentPhaseStarted = brew->currentPhaseStarted;
+        snapshot.finished = brew->finished;
+        snapshot.phaseDuration = brew->getPhaseDuration();
+        snapshot.totalDuration = brew->getTotalDuration();
+    }
+    processSnapshot.write(snapshot);
 }
 
 void Controller::activate() {
@@ -520,7 +585,7 @@ void Controller::activate() {
 #else
         currentVolumetricSource = VolumetricMeasurementSource::BLUETOOTH;
 #endif
-        pluginManager->trigger("controller:brew:prestart");
+        pluginManager->trigger(EventId::CONTROLLER_BREW_PRESTART);
     }
     delay(200);
     switch (mode) {
@@ -539,7 +604,7 @@ void Controller::activate() {
     default:;
     }
     if (currentProcess->getType() == MODE_BREW) {
-        pluginManager->trigger("controller:brew:start");
+        pluginManager->trigger(EventId::CONTROLLER_BREW_START);
     }
 }
 
@@ -551,18 +616,18 @@ void Controller::deactivate() {
     lastProcess = currentProcess;
     currentProcess = nullptr;
     if (lastProcess->getType() == MODE_BREW) {
-        pluginManager->trigger("controller:brew:end");
+        pluginManager->trigger(EventId::CONTROLLER_BREW_END);
     } else if (lastProcess->getType() == MODE_GRIND) {
-        pluginManager->trigger("controller:grind:end");
+        pluginManager->trigger(EventId::CONTROLLER_GRIND_END);
     }
-    pluginManager->trigger("controller:process:end");
+    pluginManager->trigger(EventId::CONTROLLER_PROCESS_END);
     updateLastAction();
 }
 
 void Controller::clear() {
     processCompleted = true;
     if (lastProcess != nullptr && lastProcess->getType() == MODE_BREW) {
-        pluginManager->trigger("controller:brew:clear");
+        pluginManager->trigger(EventId::CONTROLLER_BREW_CLEAR);
     }
     delete lastProcess;
     lastProcess = nullptr;
@@ -570,7 +635,7 @@ void Controller::clear() {
 }
 
 void Controller::activateGrind() {
-    pluginManager->trigger("controller:grind:start");
+    pluginManager->trigger(EventId::CONTROLLER_GRIND_START);
     if (isGrindActive())
         return;
     clear();
@@ -606,17 +671,29 @@ int Controller::getMode() const { return mode; }
 
 void Controller::setMode(int newMode) {
     steamReady = false;
-    Event modeEvent = pluginManager->trigger("controller:mode:change", "value", newMode);
+    Event modeEvent = pluginManager->trigger(EventId::CONTROLLER_MODE_CHANGE, "value", newMode);
     mode = modeEvent.getInt("value");
 
     updateLastAction();
     setTargetTemp(getTargetTemp());
 }
 
+void Controller::onSensorRead(float temperature, float pressure, float puckFlow, float pumpFlow, float puckResistance) {
+    onTempRead(temperature);
+    this->pressure = pressure;
+    this->currentPuckFlow = puckFlow;
+    this->currentPumpFlow = pumpFlow;
+    // Listeners run on the plugin dispatch task so they never delay the BLE callback
+    pluginManager->post(EventId::BOILER_PRESSURE_CHANGE, "value", pressure, EventPriority::TELEMETRY);
+    pluginManager->post(EventId::PUMP_PUCK_FLOW_CHANGE, "value", puckFlow, EventPriority::TELEMETRY);
+    pluginManager->post(EventId::PUMP_FLOW_CHANGE, "value", pumpFlow, EventPriority::TELEMETRY);
+    pluginManager->post(EventId::PUMP_PUCK_RESISTANCE_CHANGE, "value", puckResistance, EventPriority::TELEMETRY);
+}
+
 void Controller::onTempRead(float temperature) {
     float temp = temperature - static_cast<float>(settings.getTemperatureOffset());
-    Event event = pluginManager->trigger("boiler:currentTemperature:change", "value", temp);
-    currentTemp = event.getFloat("value");
+    currentTemp = temp;
+    pluginManager->post(EventId::BOILER_CURRENT_TEMPERATURE_CHANGE, "value", temp, EventPriority::TELEMETRY);
 }
 
 void Controller::updateLastAction() { lastAction = millis(); }
@@ -627,10 +704,9 @@ void Controller::onOTAUpdate() {
 }
 
 void Controller::onVolumetricMeasurement(double measurement, VolumetricMeasurementSource source) {
-    pluginManager->trigger(source == VolumetricMeasurementSource::FLOW_ESTIMATION
-                               ? F("controller:volumetric-measurement:estimation:change")
-                               : F("controller:volumetric-measurement:bluetooth:change"),
-                           "value", static_cast<float>(measurement));
+    EventId eventId = source == VolumetricMeasurementSource::FLOW_ESTIMATION ? EventId::CONTROLLER_VOLUMETRIC_ESTIMATION_CHANGE
+                                                                             : EventId::CONTROLLER_VOLUMETRIC_BLUETOOTH_CHANGE;
+    pluginManager->post(eventId, "value", static_cast<float>(measurement), EventPriority::TELEMETRY);
     if (source == VolumetricMeasurementSource::BLUETOOTH) {
         lastBluetoothMeasurement = millis();
     }
@@ -657,8 +733,8 @@ void Controller::onFlush() {
         return;
     }
     clear();
-    startProcess(new BrewProcess(FLUSH_PROFILE, ProcessTarget::TIME, settings.getBrewDelay()));
-    pluginManager->trigger("controller:brew:start");
+    startProcess(new BrewProcess(std::make_shared<const Profile>(FLUSH_PROFILE), ProcessTarget::TIME, settings.getBrewDelay()));
+    pluginManager->trigger(EventId::CONTROLLER_BREW_START);
 }
 
 void Controller::handleBrewButton(int brewButtonStatus) {
@@ -721,7 +797,7 @@ void Controller::handleSteamButton(int steamButtonStatus) {
 }
 
 void Controller::handleProfileUpdate() {
-    pluginManager->trigger("boiler:targetTemperature:change", "value", profileManager->getSelectedProfile().temperature);
+    pluginManager->trigger(EventId::BOILER_TARGET_TEMPERATURE_CHANGE, "value", profileManager->getSelectedProfile()->temperature);
 }
 
 void Controller::loopTask(void *arg) {
@@ -4,10 +4,13 @@
 #include "NimBLEClientController.h"
 #include "NimBLEComm.h"
 #include "PluginManager.h"
+#include "SensorSampleBuffer.h"
+#include "SeqLock.h"
 #include "Settings.h"
 #include <WiFi.h>
 #include <display/core/ProfileManager.h>
 #include <display/core/process/Process.h>
+#include <display/core/process/ProcessSnapshot.h>
 #ifndef GAGGIMATE_HEADLESS
 #include <display/ui/default/DefaultUI.h>
 #endif
@@ -52,11 +55,12 @@ class Controller {
     virtual float getCurrentPressure() const { return pressure; }
     virtual float getCurrentPuckFlow() const { return currentPuckFlow; }
     virtual float getCurrentPumpFlow() const { return currentPumpFlow; }
+    const SensorSampleBuffer &getSensorSamples() const { return sensorSamples; }
 
     void autotune(int testTime, int samples);
     void startProcess(Process *process);
-    Process *getProcess() const { return currentProcess; }
-    Process *getLastProcess() const { return lastProcess; }
+    // Consistent copy of the running or last process, safe to take from any task
+    ProcessSnapshot getProcessSnapshot() const { return processSnapshot.read(); }
     Settings &getSettings() { return settings; }
     ProfileManager *getProfileManager() { return profileManager; }
 #ifndef GAGGIMATE_HEADLESS
@@ -108,9 +112,11 @@ class Controller {
 
     // Functional methods
     void updateControl();
+    void publishProcessSnapshot();
 
     // Event handlers
     void onTempRead(float temperature);
+    void onSensorRead(float temperature, float pressure, float puckFlow, float pumpFlow, float puckResistance);
 
     // brew button
     void handleBrewButton(int brewButtonStatus);
@@ -137,11 +143,13 @@ class Controller {
     float currentPumpFlow = 0.0f;
     float targetFlow = 0.0f;
     int tofDistance = 0;
+    SensorSampleBuffer sensorSamples;
 
     SystemInfo systemInfo{};
 
     Process *currentProcess = nullptr;
     Process *lastProcess = nullptr;
+    SeqLock<ProcessSnapshot> processSnapshot; // written by loop() only
 
     unsigned long grindActiveUntil = 0;
     unsigned long lastPing = 0;
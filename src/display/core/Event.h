@@ -2,64 +2,156 @@
 #define EVENT_H
 
 #include <Arduino.h>
-#include <vector>
-
-enum class EventDataType { EVENT_TYPE_INT, EVENT_TYPE_FLOAT, EVENT_TYPE_STRING, EVENT_TYPE_NONE };
-
+#include <array>
+#include <cstring>
+
+// Events known at compile time. The enumerator is the interned id, the string is the name used by on("...") subscribers.
+#define EVENT_LIST(X)                                                                                                            \
+    X(SYSTEM_DUMMY, "system:dummy")                                                                                              \
+    X(CONTROLLER_STARTUP, "controller:startup")                                                                                  \
+    X(CONTROLLER_READY, "controller:ready")                                                                                      \
+    X(CONTROLLER_ERROR, "controller:error")                                                                                      \
+    X(CONTROLLER_BLUETOOTH_INIT, "controller:bluetooth:init")                                                                    \
+    X(CONTROLLER_BLUETOOTH_CONNECT, "controller:bluetooth:connect")                                                              \
+    X(CONTROLLER_WIFI_CONNECT, "controller:wifi:connect")                                                                        \
+    X(CONTROLLER_WIFI_DISCONNECT, "controller:wifi:disconnect")                                                                  \
+    X(CONTROLLER_MODE_CHANGE, "controller:mode:change")                                                                          \
+    X(CONTROLLER_PROCESS_START, "controller:process:start")                                                                      \
+    X(CONTROLLER_PROCESS_END, "controller:process:end")                                                                          \
+    X(CONTROLLER_BREW_PRESTART, "controller:brew:prestart")                                                                      \
+    X(CONTROLLER_BREW_START, "controller:brew:start")                                                                            \
+    X(CONTROLLER_BREW_END, "controller:brew:end")                                                                                \
+    X(CONTROLLER_BREW_CLEAR, "controller:brew:clear")                                                                            \
+    X(CONTROLLER_GRIND_START, "controller:grind:start")                                                                          \
+    X(CONTROLLER_GRIND_END, "controller:grind:end")                                                                              \
+    X(CONTROLLER_AUTOTUNE_START, "controller:autotune:start")                                                                    \
+    X(CONTROLLER_AUTOTUNE_RESULT, "controller:autotune:result")                                                                  \
+    X(CONTROLLER_AUTOTUNE_PROGRESS, "controller:autotune:progress")                                                              \
+    X(CONTROLLER_TARGET_DURATION_CHANGE, "controller:targetDuration:change")                                                     \
+    X(CONTROLLER_TARGET_VOLUME_CHANGE, "controller:targetVolume:change")                                                         \
+    X(CONTROLLER_GRIND_DURATION_CHANGE, "controller:grindDuration:change")                                                       \
+    X(CONTROLLER_GRIND_VOLUME_CHANGE, "controller:grindVolume:change")                                                           \
+    X(CONTROLLER_TOF_CHANGE, "controller:tof:change")                                                                            \
+    X(CONTROLLER_VOLUMETRIC_ESTIMATION_CHANGE, "controller:volumetric-measurement:estimation:change")                            \
+    X(CONTROLLER_VOLUMETRIC_BLUETOOTH_CHANGE, "controller:volumetric-measurement:bluetooth:change")                              \
+    X(BOILER_CURRENT_TEMPERATURE_CHANGE, "boiler:currentTemperature:change")                                                     \
+    X(BOILER_TARGET_TEMPERATURE_CHANGE, "boiler:targetTemperature:change")                                                       \
+    X(BOILER_PRESSURE_CHANGE, "boiler:pressure:change")                                                                          \
+    X(PUMP_FLOW_CHANGE, "pump:flow:change")                                                                                      \
+    X(PUMP_PUCK_FLOW_CHANGE, "pump:puck-flow:change")                                                                            \
+    X(PUMP_PUCK_RESISTANCE_CHANGE, "pump:puck-resistance:change")                                                                \
+    X(PROFILES_PROFILE_SAVE, "profiles:profile:save")                                                                            \
+    X(PROFILES_PROFILE_SELECT, "profiles:profile:select")                                                                        \
+    X(SETTINGS_CHANGED, "settings:changed")                                                                                      \
+    X(OTA_UPDATE_START, "ota:update:start")                                                                                      \
+    X(OTA_UPDATE_END, "ota:update:end")                                                                                          \
+    X(OTA_UPDATE_STATUS, "ota:update:status")                                                                                    \
+    X(OTA_UPDATE_PHASE, "ota:update:phase")                                                                                      \
+    X(OTA_UPDATE_PROGRESS, "ota:update:progress")                                                                                \
+    X(AUTOWAKEUP_ACTIVATED, "autowakeup:activated")                                                                              \
+    X(SYSTEM_STATS_SAMPLE, "system:stats:sample")                                                                                \
+    X(SMARTGRIND_RELAY_RESULT, "smartgrind:relay:result")
+
+#define EVENT_ID_ENUM(id, name) id,
+#define EVENT_ID_NAME(id, name) name,
+
+enum class EventId : uint8_t { EVENT_LIST(EVENT_ID_ENUM) COUNT };
+
+constexpr size_t EVENT_COUNT = static_cast<size_t>(EventId::COUNT);
+constexpr const char *EVENT_NAMES[EVENT_COUNT] = {EVENT_LIST(EVENT_ID_NAME)};
+
+#undef EVENT_ID_ENUM
+#undef EVENT_ID_NAME
+
+// Name of a compile time event, nullptr for ids interned at runtime
+inline const char *eventName(EventId id) {
+    return static_cast<size_t>(id) < EVENT_COUNT ? EVENT_NAMES[static_cast<size_t>(id)] : nullptr;
+}
+
+constexpr size_t EVENT_MAX_ENTRIES = 2;
+constexpr size_t EVENT_STRING_CAPACITY = 40; // fits profile UUIDs
+
+enum class EventDataType { EVENT_TYPE_INT, EVENT_TYPE_FLOAT, EVENT_TYPE_STRING, EVENT_TYPE_POINTER, EVENT_TYPE_NONE };
+
+// Keys are expected to be string literals, only the pointer is stored
 struct EventDataEntry {
-    String key;
+    const char *key = nullptr;
     EventDataType type = EventDataType::EVENT_TYPE_NONE;
-    int intValue = 0;
-    float floatValue = 0.0f;
-    String stringValue = "";
-
-    EventDataEntry() = default;
+    union {
+        int intValue = 0;
+        float floatValue;
+        const void *pointerValue;
+    };
+};
 
-    EventDataEntry(const String &k, int value) : key(k), type(EventDataType::EVENT_TYPE_INT), intValue(value) {}
+// Fixed capacity event payload, creating and dispatching an event never allocates.
+// At most EVENT_MAX_ENTRIES values and one string of up to EVENT_STRING_CAPACITY - 1 characters.
+struct Event {
+    EventId id = EventId::SYSTEM_DUMMY;
+    std::array<EventDataEntry, EVENT_MAX_ENTRIES> data{};
+    uint8_t dataCount = 0;
+    char stringValue[EVENT_STRING_CAPACITY] = {};
+    bool stopPropagation = false;
 
-    EventDataEntry(const String &k, float value) : key(k), type(EventDataType::EVENT_TYPE_FLOAT), floatValue(value) {}
+    const char *name() const { return eventName(id); }
 
-    EventDataEntry(const String &k, const String &value) : key(k), type(EventDataType::EVENT_TYPE_STRING), stringValue(value) {}
-};
+    void setInt(const char *key, int value) { set(key, EventDataType::EVENT_TYPE_INT).intValue = value; }
 
-using EventData = std::vector<EventDataEntry>;
+    void setFloat(const char *key, float value) { set(key, EventDataType::EVENT_TYPE_FLOAT).floatValue = value; }
 
-struct Event {
-    String id;
-    EventData data;
-    bool stopPropagation = false;
+    void setPointer(const char *key, const void *value) { set(key, EventDataType::EVENT_TYPE_POINTER).pointerValue = value; }
 
-    void setInt(const String &key, int value) { data.emplace_back(key, value); }
+    void setString(const char *key, const char *value) {
+        strncpy(stringValue, value, sizeof(stringValue) - 1);
+        stringValue[sizeof(stringValue) - 1] = '\0';
+        set(key, EventDataType::EVENT_TYPE_STRING);
+    }
 
-    void setFloat(const String &key, float value) { data.emplace_back(key, value); }
+    int getInt(const char *key) const {
+        const EventDataEntry *entry = find(key, EventDataType::EVENT_TYPE_INT);
+        return entry ? entry->intValue : 0;
+    }
 
-    void setString(const String &key, const String &value) { data.emplace_back(key, value); }
+    float getFloat(const char *key) const {
+        const EventDataEntry *entry = find(key, EventDataType::EVENT_TYPE_FLOAT);
+        return entry ? entry->floatValue : 0.0f;
+    }
 
-    int getInt(const String &key) const {
-        for (const auto &entry : data) {
-            if (entry.key == key && entry.type == EventDataType::EVENT_TYPE_INT) {
-                return entry.intValue;
-            }
-        }
-        return 0;
+    const void *getPointer(const char *key) const {
+        const EventDataEntry *entry = find(key, EventDataType::EVENT_TYPE_POINTER);
+        return entry ? entry->pointerValue : nullptr;
     }
 
-    float getFloat(const String &key) const {
-        for (const auto &entry : data) {
-            if (entry.key == key && entry.type == EventDataType::EVENT_TYPE_FLOAT) {
-                return entry.floatValue;
+    const char *getCString(const char *key) const { return find(key, EventDataType::EVENT_TYPE_STRING) ? stringValue : ""; }
+
+    String getString(const char *key) const { return String(getCString(key)); }
+
+  private:
+    // Listeners may overwrite a value, the last entry is reused once the payload is full
+    EventDataEntry &set(const char *key, EventDataType type) {
+        size_t index = 0;
+        while (index < dataCount && strcmp(data[index].key, key) != 0) {
+            index++;
+        }
+        if (index == dataCount) {
+            if (dataCount < EVENT_MAX_ENTRIES) {
+                dataCount++;
+            } else {
+                index = EVENT_MAX_ENTRIES - 1;
             }
         }
-        return 0.0f;
+        data[index].key = key;
+        data[index].type = type;
+        return data[index];
     }
 
-    String getString(const String &key) const {
-        for (const auto &entry : data) {
-            if (entry.key == key && entry.type == EventDataType::EVENT_TYPE_STRING) {
-                return entry.stringValue;
+    const EventDataEntry *find(const char *key, EventDataType type) const {
+        for (size_t i = 0; i < dataCount; i++) {
+            if (data[i].type == type && strcmp(data[i].key, key) == 0) {
+                return &data[i];
             }
         }
-        return "";
+        return nullptr;
     }
 };
 
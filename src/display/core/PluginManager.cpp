@@ -4,12 +4,14 @@ void PluginManager::registerPlugin(Plugin *plugin) { plugins.push_back(plugin);
 
 void PluginManager::setup(Controller *controller) {
     ESP_LOGV("PluginManager", "Setting up PluginManager");
-    on("system:dummy", [](const Event &) {
-        // Register a dummy event so the event map is initialized properly
-    });
+    controlQueue = xQueueCreate(EVENT_QUEUE_LENGTH, sizeof(Event));
+    uiQueue = xQueueCreate(EVENT_QUEUE_LENGTH, sizeof(Event));
+    telemetryQueue = xQueueCreate(EVENT_COALESCE_SLOTS, sizeof(uint8_t));
     for (const auto &plugin : plugins) {
         plugin->setup(controller, this);
     }
+    xTaskCreatePinnedToCore(dispatchTask, "PluginManager::dispatch", configMINIMAL_STACK_SIZE * 8, this, 1,
+                            &dispatchTaskHandle, 0);
     initialized = true;
 }
 
@@ -21,19 +23,21 @@ void PluginManager::loop() {
     }
 }
 
-void PluginManager::on(const String &eventId, const EventCallback &callback) {
-    ESP_LOGV("PluginManager", "Registering listener: %s", eventId.c_str());
-    listeners[std::string(eventId.c_str())].push_back(callback);
+void PluginManager::on(EventId eventId, const EventCallback &callback) {
+    if (static_cast<size_t>(eventId) >= EVENT_ID_CAPACITY) {
+        return;
+    }
+    listeners[static_cast<size_t>(eventId)].push_back(callback);
 }
 
-Event PluginManager::trigger(const String &eventId) {
+Event PluginManager::trigger(EventId eventId) {
     Event event;
     event.id = eventId;
     trigger(event);
     return event;
 }
 
-Event PluginManager::trigger(const String &eventId, const String &key, const String &value) {
+Event PluginManager::trigger(EventId eventId, const char *key, const char *value) {
     Event event;
     event.id = eventId;
     event.setString(key, value);
@@ -41,7 +45,7 @@ Event PluginManager::trigger(const String &eventId, const String &key, const Str
     return event;
 }
 
-Event PluginManager::trigger(const String &eventId, const String &key, const int value) {
+Event PluginManager::trigger(EventId eventId, const char *key, const int value) {
     Event event;
     event.id = eventId;
     event.setInt(key, value);
@@ -49,7 +53,7 @@ Event PluginManager::trigger(const String &eventId, const String &key, const int
     return event;
 }
 
-Event PluginManager::trigger(const String &eventId, const String &key, const float value) {
+Event PluginManager::trigger(EventId eventId, const char *key, const float value) {
     Event event;
     event.id = eventId;
     event.setFloat(key, value);
@@ -58,13 +62,157 @@ Event PluginManager::trigger(const String &eventId, const String &key, const flo
 }
 
 void PluginManager::trigger(Event &event) {
-    ESP_LOGV("PluginManager", "Triggering event: %s", event.id.c_str());
-    if (listeners.count(std::string(event.id.c_str()))) {
-        for (auto const &callback : listeners[std::string(event.id.c_str())]) {
-            callback(event);
-            if (event.stopPropagation) {
-                break;
+    if (static_cast<size_t>(event.id) >= EVENT_ID_CAPACITY) {
+        return;
+    }
+    for (auto const &callback : listeners[static_cast<size_t>(event.id)]) {
+        callback(event);
+        if (event.stopPropagation) {
+            break;
+        }
+    }
+}
+
+void PluginManager::post(const Event &event, EventPriority priority) {
+    if (dispatchTaskHandle == nullptr) {
+        Event copy = event;
+        trigger(copy);
+        return;
+    }
+
+    bool queued = false;
+    if (priority == EventPriority::TELEMETRY) {
+        // Overwrite the pending value for this id, only enqueue the slot when it was not pending yet
+        int slot = -1;
+        bool enqueue = false;
+        portENTER_CRITICAL(&coalesceLock);
+        for (size_t i = 0; i < coalesceSlots.size() && slot < 0; i++) {
+            if (coalesceSlots[i].id == event.id || coalesceSlots[i].id == EVENT_ID_NONE) {
+                slot = static_cast<int>(i);
+            }
+        }
+        if (slot >= 0) {
+            CoalesceSlot &entry = coalesceSlots[slot];
+            entry.id = event.id;
+            entry.event = event;
+            enqueue = !entry.pending;
+            entry.pending = true;
+        }
+        portEXIT_CRITICAL(&coalesceLock);
+
+        if (slot < 0) {
+            queued = xQueueSend(uiQueue, &event, 0) == pdTRUE;
+        } else if (enqueue) {
+            auto index = static_cast<uint8_t>(slot);
+            queued = xQueueSend(telemetryQueue, &index, 0) == pdTRUE;
+            if (!queued) {
+                portENTER_CRITICAL(&coalesceLock);
+                coalesceSlots[slot].pending = false;
+                portEXIT_CRITICAL(&coalesceLock);
             }
+        } else {
+            queued = true;
+        }
+    } else {
+        queued = xQueueSend(priority == EventPriority::CONTROL ? controlQueue : uiQueue, &event, 0) == pdTRUE;
+    }
+
+    if (!queued) {
+        droppedEvents++;
+        ESP_LOGV("PluginManager", "Event queue full, dropped event %u", static_cast<unsigned>(event.id));
+        return;
+    }
+    xTaskNotifyGive(dispatchTaskHandle);
+}
+
+void PluginManager::post(EventId eventId, const char *key, float value, EventPriority priority) {
+    Event event;
+    event.id = eventId;
+    event.setFloat(key, value);
+    post(event, priority);
+}
+
+void PluginManager::post(EventId eventId, const char *key, int value, EventPriority priority) {
+    Event event;
+    event.id = eventId;
+    event.setInt(key, value);
+    post(event, priority);
+}
+
+bool PluginManager::dispatchNext() {
+    Event event;
+    if (xQueueReceive(controlQueue, &event, 0) == pdTRUE || xQueueReceive(uiQueue, &event, 0) == pdTRUE) {
+        trigger(event);
+        return true;
+    }
+    uint8_t slot;
+    if (xQueueReceive(telemetryQueue, &slot, 0) == pdTRUE) {
+        portENTER_CRITICAL(&coalesceLock);
+        event = coalesceSlots[slot].event;
+        coalesceSlots[slot].pending = false;
+        portEXIT_CRITICAL(&coalesceLock);
+        trigger(event);
+        return true;
+    }
+    return false;
+}
+
+void PluginManager::dispatchTask(void *arg) {
+    auto *manager = static_cast<PluginManager *>(arg);
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        // Higher priority queues are checked again before every event
+        while (manager->dispatchNext()) {
+        }
+    }
+}
+
+void PluginManager::on(const String &eventId, const EventCallback &callback) {
+    ESP_LOGV("PluginManager", "Registering listener: %s", eventId.c_str());
+    on(intern(eventId.c_str()), callback);
+}
+
+Event PluginManager::trigger(const String &eventId) { return trigger(intern(eventId.c_str())); }
+
+Event PluginManager::trigger(const String &eventId, const String &key, const String &value) {
+    return trigger(intern(eventId.c_str()), internKey(key), value.c_str());
+}
+
+Event PluginManager::trigger(const String &eventId, const String &key, const int value) {
+    return trigger(intern(eventId.c_str()), internKey(key), value);
+}
+
+Event PluginManager::trigger(const String &eventId, const String &key, const float value) {
+    return trigger(intern(eventId.c_str()), internKey(key), value);
+}
+
+EventId PluginManager::intern(const char *name) {
+    for (size_t i = 0; i < EVENT_COUNT; i++) {
+        if (strcmp(EVENT_NAMES[i], name) == 0) {
+            return static_cast<EventId>(i);
+        }
+    }
+    for (size_t i = 0; i < dynamicNames.size(); i++) {
+        if (dynamicNames[i] == name) {
+            return static_cast<EventId>(EVENT_COUNT + i);
+        }
+    }
+    if (dynamicNames.size() >= EVENT_DYNAMIC_CAPACITY) {
+        ESP_LOGE("PluginManager", "No room to register event %s", name);
+        return EVENT_ID_NONE;
+    }
+    ESP_LOGV("PluginManager", "Registering runtime event: %s", name);
+    dynamicNames.emplace_back(name);
+    return static_cast<EventId>(EVENT_COUNT + dynamicNames.size() - 1);
+}
+
+// Event payloads only store key pointers, keys passed as String are kept here for the lifetime of the manager
+const char *PluginManager::internKey(const String &key) {
+    for (const std::string &known : dynamicKeys) {
+        if (key == known.c_str()) {
+            return known.c_str();
         }
     }
+    dynamicKeys.emplace_back(key.c_str());
+    return dynamicKeys.back().c_str();
 }
@@ -3,13 +3,27 @@
 #include "Event.h"
 #include "Plugin.h"
 
+#include <array>
+#include <deque>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
 #include <functional>
-#include <map>
 #include <string>
 #include <vector>
 
 using EventCallback = std::function<void(Event &)>;
 
+constexpr size_t EVENT_DYNAMIC_CAPACITY = 16; // names outside EVENT_LIST that can be interned at runtime
+constexpr size_t EVENT_ID_CAPACITY = EVENT_COUNT + EVENT_DYNAMIC_CAPACITY;
+constexpr auto EVENT_ID_NONE = static_cast<EventId>(0xFF);
+
+constexpr size_t EVENT_QUEUE_LENGTH = 16;    // per priority class
+constexpr size_t EVENT_COALESCE_SLOTS = 12; // distinct telemetry events pending at once
+
+// Delivery order for posted events. Telemetry events are coalesced per id, only the latest value is delivered.
+enum class EventPriority : uint8_t { CONTROL, UI, TELEMETRY };
+
 class Controller;
 class PluginManager {
   public:
@@ -18,18 +32,56 @@ class PluginManager {
     void setup(Controller *controller);
     void loop();
 
-    void on(const String &eventId, const EventCallback &callback);
+    void on(EventId eventId, const EventCallback &callback);
+
+    Event trigger(EventId eventId);
+    Event trigger(EventId eventId, const char *key, const char *value);
+    Event trigger(EventId eventId, const char *key, const String &value) { return trigger(eventId, key, value.c_str()); }
+    Event trigger(EventId eventId, const char *key, int value);
+    Event trigger(EventId eventId, const char *key, float value);
+    void trigger(Event &event);
+
+    // Queues the event for the dispatch task and returns immediately, listeners run on that task. Events are dropped
+    // when their queue is full. Before setup() has started the dispatch task this dispatches synchronously.
+    void post(const Event &event, EventPriority priority);
+    void post(EventId eventId, const char *key, float value, EventPriority priority);
+    void post(EventId eventId, const char *key, int value, EventPriority priority);
+    uint32_t getDroppedEvents() const { return droppedEvents; }
 
+    // Compatibility with events identified by name, the name is interned once and dispatched by id
+    void on(const String &eventId, const EventCallback &callback);
     Event trigger(const String &eventId);
     Event trigger(const String &eventId, const String &key, const String &value);
     Event trigger(const String &eventId, const String &key, int value);
     Event trigger(const String &eventId, const String &key, float value);
-    void trigger(Event &event);
+
+    // Returns the id for an event name, registering names outside EVENT_LIST. Returns EVENT_ID_NONE when full.
+    EventId intern(const char *name);
 
   private:
     bool initialized = false;
     std::vector<Plugin *> plugins;
-    std::map<std::string, std::vector<EventCallback>> listeners = {};
+    std::array<std::vector<EventCallback>, EVENT_ID_CAPACITY> listeners = {};
+    const char *internKey(const String &key);
+    bool dispatchNext();
+    [[noreturn]] static void dispatchTask(void *arg);
+
+    struct CoalesceSlot {
+        EventId id = EVENT_ID_NONE;
+        bool pending = false;
+        Event event;
+    };
+
+    TaskHandle_t dispatchTaskHandle = nullptr;
+    QueueHandle_t controlQueue = nullptr;
+    QueueHandle_t uiQueue = nullptr;
+    QueueHandle_t telemetryQueue = nullptr; // indices into coalesceSlots
+    std::array<CoalesceSlot, EVENT_COALESCE_SLOTS> coalesceSlots{};
+    portMUX_TYPE coalesceLock = portMUX_INITIALIZER_UNLOCKED;
+    volatile uint32_t droppedEvents = 0;
+
+    std::vector<std::string> dynamicNames;
+    std::deque<std::string> dynamicKeys; // deque keeps the c_str() pointers stored in events valid
 };
 
 #endif // PLUGINMANAGER_H
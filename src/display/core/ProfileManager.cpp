@@ -8,11 +8,15 @@ ProfileManager::ProfileManager(fs::FS &fs, String dir, Settings &settings, Plugi
 
 void ProfileManager::setup() {
     ensureDirectory();
-    auto profiles = listProfiles();
-    if (!_settings.isProfilesMigrated() || profiles.empty() || !loadSelectedProfile(selectedProfile)) {
+    loadProfiles();
+    if (!_settings.isProfilesMigrated() || listProfiles().empty() || !profileExists(_settings.getSelectedProfile())) {
         migrate();
         _settings.setProfilesMigrated(true);
-        loadSelectedProfile(selectedProfile);
+    }
+    ProfileRef selected = getProfile(_settings.getSelectedProfile());
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        selectedProfile = selected ? selected : std::make_shared<const Profile>();
     }
     _settings.setFavoritedProfiles(getFavoritedProfiles(true));
 }
@@ -32,7 +36,7 @@ void ProfileManager::migrate() {
     profile.label = "Default";
     profile.description = "Default profile generated from previous settings";
     profile.temperature = _settings.getTargetBrewTemp();
-    profile.type = "standard";
+    profile.type = ProfileType::PROFILE_TYPE_STANDARD;
     if (_settings.getPressurizeTime() > 0) {
         Phase pressurizePhase1{};
         pressurizePhase1.name = "Pressurize";
@@ -91,21 +95,54 @@ void ProfileManager::migrate() {
     _settings.addFavoritedProfile(profile.id);
 }
 
+void ProfileManager::loadProfiles() {
+    std::map<String, ProfileRef> loaded;
+    File root = _fs.open(_dir);
+    if (root && root.isDirectory()) {
+        File file = root.openNextFile();
+        while (file) {
+            String name = file.name();
+            if (name.endsWith(".json")) {
+                int start = name.lastIndexOf('/') + 1;
+                int end = name.lastIndexOf('.');
+                String uuid = name.substring(start, end);
+                auto profile = std::make_shared<Profile>();
+                if (readProfile(file, *profile)) {
+                    loaded[uuid] = std::move(profile);
+                } else {
+                    ESP_LOGW("ProfileManager", "Skipping unreadable profile %s", uuid.c_str());
+                }
+            }
+            file = root.openNextFile();
+        }
+    }
+    ESP_LOGI("ProfileManager", "Loaded %u profiles", static_cast<unsigned>(loaded.size()));
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    profiles = std::move(loaded);
+    generation++;
+}
+
+// Parses a profile file into the cached form. selected and favorite depend on the settings and are filled in by
+// loadProfile instead.
+bool ProfileManager::readProfile(File &file, Profile &outProfile) const {
+    JsonDocument doc;
+    DeserializationError err = deserializeJson(doc, file);
+    if (err || !parseProfile(doc.as<JsonObject>(), outProfile)) {
+        return false;
+    }
+    outProfile.selected = false;
+    outProfile.favorite = false;
+    return true;
+}
+
 std::vector<String> ProfileManager::listProfiles() {
     std::vector<String> uuids;
-    File root = _fs.open(_dir);
-    if (!root || !root.isDirectory())
-        return uuids;
-
-    File file = root.openNextFile();
-    while (file) {
-        String name = file.name();
-        if (name.endsWith(".json")) {
-            int start = name.lastIndexOf('/') + 1;
-            int end = name.lastIndexOf('.');
-            uuids.push_back(name.substring(start, end));
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        uuids.reserve(profiles.size());
+        for (auto const &entry : profiles) {
+            uuids.push_back(entry.first);
         }
-        file = root.openNextFile();
     }
 
     std::vector<String> ordered;
@@ -124,20 +161,18 @@ std::vector<String> ProfileManager::listProfiles() {
     return ordered;
 }
 
-bool ProfileManager::loadProfile(const String &uuid, Profile &outProfile) {
-    File file = _fs.open(profilePath(uuid), "r");
-    if (!file)
-        return false;
+ProfileRef ProfileManager::getProfile(const String &uuid) const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = profiles.find(uuid);
+    return it != profiles.end() ? it->second : nullptr;
+}
 
-    JsonDocument doc;
-    DeserializationError err = deserializeJson(doc, file);
-    file.close();
-    if (err)
+bool ProfileManager::loadProfile(const String &uuid, Profile &outProfile) {
+    ProfileRef profile = getProfile(uuid);
+    if (!profile)
         return false;
 
-    if (!parseProfile(doc.as<JsonObject>(), outProfile)) {
-        return false;
-    }
+    outProfile = *profile;
     outProfile.selected = outProfile.id == _settings.getSelectedProfile();
     std::vector<String> favoritedProfiles = _settings.getFavoritedProfiles();
     outProfile.favorite = std::find(favoritedProfiles.begin(), favoritedProfiles.end(), outProfile.id) != favoritedProfiles.end();
@@ -166,12 +201,16 @@ bool ProfileManager::saveProfile(Profile &profile) {
 
     bool ok = serializeJson(doc, file) > 0;
     file.close();
-    if (profile.id == selectedProfile.id) {
-        selectedProfile = Profile{};
-        loadSelectedProfile(selectedProfile);
+    if (ok) {
+        auto cached = std::make_shared<Profile>(profile);
+        cached->selected = false;
+        cached->favorite = false;
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        profiles[profile.id] = std::move(cached);
+        generation++;
     }
     selectProfile(_settings.getSelectedProfile());
-    _plugin_manager->trigger("profiles:profile:save", "id", profile.id);
+    _plugin_manager->trigger(EventId::PROFILES_PROFILE_SAVE, "id", profile.id);
     if (isNew) {
         _settings.addFavoritedProfile(profile.id);
     }
@@ -180,20 +219,40 @@ bool ProfileManager::saveProfile(Profile &profile) {
 
 bool ProfileManager::deleteProfile(const String &uuid) {
     _settings.removeFavoritedProfile(uuid);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        profiles.erase(uuid);
+        generation++;
+    }
     return _fs.remove(profilePath(uuid));
 }
 
-bool ProfileManager::profileExists(const String &uuid) { return _fs.exists(profilePath(uuid)); }
+bool ProfileManager::profileExists(const String &uuid) {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return profiles.find(uuid) != profiles.end();
+}
 
 void ProfileManager::selectProfile(const String &uuid) {
     ESP_LOGI("ProfileManager", "Selecting profile %s", uuid.c_str());
     _settings.setSelectedProfile(uuid);
-    selectedProfile = Profile{};
-    loadSelectedProfile(selectedProfile);
-    _plugin_manager->trigger("profiles:profile:select", "id", uuid);
+    ProfileRef profile = getProfile(uuid);
+    {
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        selectedProfile = profile ? profile : std::make_shared<const Profile>();
+        generation++;
+    }
+    _plugin_manager->trigger(EventId::PROFILES_PROFILE_SELECT, "id", uuid);
+}
+
+ProfileRef ProfileManager::getSelectedProfile() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return selectedProfile;
 }
 
-Profile ProfileManager::getSelectedProfile() const { return selectedProfile; }
+uint32_t ProfileManager::getGeneration() const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    return generation;
+}
 
 bool ProfileManager::loadSelectedProfile(Profile &outProfile) { return loadProfile(_settings.getSelectedProfile(), outProfile); }
 
@@ -6,31 +6,47 @@
 #include <display/core/Settings.h>
 #include <display/core/utils.h>
 #include <display/models/profile.h>
+#include <map>
+#include <mutex>
 
+// Parsed profiles are handed out as shared read only ProfileRefs. A reference stays valid after the profile is saved again
+// or deleted, it then simply describes the old version.
 class ProfileManager {
   public:
     ProfileManager(fs::FS &fs, String dir, Settings &settings, PluginManager *plugin_manager);
 
     void setup();
     std::vector<String> listProfiles();
+    ProfileRef getProfile(const String &uuid) const;
     bool loadProfile(const String &uuid, Profile &outProfile);
     bool saveProfile(Profile &profile);
     bool deleteProfile(const String &uuid);
     bool profileExists(const String &uuid);
     void selectProfile(const String &uuid);
-    Profile getSelectedProfile() const;
+    ProfileRef getSelectedProfile() const;
     bool loadSelectedProfile(Profile &outProfile);
     std::vector<String> getFavoritedProfiles(bool validate = false);
 
+    // Incremented whenever a profile is saved, deleted or selected. Holders of a ProfileRef compare it to know when to
+    // fetch the profile again.
+    uint32_t getGeneration() const;
+
   private:
-    Profile selectedProfile{};
     PluginManager *_plugin_manager;
     Settings &_settings;
     fs::FS &_fs;
     String _dir;
     bool ensureDirectory() const;
     String profilePath(const String &uuid) const;
+    void loadProfiles();
+    bool readProfile(File &file, Profile &outProfile) const;
     void migrate();
+
+    // Every profile on the filesystem, parsed once in setup() and kept in sync by saveProfile and deleteProfile
+    mutable std::mutex cacheMutex;
+    std::map<String, ProfileRef> profiles;
+    ProfileRef selectedProfile = std::make_shared<const Profile>();
+    uint32_t generation = 0;
 };
 
 #endif // PROFILEMANAGER_H
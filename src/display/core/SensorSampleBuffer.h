@@ -0,0 +1,51 @@
+#ifndef SENSORSAMPLEBUFFER_H
+#define SENSORSAMPLEBUFFER_H
+
+#include <BinaryProtocol.h>
+#include <array>
+#include <freertos/FreeRTOS.h>
+
+constexpr size_t SENSOR_SAMPLE_BUFFER_SIZE = 128; // ~3.8 s at the 30 ms controller tick
+
+// Recent controller sensor samples, timestamps in local millis(). Written from the BLE callback and read by any number of
+// consumers on other tasks, each keeping its own cursor.
+class SensorSampleBuffer {
+  public:
+    void push(const SensorSample &sample) {
+        portENTER_CRITICAL(&lock);
+        samples[writeIndex % SENSOR_SAMPLE_BUFFER_SIZE] = sample;
+        writeIndex++;
+        portEXIT_CRITICAL(&lock);
+    }
+
+    // Index of the next sample to be written, use as the initial cursor to only read samples pushed from now on
+    uint32_t head() const {
+        portENTER_CRITICAL(&lock);
+        uint32_t index = writeIndex;
+        portEXIT_CRITICAL(&lock);
+        return index;
+    }
+
+    // Copies up to maxSamples samples starting at cursor and advances it. Readers that fell behind skip the overwritten
+    // samples.
+    size_t read(uint32_t &cursor, SensorSample *out, size_t maxSamples) const {
+        portENTER_CRITICAL(&lock);
+        if (writeIndex - cursor > SENSOR_SAMPLE_BUFFER_SIZE) {
+            cursor = writeIndex - SENSOR_SAMPLE_BUFFER_SIZE;
+        }
+        size_t count = 0;
+        while (cursor != writeIndex && count < maxSamples) {
+            out[count++] = samples[cursor % SENSOR_SAMPLE_BUFFER_SIZE];
+            cursor++;
+        }
+        portEXIT_CRITICAL(&lock);
+        return count;
+    }
+
+  private:
+    std::array<SensorSample, SENSOR_SAMPLE_BUFFER_SIZE> samples{};
+    uint32_t writeIndex = 0;
+    mutable portMUX_TYPE lock = portMUX_INITIALIZER_UNLOCKED;
+};
+
+#endif // SENSORSAMPLEBUFFER_H
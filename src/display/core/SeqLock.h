@@ -0,0 +1,50 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <type_traits>
+
+constexpr uint8_t SEQLOCK_SPINS_BEFORE_YIELD = 4;
+
+// Single writer, many reader sequence lock. The writer never blocks, readers copy the value and retry when a write was
+// in progress or happened during the copy. A reader that keeps losing delays a tick, so a writer of lower priority on the
+// same core gets to finish its write.
+template <typename T> class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied bytewise");
+
+  public:
+    void write(const T &next) {
+        const uint32_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + 1, std::memory_order_relaxed); // odd while the value is written
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&value, &next, sizeof(T));
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    T read() const {
+        T copy;
+        for (uint8_t attempt = 0;; attempt++) {
+            const uint32_t before = sequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                memcpy(&copy, &value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) {
+                    return copy;
+                }
+            }
+            if (attempt >= SEQLOCK_SPINS_BEFORE_YIELD) {
+                vTaskDelay(1);
+            }
+        }
+    }
+
+  private:
+    std::atomic<uint32_t> sequence{0};
+    T value{};
+};
+
+#endif // SEQLOCK_H
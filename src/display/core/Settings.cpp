@@ -1,6 +1,7 @@
 #include "Settings.h"
 
 #include <algorithm>
+#include <esp_timer.h>
 #include <utility>
 
 Settings::Settings() {
@@ -38,6 +39,7 @@ Settings::Settings() {
     smartGrindIp = preferences.getString("sg_i", "");
     smartGrindToggle = preferences.getBool("sg_t", false);
     smartGrindMode = preferences.getInt("sg_m", smartGrindToggle ? 1 : 0);
+    smartGrindTimeout = preferences.getInt("sg_to", DEFAULT_SMART_GRIND_TIMEOUT_MS);
     homeAssistant = preferences.getBool("ha_a", false);
     homeAssistantIP = preferences.getString("ha_i", "");
     homeAssistantPort = preferences.getInt("ha_p", 1883);
@@ -115,245 +117,214 @@ Settings::Settings() {
     xTaskCreate(loopTask, "Settings::loop", configMINIMAL_STACK_SIZE * 6, this, 1, &taskHandle);
 }
 
-void Settings::batchUpdate(const SettingsCallback &callback) {
-    callback(this);
-    save();
-}
+// Setters only mark the keys they change, the settings task writes them together with the next periodic save
+void Settings::batchUpdate(const SettingsCallback &callback) { callback(this); }
 
 void Settings::save(bool noDelay) {
     if (noDelay) {
         doSave();
-        return;
     }
-    dirty = true;
+}
+
+SettingsStats Settings::getStats() const {
+    portENTER_CRITICAL(&dirtyLock);
+    SettingsStats result = stats;
+    portEXIT_CRITICAL(&dirtyLock);
+    return result;
+}
+
+void Settings::markDirty(SettingKey key) {
+    portENTER_CRITICAL(&dirtyLock);
+    dirty.set(static_cast<size_t>(key));
+    portEXIT_CRITICAL(&dirtyLock);
 }
 
 void Settings::setTargetBrewTemp(const int target_brew_temp) {
-    targetBrewTemp = target_brew_temp;
-    save();
+    setValue(targetBrewTemp, target_brew_temp, SettingKey::TARGET_BREW_TEMP);
 }
 
 void Settings::setTargetSteamTemp(const int target_steam_temp) {
-    targetSteamTemp = target_steam_temp;
-    save();
+    setValue(targetSteamTemp, target_steam_temp, SettingKey::TARGET_STEAM_TEMP);
 }
 
 void Settings::setTargetWaterTemp(const int target_water_temp) {
-    targetWaterTemp = target_water_temp;
-    save();
+    setValue(targetWaterTemp, target_water_temp, SettingKey::TARGET_WATER_TEMP);
 }
 
 void Settings::setTemperatureOffset(const int temperature_offset) {
-    temperatureOffset = temperature_offset;
-    save();
+    setValue(temperatureOffset, temperature_offset, SettingKey::TEMPERATURE_OFFSET);
 }
 
 void Settings::setPressureScaling(const float pressure_scaling) {
-    pressureScaling = pressure_scaling;
-    save();
+    setValue(pressureScaling, pressure_scaling, SettingKey::PRESSURE_SCALING);
 }
 
 void Settings::setTargetDuration(const int target_duration) {
-    targetDuration = target_duration;
-    save();
+    setValue(targetDuration, target_duration, SettingKey::TARGET_DURATION);
 }
 
 void Settings::setTargetVolume(int target_volume) {
-    targetVolume = target_volume;
-    save();
+    setValue(targetVolume, target_volume, SettingKey::TARGET_VOLUME);
 }
 
 void Settings::setTargetGrindVolume(double target_grind_volume) {
-    targetGrindVolume = target_grind_volume;
-    save();
+    setValue(targetGrindVolume, target_grind_volume, SettingKey::TARGET_GRIND_VOLUME);
 }
 
 void Settings::setTargetGrindDuration(const int target_duration) {
-    targetGrindDuration = target_duration;
-    save();
+    setValue(targetGrindDuration, target_duration, SettingKey::TARGET_GRIND_DURATION);
 }
 
 void Settings::setBrewDelay(double brew_Delay) {
-    brewDelay = std::clamp(brew_Delay, 0.0, 4000.0);
-    save();
+    setValue(brewDelay, std::clamp(brew_Delay, 0.0, 4000.0), SettingKey::BREW_DELAY);
 }
 
 void Settings::setGrindDelay(double grind_Delay) {
-    grindDelay = std::clamp(grind_Delay, 0.0, 4000.0);
-    save();
+    setValue(grindDelay, std::clamp(grind_Delay, 0.0, 4000.0), SettingKey::GRIND_DELAY);
 }
 
 void Settings::setDelayAdjust(bool delay_adjust) {
-    delayAdjust = delay_adjust;
-    save();
+    setValue(delayAdjust, delay_adjust, SettingKey::DELAY_ADJUST);
 }
 
 void Settings::setStartupMode(const int startup_mode) {
-    startupMode = startup_mode;
-    save();
+    setValue(startupMode, startup_mode, SettingKey::STARTUP_MODE);
 }
 
 void Settings::setStandbyTimeout(int standby_timeout) {
-    standbyTimeout = standby_timeout;
-    save();
+    setValue(standbyTimeout, standby_timeout, SettingKey::STANDBY_TIMEOUT);
 }
 
 void Settings::setInfuseBloomTime(int infuse_bloom_time) {
-    infuseBloomTime = infuse_bloom_time;
-    save();
+    setValue(infuseBloomTime, infuse_bloom_time, SettingKey::INFUSE_BLOOM_TIME);
 }
 
 void Settings::setInfusePumpTime(int infuse_pump_time) {
-    infusePumpTime = infuse_pump_time;
-    save();
+    setValue(infusePumpTime, infuse_pump_time, SettingKey::INFUSE_PUMP_TIME);
 }
 
 void Settings::setPressurizeTime(int pressurize_time) {
-    pressurizeTime = pressurize_time;
-    save();
+    setValue(pressurizeTime, pressurize_time, SettingKey::PRESSURIZE_TIME);
 }
 
 void Settings::setPid(const String &pid) {
-    this->pid = pid;
-    save();
+    setValue(this->pid, pid, SettingKey::PID);
 }
 
 void Settings::setPumpModelCoeffs(const String &pumpModelCoeffs) {
-    this->pumpModelCoeffs = pumpModelCoeffs;
-    save();
+    setValue(this->pumpModelCoeffs, pumpModelCoeffs, SettingKey::PUMP_MODEL_COEFFS);
 }
 
 void Settings::setWifiSsid(const String &wifiSsid) {
-    this->wifiSsid = wifiSsid;
-    save();
+    setValue(this->wifiSsid, wifiSsid, SettingKey::WIFI_SSID);
 }
 
 void Settings::setWifiPassword(const String &wifiPassword) {
-    this->wifiPassword = wifiPassword;
-    save();
+    setValue(this->wifiPassword, wifiPassword, SettingKey::WIFI_PASSWORD);
 }
 
 void Settings::setMdnsName(const String &mdnsName) {
-    this->mdnsName = mdnsName;
-    save();
+    setValue(this->mdnsName, mdnsName, SettingKey::MDNS_NAME);
 }
 
 void Settings::setHomekit(const bool homekit) {
-    this->homekit = homekit;
-    save();
+    setValue(this->homekit, homekit, SettingKey::HOMEKIT);
 }
 
 void Settings::setVolumetricTarget(bool volumetric_target) {
-    this->volumetricTarget = volumetric_target;
-    save();
+    setValue(this->volumetricTarget, volumetric_target, SettingKey::VOLUMETRIC_TARGET);
 }
 
 void Settings::setOTAChannel(const String &otaChannel) {
-    this->otaChannel = otaChannel;
-    save();
+    setValue(this->otaChannel, otaChannel, SettingKey::OTA_CHANNEL);
 }
 
 void Settings::setSavedScale(const String &savedScale) {
-    this->savedScale = savedScale;
-    save();
+    setValue(this->savedScale, savedScale, SettingKey::SAVED_SCALE);
 }
 
 void Settings::setBoilerFillActive(bool boiler_fill_active) {
-    boilerFillActive = boiler_fill_active;
-    save();
+    setValue(boilerFillActive, boiler_fill_active, SettingKey::BOILER_FILL_ACTIVE);
 }
 
 void Settings::setStartupFillTime(int startup_fill_time) {
-    startupFillTime = startup_fill_time;
-    save();
+    setValue(startupFillTime, startup_fill_time, SettingKey::STARTUP_FILL_TIME);
 }
 
 void Settings::setSteamFillTime(int steam_fill_time) {
-    steamFillTime = steam_fill_time;
-    save();
+    setValue(steamFillTime, steam_fill_time, SettingKey::STEAM_FILL_TIME);
 }
 
 void Settings::setSmartGrindActive(bool smart_grind_active) {
-    smartGrindActive = smart_grind_active;
-    save();
+    setValue(smartGrindActive, smart_grind_active, SettingKey::SMART_GRIND_ACTIVE);
 }
 
 void Settings::setSmartGrindIp(String smart_grind_ip) {
-    this->smartGrindIp = std::move(smart_grind_ip);
-    save();
+    setValue(this->smartGrindIp, std::move(smart_grind_ip), SettingKey::SMART_GRIND_IP);
 }
 
 void Settings::setSmartGrindMode(int smart_grind_mode) {
-    this->smartGrindMode = smart_grind_mode;
-    save();
+    setValue(this->smartGrindMode, smart_grind_mode, SettingKey::SMART_GRIND_MODE);
+}
+
+void Settings::setSmartGrindTimeout(int smart_grind_timeout) {
+    setValue(this->smartGrindTimeout, smart_grind_timeout, SettingKey::SMART_GRIND_TIMEOUT);
 }
 
 void Settings::setHomeAssistant(const bool homeAssistant) {
-    this->homeAssistant = homeAssistant;
-    save();
+    setValue(this->homeAssistant, homeAssistant, SettingKey::HOME_ASSISTANT);
 }
 
 void Settings::setHomeAssistantIP(const String &homeAssistantIP) {
-    this->homeAssistantIP = homeAssistantIP;
-    save();
+    setValue(this->homeAssistantIP, homeAssistantIP, SettingKey::HOME_ASSISTANT_IP);
 }
 
 void Settings::setHomeAssistantPort(const int homeAssistantPort) {
-    this->homeAssistantPort = homeAssistantPort;
-    save();
+    setValue(this->homeAssistantPort, homeAssistantPort, SettingKey::HOME_ASSISTANT_PORT);
 }
 void Settings::setHomeAssistantTopic(const String &homeAssistantTopic) {
-    this->homeAssistantTopic = homeAssistantTopic;
-    save();
+    setValue(this->homeAssistantTopic, homeAssistantTopic, SettingKey::HOME_ASSISTANT_TOPIC);
 }
 void Settings::setHomeAssistantUser(const String &homeAssistantUser) {
-    this->homeAssistantUser = homeAssistantUser;
-    save();
+    setValue(this->homeAssistantUser, homeAssistantUser, SettingKey::HOME_ASSISTANT_USER);
 }
 void Settings::setHomeAssistantPassword(const String &homeAssistantPassword) {
-    this->homeAssistantPassword = homeAssistantPassword;
-    save();
+    setValue(this->homeAssistantPassword, homeAssistantPassword, SettingKey::HOME_ASSISTANT_PASSWORD);
 }
 
 void Settings::setMomentaryButtons(bool momentary_buttons) {
-    momentaryButtons = momentary_buttons;
-    save();
+    setValue(momentaryButtons, momentary_buttons, SettingKey::MOMENTARY_BUTTONS);
 }
 
 void Settings::setTimezone(String timezone) {
-    this->timezone = std::move(timezone);
-    save();
+    setValue(this->timezone, std::move(timezone), SettingKey::TIMEZONE);
 }
 
 void Settings::setClockFormat(bool clock_24h_format) {
-    this->clock24hFormat = clock_24h_format;
-    save();
+    setValue(this->clock24hFormat, clock_24h_format, SettingKey::CLOCK_24H_FORMAT);
 }
 
 void Settings::setSelectedProfile(String selected_profile) {
-    this->selectedProfile = std::move(selected_profile);
-    save();
+    setValue(this->selectedProfile, std::move(selected_profile), SettingKey::SELECTED_PROFILE);
 }
 
 void Settings::setProfilesMigrated(bool profiles_migrated) {
-    profilesMigrated = profiles_migrated;
-    save();
+    setValue(profilesMigrated, profiles_migrated, SettingKey::PROFILES_MIGRATED);
 }
 
 void Settings::setFavoritedProfiles(std::vector<String> favorited_profiles) {
-    favoritedProfiles = std::move(favorited_profiles);
-    save();
+    setValue(favoritedProfiles, std::move(favorited_profiles), SettingKey::FAVORITED_PROFILES);
 }
 
 void Settings::addFavoritedProfile(String profile) {
     favoritedProfiles.emplace_back(profile);
-    save();
+    markDirty(SettingKey::FAVORITED_PROFILES);
 }
 
 void Settings::removeFavoritedProfile(String profile) {
     favoritedProfiles.erase(std::remove(favoritedProfiles.begin(), favoritedProfiles.end(), profile), favoritedProfiles.end());
     favoritedProfiles.shrink_to_fit();
-    save();
+    markDirty(SettingKey::FAVORITED_PROFILES);
 }
 
 void Settings::setProfileOrder(std::vector<String> profile_order) {
@@ -367,183 +338,182 @@ void Settings::setProfileOrder(std::vector<String> profile_order) {
         }
     }
 
-    profileOrder = std::move(cleaned);
-    save();
+    setValue(profileOrder, std::move(cleaned), SettingKey::PROFILE_ORDER);
 }
 
 void Settings::setMainBrightness(int main_brightness) {
-    mainBrightness = main_brightness;
-    save();
+    setValue(mainBrightness, main_brightness, SettingKey::MAIN_BRIGHTNESS);
 }
 
 void Settings::setStandbyBrightness(int standby_brightness) {
-    standbyBrightness = standby_brightness;
-    save();
+    setValue(standbyBrightness, standby_brightness, SettingKey::STANDBY_BRIGHTNESS);
 }
 
 void Settings::setStandbyBrightnessTimeout(int standby_brightness_timeout) {
-    standbyBrightnessTimeout = standby_brightness_timeout;
-    save();
+    setValue(standbyBrightnessTimeout, standby_brightness_timeout, SettingKey::STANDBY_BRIGHTNESS_TIMEOUT);
 }
 
 void Settings::setWifiApTimeout(int timeout) {
-    wifiApTimeout = timeout;
-    save();
+    setValue(wifiApTimeout, timeout, SettingKey::WIFI_AP_TIMEOUT);
 }
 
 void Settings::setSteamPumpPercentage(float steam_pump_percentage) {
-    steamPumpPercentage = steam_pump_percentage;
-    save();
+    setValue(steamPumpPercentage, steam_pump_percentage, SettingKey::STEAM_PUMP_PERCENTAGE);
 }
 
 void Settings::setSteamPumpCutoff(float steam_pump_cutoff) {
-    steamPumpCutoff = steam_pump_cutoff;
-    save();
+    setValue(steamPumpCutoff, steam_pump_cutoff, SettingKey::STEAM_PUMP_CUTOFF);
 }
 
 void Settings::setThemeMode(int theme_mode) {
-    themeMode = theme_mode;
-    save();
+    setValue(themeMode, theme_mode, SettingKey::THEME_MODE);
 }
 
 void Settings::setHistoryIndex(int history_index) {
-    historyIndex = history_index;
-    save();
+    setValue(historyIndex, history_index, SettingKey::HISTORY_INDEX);
 }
 
 void Settings::setSunriseR(int sunrise_r) {
-    sunriseR = sunrise_r;
-    save();
+    setValue(sunriseR, sunrise_r, SettingKey::SUNRISE_R);
 }
 
 void Settings::setSunriseG(int sunrise_g) {
-    sunriseG = sunrise_g;
-    save();
+    setValue(sunriseG, sunrise_g, SettingKey::SUNRISE_G);
 }
 
 void Settings::setSunriseB(int sunrise_b) {
-    sunriseB = sunrise_b;
-    save();
+    setValue(sunriseB, sunrise_b, SettingKey::SUNRISE_B);
 }
 
 void Settings::setSunriseW(int sunrise_w) {
-    sunriseW = sunrise_w;
-    save();
+    setValue(sunriseW, sunrise_w, SettingKey::SUNRISE_W);
 }
 
 void Settings::setSunriseExtBrightness(int sunrise_ext_brightness) {
-    sunriseExtBrightness = sunrise_ext_brightness;
-    save();
+    setValue(sunriseExtBrightness, sunrise_ext_brightness, SettingKey::SUNRISE_EXT_BRIGHTNESS);
 }
 
 void Settings::setEmptyTankDistance(int empty_tank_distance) {
-    emptyTankDistance = empty_tank_distance;
-    save();
+    setValue(emptyTankDistance, empty_tank_distance, SettingKey::EMPTY_TANK_DISTANCE);
 }
 
 void Settings::setFullTankDistance(int full_tank_distance) {
-    fullTankDistance = full_tank_distance;
-    save();
+    setValue(fullTankDistance, full_tank_distance, SettingKey::FULL_TANK_DISTANCE);
 }
 
 void Settings::setAutoWakeupEnabled(bool enabled) {
-    autowakeupEnabled = enabled;
-    save();
+    setValue(autowakeupEnabled, enabled, SettingKey::AUTOWAKEUP_ENABLED);
 }
 
 void Settings::setAutoWakeupSchedules(const std::vector<AutoWakeupSchedule> &schedules) {
     autowakeupSchedules = schedules;
-    save();
+    markDirty(SettingKey::AUTOWAKEUP_SCHEDULES);
 }
 
+// Writes the keys changed since the last save in one NVS session with a single commit. Keys that fail are queued again
+// for the next save.
 void Settings::doSave() {
-    if (!dirty) {
+    std::bitset<SETTING_KEY_COUNT> pending;
+    portENTER_CRITICAL(&dirtyLock);
+    pending = dirty;
+    dirty.reset();
+    portEXIT_CRITICAL(&dirtyLock);
+    if (pending.none()) {
         return;
     }
-    dirty = false;
-    ESP_LOGI("Settings", "Saving settings");
-    preferences.begin(PREFERENCES_KEY, false);
-    preferences.putInt("sm", startupMode);
-    preferences.putInt("tb", targetBrewTemp);
-    preferences.putInt("ts", targetSteamTemp);
-    preferences.putInt("tw", targetWaterTemp);
-    preferences.putInt("td", targetDuration);
-    preferences.putInt("tv", targetVolume);
-    preferences.putDouble("tgv", targetGrindVolume);
-    preferences.putInt("tgd", targetGrindDuration);
-    preferences.putDouble("del_br", brewDelay);
-    preferences.putDouble("del_gd", grindDelay);
-    preferences.putBool("del_ad", delayAdjust);
-    preferences.putInt("to", temperatureOffset);
-    preferences.putFloat("ps", pressureScaling);
-    preferences.putString("pid", pid);
-    preferences.putString("pmc", pumpModelCoeffs);
-    preferences.putString("ws", wifiSsid);
-    preferences.putString("wp", wifiPassword);
-    preferences.putString("mn", mdnsName);
-    preferences.putBool("hk", homekit);
-    preferences.putBool("vt", volumetricTarget);
-    preferences.putString("oc", otaChannel);
-    preferences.putInt("ipt", infusePumpTime);
-    preferences.putInt("ibt", infuseBloomTime);
-    preferences.putInt("pt", pressurizeTime);
-    preferences.putString("ssc", savedScale);
-    preferences.putBool("bf_a", boilerFillActive);
-    preferences.putInt("bf_su", startupFillTime);
-    preferences.putInt("bf_st", steamFillTime);
-    preferences.putBool("sg_a", smartGrindActive);
-    preferences.putString("sg_i", smartGrindIp);
-    preferences.putBool("sg_t", smartGrindToggle);
-    preferences.putInt("sg_m", smartGrindMode);
-    preferences.putBool("ha_a", homeAssistant);
-    preferences.putString("ha_i", homeAssistantIP);
-    preferences.putInt("ha_p", homeAssistantPort);
-    preferences.putString("ha_t", homeAssistantTopic);
-    preferences.putString("ha_u", homeAssistantUser);
-    preferences.putString("ha_pw", homeAssistantPassword);
-    preferences.putString("tz", timezone);
-    preferences.putBool("clk_24h", clock24hFormat);
-    preferences.putString("sp", selectedProfile);
-    preferences.putInt("sbt", standbyTimeout);
-    preferences.putBool("pm", profilesMigrated);
-    preferences.putBool("mb", momentaryButtons);
-    preferences.putString("fp", implode(favoritedProfiles, ","));
-    preferences.putString("po", implode(profileOrder, ","));
-    preferences.putFloat("spp", steamPumpPercentage);
-    preferences.putFloat("spc", steamPumpCutoff);
-    preferences.putInt("hi", historyIndex);
-    preferences.putBool("ab_en", autowakeupEnabled);
-    
-    // Save schedule format
+
+    const int64_t started = esp_timer_get_time();
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(PREFERENCES_KEY, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        ESP_LOGE("Settings", "Failed to open settings storage: %s", esp_err_to_name(err));
+        portENTER_CRITICAL(&dirtyLock);
+        dirty |= pending;
+        stats.failedWrites++;
+        portEXIT_CRITICAL(&dirtyLock);
+        return;
+    }
+
+    std::bitset<SETTING_KEY_COUNT> failed;
+    uint32_t written = 0;
+    for (size_t i = 0; i < SETTING_KEY_COUNT; i++) {
+        if (!pending.test(i)) {
+            continue;
+        }
+        err = writeKey(handle, static_cast<SettingKey>(i));
+        if (err == ESP_OK) {
+            written++;
+        } else {
+            ESP_LOGE("Settings", "Failed to write setting %u: %s", static_cast<unsigned>(i), esp_err_to_name(err));
+            failed.set(i);
+        }
+    }
+    err = nvs_commit(handle);
+    nvs_close(handle);
+    if (err != ESP_OK) {
+        ESP_LOGE("Settings", "Failed to commit settings: %s", esp_err_to_name(err));
+        failed = pending;
+        written = 0;
+    }
+    const auto duration = static_cast<uint32_t>(esp_timer_get_time() - started);
+
+    portENTER_CRITICAL(&dirtyLock);
+    dirty |= failed;
+    stats.failedWrites += failed.count();
+    if (written > 0) {
+        stats.commits++;
+        stats.keysWritten += written;
+        stats.lastCommitKeys = written;
+        stats.lastCommitMicros = duration;
+    }
+    portEXIT_CRITICAL(&dirtyLock);
+    ESP_LOGI("Settings", "Saved %u settings in %u us", static_cast<unsigned>(written), static_cast<unsigned>(duration));
+}
+
+#define SETTING_KEY_WRITE(id, key, type, value)                                                                                  \
+    case SettingKey::id:                                                                                                         \
+        return write##type(handle, key, value);
+
+namespace {
+esp_err_t writeInt(nvs_handle_t handle, const char *key, int32_t value) { return nvs_set_i32(handle, key, value); }
+
+esp_err_t writeBool(nvs_handle_t handle, const char *key, bool value) { return nvs_set_u8(handle, key, value ? 1 : 0); }
+
+esp_err_t writeFloat(nvs_handle_t handle, const char *key, float value) {
+    return nvs_set_blob(handle, key, &value, sizeof(value));
+}
+
+esp_err_t writeDouble(nvs_handle_t handle, const char *key, double value) {
+    return nvs_set_blob(handle, key, &value, sizeof(value));
+}
+
+esp_err_t writeString(nvs_handle_t handle, const char *key, const String &value) {
+    return nvs_set_str(handle, key, value.c_str());
+}
+} // namespace
+
+esp_err_t Settings::writeKey(nvs_handle_t handle, SettingKey key) const {
+    switch (key) {
+        SETTINGS_KEYS(SETTING_KEY_WRITE)
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+}
+
+#undef SETTING_KEY_WRITE
+
+// Format: "time1|days1;time2|days2" where days is a 7 character string (e.g., "1111100" for weekdays only)
+String Settings::serializeAutoWakeupSchedules() const {
     String schedulesForSave = "";
     for (size_t i = 0; i < autowakeupSchedules.size(); i++) {
-        if (i > 0) schedulesForSave += ";";
+        if (i > 0)
+            schedulesForSave += ";";
         schedulesForSave += autowakeupSchedules[i].time + "|";
-        
-        // Convert days array to 7-bit string
         for (int j = 0; j < 7; j++) {
             schedulesForSave += autowakeupSchedules[i].days[j] ? "1" : "0";
         }
     }
-    preferences.putString("ab_schedules", schedulesForSave);   
-
-    // Display settings
-    preferences.putInt("main_b", mainBrightness);
-    preferences.putInt("standby_b", standbyBrightness);
-    preferences.putInt("standby_bt", standbyBrightnessTimeout);
-    preferences.putInt("wifi_apt", wifiApTimeout);
-    preferences.putInt("theme", themeMode);
-
-    // Sunrise Settings
-    preferences.putInt("sr_r", sunriseR);
-    preferences.putInt("sr_g", sunriseG);
-    preferences.putInt("sr_b", sunriseB);
-    preferences.putInt("sr_w", sunriseW);
-    preferences.putInt("sr_exb", sunriseExtBrightness);
-    preferences.putInt("sr_ed", emptyTankDistance);
-    preferences.putInt("sr_fd", fullTankDistance);
-
-    preferences.end();
+    return schedulesForSave;
 }
 
 void Settings::loopTask(void *arg) {
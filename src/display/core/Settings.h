@@ -4,12 +4,97 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include <bitset>
 #include <display/core/constants.h>
 #include <display/core/utils.h>
+#include <nvs.h>
 #include <vector>
 
 #define PREFERENCES_KEY "controller"
 
+// Persisted settings: enumerator, NVS key, storage type and the value written. Types match what Preferences uses for
+// reading them back (Int: i32, Bool: u8, Float and Double: blob, String: str).
+#define SETTINGS_KEYS(X)                                                                                                         \
+    X(STARTUP_MODE, "sm", Int, startupMode)                                                                                      \
+    X(TARGET_BREW_TEMP, "tb", Int, targetBrewTemp)                                                                               \
+    X(TARGET_STEAM_TEMP, "ts", Int, targetSteamTemp)                                                                             \
+    X(TARGET_WATER_TEMP, "tw", Int, targetWaterTemp)                                                                             \
+    X(TARGET_DURATION, "td", Int, targetDuration)                                                                                \
+    X(TARGET_VOLUME, "tv", Int, targetVolume)                                                                                    \
+    X(TARGET_GRIND_VOLUME, "tgv", Double, targetGrindVolume)                                                                     \
+    X(TARGET_GRIND_DURATION, "tgd", Int, targetGrindDuration)                                                                    \
+    X(BREW_DELAY, "del_br", Double, brewDelay)                                                                                   \
+    X(GRIND_DELAY, "del_gd", Double, grindDelay)                                                                                 \
+    X(DELAY_ADJUST, "del_ad", Bool, delayAdjust)                                                                                 \
+    X(TEMPERATURE_OFFSET, "to", Int, temperatureOffset)                                                                          \
+    X(PRESSURE_SCALING, "ps", Float, pressureScaling)                                                                            \
+    X(PID, "pid", String, pid)                                                                                                   \
+    X(PUMP_MODEL_COEFFS, "pmc", String, pumpModelCoeffs)                                                                         \
+    X(WIFI_SSID, "ws", String, wifiSsid)                                                                                         \
+    X(WIFI_PASSWORD, "wp", String, wifiPassword)                                                                                 \
+    X(MDNS_NAME, "mn", String, mdnsName)                                                                                         \
+    X(HOMEKIT, "hk", Bool, homekit)                                                                                              \
+    X(VOLUMETRIC_TARGET, "vt", Bool, volumetricTarget)                                                                           \
+    X(OTA_CHANNEL, "oc", String, otaChannel)                                                                                     \
+    X(INFUSE_PUMP_TIME, "ipt", Int, infusePumpTime)                                                                              \
+    X(INFUSE_BLOOM_TIME, "ibt", Int, infuseBloomTime)                                                                            \
+    X(PRESSURIZE_TIME, "pt", Int, pressurizeTime)                                                                                \
+    X(SAVED_SCALE, "ssc", String, savedScale)                                                                                    \
+    X(BOILER_FILL_ACTIVE, "bf_a", Bool, boilerFillActive)                                                                        \
+    X(STARTUP_FILL_TIME, "bf_su", Int, startupFillTime)                                                                          \
+    X(STEAM_FILL_TIME, "bf_st", Int, steamFillTime)                                                                              \
+    X(SMART_GRIND_ACTIVE, "sg_a", Bool, smartGrindActive)                                                                        \
+    X(SMART_GRIND_IP, "sg_i", String, smartGrindIp)                                                                              \
+    X(SMART_GRIND_MODE, "sg_m", Int, smartGrindMode)                                                                             \
+    X(SMART_GRIND_TIMEOUT, "sg_to", Int, smartGrindTimeout)                                                                      \
+    X(HOME_ASSISTANT, "ha_a", Bool, homeAssistant)                                                                               \
+    X(HOME_ASSISTANT_IP, "ha_i", String, homeAssistantIP)                                                                        \
+    X(HOME_ASSISTANT_PORT, "ha_p", Int, homeAssistantPort)                                                                       \
+    X(HOME_ASSISTANT_TOPIC, "ha_t", String, homeAssistantTopic)                                                                  \
+    X(HOME_ASSISTANT_USER, "ha_u", String, homeAssistantUser)                                                                    \
+    X(HOME_ASSISTANT_PASSWORD, "ha_pw", String, homeAssistantPassword)                                                           \
+    X(TIMEZONE, "tz", String, timezone)                                                                                          \
+    X(CLOCK_24H_FORMAT, "clk_24h", Bool, clock24hFormat)                                                                         \
+    X(SELECTED_PROFILE, "sp", String, selectedProfile)                                                                           \
+    X(STANDBY_TIMEOUT, "sbt", Int, standbyTimeout)                                                                               \
+    X(PROFILES_MIGRATED, "pm", Bool, profilesMigrated)                                                                           \
+    X(MOMENTARY_BUTTONS, "mb", Bool, momentaryButtons)                                                                           \
+    X(FAVORITED_PROFILES, "fp", String, implode(favoritedProfiles, ","))                                                         \
+    X(PROFILE_ORDER, "po", String, implode(profileOrder, ","))                                                                   \
+    X(STEAM_PUMP_PERCENTAGE, "spp", Float, steamPumpPercentage)                                                                  \
+    X(STEAM_PUMP_CUTOFF, "spc", Float, steamPumpCutoff)                                                                          \
+    X(HISTORY_INDEX, "hi", Int, historyIndex)                                                                                    \
+    X(AUTOWAKEUP_ENABLED, "ab_en", Bool, autowakeupEnabled)                                                                      \
+    X(AUTOWAKEUP_SCHEDULES, "ab_schedules", String, serializeAutoWakeupSchedules())                                              \
+    X(MAIN_BRIGHTNESS, "main_b", Int, mainBrightness)                                                                            \
+    X(STANDBY_BRIGHTNESS, "standby_b", Int, standbyBrightness)                                                                   \
+    X(STANDBY_BRIGHTNESS_TIMEOUT, "standby_bt", Int, standbyBrightnessTimeout)                                                   \
+    X(WIFI_AP_TIMEOUT, "wifi_apt", Int, wifiApTimeout)                                                                           \
+    X(THEME_MODE, "theme", Int, themeMode)                                                                                       \
+    X(SUNRISE_R, "sr_r", Int, sunriseR)                                                                                          \
+    X(SUNRISE_G, "sr_g", Int, sunriseG)                                                                                          \
+    X(SUNRISE_B, "sr_b", Int, sunriseB)                                                                                          \
+    X(SUNRISE_W, "sr_w", Int, sunriseW)                                                                                          \
+    X(SUNRISE_EXT_BRIGHTNESS, "sr_exb", Int, sunriseExtBrightness)                                                               \
+    X(EMPTY_TANK_DISTANCE, "sr_ed", Int, emptyTankDistance)                                                                      \
+    X(FULL_TANK_DISTANCE, "sr_fd", Int, fullTankDistance)
+
+#define SETTING_KEY_ENUM(id, key, type, value) id,
+
+enum class SettingKey : uint8_t { SETTINGS_KEYS(SETTING_KEY_ENUM) COUNT };
+
+#undef SETTING_KEY_ENUM
+
+constexpr size_t SETTING_KEY_COUNT = static_cast<size_t>(SettingKey::COUNT);
+
+struct SettingsStats {
+    uint32_t commits = 0;          // NVS commits, one per save that had changes
+    uint32_t keysWritten = 0;      // keys written over all commits
+    uint32_t failedWrites = 0;     // keys or commits that failed and were queued again
+    uint32_t lastCommitKeys = 0;   // keys written by the last commit
+    uint32_t lastCommitMicros = 0; // duration of the last save
+};
+
 struct AutoWakeupSchedule {
     String time;  // HH:MM format
     bool days[7]; // [Mon, Tue, Wed, Thu, Fri, Sat, Sun]
@@ -51,6 +136,7 @@ class Settings {
 
     void batchUpdate(const SettingsCallback &callback);
     void save(bool noDelay = false);
+    SettingsStats getStats() const;
 
     // Getters and setters
     int getTargetBrewTemp() const { return targetBrewTemp; }
@@ -85,6 +171,7 @@ class Settings {
     bool isSmartGrindActive() const { return smartGrindActive; }
     int getSmartGrindMode() const { return smartGrindMode; }
     String getSmartGrindIp() const { return smartGrindIp; }
+    int getSmartGrindTimeout() const { return smartGrindTimeout; }
     bool isHomeAssistant() const { return homeAssistant; }
     String getHomeAssistantIP() const { return homeAssistantIP; }
     String getHomeAssistantUser() const { return homeAssistantUser; }
@@ -147,6 +234,7 @@ class Settings {
     void setSmartGrindActive(bool smart_grind_active);
     void setSmartGrindIp(String smart_grind_ip);
     void setSmartGrindMode(int smart_grind_mode);
+    void setSmartGrindTimeout(int smart_grind_timeout);
     void setHomeAssistant(bool homeAssistant);
     void setHomeAssistantUser(const String &homeAssistantUser);
     void setHomeAssistantPassword(const String &homeAssistantPassword);
@@ -182,7 +270,22 @@ class Settings {
 
   private:
     Preferences preferences;
-    bool dirty = false;
+
+    // Keys changed since the last save, set by the setters and taken by doSave
+    std::bitset<SETTING_KEY_COUNT> dirty;
+    mutable portMUX_TYPE dirtyLock = portMUX_INITIALIZER_UNLOCKED;
+    SettingsStats stats;
+
+    void markDirty(SettingKey key);
+
+    // Assigns value and marks the key dirty, unless the value is unchanged
+    template <typename T, typename V> void setValue(T &field, V &&value, SettingKey key) {
+        if (field == value) {
+            return;
+        }
+        field = std::forward<V>(value);
+        markDirty(key);
+    }
 
     String selectedProfile;
     bool profilesMigrated = false;
@@ -214,6 +317,7 @@ class Settings {
     bool smartGrindToggle = false;
     int smartGrindMode = 0;
     String smartGrindIp = "";
+    int smartGrindTimeout = DEFAULT_SMART_GRIND_TIMEOUT_MS;
     bool homeAssistant = false;
     String homeAssistantUser = "";
     String homeAssistantPassword = "";
@@ -255,6 +359,8 @@ class Settings {
     int fullTankDistance = 50;
 
     void doSave();
+    esp_err_t writeKey(nvs_handle_t handle, SettingKey key) const;
+    String serializeAutoWakeupSchedules() const;
     xTaskHandle taskHandle;
     static void loopTask(void *arg);
 };
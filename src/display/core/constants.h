@@ -11,6 +11,7 @@
 #define BREW_SAFETY_DURATION_MS BREW_MAX_DURATION_MS
 #define BREW_MIN_VOLUMETRIC 5.0
 #define BREW_MAX_VOLUMETRIC 250.0
+#define BREW_NOMINAL_FLOW 2.0f // ml/s at full pump power, the planned heat load until the controller reports a pump flow
 #define DEFAULT_STANDBY_TIMEOUT_MS 900000
 #define MIN_TEMP 0
 #define MAX_TEMP 160
@@ -22,6 +23,7 @@
 #define DEFAULT_OTA_CHANNEL "latest"
 #define DEFAULT_TIMEZONE "Europe/Rome"
 #define DEFAULT_HOME_ASSISTANT_TOPIC "homeassistant"
+#define DEFAULT_SMART_GRIND_TIMEOUT_MS 1000
 #define DEFAULT_STEAM_PUMP_PERCENTAGE 4.f
 #define DEFAULT_STEAM_PUMP_CUTOFF 2.f
 #define WIFI_CONNECT_ATTEMPTS 20
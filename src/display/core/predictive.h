@@ -2,64 +2,177 @@
 #define PREDICTIVE_H
 
 #include <Arduino.h>
+#include <array>
+#include <cmath>
 
+// Measurements kept, about 4 s of estimated volume at the 30 ms sensor rate. Older ones drop out early when it fills up.
+constexpr size_t VOLUMETRIC_RATE_CAPACITY = 128;
+// Samples in the window before the confidence can reach 1
+constexpr size_t VOLUMETRIC_RATE_FULL_CONFIDENCE = 8;
+// Samples needed for a fit before outlier rejection kicks in
+constexpr size_t VOLUMETRIC_RATE_OUTLIER_MIN_SAMPLES = 4;
+// Consecutive rejections before a jump is accepted as a real level change
+constexpr uint8_t VOLUMETRIC_RATE_MAX_OUTLIERS = 3;
+
+struct VolumetricRateEstimate {
+    double rate = 0.0;       // volume per millisecond, never negative
+    double confidence = 0.0; // 0..1, coefficient of determination of the fit scaled down while the window has few samples
+    size_t samples = 0;
+};
+
+// Least squares fit of volume over time through the measurements of the last windowDuration ms.
+// Measurements live in a fixed ring and the fit works on running sums, so adding a measurement and querying the rate cost
+// the same at the end of a long shot as at its start.
 class VolumetricRateCalculator {
   public:
     explicit VolumetricRateCalculator(double window_duration) : windowDuration(window_duration) {}
 
+    // Measurements further than maxResidual away from the current fit are dropped, 0 disables the check.
+    // A level change that persists for VOLUMETRIC_RATE_MAX_OUTLIERS measurements restarts the fit from it.
+    void setOutlierRejection(double maxResidual) { outlierResidual = maxResidual; }
+
+    size_t getRejectedCount() const { return rejected; }
+
     void addMeasurement(double volume) {
-        measurements.emplace_back(volume);
-        measurementTimes.emplace_back(millis());
+        const unsigned long now = millis();
+        if (count == 0) {
+            origin = now;
+        }
+        const double t = static_cast<double>(now - origin);
+        if (isOutlier(t, volume)) {
+            rejected++;
+            if (++consecutiveOutliers < VOLUMETRIC_RATE_MAX_OUTLIERS) {
+                return;
+            }
+            clear();
+            origin = now;
+            push(0.0, volume);
+            return;
+        }
+        consecutiveOutliers = 0;
+        while (count > 0 && (count == VOLUMETRIC_RATE_CAPACITY || times[head] <= t - windowDuration)) {
+            pop();
+        }
+        push(t, volume);
     }
 
-    double getRate(double time = 0) const {
+    VolumetricRateEstimate getEstimate(double time = 0) const {
         if (time == 0) {
             time = millis();
         }
-        // perform a linear fit through the last PREDICTIVE_TIME (ms) of data time & measurement data and return the slope
-        if (measurements.size() < 2)
-            return 0.0;
-
-        size_t i = measurementTimes.size();
-        double cutoff = time - windowDuration;
-        while (measurementTimes[i - 1] > cutoff) { // check from the most recent time
-            i--;
+        // Measurements that left the window since the last one was added are taken out of a copy of the sums, at most
+        // the few that arrived before the cutoff
+        Sums window = sums;
+        size_t n = count;
+        const double cutoff = time - static_cast<double>(origin) - windowDuration;
+        for (size_t i = 0; i < count && times[index(i)] <= cutoff; i++) {
+            window.remove(times[index(i)], volumes[index(i)]);
+            n--;
         }
-        // i is the index of the first entry after the cutoff
-
-        if (measurements.size() - i < 2)
-            return 0.0;
-
-        double v_mean = 0.0;
-        double t_mean = 0.0;
-        for (size_t j = i; j < measurements.size(); j++) {
-            v_mean += measurements[j];
-            t_mean += measurementTimes[j];
+        VolumetricRateEstimate estimate;
+        estimate.samples = n;
+        if (n < 2) {
+            return estimate;
+        }
+        const double stt = window.tt - window.t * window.t / n;
+        const double stv = window.tv - window.t * window.v / n;
+        const double svv = window.vv - window.v * window.v / n;
+        if (stt <= 0.0) {
+            return estimate;
         }
-        v_mean = v_mean / (measurements.size() - i);
-        t_mean = t_mean / (measurements.size() - i);
-
-        double tdev2 = 0.0;
-        double tdev_vdev = 0.0;
-        for (size_t j = i; j < measurements.size(); j++) {
-            tdev_vdev += (measurementTimes[i] - t_mean) * (measurements[i] - v_mean);
-            tdev2 += pow(measurementTimes[i] - t_mean, 2.0);
+        const double slope = stv / stt;
+        estimate.rate = slope > 0.0 ? slope : 0.0;
+        if (slope > 0.0 && svv > 0.0) {
+            const double r2 = std::min(1.0, stv * stv / (stt * svv));
+            estimate.confidence = r2 * std::min(1.0, static_cast<double>(n) / VOLUMETRIC_RATE_FULL_CONFIDENCE);
         }
-        double volumePerMilliSecond = tdev_vdev / tdev2;              // the slope (volume per millisecond) of the linear best fit
-        return volumePerMilliSecond > 0 ? volumePerMilliSecond : 0.0; // return 0 if it is not positive, convert to seconds
+        return estimate;
     }
 
-    double getOvershootAdjustMillis(double expectedVolume, double actualVolume) {
-        if (measurementTimes.size() < 2)
+    double getRate(double time = 0) const { return getEstimate(time).rate; }
+
+    double getOvershootAdjustMillis(double expectedVolume, double actualVolume) const {
+        if (count < 2)
+            return 0.0;
+        const double rate = getRate(static_cast<double>(origin) + times[index(count - 1)]);
+        if (rate <= 0.0)
             return 0.0;
         double overshoot = actualVolume - expectedVolume;
-        return overshoot / getRate(measurementTimes.back());
+        return overshoot / rate;
     }
 
   private:
-    std::vector<double> measurements;
-    std::vector<double> measurementTimes;
+    // Running sums over the measurements in the ring, times relative to origin to keep the squares small
+    struct Sums {
+        double t = 0.0;
+        double v = 0.0;
+        double tt = 0.0;
+        double tv = 0.0;
+        double vv = 0.0;
+
+        void add(double time, double volume) {
+            t += time;
+            v += volume;
+            tt += time * time;
+            tv += time * volume;
+            vv += volume * volume;
+        }
+
+        void remove(double time, double volume) {
+            t -= time;
+            v -= volume;
+            tt -= time * time;
+            tv -= time * volume;
+            vv -= volume * volume;
+        }
+    };
+
+    size_t index(size_t offset) const { return (head + offset) % VOLUMETRIC_RATE_CAPACITY; }
+
+    void push(double time, double volume) {
+        const size_t slot = index(count);
+        times[slot] = static_cast<float>(time);
+        volumes[slot] = static_cast<float>(volume);
+        sums.add(times[slot], volumes[slot]);
+        count++;
+    }
+
+    void pop() {
+        sums.remove(times[head], volumes[head]);
+        head = (head + 1) % VOLUMETRIC_RATE_CAPACITY;
+        count--;
+        if (count == 0) {
+            sums = Sums{}; // drop accumulated rounding whenever the window empties
+        }
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+        sums = Sums{};
+        consecutiveOutliers = 0;
+    }
+
+    bool isOutlier(double time, double volume) const {
+        if (outlierResidual <= 0.0 || count < VOLUMETRIC_RATE_OUTLIER_MIN_SAMPLES) {
+            return false;
+        }
+        const double stt = sums.tt - sums.t * sums.t / count;
+        const double slope = stt > 0.0 ? (sums.tv - sums.t * sums.v / count) / stt : 0.0;
+        const double predicted = sums.v / count + slope * (time - sums.t / count);
+        return std::fabs(volume - predicted) > outlierResidual;
+    }
+
+    std::array<float, VOLUMETRIC_RATE_CAPACITY> times{};
+    std::array<float, VOLUMETRIC_RATE_CAPACITY> volumes{};
+    size_t head = 0;
+    size_t count = 0;
+    unsigned long origin = 0;
+    Sums sums;
     const double windowDuration;
+    double outlierResidual = 0.0;
+    size_t rejected = 0;
+    uint8_t consecutiveOutliers = 0;
 };
 
 #endif
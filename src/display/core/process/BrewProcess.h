@@ -9,7 +9,7 @@
 
 class BrewProcess : public Process {
   public:
-    Profile profile;
+    ProfileRef profile;
     ProcessTarget target;
     double brewDelay;
     unsigned int phaseIndex = 0;
@@ -25,14 +25,15 @@ class BrewProcess : public Process {
     float waterPumped = 0.0f;
     VolumetricRateCalculator volumetricRateCalculator{PREDICTIVE_TIME};
 
-    explicit BrewProcess(Profile profile, ProcessTarget target, double brewDelay = 0.0)
-        : profile(profile), target(target), brewDelay(brewDelay) {
-        currentPhase = profile.phases.at(phaseIndex);
+    explicit BrewProcess(ProfileRef _profile, ProcessTarget target, double brewDelay = 0.0)
+        : profile(std::move(_profile)), target(target), brewDelay(brewDelay) {
+        currentPhase = profile->phases.at(phaseIndex);
         processStarted = millis();
         currentPhaseStarted = millis();
         phaseStartPressure = currentPhase.transition.adaptive ? currentPressure : 0;
         phaseStartFlow = currentPhase.transition.adaptive ? currentFlow : 0;
         computeEffectiveTargetsForCurrentPhase();
+        volumetricRateCalculator.setOutlierRejection(PREDICTIVE_OUTLIER_RESIDUAL);
     }
 
     void updateVolume(double volume) override { // called even after the Process is no longer active
@@ -46,7 +47,7 @@ class BrewProcess : public Process {
 
     void updateFlow(float flow) { currentFlow = flow; }
 
-    unsigned long getTotalDuration() const { return profile.getTotalDuration() * 1000L; }
+    unsigned long getTotalDuration() const { return profile->getTotalDuration() * 1000L; }
 
     unsigned long getPhaseDuration() const { return static_cast<long>(currentPhase.duration) * 1000L; }
 
@@ -56,18 +57,20 @@ class BrewProcess : public Process {
         }
         double volume = currentVolume;
         if (volume > 0.0) {
-            double currentRate = volumetricRateCalculator.getRate();
-            const double predictedAddedVolume = currentRate * brewDelay;
-            volume = currentVolume + predictedAddedVolume;
+            const VolumetricRateEstimate estimate = volumetricRateCalculator.getEstimate();
+            if (estimate.confidence >= PREDICTIVE_MIN_CONFIDENCE) {
+                const double predictedAddedVolume = estimate.rate * brewDelay;
+                volume = currentVolume + predictedAddedVolume;
+            }
         }
         float timeInPhase = static_cast<float>(millis() - currentPhaseStarted) / 1000.0f;
         return currentPhase.isFinished(target == ProcessTarget::VOLUMETRIC, volume, timeInPhase, currentFlow, currentPressure,
-                                       waterPumped, profile.type);
+                                       waterPumped, profile->type);
     }
 
     double getBrewVolume() const {
         double brewVolume = 0;
-        for (const auto &phase : profile.phases) {
+        for (const auto &phase : profile->phases) {
             if (phase.hasVolumetricTarget()) {
                 Target target = phase.getVolumetricTarget();
                 brewVolume = target.value;
@@ -120,11 +123,27 @@ class BrewProcess : public Process {
         return startVal + (endVal - startVal) * a;
     }
 
+    // Water drawn through the boiler (ml/s) for the controller to heat ahead of: the flow target when the phase has one,
+    // the pump flow otherwise
+    float getPlannedFlow() const {
+        if (processPhase == ProcessPhase::FINISHED || !currentPhase.valve) {
+            return 0.0f;
+        }
+        if (isAdvancedPump() && getPumpTarget() == PumpTarget::PUMP_TARGET_FLOW) {
+            return getPumpFlow();
+        }
+        if (currentFlow > 0.0f) {
+            return currentFlow;
+        }
+        const float pumpPower = currentPhase.pumpIsSimple ? currentPhase.pumpSimple : 100.0f;
+        return pumpPower / 100.0f * BREW_NOMINAL_FLOW;
+    }
+
     float getTemperature() const {
         if (currentPhase.temperature > 0.0f) {
             return currentPhase.temperature;
         }
-        return profile.temperature;
+        return profile->temperature;
     }
 
     void progress() override {
@@ -132,10 +151,10 @@ class BrewProcess : public Process {
         waterPumped += currentFlow / 10.0f; // Add current flow divided to 100ms to water pumped counter
         while (isCurrentPhaseFinished() && processPhase == ProcessPhase::RUNNING) {
             previousPhaseFinished = millis();
-            if (phaseIndex + 1 < profile.phases.size()) {
+            if (phaseIndex + 1 < profile->phases.size()) {
                 waterPumped = 0.0f;
                 phaseIndex++;
-                Phase nextPhase = profile.phases.at(phaseIndex);
+                Phase nextPhase = profile->phases.at(phaseIndex);
                 phaseStartPressure = nextPhase.transition.adaptive ? currentPressure : getPumpPressure();
                 phaseStartFlow = nextPhase.transition.adaptive ? currentFlow : getPumpFlow();
                 currentPhase = nextPhase;
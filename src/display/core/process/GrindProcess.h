@@ -21,6 +21,7 @@ class GrindProcess : public Process {
     explicit GrindProcess(ProcessTarget target = ProcessTarget::TIME, int time = 0, double volume = 0, double grindDelay = 0.0)
         : target(target), time(time), grindVolume(volume), grindDelay(grindDelay) {
         started = millis();
+        volumetricRateCalculator.setOutlierRejection(PREDICTIVE_OUTLIER_RESIDUAL);
     }
 
     void updateVolume(double volume) override {
@@ -41,9 +42,10 @@ class GrindProcess : public Process {
         if (target == ProcessTarget::TIME) {
             active = millis() - started < time;
         } else {
-            double currentRate = volumetricRateCalculator.getRate();
-            ESP_LOGI("GrindProcess", "Current rate: %f, Current volume: %f, Expected Offset: %f", currentRate, currentVolume,
-                     currentRate * grindDelay);
+            const VolumetricRateEstimate estimate = volumetricRateCalculator.getEstimate();
+            const double currentRate = estimate.confidence >= PREDICTIVE_MIN_CONFIDENCE ? estimate.rate : 0.0;
+            ESP_LOGI("GrindProcess", "Current rate: %f (confidence %.2f), Current volume: %f, Expected Offset: %f", estimate.rate,
+                     estimate.confidence, currentVolume, currentRate * grindDelay);
             if (currentVolume + currentRate * grindDelay > grindVolume && active) {
                 active = false;
                 finished = millis();
@@ -1,7 +1,9 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
-constexpr double PREDICTIVE_TIME = 4000.0; // time window for the prediction
+constexpr double PREDICTIVE_TIME = 4000.0;          // time window for the prediction
+constexpr double PREDICTIVE_MIN_CONFIDENCE = 0.5;   // below this the rate fit is too noisy to stop early on
+constexpr double PREDICTIVE_OUTLIER_RESIDUAL = 5.0; // scale readings further off the fit (g) are treated as glitches
 // constexpr double PREDICTIVE_TIME_MS = 1000.0;
 
 class Process {
@@ -0,0 +1,43 @@
+#ifndef PROCESSSNAPSHOT_H
+#define PROCESSSNAPSHOT_H
+
+#include "Process.h"
+#include <cstddef>
+#include <cstring>
+
+constexpr size_t PROCESS_SNAPSHOT_PHASE_CAPACITY = 48; // phase name including the terminator
+
+// Copy of the running process, or the last one while it is not cleared, published by the controller every progress tick.
+// Holds no pointers into the process, readers on other tasks never touch a process the controller may have deleted.
+// The brew fields are only set for MODE_BREW.
+struct ProcessSnapshot {
+    bool present = false;
+    bool current = false; // the running process rather than the last one
+    bool active = false;  // the process itself is active, a finished brew stays present but inactive
+    int type = -1;
+    ProcessTarget target = ProcessTarget::TIME;
+
+    bool brewPhase = false; // PHASE_TYPE_BREW, infusion otherwise
+    bool phaseVolumetric = false;
+    bool advancedPump = false;
+    char phaseName[PROCESS_SNAPSHOT_PHASE_CAPACITY] = {};
+    float phaseVolumetricTarget = 0.0f;
+    float pumpPressure = 0.0f;
+    double currentVolume = 0.0;
+    double brewVolume = 0.0; // volumetric target of the last phase that has one
+    unsigned long processStarted = 0;
+    unsigned long currentPhaseStarted = 0;
+    unsigned long finished = 0;
+    unsigned long phaseDuration = 0;
+    unsigned long totalDuration = 0;
+
+    // Whether a brew is still running, the controller reports it active only while it is the current process
+    bool isRunning() const { return current && active; }
+
+    void setPhaseName(const char *name) {
+        strncpy(phaseName, name, sizeof(phaseName) - 1);
+        phaseName[sizeof(phaseName) - 1] = '\0';
+    }
+};
+
+#endif // PROCESSSNAPSHOT_H
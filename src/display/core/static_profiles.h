@@ -4,7 +4,7 @@
 #include <display/models/profile.h>
 
 Profile FLUSH_PROFILE{.label = "Flush",
-                      .type = "standard",
+                      .type = ProfileType::PROFILE_TYPE_STANDARD,
                       .temperature = 93,
                       .phases = {Phase{.name = "Flush",
                                        .phase = PhaseType::PHASE_TYPE_BREW,
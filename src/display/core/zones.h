@@ -1,487 +1,1123 @@
 #ifndef ZONES_H
 #define ZONES_H
 
+// Generated by scripts/generate_zones.py from scripts/zones.txt, do not edit.
+
 #include "Arduino.h"
 #include <pgmspace.h>
 
+// Tables are inline variables, every translation unit that includes this header shares one copy.
+
+// 92 distinct POSIX TZ strings in byte order, NUL separated
+inline constexpr char TZ_POOL[] PROGMEM =
+    "<+00>0<+02>-2,M3.5.0/1,M10.5.0/3\0"
+    "<+01>-1\0"
+    "<+02>-2\0"
+    "<+0330>-3:30\0"
+    "<+03>-3\0"
+    "<+0430>-4:30\0"
+    "<+04>-4\0"
+    "<+0530>-5:30\0"
+    "<+0545>-5:45\0"
+    "<+05>-5\0"
+    "<+0630>-6:30\0"
+    "<+06>-6\0"
+    "<+07>-7\0"
+    "<+0845>-8:45\0"
+    "<+08>-8\0"
+    "<+09>-9\0"
+    "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0\0"
+    "<+10>-10\0"
+    "<+11>-11\0"
+    "<+11>-11<+12>,M10.1.0,M4.1.0/3\0"
+    "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45\0"
+    "<+12>-12\0"
+    "<+13>-13\0"
+    "<+14>-14\0"
+    "<-01>1\0"
+    "<-01>1<+00>,M3.5.0/0,M10.5.0/1\0"
+    "<-02>2\0"
+    "<-03>3\0"
+    "<-03>3<-02>,M3.2.0,M11.1.0\0"
+    "<-04>4\0"
+    "<-04>4<-03>,M10.1.0/0,M3.4.0/0\0"
+    "<-04>4<-03>,M9.1.6/24,M4.1.6/24\0"
+    "<-05>5\0"
+    "<-06>6\0"
+    "<-06>6<-05>,M9.1.6/22,M4.1.6/22\0"
+    "<-07>7\0"
+    "<-08>8\0"
+    "<-0930>9:30\0"
+    "<-09>9\0"
+    "<-10>10\0"
+    "<-11>11\0"
+    "<-12>12\0"
+    "ACST-9:30\0"
+    "ACST-9:30ACDT,M10.1.0,M4.1.0/3\0"
+    "AEST-10\0"
+    "AEST-10AEDT,M10.1.0,M4.1.0/3\0"
+    "AKST9AKDT,M3.2.0,M11.1.0\0"
+    "AST4\0"
+    "AST4ADT,M3.2.0,M11.1.0\0"
+    "AWST-8\0"
+    "CAT-2\0"
+    "CET-1\0"
+    "CET-1CEST,M3.5.0,M10.5.0/3\0"
+    "CST-8\0"
+    "CST5CDT,M3.2.0/0,M11.1.0/1\0"
+    "CST6\0"
+    "CST6CDT,M3.2.0,M11.1.0\0"
+    "ChST-10\0"
+    "EAT-3\0"
+    "EET-2\0"
+    "EET-2EEST,M3.4.4/50,M10.4.4/50\0"
+    "EET-2EEST,M3.5.0,M10.5.0/3\0"
+    "EET-2EEST,M3.5.0/0,M10.5.0/0\0"
+    "EET-2EEST,M3.5.0/3,M10.5.0/4\0"
+    "EST5\0"
+    "EST5EDT,M3.2.0,M11.1.0\0"
+    "GMT0\0"
+    "GMT0BST,M3.5.0/1,M10.5.0\0"
+    "HKT-8\0"
+    "HST10\0"
+    "HST10HDT,M3.2.0,M11.1.0\0"
+    "IST-1GMT0,M10.5.0,M3.5.0/1\0"
+    "IST-2IDT,M3.4.4/26,M10.5.0\0"
+    "IST-5:30\0"
+    "JST-9\0"
+    "KST-9\0"
+    "MSK-3\0"
+    "MST7\0"
+    "MST7MDT,M3.2.0,M11.1.0\0"
+    "NST3:30NDT,M3.2.0,M11.1.0\0"
+    "NZST-12NZDT,M9.5.0,M4.1.0/3\0"
+    "PKT-5\0"
+    "PST-8\0"
+    "PST8PDT,M3.2.0,M11.1.0\0"
+    "SAST-2\0"
+    "SST11\0"
+    "UTC0\0"
+    "WAT-1\0"
+    "WET0WEST,M3.5.0/1,M10.5.0\0"
+    "WIB-7\0"
+    "WIT-9\0"
+    "WITA-8\0";
+
+// IANA zone names in byte order, NUL separated
+inline constexpr char ZONE_NAME_POOL[] PROGMEM =
+    "Africa/Abidjan\0"
+    "Africa/Accra\0"
+    "Africa/Addis_Ababa\0"
+    "Africa/Algiers\0"
+    "Africa/Asmara\0"
+    "Africa/Bamako\0"
+    "Africa/Bangui\0"
+    "Africa/Banjul\0"
+    "Africa/Bissau\0"
+    "Africa/Blantyre\0"
+    "Africa/Brazzaville\0"
+    "Africa/Bujumbura\0"
+    "Africa/Cairo\0"
+    "Africa/Casablanca\0"
+    "Africa/Ceuta\0"
+    "Africa/Conakry\0"
+    "Africa/Dakar\0"
+    "Africa/Dar_es_Salaam\0"
+    "Africa/Djibouti\0"
+    "Africa/Douala\0"
+    "Africa/El_Aaiun\0"
+    "Africa/Freetown\0"
+    "Africa/Gaborone\0"
+    "Africa/Harare\0"
+    "Africa/Johannesburg\0"
+    "Africa/Juba\0"
+    "Africa/Kampala\0"
+    "Africa/Khartoum\0"
+    "Africa/Kigali\0"
+    "Africa/Kinshasa\0"
+    "Africa/Lagos\0"
+    "Africa/Libreville\0"
+    "Africa/Lome\0"
+    "Africa/Luanda\0"
+    "Africa/Lubumbashi\0"
+    "Africa/Lusaka\0"
+    "Africa/Malabo\0"
+    "Africa/Maputo\0"
+    "Africa/Maseru\0"
+    "Africa/Mbabane\0"
+    "Africa/Mogadishu\0"
+    "Africa/Monrovia\0"
+    "Africa/Nairobi\0"
+    "Africa/Ndjamena\0"
+    "Africa/Niamey\0"
+    "Africa/Nouakchott\0"
+    "Africa/Ouagadougou\0"
+    "Africa/Porto-Novo\0"
+    "Africa/Sao_Tome\0"
+    "Africa/Tripoli\0"
+    "Africa/Tunis\0"
+    "Africa/Windhoek\0"
+    "America/Adak\0"
+    "America/Anchorage\0"
+    "America/Anguilla\0"
+    "America/Antigua\0"
+    "America/Araguaina\0"
+    "America/Argentina/Buenos_Aires\0"
+    "America/Argentina/Catamarca\0"
+    "America/Argentina/Cordoba\0"
+    "America/Argentina/Jujuy\0"
+    "America/Argentina/La_Rioja\0"
+    "America/Argentina/Mendoza\0"
+    "America/Argentina/Rio_Gallegos\0"
+    "America/Argentina/Salta\0"
+    "America/Argentina/San_Juan\0"
+    "America/Argentina/San_Luis\0"
+    "America/Argentina/Tucuman\0"
+    "America/Argentina/Ushuaia\0"
+    "America/Aruba\0"
+    "America/Asuncion\0"
+    "America/Atikokan\0"
+    "America/Bahia\0"
+    "America/Bahia_Banderas\0"
+    "America/Barbados\0"
+    "America/Belem\0"
+    "America/Belize\0"
+    "America/Blanc-Sablon\0"
+    "America/Boa_Vista\0"
+    "America/Bogota\0"
+    "America/Boise\0"
+    "America/Cambridge_Bay\0"
+    "America/Campo_Grande\0"
+    "America/Cancun\0"
+    "America/Caracas\0"
+    "America/Cayenne\0"
+    "America/Cayman\0"
+    "America/Chicago\0"
+    "America/Chihuahua\0"
+    "America/Costa_Rica\0"
+    "America/Creston\0"
+    "America/Cuiaba\0"
+    "America/Curacao\0"
+    "America/Danmarkshavn\0"
+    "America/Dawson\0"
+    "America/Dawson_Creek\0"
+    "America/Denver\0"
+    "America/Detroit\0"
+    "America/Dominica\0"
+    "America/Edmonton\0"
+    "America/Eirunepe\0"
+    "America/El_Salvador\0"
+    "America/Fort_Nelson\0"
+    "America/Fortaleza\0"
+    "America/Glace_Bay\0"
+    "America/Godthab\0"
+    "America/Goose_Bay\0"
+    "America/Grand_Turk\0"
+    "America/Grenada\0"
+    "America/Guadeloupe\0"
+    "America/Guatemala\0"
+    "America/Guayaquil\0"
+    "America/Guyana\0"
+    "America/Halifax\0"
+    "America/Havana\0"
+    "America/Hermosillo\0"
+    "America/Indiana/Indianapolis\0"
+    "America/Indiana/Knox\0"
+    "America/Indiana/Marengo\0"
+    "America/Indiana/Petersburg\0"
+    "America/Indiana/Tell_City\0"
+    "America/Indiana/Vevay\0"
+    "America/Indiana/Vincennes\0"
+    "America/Indiana/Winamac\0"
+    "America/Inuvik\0"
+    "America/Iqaluit\0"
+    "America/Jamaica\0"
+    "America/Juneau\0"
+    "America/Kentucky/Louisville\0"
+    "America/Kentucky/Monticello\0"
+    "America/Kralendijk\0"
+    "America/La_Paz\0"
+    "America/Lima\0"
+    "America/Los_Angeles\0"
+    "America/Lower_Princes\0"
+    "America/Maceio\0"
+    "America/Managua\0"
+    "America/Manaus\0"
+    "America/Marigot\0"
+    "America/Martinique\0"
+    "America/Matamoros\0"
+    "America/Mazatlan\0"
+    "America/Menominee\0"
+    "America/Merida\0"
+    "America/Metlakatla\0"
+    "America/Mexico_City\0"
+    "America/Miquelon\0"
+    "America/Moncton\0"
+    "America/Monterrey\0"
+    "America/Montevideo\0"
+    "America/Montreal\0"
+    "America/Montserrat\0"
+    "America/Nassau\0"
+    "America/New_York\0"
+    "America/Nipigon\0"
+    "America/Nome\0"
+    "America/Noronha\0"
+    "America/North_Dakota/Beulah\0"
+    "America/North_Dakota/Center\0"
+    "America/North_Dakota/New_Salem\0"
+    "America/Nuuk\0"
+    "America/Ojinaga\0"
+    "America/Panama\0"
+    "America/Pangnirtung\0"
+    "America/Paramaribo\0"
+    "America/Phoenix\0"
+    "America/Port-au-Prince\0"
+    "America/Port_of_Spain\0"
+    "America/Porto_Velho\0"
+    "America/Puerto_Rico\0"
+    "America/Punta_Arenas\0"
+    "America/Rainy_River\0"
+    "America/Rankin_Inlet\0"
+    "America/Recife\0"
+    "America/Regina\0"
+    "America/Resolute\0"
+    "America/Rio_Branco\0"
+    "America/Santarem\0"
+    "America/Santiago\0"
+    "America/Santo_Domingo\0"
+    "America/Sao_Paulo\0"
+    "America/Scoresbysund\0"
+    "America/Sitka\0"
+    "America/St_Barthelemy\0"
+    "America/St_Johns\0"
+    "America/St_Kitts\0"
+    "America/St_Lucia\0"
+    "America/St_Thomas\0"
+    "America/St_Vincent\0"
+    "America/Swift_Current\0"
+    "America/Tegucigalpa\0"
+    "America/Thule\0"
+    "America/Thunder_Bay\0"
+    "America/Tijuana\0"
+    "America/Toronto\0"
+    "America/Tortola\0"
+    "America/Vancouver\0"
+    "America/Whitehorse\0"
+    "America/Winnipeg\0"
+    "America/Yakutat\0"
+    "America/Yellowknife\0"
+    "Antarctica/Casey\0"
+    "Antarctica/Davis\0"
+    "Antarctica/DumontDUrville\0"
+    "Antarctica/Macquarie\0"
+    "Antarctica/Mawson\0"
+    "Antarctica/McMurdo\0"
+    "Antarctica/Palmer\0"
+    "Antarctica/Rothera\0"
+    "Antarctica/Syowa\0"
+    "Antarctica/Troll\0"
+    "Antarctica/Vostok\0"
+    "Arctic/Longyearbyen\0"
+    "Asia/Aden\0"
+    "Asia/Almaty\0"
+    "Asia/Amman\0"
+    "Asia/Anadyr\0"
+    "Asia/Aqtau\0"
+    "Asia/Aqtobe\0"
+    "Asia/Ashgabat\0"
+    "Asia/Atyrau\0"
+    "Asia/Baghdad\0"
+    "Asia/Bahrain\0"
+    "Asia/Baku\0"
+    "Asia/Bangkok\0"
+    "Asia/Barnaul\0"
+    "Asia/Beirut\0"
+    "Asia/Bishkek\0"
+    "Asia/Brunei\0"
+    "Asia/Chita\0"
+    "Asia/Choibalsan\0"
+    "Asia/Colombo\0"
+    "Asia/Damascus\0"
+    "Asia/Dhaka\0"
+    "Asia/Dili\0"
+    "Asia/Dubai\0"
+    "Asia/Dushanbe\0"
+    "Asia/Famagusta\0"
+    "Asia/Gaza\0"
+    "Asia/Hebron\0"
+    "Asia/Ho_Chi_Minh\0"
+    "Asia/Hong_Kong\0"
+    "Asia/Hovd\0"
+    "Asia/Irkutsk\0"
+    "Asia/Jakarta\0"
+    "Asia/Jayapura\0"
+    "Asia/Jerusalem\0"
+    "Asia/Kabul\0"
+    "Asia/Kamchatka\0"
+    "Asia/Karachi\0"
+    "Asia/Kathmandu\0"
+    "Asia/Khandyga\0"
+    "Asia/Kolkata\0"
+    "Asia/Krasnoyarsk\0"
+    "Asia/Kuala_Lumpur\0"
+    "Asia/Kuching\0"
+    "Asia/Kuwait\0"
+    "Asia/Macau\0"
+    "Asia/Magadan\0"
+    "Asia/Makassar\0"
+    "Asia/Manila\0"
+    "Asia/Muscat\0"
+    "Asia/Nicosia\0"
+    "Asia/Novokuznetsk\0"
+    "Asia/Novosibirsk\0"
+    "Asia/Omsk\0"
+    "Asia/Oral\0"
+    "Asia/Phnom_Penh\0"
+    "Asia/Pontianak\0"
+    "Asia/Pyongyang\0"
+    "Asia/Qatar\0"
+    "Asia/Qyzylorda\0"
+    "Asia/Riyadh\0"
+    "Asia/Sakhalin\0"
+    "Asia/Samarkand\0"
+    "Asia/Seoul\0"
+    "Asia/Shanghai\0"
+    "Asia/Singapore\0"
+    "Asia/Srednekolymsk\0"
+    "Asia/Taipei\0"
+    "Asia/Tashkent\0"
+    "Asia/Tbilisi\0"
+    "Asia/Tehran\0"
+    "Asia/Thimphu\0"
+    "Asia/Tokyo\0"
+    "Asia/Tomsk\0"
+    "Asia/Ulaanbaatar\0"
+    "Asia/Urumqi\0"
+    "Asia/Ust-Nera\0"
+    "Asia/Vientiane\0"
+    "Asia/Vladivostok\0"
+    "Asia/Yakutsk\0"
+    "Asia/Yangon\0"
+    "Asia/Yekaterinburg\0"
+    "Asia/Yerevan\0"
+    "Atlantic/Azores\0"
+    "Atlantic/Bermuda\0"
+    "Atlantic/Canary\0"
+    "Atlantic/Cape_Verde\0"
+    "Atlantic/Faroe\0"
+    "Atlantic/Madeira\0"
+    "Atlantic/Reykjavik\0"
+    "Atlantic/South_Georgia\0"
+    "Atlantic/St_Helena\0"
+    "Atlantic/Stanley\0"
+    "Australia/Adelaide\0"
+    "Australia/Brisbane\0"
+    "Australia/Broken_Hill\0"
+    "Australia/Currie\0"
+    "Australia/Darwin\0"
+    "Australia/Eucla\0"
+    "Australia/Hobart\0"
+    "Australia/Lindeman\0"
+    "Australia/Lord_Howe\0"
+    "Australia/Melbourne\0"
+    "Australia/Perth\0"
+    "Australia/Sydney\0"
+    "Etc/GMT\0"
+    "Etc/GMT+0\0"
+    "Etc/GMT+1\0"
+    "Etc/GMT+10\0"
+    "Etc/GMT+11\0"
+    "Etc/GMT+12\0"
+    "Etc/GMT+2\0"
+    "Etc/GMT+3\0"
+    "Etc/GMT+4\0"
+    "Etc/GMT+5\0"
+    "Etc/GMT+6\0"
+    "Etc/GMT+7\0"
+    "Etc/GMT+8\0"
+    "Etc/GMT+9\0"
+    "Etc/GMT-0\0"
+    "Etc/GMT-1\0"
+    "Etc/GMT-10\0"
+    "Etc/GMT-11\0"
+    "Etc/GMT-12\0"
+    "Etc/GMT-13\0"
+    "Etc/GMT-14\0"
+    "Etc/GMT-2\0"
+    "Etc/GMT-3\0"
+    "Etc/GMT-4\0"
+    "Etc/GMT-5\0"
+    "Etc/GMT-6\0"
+    "Etc/GMT-7\0"
+    "Etc/GMT-8\0"
+    "Etc/GMT-9\0"
+    "Etc/GMT0\0"
+    "Etc/Greenwich\0"
+    "Etc/UCT\0"
+    "Etc/UTC\0"
+    "Etc/Universal\0"
+    "Etc/Zulu\0"
+    "Europe/Amsterdam\0"
+    "Europe/Andorra\0"
+    "Europe/Astrakhan\0"
+    "Europe/Athens\0"
+    "Europe/Belgrade\0"
+    "Europe/Berlin\0"
+    "Europe/Bratislava\0"
+    "Europe/Brussels\0"
+    "Europe/Bucharest\0"
+    "Europe/Budapest\0"
+    "Europe/Busingen\0"
+    "Europe/Chisinau\0"
+    "Europe/Copenhagen\0"
+    "Europe/Dublin\0"
+    "Europe/Gibraltar\0"
+    "Europe/Guernsey\0"
+    "Europe/Helsinki\0"
+    "Europe/Isle_of_Man\0"
+    "Europe/Istanbul\0"
+    "Europe/Jersey\0"
+    "Europe/Kaliningrad\0"
+    "Europe/Kiev\0"
+    "Europe/Kirov\0"
+    "Europe/Lisbon\0"
+    "Europe/Ljubljana\0"
+    "Europe/London\0"
+    "Europe/Luxembourg\0"
+    "Europe/Madrid\0"
+    "Europe/Malta\0"
+    "Europe/Mariehamn\0"
+    "Europe/Minsk\0"
+    "Europe/Monaco\0"
+    "Europe/Moscow\0"
+    "Europe/Oslo\0"
+    "Europe/Paris\0"
+    "Europe/Podgorica\0"
+    "Europe/Prague\0"
+    "Europe/Riga\0"
+    "Europe/Rome\0"
+    "Europe/Samara\0"
+    "Europe/San_Marino\0"
+    "Europe/Sarajevo\0"
+    "Europe/Saratov\0"
+    "Europe/Simferopol\0"
+    "Europe/Skopje\0"
+    "Europe/Sofia\0"
+    "Europe/Stockholm\0"
+    "Europe/Tallinn\0"
+    "Europe/Tirane\0"
+    "Europe/Ulyanovsk\0"
+    "Europe/Uzhgorod\0"
+    "Europe/Vaduz\0"
+    "Europe/Vatican\0"
+    "Europe/Vienna\0"
+    "Europe/Vilnius\0"
+    "Europe/Volgograd\0"
+    "Europe/Warsaw\0"
+    "Europe/Zagreb\0"
+    "Europe/Zaporozhye\0"
+    "Europe/Zurich\0"
+    "Indian/Antananarivo\0"
+    "Indian/Chagos\0"
+    "Indian/Christmas\0"
+    "Indian/Cocos\0"
+    "Indian/Comoro\0"
+    "Indian/Kerguelen\0"
+    "Indian/Mahe\0"
+    "Indian/Maldives\0"
+    "Indian/Mauritius\0"
+    "Indian/Mayotte\0"
+    "Indian/Reunion\0"
+    "Pacific/Apia\0"
+    "Pacific/Auckland\0"
+    "Pacific/Bougainville\0"
+    "Pacific/Chatham\0"
+    "Pacific/Chuuk\0"
+    "Pacific/Easter\0"
+    "Pacific/Efate\0"
+    "Pacific/Enderbury\0"
+    "Pacific/Fakaofo\0"
+    "Pacific/Fiji\0"
+    "Pacific/Funafuti\0"
+    "Pacific/Galapagos\0"
+    "Pacific/Gambier\0"
+    "Pacific/Guadalcanal\0"
+    "Pacific/Guam\0"
+    "Pacific/Honolulu\0"
+    "Pacific/Kiritimati\0"
+    "Pacific/Kosrae\0"
+    "Pacific/Kwajalein\0"
+    "Pacific/Majuro\0"
+    "Pacific/Marquesas\0"
+    "Pacific/Midway\0"
+    "Pacific/Nauru\0"
+    "Pacific/Niue\0"
+    "Pacific/Norfolk\0"
+    "Pacific/Noumea\0"
+    "Pacific/Pago_Pago\0"
+    "Pacific/Palau\0"
+    "Pacific/Pitcairn\0"
+    "Pacific/Pohnpei\0"
+    "Pacific/Port_Moresby\0"
+    "Pacific/Rarotonga\0"
+    "Pacific/Saipan\0"
+    "Pacific/Tahiti\0"
+    "Pacific/Tarawa\0"
+    "Pacific/Tongatapu\0"
+    "Pacific/Wake\0"
+    "Pacific/Wallis\0";
+
 typedef struct {
-    const char *name;
-    const char *zones;
-} zones_t;
+    uint16_t name; // offset into ZONE_NAME_POOL
+    uint16_t tz;   // offset into TZ_POOL
+} zone_entry_t;
+
+static constexpr size_t ZONE_COUNT = 461;
 
-static const zones_t zones[] PROGMEM = {
-    {"Africa/Abidjan", "GMT0"},
-    {"Africa/Accra", "GMT0"},
-    {"Africa/Addis_Ababa", "EAT-3"},
-    {"Africa/Algiers", "CET-1"},
-    {"Africa/Asmara", "EAT-3"},
-    {"Africa/Bamako", "GMT0"},
-    {"Africa/Bangui", "WAT-1"},
-    {"Africa/Banjul", "GMT0"},
-    {"Africa/Bissau", "GMT0"},
-    {"Africa/Blantyre", "CAT-2"},
-    {"Africa/Brazzaville", "WAT-1"},
-    {"Africa/Bujumbura", "CAT-2"},
-    {"Africa/Cairo", "EET-2"},
-    {"Africa/Casablanca", "<+01>-1"},
-    {"Africa/Ceuta", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Africa/Conakry", "GMT0"},
-    {"Africa/Dakar", "GMT0"},
-    {"Africa/Dar_es_Salaam", "EAT-3"},
-    {"Africa/Djibouti", "EAT-3"},
-    {"Africa/Douala", "WAT-1"},
-    {"Africa/El_Aaiun", "<+01>-1"},
-    {"Africa/Freetown", "GMT0"},
-    {"Africa/Gaborone", "CAT-2"},
-    {"Africa/Harare", "CAT-2"},
-    {"Africa/Johannesburg", "SAST-2"},
-    {"Africa/Juba", "CAT-2"},
-    {"Africa/Kampala", "EAT-3"},
-    {"Africa/Khartoum", "CAT-2"},
-    {"Africa/Kigali", "CAT-2"},
-    {"Africa/Kinshasa", "WAT-1"},
-    {"Africa/Lagos", "WAT-1"},
-    {"Africa/Libreville", "WAT-1"},
-    {"Africa/Lome", "GMT0"},
-    {"Africa/Luanda", "WAT-1"},
-    {"Africa/Lubumbashi", "CAT-2"},
-    {"Africa/Lusaka", "CAT-2"},
-    {"Africa/Malabo", "WAT-1"},
-    {"Africa/Maputo", "CAT-2"},
-    {"Africa/Maseru", "SAST-2"},
-    {"Africa/Mbabane", "SAST-2"},
-    {"Africa/Mogadishu", "EAT-3"},
-    {"Africa/Monrovia", "GMT0"},
-    {"Africa/Nairobi", "EAT-3"},
-    {"Africa/Ndjamena", "WAT-1"},
-    {"Africa/Niamey", "WAT-1"},
-    {"Africa/Nouakchott", "GMT0"},
-    {"Africa/Ouagadougou", "GMT0"},
-    {"Africa/Porto-Novo", "WAT-1"},
-    {"Africa/Sao_Tome", "GMT0"},
-    {"Africa/Tripoli", "EET-2"},
-    {"Africa/Tunis", "CET-1"},
-    {"Africa/Windhoek", "CAT-2"},
-    {"America/Adak", "HST10HDT,M3.2.0,M11.1.0"},
-    {"America/Anchorage", "AKST9AKDT,M3.2.0,M11.1.0"},
-    {"America/Anguilla", "AST4"},
-    {"America/Antigua", "AST4"},
-    {"America/Araguaina", "<-03>3"},
-    {"America/Argentina/Buenos_Aires", "<-03>3"},
-    {"America/Argentina/Catamarca", "<-03>3"},
-    {"America/Argentina/Cordoba", "<-03>3"},
-    {"America/Argentina/Jujuy", "<-03>3"},
-    {"America/Argentina/La_Rioja", "<-03>3"},
-    {"America/Argentina/Mendoza", "<-03>3"},
-    {"America/Argentina/Rio_Gallegos", "<-03>3"},
-    {"America/Argentina/Salta", "<-03>3"},
-    {"America/Argentina/San_Juan", "<-03>3"},
-    {"America/Argentina/San_Luis", "<-03>3"},
-    {"America/Argentina/Tucuman", "<-03>3"},
-    {"America/Argentina/Ushuaia", "<-03>3"},
-    {"America/Aruba", "AST4"},
-    {"America/Asuncion", "<-04>4<-03>,M10.1.0/0,M3.4.0/0"},
-    {"America/Atikokan", "EST5"},
-    {"America/Bahia", "<-03>3"},
-    {"America/Bahia_Banderas", "CST6"},
-    {"America/Barbados", "AST4"},
-    {"America/Belem", "<-03>3"},
-    {"America/Belize", "CST6"},
-    {"America/Blanc-Sablon", "AST4"},
-    {"America/Boa_Vista", "<-04>4"},
-    {"America/Bogota", "<-05>5"},
-    {"America/Boise", "MST7MDT,M3.2.0,M11.1.0"},
-    {"America/Cambridge_Bay", "MST7MDT,M3.2.0,M11.1.0"},
-    {"America/Campo_Grande", "<-04>4"},
-    {"America/Cancun", "EST5"},
-    {"America/Caracas", "<-04>4"},
-    {"America/Cayenne", "<-03>3"},
-    {"America/Cayman", "EST5"},
-    {"America/Chicago", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Chihuahua", "CST6"},
-    {"America/Costa_Rica", "CST6"},
-    {"America/Creston", "MST7"},
-    {"America/Cuiaba", "<-04>4"},
-    {"America/Curacao", "AST4"},
-    {"America/Danmarkshavn", "GMT0"},
-    {"America/Dawson", "MST7"},
-    {"America/Dawson_Creek", "MST7"},
-    {"America/Denver", "MST7MDT,M3.2.0,M11.1.0"},
-    {"America/Detroit", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Dominica", "AST4"},
-    {"America/Edmonton", "MST7MDT,M3.2.0,M11.1.0"},
-    {"America/Eirunepe", "<-05>5"},
-    {"America/El_Salvador", "CST6"},
-    {"America/Fort_Nelson", "MST7"},
-    {"America/Fortaleza", "<-03>3"},
-    {"America/Glace_Bay", "AST4ADT,M3.2.0,M11.1.0"},
-    {"America/Godthab", "<-02>2"},
-    {"America/Goose_Bay", "AST4ADT,M3.2.0,M11.1.0"},
-    {"America/Grand_Turk", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Grenada", "AST4"},
-    {"America/Guadeloupe", "AST4"},
-    {"America/Guatemala", "CST6"},
-    {"America/Guayaquil", "<-05>5"},
-    {"America/Guyana", "<-04>4"},
-    {"America/Halifax", "AST4ADT,M3.2.0,M11.1.0"},
-    {"America/Havana", "CST5CDT,M3.2.0/0,M11.1.0/1"},
-    {"America/Hermosillo", "MST7"},
-    {"America/Indiana/Indianapolis", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Indiana/Knox", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Indiana/Marengo", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Indiana/Petersburg", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Indiana/Tell_City", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Indiana/Vevay", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Indiana/Vincennes", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Indiana/Winamac", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Inuvik", "MST7MDT,M3.2.0,M11.1.0"},
-    {"America/Iqaluit", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Jamaica", "EST5"},
-    {"America/Juneau", "AKST9AKDT,M3.2.0,M11.1.0"},
-    {"America/Kentucky/Louisville", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Kentucky/Monticello", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Kralendijk", "AST4"},
-    {"America/La_Paz", "<-04>4"},
-    {"America/Lima", "<-05>5"},
-    {"America/Los_Angeles", "PST8PDT,M3.2.0,M11.1.0"},
-    {"America/Lower_Princes", "AST4"},
-    {"America/Maceio", "<-03>3"},
-    {"America/Managua", "CST6"},
-    {"America/Manaus", "<-04>4"},
-    {"America/Marigot", "AST4"},
-    {"America/Martinique", "AST4"},
-    {"America/Matamoros", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Mazatlan", "MST7"},
-    {"America/Menominee", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Merida", "CST6"},
-    {"America/Metlakatla", "AKST9AKDT,M3.2.0,M11.1.0"},
-    {"America/Mexico_City", "CST6"},
-    {"America/Miquelon", "<-03>3<-02>,M3.2.0,M11.1.0"},
-    {"America/Moncton", "AST4ADT,M3.2.0,M11.1.0"},
-    {"America/Monterrey", "CST6"},
-    {"America/Montevideo", "<-03>3"},
-    {"America/Montreal", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Montserrat", "AST4"},
-    {"America/Nassau", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/New_York", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Nipigon", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Nome", "AKST9AKDT,M3.2.0,M11.1.0"},
-    {"America/Noronha", "<-02>2"},
-    {"America/North_Dakota/Beulah", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/North_Dakota/Center", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/North_Dakota/New_Salem", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Nuuk", "<-02>2"},
-    {"America/Ojinaga", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Panama", "EST5"},
-    {"America/Pangnirtung", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Paramaribo", "<-03>3"},
-    {"America/Phoenix", "MST7"},
-    {"America/Port-au-Prince", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Port_of_Spain", "AST4"},
-    {"America/Porto_Velho", "<-04>4"},
-    {"America/Puerto_Rico", "AST4"},
-    {"America/Punta_Arenas", "<-03>3"},
-    {"America/Rainy_River", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Rankin_Inlet", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Recife", "<-03>3"},
-    {"America/Regina", "CST6"},
-    {"America/Resolute", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Rio_Branco", "<-05>5"},
-    {"America/Santarem", "<-03>3"},
-    {"America/Santiago", "<-04>4<-03>,M9.1.6/24,M4.1.6/24"},
-    {"America/Santo_Domingo", "AST4"},
-    {"America/Sao_Paulo", "<-03>3"},
-    {"America/Scoresbysund", "<-01>1<+00>,M3.5.0/0,M10.5.0/1"},
-    {"America/Sitka", "AKST9AKDT,M3.2.0,M11.1.0"},
-    {"America/St_Barthelemy", "AST4"},
-    {"America/St_Johns", "NST3:30NDT,M3.2.0,M11.1.0"},
-    {"America/St_Kitts", "AST4"},
-    {"America/St_Lucia", "AST4"},
-    {"America/St_Thomas", "AST4"},
-    {"America/St_Vincent", "AST4"},
-    {"America/Swift_Current", "CST6"},
-    {"America/Tegucigalpa", "CST6"},
-    {"America/Thule", "AST4ADT,M3.2.0,M11.1.0"},
-    {"America/Thunder_Bay", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Tijuana", "PST8PDT,M3.2.0,M11.1.0"},
-    {"America/Toronto", "EST5EDT,M3.2.0,M11.1.0"},
-    {"America/Tortola", "AST4"},
-    {"America/Vancouver", "PST8PDT,M3.2.0,M11.1.0"},
-    {"America/Whitehorse", "MST7"},
-    {"America/Winnipeg", "CST6CDT,M3.2.0,M11.1.0"},
-    {"America/Yakutat", "AKST9AKDT,M3.2.0,M11.1.0"},
-    {"America/Yellowknife", "MST7MDT,M3.2.0,M11.1.0"},
-    {"Antarctica/Casey", "<+11>-11"},
-    {"Antarctica/Davis", "<+07>-7"},
-    {"Antarctica/DumontDUrville", "<+10>-10"},
-    {"Antarctica/Macquarie", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {"Antarctica/Mawson", "<+05>-5"},
-    {"Antarctica/McMurdo", "NZST-12NZDT,M9.5.0,M4.1.0/3"},
-    {"Antarctica/Palmer", "<-03>3"},
-    {"Antarctica/Rothera", "<-03>3"},
-    {"Antarctica/Syowa", "<+03>-3"},
-    {"Antarctica/Troll", "<+00>0<+02>-2,M3.5.0/1,M10.5.0/3"},
-    {"Antarctica/Vostok", "<+06>-6"},
-    {"Arctic/Longyearbyen", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Asia/Aden", "<+03>-3"},
-    {"Asia/Almaty", "<+06>-6"},
-    {"Asia/Amman", "<+03>-3"},
-    {"Asia/Anadyr", "<+12>-12"},
-    {"Asia/Aqtau", "<+05>-5"},
-    {"Asia/Aqtobe", "<+05>-5"},
-    {"Asia/Ashgabat", "<+05>-5"},
-    {"Asia/Atyrau", "<+05>-5"},
-    {"Asia/Baghdad", "<+03>-3"},
-    {"Asia/Bahrain", "<+03>-3"},
-    {"Asia/Baku", "<+04>-4"},
-    {"Asia/Bangkok", "<+07>-7"},
-    {"Asia/Barnaul", "<+07>-7"},
-    {"Asia/Beirut", "EET-2EEST,M3.5.0/0,M10.5.0/0"},
-    {"Asia/Bishkek", "<+06>-6"},
-    {"Asia/Brunei", "<+08>-8"},
-    {"Asia/Chita", "<+09>-9"},
-    {"Asia/Choibalsan", "<+08>-8"},
-    {"Asia/Colombo", "<+0530>-5:30"},
-    {"Asia/Damascus", "<+03>-3"},
-    {"Asia/Dhaka", "<+06>-6"},
-    {"Asia/Dili", "<+09>-9"},
-    {"Asia/Dubai", "<+04>-4"},
-    {"Asia/Dushanbe", "<+05>-5"},
-    {"Asia/Famagusta", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Asia/Gaza", "EET-2EEST,M3.4.4/50,M10.4.4/50"},
-    {"Asia/Hebron", "EET-2EEST,M3.4.4/50,M10.4.4/50"},
-    {"Asia/Ho_Chi_Minh", "<+07>-7"},
-    {"Asia/Hong_Kong", "HKT-8"},
-    {"Asia/Hovd", "<+07>-7"},
-    {"Asia/Irkutsk", "<+08>-8"},
-    {"Asia/Jakarta", "WIB-7"},
-    {"Asia/Jayapura", "WIT-9"},
-    {"Asia/Jerusalem", "IST-2IDT,M3.4.4/26,M10.5.0"},
-    {"Asia/Kabul", "<+0430>-4:30"},
-    {"Asia/Kamchatka", "<+12>-12"},
-    {"Asia/Karachi", "PKT-5"},
-    {"Asia/Kathmandu", "<+0545>-5:45"},
-    {"Asia/Khandyga", "<+09>-9"},
-    {"Asia/Kolkata", "IST-5:30"},
-    {"Asia/Krasnoyarsk", "<+07>-7"},
-    {"Asia/Kuala_Lumpur", "<+08>-8"},
-    {"Asia/Kuching", "<+08>-8"},
-    {"Asia/Kuwait", "<+03>-3"},
-    {"Asia/Macau", "CST-8"},
-    {"Asia/Magadan", "<+11>-11"},
-    {"Asia/Makassar", "WITA-8"},
-    {"Asia/Manila", "PST-8"},
-    {"Asia/Muscat", "<+04>-4"},
-    {"Asia/Nicosia", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Asia/Novokuznetsk", "<+07>-7"},
-    {"Asia/Novosibirsk", "<+07>-7"},
-    {"Asia/Omsk", "<+06>-6"},
-    {"Asia/Oral", "<+05>-5"},
-    {"Asia/Phnom_Penh", "<+07>-7"},
-    {"Asia/Pontianak", "WIB-7"},
-    {"Asia/Pyongyang", "KST-9"},
-    {"Asia/Qatar", "<+03>-3"},
-    {"Asia/Qyzylorda", "<+05>-5"},
-    {"Asia/Riyadh", "<+03>-3"},
-    {"Asia/Sakhalin", "<+11>-11"},
-    {"Asia/Samarkand", "<+05>-5"},
-    {"Asia/Seoul", "KST-9"},
-    {"Asia/Shanghai", "CST-8"},
-    {"Asia/Singapore", "<+08>-8"},
-    {"Asia/Srednekolymsk", "<+11>-11"},
-    {"Asia/Taipei", "CST-8"},
-    {"Asia/Tashkent", "<+05>-5"},
-    {"Asia/Tbilisi", "<+04>-4"},
-    {"Asia/Tehran", "<+0330>-3:30"},
-    {"Asia/Thimphu", "<+06>-6"},
-    {"Asia/Tokyo", "JST-9"},
-    {"Asia/Tomsk", "<+07>-7"},
-    {"Asia/Ulaanbaatar", "<+08>-8"},
-    {"Asia/Urumqi", "<+06>-6"},
-    {"Asia/Ust-Nera", "<+10>-10"},
-    {"Asia/Vientiane", "<+07>-7"},
-    {"Asia/Vladivostok", "<+10>-10"},
-    {"Asia/Yakutsk", "<+09>-9"},
-    {"Asia/Yangon", "<+0630>-6:30"},
-    {"Asia/Yekaterinburg", "<+05>-5"},
-    {"Asia/Yerevan", "<+04>-4"},
-    {"Atlantic/Azores", "<-01>1<+00>,M3.5.0/0,M10.5.0/1"},
-    {"Atlantic/Bermuda", "AST4ADT,M3.2.0,M11.1.0"},
-    {"Atlantic/Canary", "WET0WEST,M3.5.0/1,M10.5.0"},
-    {"Atlantic/Cape_Verde", "<-01>1"},
-    {"Atlantic/Faroe", "WET0WEST,M3.5.0/1,M10.5.0"},
-    {"Atlantic/Madeira", "WET0WEST,M3.5.0/1,M10.5.0"},
-    {"Atlantic/Reykjavik", "GMT0"},
-    {"Atlantic/South_Georgia", "<-02>2"},
-    {"Atlantic/St_Helena", "GMT0"},
-    {"Atlantic/Stanley", "<-03>3"},
-    {"Australia/Adelaide", "ACST-9:30ACDT,M10.1.0,M4.1.0/3"},
-    {"Australia/Brisbane", "AEST-10"},
-    {"Australia/Broken_Hill", "ACST-9:30ACDT,M10.1.0,M4.1.0/3"},
-    {"Australia/Currie", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {"Australia/Darwin", "ACST-9:30"},
-    {"Australia/Eucla", "<+0845>-8:45"},
-    {"Australia/Hobart", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {"Australia/Lindeman", "AEST-10"},
-    {"Australia/Lord_Howe", "<+1030>-10:30<+11>-11,M10.1.0,M4.1.0"},
-    {"Australia/Melbourne", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {"Australia/Perth", "AWST-8"},
-    {"Australia/Sydney", "AEST-10AEDT,M10.1.0,M4.1.0/3"},
-    {"Etc/GMT", "GMT0"},
-    {"Etc/GMT+0", "GMT0"},
-    {"Etc/GMT+1", "<-01>1"},
-    {"Etc/GMT+10", "<-10>10"},
-    {"Etc/GMT+11", "<-11>11"},
-    {"Etc/GMT+12", "<-12>12"},
-    {"Etc/GMT+2", "<-02>2"},
-    {"Etc/GMT+3", "<-03>3"},
-    {"Etc/GMT+4", "<-04>4"},
-    {"Etc/GMT+5", "<-05>5"},
-    {"Etc/GMT+6", "<-06>6"},
-    {"Etc/GMT+7", "<-07>7"},
-    {"Etc/GMT+8", "<-08>8"},
-    {"Etc/GMT+9", "<-09>9"},
-    {"Etc/GMT-0", "GMT0"},
-    {"Etc/GMT-1", "<+01>-1"},
-    {"Etc/GMT-10", "<+10>-10"},
-    {"Etc/GMT-11", "<+11>-11"},
-    {"Etc/GMT-12", "<+12>-12"},
-    {"Etc/GMT-13", "<+13>-13"},
-    {"Etc/GMT-14", "<+14>-14"},
-    {"Etc/GMT-2", "<+02>-2"},
-    {"Etc/GMT-3", "<+03>-3"},
-    {"Etc/GMT-4", "<+04>-4"},
-    {"Etc/GMT-5", "<+05>-5"},
-    {"Etc/GMT-6", "<+06>-6"},
-    {"Etc/GMT-7", "<+07>-7"},
-    {"Etc/GMT-8", "<+08>-8"},
-    {"Etc/GMT-9", "<+09>-9"},
-    {"Etc/GMT0", "GMT0"},
-    {"Etc/Greenwich", "GMT0"},
-    {"Etc/UCT", "UTC0"},
-    {"Etc/UTC", "UTC0"},
-    {"Etc/Universal", "UTC0"},
-    {"Etc/Zulu", "UTC0"},
-    {"Europe/Amsterdam", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Andorra", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Astrakhan", "<+04>-4"},
-    {"Europe/Athens", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Belgrade", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Berlin", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Bratislava", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Brussels", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Bucharest", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Budapest", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Busingen", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Chisinau", "EET-2EEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Copenhagen", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Dublin", "IST-1GMT0,M10.5.0,M3.5.0/1"},
-    {"Europe/Gibraltar", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Guernsey", "GMT0BST,M3.5.0/1,M10.5.0"},
-    {"Europe/Helsinki", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Isle_of_Man", "GMT0BST,M3.5.0/1,M10.5.0"},
-    {"Europe/Istanbul", "<+03>-3"},
-    {"Europe/Jersey", "GMT0BST,M3.5.0/1,M10.5.0"},
-    {"Europe/Kaliningrad", "EET-2"},
-    {"Europe/Kiev", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Kirov", "<+03>-3"},
-    {"Europe/Lisbon", "WET0WEST,M3.5.0/1,M10.5.0"},
-    {"Europe/Ljubljana", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/London", "GMT0BST,M3.5.0/1,M10.5.0"},
-    {"Europe/Luxembourg", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Madrid", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Malta", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Mariehamn", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Minsk", "<+03>-3"},
-    {"Europe/Monaco", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Moscow", "MSK-3"},
-    {"Europe/Oslo", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Paris", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Podgorica", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Prague", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Riga", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Rome", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Samara", "<+04>-4"},
-    {"Europe/San_Marino", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Sarajevo", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Saratov", "<+04>-4"},
-    {"Europe/Simferopol", "MSK-3"},
-    {"Europe/Skopje", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Sofia", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Stockholm", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Tallinn", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Tirane", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Ulyanovsk", "<+04>-4"},
-    {"Europe/Uzhgorod", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Vaduz", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Vatican", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Vienna", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Vilnius", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Volgograd", "<+03>-3"},
-    {"Europe/Warsaw", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Zagreb", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Europe/Zaporozhye", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
-    {"Europe/Zurich", "CET-1CEST,M3.5.0,M10.5.0/3"},
-    {"Indian/Antananarivo", "EAT-3"},
-    {"Indian/Chagos", "<+06>-6"},
-    {"Indian/Christmas", "<+07>-7"},
-    {"Indian/Cocos", "<+0630>-6:30"},
-    {"Indian/Comoro", "EAT-3"},
-    {"Indian/Kerguelen", "<+05>-5"},
-    {"Indian/Mahe", "<+04>-4"},
-    {"Indian/Maldives", "<+05>-5"},
-    {"Indian/Mauritius", "<+04>-4"},
-    {"Indian/Mayotte", "EAT-3"},
-    {"Indian/Reunion", "<+04>-4"},
-    {"Pacific/Apia", "<+13>-13"},
-    {"Pacific/Auckland", "NZST-12NZDT,M9.5.0,M4.1.0/3"},
-    {"Pacific/Bougainville", "<+11>-11"},
-    {"Pacific/Chatham", "<+1245>-12:45<+1345>,M9.5.0/2:45,M4.1.0/3:45"},
-    {"Pacific/Chuuk", "<+10>-10"},
-    {"Pacific/Easter", "<-06>6<-05>,M9.1.6/22,M4.1.6/22"},
-    {"Pacific/Efate", "<+11>-11"},
-    {"Pacific/Enderbury", "<+13>-13"},
-    {"Pacific/Fakaofo", "<+13>-13"},
-    {"Pacific/Fiji", "<+12>-12"},
-    {"Pacific/Funafuti", "<+12>-12"},
-    {"Pacific/Galapagos", "<-06>6"},
-    {"Pacific/Gambier", "<-09>9"},
-    {"Pacific/Guadalcanal", "<+11>-11"},
-    {"Pacific/Guam", "ChST-10"},
-    {"Pacific/Honolulu", "HST10"},
-    {"Pacific/Kiritimati", "<+14>-14"},
-    {"Pacific/Kosrae", "<+11>-11"},
-    {"Pacific/Kwajalein", "<+12>-12"},
-    {"Pacific/Majuro", "<+12>-12"},
-    {"Pacific/Marquesas", "<-0930>9:30"},
-    {"Pacific/Midway", "SST11"},
-    {"Pacific/Nauru", "<+12>-12"},
-    {"Pacific/Niue", "<-11>11"},
-    {"Pacific/Norfolk", "<+11>-11<+12>,M10.1.0,M4.1.0/3"},
-    {"Pacific/Noumea", "<+11>-11"},
-    {"Pacific/Pago_Pago", "SST11"},
-    {"Pacific/Palau", "<+09>-9"},
-    {"Pacific/Pitcairn", "<-08>8"},
-    {"Pacific/Pohnpei", "<+11>-11"},
-    {"Pacific/Port_Moresby", "<+10>-10"},
-    {"Pacific/Rarotonga", "<-10>10"},
-    {"Pacific/Saipan", "ChST-10"},
-    {"Pacific/Tahiti", "<-10>10"},
-    {"Pacific/Tarawa", "<+12>-12"},
-    {"Pacific/Tongatapu", "<+13>-13"},
-    {"Pacific/Wake", "<+12>-12"},
-    {"Pacific/Wallis", "<+12>-12"},
+// Sorted by name
+inline constexpr zone_entry_t ZONES[ZONE_COUNT] PROGMEM = {
+    {0, 995}, // Africa/Abidjan
+    {15, 995}, // Africa/Accra
+    {28, 839}, // Africa/Addis_Ababa
+    {47, 737}, // Africa/Algiers
+    {62, 839}, // Africa/Asmara
+    {76, 995}, // Africa/Bamako
+    {90, 1277}, // Africa/Bangui
+    {104, 995}, // Africa/Banjul
+    {118, 995}, // Africa/Bissau
+    {132, 731}, // Africa/Blantyre
+    {148, 1277}, // Africa/Brazzaville
+    {167, 731}, // Africa/Bujumbura
+    {184, 845}, // Africa/Cairo
+    {197, 33}, // Africa/Casablanca
+    {215, 743}, // Africa/Ceuta
+    {228, 995}, // Africa/Conakry
+    {243, 995}, // Africa/Dakar
+    {256, 839}, // Africa/Dar_es_Salaam
+    {277, 839}, // Africa/Djibouti
+    {293, 1277}, // Africa/Douala
+    {307, 33}, // Africa/El_Aaiun
+    {323, 995}, // Africa/Freetown
+    {339, 731}, // Africa/Gaborone
+    {355, 731}, // Africa/Harare
+    {369, 1259}, // Africa/Johannesburg
+    {389, 731}, // Africa/Juba
+    {401, 839}, // Africa/Kampala
+    {416, 731}, // Africa/Khartoum
+    {432, 731}, // Africa/Kigali
+    {446, 1277}, // Africa/Kinshasa
+    {462, 1277}, // Africa/Lagos
+    {475, 1277}, // Africa/Libreville
+    {493, 995}, // Africa/Lome
+    {505, 1277}, // Africa/Luanda
+    {519, 731}, // Africa/Lubumbashi
+    {537, 731}, // Africa/Lusaka
+    {551, 1277}, // Africa/Malabo
+    {565, 731}, // Africa/Maputo
+    {579, 1259}, // Africa/Maseru
+    {593, 1259}, // Africa/Mbabane
+    {608, 839}, // Africa/Mogadishu
+    {625, 995}, // Africa/Monrovia
+    {641, 839}, // Africa/Nairobi
+    {656, 1277}, // Africa/Ndjamena
+    {672, 1277}, // Africa/Niamey
+    {686, 995}, // Africa/Nouakchott
+    {704, 995}, // Africa/Ouagadougou
+    {723, 1277}, // Africa/Porto-Novo
+    {741, 995}, // Africa/Sao_Tome
+    {757, 845}, // Africa/Tripoli
+    {772, 737}, // Africa/Tunis
+    {785, 731}, // Africa/Windhoek
+    {801, 1037}, // America/Adak
+    {814, 671}, // America/Anchorage
+    {832, 696}, // America/Anguilla
+    {849, 696}, // America/Antigua
+    {865, 386}, // America/Araguaina
+    {883, 386}, // America/Argentina/Buenos_Aires
+    {914, 386}, // America/Argentina/Catamarca
+    {942, 386}, // America/Argentina/Cordoba
+    {968, 386}, // America/Argentina/Jujuy
+    {992, 386}, // America/Argentina/La_Rioja
+    {1019, 386}, // America/Argentina/Mendoza
+    {1045, 386}, // America/Argentina/Rio_Gallegos
+    {1076, 386}, // America/Argentina/Salta
+    {1100, 386}, // America/Argentina/San_Juan
+    {1127, 386}, // America/Argentina/San_Luis
+    {1154, 386}, // America/Argentina/Tucuman
+    {1180, 386}, // America/Argentina/Ushuaia
+    {1206, 696}, // America/Aruba
+    {1220, 427}, // America/Asuncion
+    {1237, 967}, // America/Atikokan
+    {1254, 386}, // America/Bahia
+    {1268, 803}, // America/Bahia_Banderas
+    {1291, 696}, // America/Barbados
+    {1308, 386}, // America/Belem
+    {1322, 803}, // America/Belize
+    {1337, 696}, // America/Blanc-Sablon
+    {1358, 420}, // America/Boa_Vista
+    {1376, 490}, // America/Bogota
+    {1391, 1147}, // America/Boise
+    {1405, 1147}, // America/Cambridge_Bay
+    {1427, 420}, // America/Campo_Grande
+    {1448, 967}, // America/Cancun
+    {1463, 420}, // America/Caracas
+    {1479, 386}, // America/Cayenne
+    {1495, 967}, // America/Cayman
+    {1510, 808}, // America/Chicago
+    {1526, 803}, // America/Chihuahua
+    {1544, 803}, // America/Costa_Rica
+    {1563, 1142}, // America/Creston
+    {1579, 420}, // America/Cuiaba
+    {1594, 696}, // America/Curacao
+    {1610, 995}, // America/Danmarkshavn
+    {1631, 1142}, // America/Dawson
+    {1646, 1142}, // America/Dawson_Creek
+    {1667, 1147}, // America/Denver
+    {1682, 972}, // America/Detroit
+    {1698, 696}, // America/Dominica
+    {1715, 1147}, // America/Edmonton
+    {1732, 490}, // America/Eirunepe
+    {1749, 803}, // America/El_Salvador
+    {1769, 1142}, // America/Fort_Nelson
+    {1789, 386}, // America/Fortaleza
+    {1807, 701}, // America/Glace_Bay
+    {1825, 379}, // America/Godthab
+    {1841, 701}, // America/Goose_Bay
+    {1859, 972}, // America/Grand_Turk
+    {1878, 696}, // America/Grenada
+    {1894, 696}, // America/Guadeloupe
+    {1913, 803}, // America/Guatemala
+    {1931, 490}, // America/Guayaquil
+    {1949, 420}, // America/Guyana
+    {1964, 701}, // America/Halifax
+    {1980, 776}, // America/Havana
+    {1995, 1142}, // America/Hermosillo
+    {2014, 972}, // America/Indiana/Indianapolis
+    {2043, 808}, // America/Indiana/Knox
+    {2064, 972}, // America/Indiana/Marengo
+    {2088, 972}, // America/Indiana/Petersburg
+    {2115, 808}, // America/Indiana/Tell_City
+    {2141, 972}, // America/Indiana/Vevay
+    {2163, 972}, // America/Indiana/Vincennes
+    {2189, 972}, // America/Indiana/Winamac
+    {2213, 1147}, // America/Inuvik
+    {2228, 972}, // America/Iqaluit
+    {2244, 967}, // America/Jamaica
+    {2260, 671}, // America/Juneau
+    {2275, 972}, // America/Kentucky/Louisville
+    {2303, 972}, // America/Kentucky/Monticello
+    {2331, 696}, // America/Kralendijk
+    {2350, 420}, // America/La_Paz
+    {2365, 490}, // America/Lima
+    {2378, 1236}, // America/Los_Angeles
+    {2398, 696}, // America/Lower_Princes
+    {2420, 386}, // America/Maceio
+    {2435, 803}, // America/Managua
+    {2451, 420}, // America/Manaus
+    {2466, 696}, // America/Marigot
+    {2482, 696}, // America/Martinique
+    {2501, 808}, // America/Matamoros
+    {2519, 1142}, // America/Mazatlan
+    {2536, 808}, // America/Menominee
+    {2554, 803}, // America/Merida
+    {2569, 671}, // America/Metlakatla
+    {2588, 803}, // America/Mexico_City
+    {2608, 393}, // America/Miquelon
+    {2625, 701}, // America/Moncton
+    {2641, 803}, // America/Monterrey
+    {2659, 386}, // America/Montevideo
+    {2678, 972}, // America/Montreal
+    {2695, 696}, // America/Montserrat
+    {2714, 972}, // America/Nassau
+    {2729, 972}, // America/New_York
+    {2746, 972}, // America/Nipigon
+    {2762, 671}, // America/Nome
+    {2775, 379}, // America/Noronha
+    {2791, 808}, // America/North_Dakota/Beulah
+    {2819, 808}, // America/North_Dakota/Center
+    {2847, 808}, // America/North_Dakota/New_Salem
+    {2878, 379}, // America/Nuuk
+    {2891, 808}, // America/Ojinaga
+    {2907, 967}, // America/Panama
+    {2922, 972}, // America/Pangnirtung
+    {2942, 386}, // America/Paramaribo
+    {2961, 1142}, // America/Phoenix
+    {2977, 972}, // America/Port-au-Prince
+    {3000, 696}, // America/Port_of_Spain
+    {3022, 420}, // America/Porto_Velho
+    {3042, 696}, // America/Puerto_Rico
+    {3062, 386}, // America/Punta_Arenas
+    {3083, 808}, // America/Rainy_River
+    {3103, 808}, // America/Rankin_Inlet
+    {3124, 386}, // America/Recife
+    {3139, 803}, // America/Regina
+    {3154, 808}, // America/Resolute
+    {3171, 490}, // America/Rio_Branco
+    {3190, 386}, // America/Santarem
+    {3207, 458}, // America/Santiago
+    {3224, 696}, // America/Santo_Domingo
+    {3246, 386}, // America/Sao_Paulo
+    {3264, 348}, // America/Scoresbysund
+    {3285, 671}, // America/Sitka
+    {3299, 696}, // America/St_Barthelemy
+    {3321, 1170}, // America/St_Johns
+    {3338, 696}, // America/St_Kitts
+    {3355, 696}, // America/St_Lucia
+    {3372, 696}, // America/St_Thomas
+    {3390, 696}, // America/St_Vincent
+    {3409, 803}, // America/Swift_Current
+    {3431, 803}, // America/Tegucigalpa
+    {3451, 701}, // America/Thule
+    {3465, 972}, // America/Thunder_Bay
+    {3485, 1236}, // America/Tijuana
+    {3501, 972}, // America/Toronto
+    {3517, 696}, // America/Tortola
+    {3533, 1236}, // America/Vancouver
+    {3551, 1142}, // America/Whitehorse
+    {3570, 808}, // America/Winnipeg
+    {3587, 671}, // America/Yakutat
+    {3603, 1147}, // America/Yellowknife
+    {3623, 229}, // Antarctica/Casey
+    {3640, 146}, // Antarctica/Davis
+    {3657, 220}, // Antarctica/DumontDUrville
+    {3683, 642}, // Antarctica/Macquarie
+    {3704, 117}, // Antarctica/Mawson
+    {3722, 1196}, // Antarctica/McMurdo
+    {3741, 386}, // Antarctica/Palmer
+    {3759, 386}, // Antarctica/Rothera
+    {3778, 62}, // Antarctica/Syowa
+    {3795, 0}, // Antarctica/Troll
+    {3812, 138}, // Antarctica/Vostok
+    {3830, 743}, // Arctic/Longyearbyen
+    {3850, 62}, // Asia/Aden
+    {3860, 138}, // Asia/Almaty
+    {3872, 62}, // Asia/Amman
+    {3883, 314}, // Asia/Anadyr
+    {3895, 117}, // Asia/Aqtau
+    {3906, 117}, // Asia/Aqtobe
+    {3918, 117}, // Asia/Ashgabat
+    {3932, 117}, // Asia/Atyrau
+    {3944, 62}, // Asia/Baghdad
+    {3957, 62}, // Asia/Bahrain
+    {3970, 83}, // Asia/Baku
+    {3980, 146}, // Asia/Bangkok
+    {3993, 146}, // Asia/Barnaul
+    {4006, 909}, // Asia/Beirut
+    {4018, 138}, // Asia/Bishkek
+    {4031, 167}, // Asia/Brunei
+    {4043, 175}, // Asia/Chita
+    {4054, 167}, // Asia/Choibalsan
+    {4070, 91}, // Asia/Colombo
+    {4083, 62}, // Asia/Damascus
+    {4097, 138}, // Asia/Dhaka
+    {4108, 175}, // Asia/Dili
+    {4118, 83}, // Asia/Dubai
+    {4129, 117}, // Asia/Dushanbe
+    {4143, 938}, // Asia/Famagusta
+    {4158, 851}, // Asia/Gaza
+    {4168, 851}, // Asia/Hebron
+    {4180, 146}, // Asia/Ho_Chi_Minh
+    {4197, 1025}, // Asia/Hong_Kong
+    {4212, 146}, // Asia/Hovd
+    {4222, 167}, // Asia/Irkutsk
+    {4235, 1309}, // Asia/Jakarta
+    {4248, 1315}, // Asia/Jayapura
+    {4262, 1088}, // Asia/Jerusalem
+    {4277, 70}, // Asia/Kabul
+    {4288, 314}, // Asia/Kamchatka
+    {4303, 1224}, // Asia/Karachi
+    {4316, 104}, // Asia/Kathmandu
+    {4331, 175}, // Asia/Khandyga
+    {4345, 1115}, // Asia/Kolkata
+    {4358, 146}, // Asia/Krasnoyarsk
+    {4375, 167}, // Asia/Kuala_Lumpur
+    {4393, 167}, // Asia/Kuching
+    {4406, 62}, // Asia/Kuwait
+    {4418, 770}, // Asia/Macau
+    {4429, 229}, // Asia/Magadan
+    {4442, 1321}, // Asia/Makassar
+    {4456, 1230}, // Asia/Manila
+    {4468, 83}, // Asia/Muscat
+    {4480, 938}, // Asia/Nicosia
+    {4493, 146}, // Asia/Novokuznetsk
+    {4511, 146}, // Asia/Novosibirsk
+    {4528, 138}, // Asia/Omsk
+    {4538, 117}, // Asia/Oral
+    {4548, 146}, // Asia/Phnom_Penh
+    {4564, 1309}, // Asia/Pontianak
+    {4579, 1130}, // Asia/Pyongyang
+    {4594, 62}, // Asia/Qatar
+    {4605, 117}, // Asia/Qyzylorda
+    {4620, 62}, // Asia/Riyadh
+    {4632, 229}, // Asia/Sakhalin
+    {4646, 117}, // Asia/Samarkand
+    {4661, 1130}, // Asia/Seoul
+    {4672, 770}, // Asia/Shanghai
+    {4686, 167}, // Asia/Singapore
+    {4701, 229}, // Asia/Srednekolymsk
+    {4720, 770}, // Asia/Taipei
+    {4732, 117}, // Asia/Tashkent
+    {4746, 83}, // Asia/Tbilisi
+    {4759, 49}, // Asia/Tehran
+    {4771, 138}, // Asia/Thimphu
+    {4784, 1124}, // Asia/Tokyo
+    {4795, 146}, // Asia/Tomsk
+    {4806, 167}, // Asia/Ulaanbaatar
+    {4823, 138}, // Asia/Urumqi
+    {4835, 220}, // Asia/Ust-Nera
+    {4849, 146}, // Asia/Vientiane
+    {4864, 220}, // Asia/Vladivostok
+    {4881, 175}, // Asia/Yakutsk
+    {4894, 125}, // Asia/Yangon
+    {4906, 117}, // Asia/Yekaterinburg
+    {4925, 83}, // Asia/Yerevan
+    {4938, 348}, // Atlantic/Azores
+    {4954, 701}, // Atlantic/Bermuda
+    {4971, 1283}, // Atlantic/Canary
+    {4987, 341}, // Atlantic/Cape_Verde
+    {5007, 1283}, // Atlantic/Faroe
+    {5022, 1283}, // Atlantic/Madeira
+    {5039, 995}, // Atlantic/Reykjavik
+    {5058, 379}, // Atlantic/South_Georgia
+    {5081, 995}, // Atlantic/St_Helena
+    {5100, 386}, // Atlantic/Stanley
+    {5117, 603}, // Australia/Adelaide
+    {5136, 634}, // Australia/Brisbane
+    {5155, 603}, // Australia/Broken_Hill
+    {5177, 642}, // Australia/Currie
+    {5194, 593}, // Australia/Darwin
+    {5211, 154}, // Australia/Eucla
+    {5227, 642}, // Australia/Hobart
+    {5244, 634}, // Australia/Lindeman
+    {5263, 183}, // Australia/Lord_Howe
+    {5283, 642}, // Australia/Melbourne
+    {5303, 724}, // Australia/Perth
+    {5319, 642}, // Australia/Sydney
+    {5336, 995}, // Etc/GMT
+    {5344, 995}, // Etc/GMT+0
+    {5354, 341}, // Etc/GMT+1
+    {5364, 569}, // Etc/GMT+10
+    {5375, 577}, // Etc/GMT+11
+    {5386, 585}, // Etc/GMT+12
+    {5397, 379}, // Etc/GMT+2
+    {5407, 386}, // Etc/GMT+3
+    {5417, 420}, // Etc/GMT+4
+    {5427, 490}, // Etc/GMT+5
+    {5437, 497}, // Etc/GMT+6
+    {5447, 536}, // Etc/GMT+7
+    {5457, 543}, // Etc/GMT+8
+    {5467, 562}, // Etc/GMT+9
+    {5477, 995}, // Etc/GMT-0
+    {5487, 33}, // Etc/GMT-1
+    {5497, 220}, // Etc/GMT-10
+    {5508, 229}, // Etc/GMT-11
+    {5519, 314}, // Etc/GMT-12
+    {5530, 323}, // Etc/GMT-13
+    {5541, 332}, // Etc/GMT-14
+    {5552, 41}, // Etc/GMT-2
+    {5562, 62}, // Etc/GMT-3
+    {5572, 83}, // Etc/GMT-4
+    {5582, 117}, // Etc/GMT-5
+    {5592, 138}, // Etc/GMT-6
+    {5602, 146}, // Etc/GMT-7
+    {5612, 167}, // Etc/GMT-8
+    {5622, 175}, // Etc/GMT-9
+    {5632, 995}, // Etc/GMT0
+    {5641, 995}, // Etc/Greenwich
+    {5655, 1272}, // Etc/UCT
+    {5663, 1272}, // Etc/UTC
+    {5671, 1272}, // Etc/Universal
+    {5685, 1272}, // Etc/Zulu
+    {5694, 743}, // Europe/Amsterdam
+    {5711, 743}, // Europe/Andorra
+    {5726, 83}, // Europe/Astrakhan
+    {5743, 938}, // Europe/Athens
+    {5757, 743}, // Europe/Belgrade
+    {5773, 743}, // Europe/Berlin
+    {5787, 743}, // Europe/Bratislava
+    {5805, 743}, // Europe/Brussels
+    {5821, 938}, // Europe/Bucharest
+    {5838, 743}, // Europe/Budapest
+    {5854, 743}, // Europe/Busingen
+    {5870, 882}, // Europe/Chisinau
+    {5886, 743}, // Europe/Copenhagen
+    {5904, 1061}, // Europe/Dublin
+    {5918, 743}, // Europe/Gibraltar
+    {5935, 1000}, // Europe/Guernsey
+    {5951, 938}, // Europe/Helsinki
+    {5967, 1000}, // Europe/Isle_of_Man
+    {5986, 62}, // Europe/Istanbul
+    {6002, 1000}, // Europe/Jersey
+    {6016, 845}, // Europe/Kaliningrad
+    {6035, 938}, // Europe/Kiev
+    {6047, 62}, // Europe/Kirov
+    {6060, 1283}, // Europe/Lisbon
+    {6074, 743}, // Europe/Ljubljana
+    {6091, 1000}, // Europe/London
+    {6105, 743}, // Europe/Luxembourg
+    {6123, 743}, // Europe/Madrid
+    {6137, 743}, // Europe/Malta
+    {6150, 938}, // Europe/Mariehamn
+    {6167, 62}, // Europe/Minsk
+    {6180, 743}, // Europe/Monaco
+    {6194, 1136}, // Europe/Moscow
+    {6208, 743}, // Europe/Oslo
+    {6220, 743}, // Europe/Paris
+    {6233, 743}, // Europe/Podgorica
+    {6250, 743}, // Europe/Prague
+    {6264, 938}, // Europe/Riga
+    {6276, 743}, // Europe/Rome
+    {6288, 83}, // Europe/Samara
+    {6302, 743}, // Europe/San_Marino
+    {6320, 743}, // Europe/Sarajevo
+    {6336, 83}, // Europe/Saratov
+    {6351, 1136}, // Europe/Simferopol
+    {6369, 743}, // Europe/Skopje
+    {6383, 938}, // Europe/Sofia
+    {6396, 743}, // Europe/Stockholm
+    {6413, 938}, // Europe/Tallinn
+    {6428, 743}, // Europe/Tirane
+    {6442, 83}, // Europe/Ulyanovsk
+    {6459, 938}, // Europe/Uzhgorod
+    {6475, 743}, // Europe/Vaduz
+    {6488, 743}, // Europe/Vatican
+    {6503, 743}, // Europe/Vienna
+    {6517, 938}, // Europe/Vilnius
+    {6532, 62}, // Europe/Volgograd
+    {6549, 743}, // Europe/Warsaw
+    {6563, 743}, // Europe/Zagreb
+    {6577, 938}, // Europe/Zaporozhye
+    {6595, 743}, // Europe/Zurich
+    {6609, 839}, // Indian/Antananarivo
+    {6629, 138}, // Indian/Chagos
+    {6643, 146}, // Indian/Christmas
+    {6660, 125}, // Indian/Cocos
+    {6673, 839}, // Indian/Comoro
+    {6687, 117}, // Indian/Kerguelen
+    {6704, 83}, // Indian/Mahe
+    {6716, 117}, // Indian/Maldives
+    {6732, 83}, // Indian/Mauritius
+    {6749, 839}, // Indian/Mayotte
+    {6764, 83}, // Indian/Reunion
+    {6779, 323}, // Pacific/Apia
+    {6792, 1196}, // Pacific/Auckland
+    {6809, 229}, // Pacific/Bougainville
+    {6830, 269}, // Pacific/Chatham
+    {6846, 220}, // Pacific/Chuuk
+    {6860, 504}, // Pacific/Easter
+    {6875, 229}, // Pacific/Efate
+    {6889, 323}, // Pacific/Enderbury
+    {6907, 323}, // Pacific/Fakaofo
+    {6923, 314}, // Pacific/Fiji
+    {6936, 314}, // Pacific/Funafuti
+    {6953, 497}, // Pacific/Galapagos
+    {6971, 562}, // Pacific/Gambier
+    {6987, 229}, // Pacific/Guadalcanal
+    {7007, 831}, // Pacific/Guam
+    {7020, 1031}, // Pacific/Honolulu
+    {7037, 332}, // Pacific/Kiritimati
+    {7056, 229}, // Pacific/Kosrae
+    {7071, 314}, // Pacific/Kwajalein
+    {7089, 314}, // Pacific/Majuro
+    {7104, 550}, // Pacific/Marquesas
+    {7122, 1266}, // Pacific/Midway
+    {7137, 314}, // Pacific/Nauru
+    {7151, 577}, // Pacific/Niue
+    {7164, 238}, // Pacific/Norfolk
+    {7180, 229}, // Pacific/Noumea
+    {7195, 1266}, // Pacific/Pago_Pago
+    {7213, 175}, // Pacific/Palau
+    {7227, 543}, // Pacific/Pitcairn
+    {7244, 229}, // Pacific/Pohnpei
+    {7260, 220}, // Pacific/Port_Moresby
+    {7281, 569}, // Pacific/Rarotonga
+    {7299, 831}, // Pacific/Saipan
+    {7314, 569}, // Pacific/Tahiti
+    {7329, 314}, // Pacific/Tarawa
+    {7344, 323}, // Pacific/Tongatapu
+    {7362, 314}, // Pacific/Wake
+    {7375, 314}, // Pacific/Wallis
+};
+
+// Zone indices sorted by TZ string and then name, zones sharing a TZ string are adjacent
+inline constexpr uint16_t ZONES_BY_TZ[ZONE_COUNT] PROGMEM = {
+    210, 13, 20, 332, 338, 282, 209, 213, 215, 221, 222, 232, 256, 270, 272, 339,
+    370, 374, 382, 407, 247, 223, 235, 261, 281, 294, 340, 354, 391, 394, 401, 418,
+    420, 422, 231, 250, 205, 217, 218, 219, 220, 236, 266, 271, 274, 280, 293, 341,
+    417, 419, 292, 415, 211, 214, 227, 233, 265, 283, 287, 342, 413, 202, 224, 225,
+    240, 242, 253, 263, 264, 267, 285, 289, 343, 414, 310, 228, 230, 243, 254, 255,
+    277, 286, 344, 229, 234, 251, 291, 345, 450, 313, 203, 288, 290, 333, 427, 453,
+    201, 258, 273, 278, 334, 425, 429, 436, 440, 448, 452, 447, 426, 216, 248, 335,
+    432, 433, 441, 442, 445, 457, 459, 460, 336, 423, 430, 431, 458, 337, 439, 298,
+    319, 181, 295, 105, 156, 160, 302, 323, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 72, 75, 85, 103, 135, 149, 164, 170, 173, 177, 180,
+    207, 208, 304, 324, 146, 78, 82, 84, 91, 112, 131, 137, 168, 325, 70, 178,
+    79, 100, 111, 132, 176, 326, 327, 434, 428, 328, 329, 451, 443, 330, 435, 320,
+    454, 456, 321, 446, 322, 309, 305, 307, 306, 312, 204, 308, 311, 314, 316, 53,
+    127, 144, 155, 182, 199, 54, 55, 69, 74, 77, 92, 98, 108, 109, 130, 134,
+    138, 139, 151, 167, 169, 179, 183, 185, 186, 187, 188, 195, 104, 106, 113, 147,
+    191, 296, 315, 9, 11, 22, 23, 25, 27, 28, 34, 35, 37, 51, 3, 50,
+    14, 212, 352, 353, 356, 357, 358, 359, 361, 362, 364, 366, 376, 378, 379, 380,
+    383, 385, 386, 387, 388, 390, 392, 393, 396, 398, 400, 403, 404, 405, 408, 409,
+    411, 257, 276, 279, 114, 73, 76, 88, 89, 101, 110, 136, 143, 145, 148, 174,
+    189, 190, 87, 117, 120, 140, 142, 157, 158, 159, 161, 171, 172, 175, 198, 437,
+    455, 2, 4, 17, 18, 26, 40, 42, 412, 416, 421, 12, 49, 372, 238, 239,
+    363, 226, 237, 262, 355, 360, 368, 373, 381, 389, 397, 399, 402, 406, 410, 71,
+    83, 86, 126, 162, 97, 107, 116, 118, 119, 121, 122, 123, 125, 128, 129, 150,
+    152, 153, 154, 163, 166, 192, 194, 0, 1, 5, 7, 8, 15, 16, 21, 32,
+    41, 45, 46, 48, 93, 301, 303, 317, 318, 331, 346, 347, 367, 369, 371, 377,
+    241, 438, 52, 365, 246, 252, 284, 269, 275, 384, 395, 90, 94, 95, 102, 115,
+    141, 165, 197, 80, 81, 96, 99, 124, 200, 184, 206, 424, 249, 260, 133, 193,
+    196, 24, 38, 39, 444, 449, 348, 349, 350, 351, 6, 10, 19, 29, 30, 31,
+    33, 36, 43, 44, 47, 297, 299, 300, 375, 244, 268, 245, 259,
 };
 
 static const char FALLBACK_TZ[] PROGMEM = "GMT0";
 
-inline const char *resolve_timezone(const String &time_zone_label) {
-    for (size_t i = 0; i < sizeof(zones) / sizeof(zones[0]); i++) {
-        if (time_zone_label == zones[i].name) {
-            return zones[i].zones;
+inline const char *timezone_name(size_t index) { return ZONE_NAME_POOL + ZONES[index].name; }
+
+inline const char *timezone_posix(size_t index) { return TZ_POOL + ZONES[index].tz; }
+
+// Index of the zone with this IANA name, -1 if there is none
+inline int find_timezone(const char *name) {
+    size_t low = 0;
+    size_t high = ZONE_COUNT;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        int cmp = strcmp(name, timezone_name(mid));
+        if (cmp == 0) {
+            return static_cast<int>(mid);
+        }
+        if (cmp < 0) {
+            high = mid;
+        } else {
+            low = mid + 1;
+        }
+    }
+    return -1;
+}
+
+// Reverse lookup for the settings: index of the alphabetically first zone using this POSIX TZ string, -1 if none does
+inline int find_timezone_by_posix(const char *posix) {
+    size_t low = 0;
+    size_t high = ZONE_COUNT;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (strcmp(timezone_posix(ZONES_BY_TZ[mid]), posix) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
         }
     }
-    return FALLBACK_TZ;
+    if (low < ZONE_COUNT && strcmp(timezone_posix(ZONES_BY_TZ[low]), posix) == 0) {
+        return ZONES_BY_TZ[low];
+    }
+    return -1;
+}
+
+inline const char *resolve_timezone(const String &time_zone_label) {
+    int index = find_timezone(time_zone_label.c_str());
+    return index < 0 ? FALLBACK_TZ : timezone_posix(index);
 }
 
 #endif // ZONES_H
@@ -58,6 +58,7 @@ void LilyGo_TDisplayPanel::setBrightness(uint8_t level) {
     brightness = brightness > 255 ? 255 : brightness;
     brightness = brightness < 0 ? 0 : brightness;
 
+    _flush.wait();
     if (brightness > this->currentBrightness) {
         for (int i = this->currentBrightness; i <= brightness; i++) {
             display->setBrightness(i);
@@ -205,10 +206,20 @@ void LilyGo_TDisplayPanel::pushColors(uint16_t x, uint16_t y, uint16_t width, ui
     }
 }
 
+void LilyGo_TDisplayPanel::pushColorsAsync(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data,
+                                           display_flush_done_cb_t done, void *ctx) {
+    if (displayBus && display) {
+        _flush.push(x, y, width, height, data, done, ctx);
+    } else {
+        done(ctx);
+    }
+}
+
 void LilyGo_TDisplayPanel::setRotation(uint8_t rotation) {
     _rotation = rotation;
 
     if (displayBus && display) {
+        _flush.wait();
         display->setRotation(rotation);
     }
 }
@@ -20,6 +20,7 @@
 #include "pin_config.h"
 #include <SD_MMC.h>
 #include <TouchDrvInterface.hpp>
+#include <display/drivers/common/AsyncFlush.h>
 #include <display/drivers/common/Display.h>
 #include <display/drivers/common/ext.h>
 
@@ -86,8 +87,13 @@ class LilyGo_TDisplayPanel : public Display {
 
     void pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t hight, uint16_t *data);
 
+    void pushColorsAsync(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data, display_flush_done_cb_t done,
+                         void *ctx) override;
+
     bool supportsDirectMode() { return true; }
 
+    bool supportsAsyncFlush() override { return true; }
+
     void setRotation(uint8_t rotation);
 
   private:
@@ -102,6 +108,11 @@ class LilyGo_TDisplayPanel : public Display {
   private:
     uint8_t currentBrightness = 0;
 
+    // QSPI transfers run off the LVGL task, everything else using the bus waits for them first
+    AsyncFlush _flush{[this](uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data) {
+        display->draw16bitRGBBitmap(x, y, data, width, height);
+    }};
+
     LilyGo_TDisplayPanel_Wakeup_Method _wakeupMethod;
     uint64_t _sleepTimeUs;
 };
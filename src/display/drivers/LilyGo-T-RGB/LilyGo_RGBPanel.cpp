@@ -511,6 +511,12 @@ void LilyGo_RGBPanel::pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_
     esp_lcd_panel_draw_bitmap(_panelDrv, x, y, width, hight, data);
 }
 
+void LilyGo_RGBPanel::pushColorsAsync(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data,
+                                      display_flush_done_cb_t done, void *ctx) {
+    assert(_panelDrv);
+    _flush.push(x, y, width, height, data, done, ctx);
+}
+
 static void TouchDrvDigitalWrite(uint32_t gpio, uint8_t level) {
     if (gpio & 0x80) {
         extension.digitalWrite(gpio & 0x7F, level);
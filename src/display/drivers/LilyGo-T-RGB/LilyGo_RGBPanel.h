@@ -21,6 +21,7 @@
 #include <esp_lcd_panel_rgb.h>
 #include <esp_lcd_panel_vendor.h>
 
+#include <display/drivers/common/AsyncFlush.h>
 #include <display/drivers/common/Display.h>
 #include <display/drivers/common/ext.h>
 
@@ -89,8 +90,13 @@ class LilyGo_RGBPanel : public Display {
 
     void pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t hight, uint16_t *data);
 
+    void pushColorsAsync(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data, display_flush_done_cb_t done,
+                         void *ctx) override;
+
     bool supportsDirectMode() { return false; }
 
+    bool supportsAsyncFlush() override { return true; }
+
   private:
     void writeData(const uint8_t *data, int len);
 
@@ -106,6 +112,11 @@ class LilyGo_RGBPanel : public Display {
 
     TouchDrvInterface *_touchDrv;
 
+    // Copies areas into the panel's PSRAM frame buffer off the LVGL task
+    AsyncFlush _flush{[this](uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data) {
+        esp_lcd_panel_draw_bitmap(_panelDrv, x, y, x + width, y + height, data);
+    }};
+
     LilyGo_RGBPanel_Color_Order _order;
 
     bool _has_init;
@@ -934,6 +934,12 @@ void WavesharePanel::pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t
     esp_lcd_panel_draw_bitmap(_panelDrv, x, y, width, hight, data);
 }
 
+void WavesharePanel::pushColorsAsync(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data,
+                                     display_flush_done_cb_t done, void *ctx) {
+    assert(_panelDrv);
+    _flush.push(x, y, width, height, data, done, ctx);
+}
+
 static void TouchDrvDigitalWrite(uint32_t gpio, uint8_t level) {
     if (gpio == 0) {
         Set_EXIO(EXIO_PIN2, level);
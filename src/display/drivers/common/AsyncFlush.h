@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Display.h"
+#include <Arduino.h>
+#include <atomic>
+#include <functional>
+
+// Runs a display's blocking pixel transfer on its own task on the other core, so LVGL renders the next area into its
+// second draw buffer while the first one is sent to the panel. LVGL hands over a buffer only after the previous flush
+// reported done, so a single queue slot is enough.
+class AsyncFlush {
+  public:
+    using transfer_t = std::function<void(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data)>;
+
+    explicit AsyncFlush(transfer_t transfer) : transfer(std::move(transfer)) {}
+
+    void push(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data, display_flush_done_cb_t done, void *ctx) {
+        if (!start()) {
+            transfer(x, y, width, height, data);
+            done(ctx);
+            return;
+        }
+        Job job{x, y, width, height, data, done, ctx};
+        pending++;
+        xQueueSend(queue, &job, portMAX_DELAY);
+    }
+
+    // Blocks until the queued transfer finished, for callers that need the panel bus themselves
+    void wait() const {
+        while (pending > 0) {
+            delay(1);
+        }
+    }
+
+  private:
+    struct Job {
+        uint16_t x;
+        uint16_t y;
+        uint16_t width;
+        uint16_t height;
+        uint16_t *data;
+        display_flush_done_cb_t done;
+        void *ctx;
+    };
+
+    bool start() {
+        if (queue != nullptr) {
+            return true;
+        }
+        queue = xQueueCreate(1, sizeof(Job));
+        if (queue == nullptr) {
+            return false;
+        }
+        if (xTaskCreatePinnedToCore(loopTask, "AsyncFlush", configMINIMAL_STACK_SIZE * 4, this, 2, &taskHandle, 0) != pdPASS) {
+            vQueueDelete(queue);
+            queue = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    static void loopTask(void *arg) {
+        auto *flush = static_cast<AsyncFlush *>(arg);
+        Job job{};
+        while (true) {
+            if (xQueueReceive(flush->queue, &job, portMAX_DELAY) == pdTRUE) {
+                flush->transfer(job.x, job.y, job.width, job.height, job.data);
+                flush->pending--;
+                job.done(job.ctx);
+            }
+        }
+    }
+
+    transfer_t transfer;
+    QueueHandle_t queue = nullptr;
+    TaskHandle_t taskHandle = nullptr;
+    std::atomic<uint8_t> pending{0};
+};
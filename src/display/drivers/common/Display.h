@@ -2,16 +2,29 @@
 
 #include <stdint.h>
 
+// Called once a transfer started by pushColorsAsync no longer needs its pixel data
+using display_flush_done_cb_t = void (*)(void *ctx);
+
 class Display {
   public:
     virtual ~Display() = default;
 
     Display() : _rotation(0) {};
     virtual void pushColors(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data) = 0;
+    // Starts transferring a width x height block of pixels to (x, y) and may return before it finished, done(ctx) is
+    // called from the transferring task once data can be reused. Only one transfer is outstanding at a time.
+    virtual void pushColorsAsync(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t *data,
+                                 display_flush_done_cb_t done, void *ctx) {
+        pushColors(x, y, x + width, y + height, data);
+        done(ctx);
+    }
     virtual uint16_t width() = 0;
     virtual uint16_t height() = 0;
     virtual uint8_t getPoint(int16_t *x, int16_t *y, uint8_t get_point) = 0;
     virtual bool supportsDirectMode() = 0;
+    // Whether pushColorsAsync overlaps the transfer with rendering, LVGL then renders into two small internal SRAM
+    // buffers instead of full screen PSRAM ones
+    virtual bool supportsAsyncFlush() { return false; }
 
   protected:
     uint8_t _rotation;
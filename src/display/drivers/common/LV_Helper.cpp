@@ -8,11 +8,17 @@
  *
  */
 #include "LV_Helper.h"
+#include <esp_heap_caps.h>
 
 #if LV_VERSION_CHECK(9, 0, 0)
 #error "Currently not supported 9.x"
 #endif
 
+// Lines per internal SRAM draw buffer when the display flushes asynchronously
+#ifndef LV_HELPER_PARTIAL_LINES
+#define LV_HELPER_PARTIAL_LINES 24
+#endif
+
 static lv_disp_draw_buf_t draw_buf;
 static lv_disp_drv_t disp_drv;
 static lv_indev_drv_t indev_drv;
@@ -68,6 +74,38 @@ static void disp_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_
     lv_disp_flush_ready(disp_drv);
 }
 
+static void disp_flush_done(void *ctx) { lv_disp_flush_ready(static_cast<lv_disp_drv_t *>(ctx)); }
+
+/* Partial mode flushing, returns while the panel transfer is still running */
+static void disp_flush_async(lv_disp_drv_t *disp_drv, const lv_area_t *area, lv_color_t *color_p) {
+    static_cast<Display *>(disp_drv->user_data)
+        ->pushColorsAsync(area->x1, area->y1, lv_area_get_width(area), lv_area_get_height(area), (uint16_t *)color_p,
+                          disp_flush_done, disp_drv);
+}
+
+/* Some panels (CO5300) only accept windows that start and end on even pixels, all supported panels have even sizes */
+static void disp_rounder(lv_disp_drv_t *disp_drv, lv_area_t *area) {
+    LV_UNUSED(disp_drv);
+    area->x1 &= ~1;
+    area->y1 &= ~1;
+    area->x2 |= 1;
+    area->y2 |= 1;
+}
+
+static bool alloc_partial_buffers(Display &board) {
+    size_t lv_buffer_size = board.width() * LV_HELPER_PARTIAL_LINES * sizeof(lv_color_t);
+    buf = (lv_color_t *)heap_caps_malloc(lv_buffer_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    buf1 = (lv_color_t *)heap_caps_malloc(lv_buffer_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    if (buf == NULL || buf1 == NULL) {
+        heap_caps_free(buf);
+        heap_caps_free(buf1);
+        buf = NULL;
+        buf1 = NULL;
+        return false;
+    }
+    return true;
+}
+
 /*Read the touchpad*/
 static void touchpad_read(lv_indev_drv_t *indev_driver, lv_indev_data_t *data) {
     static int16_t x, y;
@@ -110,26 +148,40 @@ void beginLvglHelper(Display &board, bool debug) {
     }
 #endif
 
-    size_t lv_buffer_size = board.width() * board.height() * sizeof(lv_color_t);
-    buf = (lv_color_t *)ps_malloc(lv_buffer_size);
-    assert(buf);
-
-    if (!board.supportsDirectMode()) {
-        buf1 = (lv_color_t *)ps_malloc(lv_buffer_size);
-        assert(buf1);
+    // Rendering into internal SRAM is much faster than into PSRAM, and with two buffers LVGL renders the next area while
+    // the previous one is transferred. Fall back to full screen PSRAM buffers when the driver flushes synchronously or
+    // the internal heap is short.
+    bool partial = board.supportsAsyncFlush() && alloc_partial_buffers(board);
+    if (partial) {
+        lv_disp_draw_buf_init(&draw_buf, buf, buf1, board.width() * LV_HELPER_PARTIAL_LINES);
+    } else {
+        if (board.supportsAsyncFlush()) {
+            log_w("Not enough internal memory for partial draw buffers, using PSRAM");
+        }
+        size_t lv_buffer_size = board.width() * board.height() * sizeof(lv_color_t);
+        buf = (lv_color_t *)ps_malloc(lv_buffer_size);
+        assert(buf);
+
+        if (!board.supportsDirectMode()) {
+            buf1 = (lv_color_t *)ps_malloc(lv_buffer_size);
+            assert(buf1);
+        }
+
+        lv_disp_draw_buf_init(&draw_buf, buf, buf1, board.width() * board.height());
     }
 
-    lv_disp_draw_buf_init(&draw_buf, buf, buf1, board.width() * board.height());
-
     /*Initialize the display*/
     lv_disp_drv_init(&disp_drv);
     /* display resolution */
     disp_drv.hor_res = board.width();
     disp_drv.ver_res = board.height();
-    disp_drv.flush_cb = disp_flush;
+    disp_drv.flush_cb = partial ? disp_flush_async : disp_flush;
     disp_drv.draw_buf = &draw_buf;
     disp_drv.full_refresh = 0;
-    disp_drv.direct_mode = board.supportsDirectMode();
+    disp_drv.direct_mode = !partial && board.supportsDirectMode();
+    if (partial) {
+        disp_drv.rounder_cb = disp_rounder;
+    }
     disp_drv.user_data = &board;
     lv_disp_drv_register(&disp_drv);
 
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <memory>
 
 enum class TargetType { TARGET_TYPE_VOLUMETRIC, TARGET_TYPE_PRESSURE, TARGET_TYPE_FLOW, TARGET_TYPE_PUMPED };
 enum class TargetOperator { LTE, GTE };
@@ -11,6 +12,7 @@ enum class PumpTarget {
     PUMP_TARGET_PRESSURE,
 };
 enum class PhaseType { PHASE_TYPE_PREINFUSION, PHASE_TYPE_BREW };
+enum class ProfileType { PROFILE_TYPE_STANDARD, PROFILE_TYPE_PRO };
 enum class TransitionType { INSTANT, LINEAR, EASE_IN, EASE_OUT, EASE_IN_OUT };
 
 struct Target {
@@ -69,7 +71,7 @@ struct Phase {
     }
 
     bool isFinished(bool enableVolumetric, float volume, float time_in_phase, float current_flow, float current_pressure,
-                    float water_pumped, String type) const {
+                    float water_pumped, ProfileType type) const {
         bool volumetricTested = false;
         for (const auto &target : targets) {
             switch (target.type) {
@@ -96,7 +98,7 @@ struct Phase {
                 break;
             }
         }
-        if (type == "standard" && volumetricTested) {
+        if (type == ProfileType::PROFILE_TYPE_STANDARD && volumetricTested) {
             return false;
         }
         return time_in_phase > duration;
@@ -106,7 +108,7 @@ struct Phase {
 struct Profile {
     String id;
     String label;
-    String type; // "standard" | "pro"
+    ProfileType type = ProfileType::PROFILE_TYPE_STANDARD; // "standard" | "pro"
     String description;
     float temperature;
     bool favorite = false;
@@ -135,11 +137,14 @@ struct Profile {
     }
 };
 
+// Shared read only profile, see ProfileManager
+using ProfileRef = std::shared_ptr<const Profile>;
+
 inline bool parseProfile(const JsonObject &obj, Profile &profile) {
     if (obj["id"].is<String>())
         profile.id = obj["id"].as<String>();
     profile.label = obj["label"].as<String>();
-    profile.type = obj["type"].as<String>();
+    profile.type = obj["type"].as<String>() == "standard" ? ProfileType::PROFILE_TYPE_STANDARD : ProfileType::PROFILE_TYPE_PRO;
     profile.description = obj["description"].as<String>();
     profile.temperature = obj["temperature"].as<float>();
     profile.favorite = obj["favorite"] | false;
@@ -230,7 +235,7 @@ inline bool parseProfile(const JsonObject &obj, Profile &profile) {
 inline void writeProfile(JsonObject &obj, const Profile &profile) {
     obj["id"] = profile.id;
     obj["label"] = profile.label;
-    obj["type"] = profile.type;
+    obj["type"] = profile.type == ProfileType::PROFILE_TYPE_STANDARD ? "standard" : "pro";
     obj["description"] = profile.description;
     obj["temperature"] = profile.temperature;
     obj["favorite"] = profile.favorite;
@@ -0,0 +1,252 @@
+#ifndef SHOT_ANALYTICS_H
+#define SHOT_ANALYTICS_H
+
+#include "shot_log_format.h"
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+// Computes the analytics stored in /h/<id>.sa (see shot_log_format.h) from the samples as they are recorded. Every
+// sample is visited once and only running sums are kept, finishing a shot costs the same however long it ran.
+// Phases are announced with beginPhase, samples before the first announcement open an unnamed phase.
+class ShotAnalyzer {
+  public:
+    void reset() {
+        memset(phases, 0, sizeof(phases));
+        memset(&result, 0, sizeof(result));
+        phaseCount = 0;
+        phase = Accumulator{};
+        shot = Accumulator{};
+        pending = false;
+        scaleDripTick = SHOT_ANALYTICS_NO_DRIP;
+        estimatedDripTick = SHOT_ANALYTICS_NO_DRIP;
+    }
+
+    // The phase starts with the first sample at or after startTick
+    void beginPhase(uint16_t startTick, const char *name) {
+        if (phaseCount > 0 && phases[phaseCount - 1].name[0] == '\0' && phase.count > 0 && !pending) {
+            copyName(phases[phaseCount - 1].name, name); // samples arrived before the first phase was known
+            return;
+        }
+        pending = true;
+        pendingTick = startTick;
+        copyName(pendingName, name);
+    }
+
+    void add(const ShotLogSample &sample) {
+        if (phaseCount == 0 || (pending && sample.t >= pendingTick)) {
+            openPhase(pending ? pendingTick : sample.t);
+        }
+        phase.add(sample);
+        shot.add(sample);
+        if (scaleDripTick == SHOT_ANALYTICS_NO_DRIP && sample.v >= SHOT_ANALYTICS_DRIP_WEIGHT) {
+            scaleDripTick = sample.t;
+        }
+        if (estimatedDripTick == SHOT_ANALYTICS_NO_DRIP && sample.ev >= SHOT_ANALYTICS_DRIP_WEIGHT) {
+            estimatedDripTick = sample.t;
+        }
+    }
+
+    // Closes the open phase and fills the header, phases() then holds header().phaseCount records
+    void finish() {
+        if (phaseCount > 0) {
+            closePhase(phase.lastTick);
+        }
+        result.magic = SHOT_ANALYTICS_MAGIC;
+        result.version = SHOT_ANALYTICS_VERSION;
+        result.phaseCount = phaseCount;
+        result.phaseSize = SHOT_ANALYTICS_PHASE_SIZE;
+
+        ShotAnalyticsSummary &summary = result.summary;
+        summary.flags = SHOT_ANALYTICS_FLAG_VALID;
+        if (scaleDripTick != SHOT_ANALYTICS_NO_DRIP) {
+            summary.flags |= SHOT_ANALYTICS_FLAG_SCALE_DRIP;
+            summary.firstDripTick = scaleDripTick;
+        } else {
+            summary.firstDripTick = estimatedDripTick;
+        }
+        uint16_t channelEvents = 0;
+        for (uint8_t i = 0; i < phaseCount; i++) {
+            channelEvents += phases[i].channelEvents;
+        }
+        summary.channelEvents = static_cast<uint8_t>(channelEvents < 0xFF ? channelEvents : 0xFF);
+        summary.avgPressure = shot.average(shot.pressureSum, shot.count);
+        summary.peakPressure = shot.pressurePeak;
+        summary.avgFlow = static_cast<int16_t>(shot.puckFlowSum / static_cast<int32_t>(shot.count > 0 ? shot.count : 1));
+        summary.peakFlow = shot.puckFlowPeak;
+        summary.tempStdDev = shot.tempStdDev();
+        summary.resistanceTrend = shot.resistanceTrend();
+    }
+
+    const ShotAnalyticsHeader &header() const { return result; }
+    const ShotPhaseAnalytics *phaseRecords() const { return phases; }
+
+  private:
+    struct Accumulator {
+        uint16_t startTick = 0;
+        uint16_t lastTick = 0;
+        uint32_t count = 0;
+        uint32_t pressureSum = 0;
+        uint16_t pressurePeak = 0;
+        int32_t pumpFlowSum = 0;
+        int32_t puckFlowSum = 0;
+        int16_t puckFlowPeak = 0;
+        uint16_t weight = 0;
+
+        // Samples under pressure with puck flow, seconds since startTick
+        uint32_t resistanceCount = 0;
+        double resistanceSum = 0.0;
+        double timeSum = 0.0;
+        double timeSquares = 0.0;
+        double productSum = 0.0;
+        uint16_t resistancePeak = 0;
+        bool channeling = false;
+        uint8_t channelEvents = 0;
+        uint8_t maxDrop = 0;
+
+        // Temperature error in 0.1 °C
+        uint32_t tempCount = 0;
+        int32_t tempErrorSum = 0;
+        double tempErrorSquares = 0.0;
+        uint16_t maxTempDeviation = 0;
+
+        void add(const ShotLogSample &sample) {
+            count++;
+            lastTick = sample.t;
+            pressureSum += sample.cp;
+            pressurePeak = sample.cp > pressurePeak ? sample.cp : pressurePeak;
+            pumpFlowSum += sample.fl;
+            puckFlowSum += sample.pf;
+            puckFlowPeak = sample.pf > puckFlowPeak ? sample.pf : puckFlowPeak;
+            weight = sample.v > 0 ? sample.v : sample.ev;
+
+            if (sample.tt > 0) {
+                const int32_t error = static_cast<int32_t>(sample.ct) - static_cast<int32_t>(sample.tt);
+                const auto deviation = static_cast<uint16_t>(error < 0 ? -error : error);
+                tempCount++;
+                tempErrorSum += error;
+                tempErrorSquares += static_cast<double>(error) * error;
+                maxTempDeviation = deviation > maxTempDeviation ? deviation : maxTempDeviation;
+            }
+
+            if (sample.cp < SHOT_ANALYTICS_MIN_PRESSURE || sample.pf <= 0) {
+                return;
+            }
+            const double time = static_cast<double>(static_cast<uint16_t>(sample.t - startTick)) * SHOT_LOG_TICK_MS / 1000.0;
+            resistanceCount++;
+            resistanceSum += sample.pr;
+            timeSum += time;
+            timeSquares += time * time;
+            productSum += time * sample.pr;
+            // A resistance collapse while the pressure holds is the signature of a channel opening through the puck,
+            // half the drop has to be recovered before the next one counts
+            if (sample.pr >= resistancePeak) {
+                resistancePeak = sample.pr;
+            }
+            if (resistancePeak == 0) {
+                return;
+            }
+            const auto drop = static_cast<uint8_t>((static_cast<uint32_t>(resistancePeak - sample.pr) * 100) / resistancePeak);
+            maxDrop = drop > maxDrop ? drop : maxDrop;
+            if (!channeling && drop >= SHOT_ANALYTICS_CHANNEL_DROP) {
+                channeling = true;
+                channelEvents += channelEvents < 0xFF ? 1 : 0;
+            } else if (channeling && drop < SHOT_ANALYTICS_CHANNEL_DROP / 2) {
+                channeling = false;
+            }
+        }
+
+        static uint16_t average(uint32_t sum, uint32_t samples) {
+            return static_cast<uint16_t>(samples > 0 ? (sum + samples / 2) / samples : 0);
+        }
+
+        int16_t resistanceTrend() const {
+            const double n = resistanceCount;
+            const double denominator = n * timeSquares - timeSum * timeSum;
+            if (resistanceCount < 2 || denominator <= 0.0) {
+                return 0;
+            }
+            return clamp16((n * productSum - timeSum * resistanceSum) / denominator);
+        }
+
+        int16_t avgTempError() const {
+            return tempCount > 0 ? clamp16(static_cast<double>(tempErrorSum) * 10.0 / tempCount) : 0;
+        }
+
+        uint16_t tempStdDev() const {
+            if (tempCount == 0) {
+                return 0;
+            }
+            const double mean = static_cast<double>(tempErrorSum) / tempCount;
+            const double variance = tempErrorSquares / tempCount - mean * mean;
+            const double deviation = variance > 0.0 ? sqrt(variance) * 10.0 : 0.0;
+            return static_cast<uint16_t>(deviation < 0xFFFF ? deviation + 0.5 : 0xFFFF);
+        }
+
+        static int16_t clamp16(double value) {
+            if (!(value > -32768.0)) {
+                return value < 0.0 ? -32768 : 0; // also NaN
+            }
+            return static_cast<int16_t>(value < 32767.0 ? lround(value) : 32767);
+        }
+    };
+
+    void openPhase(uint16_t startTick) {
+        if (phaseCount == SHOT_ANALYTICS_MAX_PHASES) {
+            pending = false; // later phases are counted into the last one
+            return;
+        }
+        if (phaseCount > 0) {
+            closePhase(startTick);
+        }
+        ShotPhaseAnalytics &record = phases[phaseCount++];
+        if (pending) {
+            copyName(record.name, pendingName);
+            pending = false;
+        }
+        phase = Accumulator{};
+        phase.startTick = startTick;
+        phase.lastTick = startTick;
+    }
+
+    void closePhase(uint16_t endTick) {
+        ShotPhaseAnalytics &record = phases[phaseCount - 1];
+        record.startTick = phase.startTick;
+        record.durationTick = static_cast<uint16_t>(endTick - phase.startTick);
+        record.sampleCount = static_cast<uint16_t>(phase.count < 0xFFFF ? phase.count : 0xFFFF);
+        record.avgPressure = Accumulator::average(phase.pressureSum, phase.count);
+        record.peakPressure = phase.pressurePeak;
+        const int32_t samples = phase.count > 0 ? static_cast<int32_t>(phase.count) : 1;
+        record.avgPumpFlow = static_cast<int16_t>(phase.pumpFlowSum / samples);
+        record.avgPuckFlow = static_cast<int16_t>(phase.puckFlowSum / samples);
+        record.peakPuckFlow = phase.puckFlowPeak;
+        record.avgResistance = phase.resistanceCount > 0
+                                   ? static_cast<uint16_t>(phase.resistanceSum / phase.resistanceCount + 0.5)
+                                   : 0;
+        record.resistanceTrend = phase.resistanceTrend();
+        record.avgTempError = phase.avgTempError();
+        record.tempStdDev = phase.tempStdDev();
+        record.maxTempDeviation = phase.maxTempDeviation;
+        record.weight = phase.weight;
+        record.channelEvents = phase.channelEvents;
+        record.maxResistanceDrop = phase.maxDrop;
+    }
+
+    static void copyName(char *name, const char *source) {
+        strncpy(name, source, sizeof(ShotPhaseAnalytics::name) - 1);
+        name[sizeof(ShotPhaseAnalytics::name) - 1] = '\0';
+    }
+
+    ShotPhaseAnalytics phases[SHOT_ANALYTICS_MAX_PHASES]{};
+    ShotAnalyticsHeader result{};
+    uint8_t phaseCount = 0;
+    Accumulator phase;
+    Accumulator shot;
+    bool pending = false;
+    uint16_t pendingTick = 0;
+    char pendingName[sizeof(ShotPhaseAnalytics::name)]{};
+    uint16_t scaleDripTick = SHOT_ANALYTICS_NO_DRIP;
+    uint16_t estimatedDripTick = SHOT_ANALYTICS_NO_DRIP;
+};
+
+#endif // SHOT_ANALYTICS_H
@@ -0,0 +1,148 @@
+#ifndef SHOT_LOG_CODEC_H
+#define SHOT_LOG_CODEC_H
+
+#include "shot_log_format.h"
+#include <stddef.h>
+#include <string.h>
+
+// Block encoder and decoder for the v2 shot log layout described in shot_log_format.h.
+// Deltas are taken modulo 2^16 on the raw field bits, so signed and unsigned fields share one code path.
+
+// IEEE crc32 (same result as zlib crc32), nibble table to keep it small
+inline uint32_t shotLogCrc32(uint32_t crc, const uint8_t *data, size_t length) {
+    static constexpr uint32_t TABLE[16] = {0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4,
+                                           0x4DB26158, 0x5005713C, 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+                                           0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C};
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = TABLE[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+        crc = TABLE[(crc ^ (data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+class ShotLogBlockEncoder {
+  public:
+    explicit ShotLogBlockEncoder(uint32_t fieldsMask = SHOT_LOG_FIELDS_MASK_ALL) { setFieldsMask(fieldsMask); }
+
+    void setFieldsMask(uint32_t mask) {
+        fieldsMask = static_cast<uint16_t>(mask & SHOT_LOG_FIELDS_MASK_ALL);
+        reset();
+    }
+
+    void reset() {
+        memset(previous, 0, sizeof(previous));
+        count = 0;
+        length = SHOT_LOG_BLOCK_HEADER_SIZE;
+        tick = 0;
+    }
+
+    // Appends a sample to the current block, returns false when the block is already full
+    bool append(const ShotLogSample &sample) {
+        if (full()) {
+            return false;
+        }
+        uint16_t values[SHOT_LOG_FIELD_COUNT];
+        memcpy(values, &sample, sizeof(values));
+        if (count == 0 && (fieldsMask & 0x01)) {
+            tick = values[0];
+        }
+        uint16_t changed = 0;
+        for (uint8_t i = 0; i < SHOT_LOG_FIELD_COUNT; i++) {
+            if ((fieldsMask & (1u << i)) && values[i] != previous[i]) {
+                changed |= 1u << i;
+            }
+        }
+        writeVarint(changed);
+        for (uint8_t i = 0; i < SHOT_LOG_FIELD_COUNT; i++) {
+            if (changed & (1u << i)) {
+                auto delta = static_cast<int16_t>(values[i] - previous[i]);
+                writeVarint(static_cast<uint16_t>((static_cast<uint16_t>(delta) << 1) ^ static_cast<uint16_t>(delta >> 15)));
+                previous[i] = values[i];
+            }
+        }
+        count++;
+        return true;
+    }
+
+    bool full() const { return count >= SHOT_LOG_BLOCK_SAMPLES; }
+    bool empty() const { return count == 0; }
+    uint16_t sampleCount() const { return count; }
+    uint16_t firstTick() const { return tick; }
+
+    // Fills in the block header. data() and size() then hold the complete block until the next reset().
+    void finish() {
+        ShotLogBlockHeader header{};
+        header.sampleCount = count;
+        header.payloadSize = static_cast<uint16_t>(length - SHOT_LOG_BLOCK_HEADER_SIZE);
+        header.crc32 = shotLogCrc32(0, buffer + SHOT_LOG_BLOCK_HEADER_SIZE, header.payloadSize);
+        memcpy(buffer, &header, sizeof(header));
+    }
+
+    const uint8_t *data() const { return buffer; }
+    size_t size() const { return length; }
+
+  private:
+    void writeVarint(uint16_t value) {
+        while (value >= 0x80) {
+            buffer[length++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        buffer[length++] = static_cast<uint8_t>(value);
+    }
+
+    uint8_t buffer[SHOT_LOG_BLOCK_HEADER_SIZE + SHOT_LOG_BLOCK_MAX_PAYLOAD];
+    uint16_t previous[SHOT_LOG_FIELD_COUNT];
+    uint16_t fieldsMask = 0;
+    uint16_t count = 0;
+    uint16_t tick = 0;
+    size_t length = SHOT_LOG_BLOCK_HEADER_SIZE;
+};
+
+// Decodes one block payload into out. Returns the number of samples, or -1 when the crc does not match, the payload is
+// malformed or out cannot hold all samples.
+inline int decodeShotLogBlock(const ShotLogBlockHeader &header, const uint8_t *payload, uint32_t fieldsMask, ShotLogSample *out,
+                              size_t maxSamples) {
+    if (header.sampleCount > maxSamples || header.payloadSize > SHOT_LOG_BLOCK_MAX_PAYLOAD ||
+        shotLogCrc32(0, payload, header.payloadSize) != header.crc32) {
+        return -1;
+    }
+    size_t position = 0;
+    auto readVarint = [&](uint16_t &value) {
+        uint32_t result = 0;
+        for (uint8_t shift = 0; shift < 21; shift += 7) {
+            if (position >= header.payloadSize) {
+                return false;
+            }
+            uint8_t byte = payload[position++];
+            result |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                value = static_cast<uint16_t>(result);
+                return result <= 0xFFFF;
+            }
+        }
+        return false;
+    };
+
+    uint16_t values[SHOT_LOG_FIELD_COUNT] = {};
+    for (uint16_t s = 0; s < header.sampleCount; s++) {
+        uint16_t changed;
+        if (!readVarint(changed) || (changed & ~fieldsMask)) {
+            return -1;
+        }
+        for (uint8_t i = 0; i < SHOT_LOG_FIELD_COUNT; i++) {
+            if (changed & (1u << i)) {
+                uint16_t zigzag;
+                if (!readVarint(zigzag)) {
+                    return -1;
+                }
+                auto delta = static_cast<uint16_t>((zigzag >> 1) ^ -(zigzag & 1));
+                values[i] = static_cast<uint16_t>(values[i] + delta);
+            }
+        }
+        memcpy(&out[s], values, sizeof(values));
+    }
+    return position == header.payloadSize ? header.sampleCount : -1;
+}
+
+#endif // SHOT_LOG_CODEC_H
@@ -3,54 +3,88 @@
 
 #include <stdint.h>
 
-// Binary shot log format v1 (no backward compatibility with previous CSV)
+// Binary shot log format (no backward compatibility with previous CSV)
 // All values little-endian. Floats are IEEE-754 32-bit.
 // File extension: .slog
-// Layout:
-//   Header (fixed size = 128 bytes) followed by contiguous sample records.
-//   Header fields set at start; sampleCount & durationMs patched at end.
-// Per-sample record fields are ALWAYS present in fixed order.
+// Header (fixed size = 128 bytes), header fields set at start; sampleCount, durationMs and the v2 index fields patched at end.
+// Per-sample fields in fixed order (bit n of fieldsMask = field n):
 //   tick(uint16_t), tt(uint16_t), ct(uint16_t), tp(uint16_t), cp(uint16_t), fl(int16_t), tf(int16_t), pf(int16_t), vf(int16_t),
 //   v(uint16_t), ev(uint16_t), pr(uint16_t)
 // Values are stored as scaled integers (see comments per field below).
-// Sample size = 12 fields * 2 bytes = 24 bytes.
+//
+// v1 layout:
+//   Header followed by contiguous raw ShotLogSample records, sample size = 12 fields * 2 bytes = 24 bytes.
+//
+// v2 layout:
+//   Header followed by blocks of up to SHOT_LOG_BLOCK_SAMPLES samples, then the block index at header.indexOffset.
+//   Block: ShotLogBlockHeader + payload. Per sample the payload holds a varint bitmask of the fields that changed, then a
+//   zigzag varint delta per changed field. Deltas restart from zero in every block, so each block decodes on its own.
+//   crc32 (IEEE, as zlib) covers the payload. Only fields in fieldsMask are encoded, the rest decode as 0.
+//   Index: blockCount ShotLogBlockIndexEntry records followed by their crc32. Shots that were cut short have no index
+//   (indexOffset = 0), readers then walk the blocks from the header up to the first one that fails its crc.
 
 static constexpr uint32_t SHOT_LOG_MAGIC = 0x544F4853; // 'S''H''O''T' little-endian 0x54 0x4F 0x48 0x53
-static constexpr uint8_t SHOT_LOG_VERSION = 1;
+static constexpr uint8_t SHOT_LOG_VERSION_RAW = 1;
+static constexpr uint8_t SHOT_LOG_VERSION_BLOCKS = 2;
+static constexpr uint8_t SHOT_LOG_VERSION = SHOT_LOG_VERSION_BLOCKS; // version written by new recordings
 static constexpr uint16_t SHOT_LOG_HEADER_SIZE = 128;
-static constexpr uint16_t SHOT_LOG_SAMPLE_INTERVAL_MS = 250; // nominal recording interval
+static constexpr uint16_t SHOT_LOG_SAMPLE_INTERVAL_MS = 250; // recording task interval
+static constexpr uint16_t SHOT_LOG_TICK_MS = 10;             // tick resolution, stored as sampleInterval
 static constexpr uint32_t SHOT_LOG_FIELDS_MASK_ALL = 0x0FFF; // 12 fields present
+static constexpr uint8_t SHOT_LOG_FIELD_COUNT = 12;
 
 static constexpr uint32_t SHOT_LOG_SAMPLE_SIZE = 24;
 
+static constexpr uint16_t SHOT_LOG_BLOCK_SAMPLES = 64;        // ~2 s at the controller sample rate
+static constexpr uint16_t SHOT_LOG_BLOCK_HEADER_SIZE = 8;
+static constexpr uint16_t SHOT_LOG_BLOCK_INDEX_ENTRY_SIZE = 12;
+// Worst case per sample: 2 byte changed mask + 3 byte delta per field
+static constexpr uint16_t SHOT_LOG_BLOCK_MAX_PAYLOAD = SHOT_LOG_BLOCK_SAMPLES * (2 + SHOT_LOG_FIELD_COUNT * 3);
+
 #pragma pack(push, 1)
 struct ShotLogHeader {
     uint32_t magic;          // SHOT_LOG_MAGIC
     uint8_t version;         // = SHOT_LOG_VERSION
     uint8_t reserved0;       // stores sample size (SHOT_LOG_SAMPLE_SIZE) for diagnostics
     uint16_t headerSize;     // = SHOT_LOG_HEADER_SIZE
-    uint16_t sampleInterval; // ms (nominal)
-    uint16_t reserved1;      // future
-    uint32_t fieldsMask;     // bitmask (currently always SHOT_LOG_FIELDS_MASK_ALL)
+    uint16_t sampleInterval; // ms per tick
+    uint16_t blockSamples;   // v2: max samples per block (SHOT_LOG_BLOCK_SAMPLES), v1: reserved
+    uint32_t fieldsMask;     // bitmask of recorded fields
     uint32_t sampleCount;    // patched at end
     uint32_t durationMs;     // patched at end (last t)
     uint32_t startEpoch;     // epoch seconds
     char profileId[32];      // null-terminated
     char profileName[48];    // null-terminated
     uint16_t finalWeight;    // final beverage weight (g * 10)
-    uint8_t reserved[128 - 4 - 1 - 1 - 2 - 2 - 2 - 4 - 4 - 4 - 4 - 32 - 48 - 2]; // pad to 128
+    uint32_t indexOffset;    // v2: file offset of the block index, 0 until patched at end
+    uint16_t blockCount;     // v2: number of blocks in the index
+    uint8_t reserved[128 - 4 - 1 - 1 - 2 - 2 - 2 - 4 - 4 - 4 - 4 - 32 - 48 - 2 - 4 - 2]; // pad to 128
+};
+
+struct ShotLogBlockHeader {
+    uint16_t sampleCount; // samples in this block
+    uint16_t payloadSize; // bytes following this header
+    uint32_t crc32;       // crc32 of the payload
+};
+
+struct ShotLogBlockIndexEntry {
+    uint32_t offset;      // file offset of the ShotLogBlockHeader
+    uint32_t firstSample; // index of the first sample in the block
+    uint16_t firstTick;   // tick of the first sample, 0 when tick is not recorded
+    uint16_t sampleCount; // samples in the block
 };
 #pragma pack(pop)
 
 // Scaled values:
-//   tick: sample index (0.25 s steps) -> milliseconds = tick * SHOT_LOG_SAMPLE_INTERVAL_MS
+//   tick: sample time since shot start -> milliseconds = tick * sampleInterval. Samples follow the controller sensor
+//         rate (up to one per 30 ms control tick), older logs used one sample per 250 ms tick.
 //   tt / ct: temperature in °C * 10 (0.1 °C resolution)
 //   tp / cp: pressure in bar * 10 (0.1 bar resolution)
 //   fl / tf / pf / vf: flow in ml/s * 100 (0.01 ml/s resolution)
 //   v / ev: weight in g * 10 (0.1 g resolution)
 //   pr: puck resistance * 100 (0.01 step, saturates at uint16_t max)
 struct ShotLogSample {
-    uint16_t t;  // sample index (0.25 s ticks)
+    uint16_t t;  // sample time in sampleInterval ticks
     uint16_t tt; // target temp * 10
     uint16_t ct; // current temp * 10
     uint16_t tp; // target pressure * 10
@@ -66,6 +100,79 @@ struct ShotLogSample {
 
 static_assert(sizeof(ShotLogHeader) == SHOT_LOG_HEADER_SIZE, "ShotLogHeader size mismatch");
 static_assert(sizeof(ShotLogSample) == SHOT_LOG_SAMPLE_SIZE, "ShotLogSample size mismatch");
+static_assert(sizeof(ShotLogBlockHeader) == SHOT_LOG_BLOCK_HEADER_SIZE, "ShotLogBlockHeader size mismatch");
+static_assert(sizeof(ShotLogBlockIndexEntry) == SHOT_LOG_BLOCK_INDEX_ENTRY_SIZE, "ShotLogBlockIndexEntry size mismatch");
+
+// Shot analytics, computed in one pass over the samples while a shot is recorded
+// File: /h/<id>.sa, written when a shot completes
+// Layout: ShotAnalyticsHeader followed by phaseCount ShotPhaseAnalytics records, all values little-endian
+// The shot summary is also stored in the index entry, listing shots needs no extra reads.
+// Scaled values use the shot log scales above, except:
+//   temperature error / stability: °C * 100
+//   resistance trend: puck resistance * 100 per second (least squares slope)
+// Resistance, its trend and channeling only count samples at SHOT_ANALYTICS_MIN_PRESSURE or more with puck flow,
+// temperature error only samples with a target temperature.
+
+static constexpr uint32_t SHOT_ANALYTICS_MAGIC = 0x4C4E4153; // 'S''A''N''L' little-endian
+static constexpr uint8_t SHOT_ANALYTICS_VERSION = 1;
+static constexpr uint16_t SHOT_ANALYTICS_HEADER_SIZE = 24;
+static constexpr uint16_t SHOT_ANALYTICS_PHASE_SIZE = 56;
+static constexpr uint8_t SHOT_ANALYTICS_MAX_PHASES = 16;    // later phases are counted into the last one
+static constexpr uint16_t SHOT_ANALYTICS_NO_DRIP = 0xFFFF;  // first drip tick when no weight was seen
+static constexpr uint16_t SHOT_ANALYTICS_DRIP_WEIGHT = 5;   // g * 10, weight that counts as the first drip
+static constexpr uint16_t SHOT_ANALYTICS_MIN_PRESSURE = 20; // bar * 10
+static constexpr uint8_t SHOT_ANALYTICS_CHANNEL_DROP = 25;  // percent below the peak resistance of the phase
+
+// Summary flags
+static constexpr uint8_t SHOT_ANALYTICS_FLAG_VALID = 0x01;
+static constexpr uint8_t SHOT_ANALYTICS_FLAG_SCALE_DRIP = 0x02; // first drip from the scale, estimated weight otherwise
+
+#pragma pack(push, 1)
+struct ShotAnalyticsSummary {
+    uint8_t flags;           // SHOT_ANALYTICS_FLAG_*, 0 for shots recorded before analytics
+    uint8_t channelEvents;   // resistance drops of SHOT_ANALYTICS_CHANNEL_DROP or more
+    uint16_t firstDripTick;  // ticks since shot start, SHOT_ANALYTICS_NO_DRIP when none
+    uint16_t avgPressure;    // bar * 10
+    uint16_t peakPressure;   // bar * 10
+    int16_t avgFlow;         // puck flow ml/s * 100
+    int16_t peakFlow;        // puck flow ml/s * 100
+    uint16_t tempStdDev;     // standard deviation of the temperature error, °C * 100
+    int16_t resistanceTrend; // puck resistance * 100 per second
+};
+
+struct ShotAnalyticsHeader {
+    uint32_t magic;     // SHOT_ANALYTICS_MAGIC
+    uint8_t version;    // SHOT_ANALYTICS_VERSION
+    uint8_t phaseCount; // records following the header
+    uint16_t phaseSize; // SHOT_ANALYTICS_PHASE_SIZE
+    ShotAnalyticsSummary summary;
+};
+
+struct ShotPhaseAnalytics {
+    char name[24];             // phase name, null-terminated and truncated
+    uint16_t startTick;        // ticks since shot start
+    uint16_t durationTick;     // ticks
+    uint16_t sampleCount;      // samples in the phase
+    uint16_t avgPressure;      // bar * 10
+    uint16_t peakPressure;     // bar * 10
+    int16_t avgPumpFlow;       // ml/s * 100
+    int16_t avgPuckFlow;       // ml/s * 100
+    int16_t peakPuckFlow;      // ml/s * 100
+    uint16_t avgResistance;    // puck resistance * 100
+    int16_t resistanceTrend;   // puck resistance * 100 per second
+    int16_t avgTempError;      // current - target, °C * 100
+    uint16_t tempStdDev;       // °C * 100
+    uint16_t maxTempDeviation; // largest absolute temperature error, °C * 10
+    uint16_t weight;           // weight at the end of the phase, g * 10
+    uint8_t channelEvents;     // resistance drops of SHOT_ANALYTICS_CHANNEL_DROP or more
+    uint8_t maxResistanceDrop; // percent below the phase peak resistance
+    uint8_t reserved[2];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(ShotAnalyticsSummary) == 16, "ShotAnalyticsSummary size mismatch");
+static_assert(sizeof(ShotAnalyticsHeader) == SHOT_ANALYTICS_HEADER_SIZE, "ShotAnalyticsHeader size mismatch");
+static_assert(sizeof(ShotPhaseAnalytics) == SHOT_ANALYTICS_PHASE_SIZE, "ShotPhaseAnalytics size mismatch");
 
 // Binary shot index format
 // File: /h/index.bin
@@ -93,19 +200,35 @@ struct ShotIndexHeader {
 };
 
 struct ShotIndexEntry {
-    uint32_t id;          // Shot ID
-    uint32_t timestamp;   // Unix timestamp
-    uint32_t duration;    // Duration in ms
-    uint16_t volume;      // Final weight (g * 10)
-    uint8_t rating;       // 0-5 star rating from notes
-    uint8_t flags;        // Bit flags (completed, deleted, etc.)
-    char profileId[32];   // Profile ID, null-terminated
-    char profileName[48]; // Profile name, null-terminated
-    uint8_t reserved[32]; // Future expansion
+    uint32_t id;                    // Shot ID
+    uint32_t timestamp;             // Unix timestamp
+    uint32_t duration;              // Duration in ms
+    uint16_t volume;                // Final weight (g * 10)
+    uint8_t rating;                 // 0-5 star rating from notes
+    uint8_t flags;                  // Bit flags (completed, deleted, etc.)
+    char profileId[32];             // Profile ID, null-terminated
+    char profileName[48];           // Profile name, null-terminated
+    ShotAnalyticsSummary analytics; // Zero until the shot completes
+    uint8_t reserved[16];           // Future expansion
+};
+
+// In-memory copy of an index entry, ShotIndexEntry without the reserved bytes
+struct ShotIndexRecord {
+    uint32_t id;
+    uint32_t timestamp;
+    uint32_t duration;
+    uint16_t volume;
+    uint8_t rating;
+    uint8_t flags;
+    char profileId[32];
+    char profileName[48];
+    ShotAnalyticsSummary analytics;
 };
 #pragma pack(pop)
 
 static_assert(sizeof(ShotIndexHeader) == SHOT_INDEX_HEADER_SIZE, "ShotIndexHeader size mismatch");
 static_assert(sizeof(ShotIndexEntry) == SHOT_INDEX_ENTRY_SIZE, "ShotIndexEntry size mismatch");
+static_assert(sizeof(ShotIndexRecord) == SHOT_INDEX_ENTRY_SIZE - sizeof(ShotIndexEntry::reserved),
+              "ShotIndexRecord size mismatch");
 
 #endif // SHOT_LOG_FORMAT_H
@@ -0,0 +1,164 @@
+#ifndef STATUS_FRAME_H
+#define STATUS_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Binary websocket status frames, the compact alternative to the evt:status JSON message.
+// Clients opt in with {"tp": "req:status:binary"} and then receive binary frames only.
+// All values little-endian. Frame layout:
+//   type(uint8_t) STATUS_FRAME_KEY or STATUS_FRAME_DELTA, seq(uint8_t), fields(uint16_t), then every field whose bit is set
+//   in fields, in bit order. Keyframes carry all fields, delta frames only the ones that changed since the previous frame.
+//   seq increments per frame, a client that sees a gap requests a new keyframe by subscribing again.
+// Fields (bit: JSON key, encoding):
+//   0: ct int16 0.1 C, 1: tt int16 0.1 C, 2: pr int16 0.01 bar, 3: fl int16 0.01 ml/s, 4: pt int16 0.01 bar, 5: m uint8,
+//   6: capability and target flags uint8, 7: p string, 8: process flags uint8, 9: process.l string, 10: process.e uint32 ms,
+//   11: process.pt float, 12: process.pp float
+// Strings are a uint8_t length followed by the bytes, without terminator.
+
+static constexpr uint8_t STATUS_FRAME_KEY = 0x01;
+static constexpr uint8_t STATUS_FRAME_DELTA = 0x02;
+static constexpr uint8_t STATUS_FRAME_HEADER_SIZE = 4;
+static constexpr uint8_t STATUS_FIELD_COUNT = 13;
+static constexpr uint16_t STATUS_FIELDS_ALL = (1u << STATUS_FIELD_COUNT) - 1;
+
+static constexpr uint8_t STATUS_PROFILE_CAPACITY = 64;
+static constexpr uint8_t STATUS_PHASE_CAPACITY = 48;
+// Header, five int16, three uint8, two strings (length byte plus at most capacity - 1 bytes), uint32 and two floats
+static constexpr size_t STATUS_FRAME_MAX_SIZE =
+    STATUS_FRAME_HEADER_SIZE + 5 * 2 + 3 + STATUS_PROFILE_CAPACITY + STATUS_PHASE_CAPACITY + 3 * 4;
+
+// Field 6
+static constexpr uint8_t STATUS_FLAG_PRESSURE = 0x01;    // cp
+static constexpr uint8_t STATUS_FLAG_DIMMING = 0x02;     // cd
+static constexpr uint8_t STATUS_FLAG_VOLUMETRIC = 0x04;  // bta
+static constexpr uint8_t STATUS_FLAG_BREW_TARGET = 0x08; // bt
+static constexpr uint8_t STATUS_FLAG_LED_CONTROL = 0x10; // led
+
+// Field 8
+static constexpr uint8_t STATUS_PROCESS_PRESENT = 0x01;    // process object sent
+static constexpr uint8_t STATUS_PROCESS_ACTIVE = 0x02;     // process.a
+static constexpr uint8_t STATUS_PROCESS_BREW = 0x04;       // brew fields (s, l, e, tt, pt, pp) present
+static constexpr uint8_t STATUS_PROCESS_BREW_PHASE = 0x08; // process.s "brew" instead of "infusion"
+static constexpr uint8_t STATUS_PROCESS_VOLUMETRIC = 0x10; // process.tt "volumetric" instead of "time"
+
+struct StatusSnapshot {
+    int16_t currentTemp = 0;
+    int16_t targetTemp = 0;
+    int16_t pressure = 0;
+    int16_t flow = 0;
+    int16_t targetPressure = 0;
+    uint8_t mode = 0;
+    uint8_t flags = 0;
+    char profile[STATUS_PROFILE_CAPACITY] = {};
+    uint8_t processFlags = 0;
+    char phase[STATUS_PHASE_CAPACITY] = {};
+    uint32_t elapsed = 0;
+    float phaseTarget = 0.0f;
+    float phaseProgress = 0.0f;
+
+    void setProfile(const char *value) { copyString(profile, value, sizeof(profile)); }
+    void setPhase(const char *value) { copyString(phase, value, sizeof(phase)); }
+
+    static int16_t fixed(float value, float scale) {
+        float scaled = value * scale;
+        if (scaled >= INT16_MAX) {
+            return INT16_MAX;
+        }
+        if (scaled <= INT16_MIN) {
+            return INT16_MIN;
+        }
+        return static_cast<int16_t>(scaled < 0.0f ? scaled - 0.5f : scaled + 0.5f);
+    }
+
+  private:
+    static void copyString(char *out, const char *value, size_t capacity) {
+        strncpy(out, value, capacity - 1);
+        out[capacity - 1] = '\0';
+    }
+};
+
+// Encodes snapshots against the previously encoded one. One encoder serves all binary clients, they share a single frame
+// stream.
+class StatusFrameEncoder {
+  public:
+    // Encodes snapshot into out (at least STATUS_FRAME_MAX_SIZE bytes), returns the frame size. Delta frames with no
+    // changed fields are still sent, they mark the sample time for the client's charts.
+    size_t encode(const StatusSnapshot &snapshot, bool keyframe, uint8_t *out) {
+        uint16_t fields = keyframe || !hasPrevious ? STATUS_FIELDS_ALL : changedFields(snapshot);
+        size_t length = 0;
+        out[length++] = fields == STATUS_FIELDS_ALL ? STATUS_FRAME_KEY : STATUS_FRAME_DELTA;
+        out[length++] = sequence++;
+        writeValue(out, length, fields);
+        if (fields & (1u << 0))
+            writeValue(out, length, snapshot.currentTemp);
+        if (fields & (1u << 1))
+            writeValue(out, length, snapshot.targetTemp);
+        if (fields & (1u << 2))
+            writeValue(out, length, snapshot.pressure);
+        if (fields & (1u << 3))
+            writeValue(out, length, snapshot.flow);
+        if (fields & (1u << 4))
+            writeValue(out, length, snapshot.targetPressure);
+        if (fields & (1u << 5))
+            out[length++] = snapshot.mode;
+        if (fields & (1u << 6))
+            out[length++] = snapshot.flags;
+        if (fields & (1u << 7))
+            writeString(out, length, snapshot.profile);
+        if (fields & (1u << 8))
+            out[length++] = snapshot.processFlags;
+        if (fields & (1u << 9))
+            writeString(out, length, snapshot.phase);
+        if (fields & (1u << 10))
+            writeValue(out, length, snapshot.elapsed);
+        if (fields & (1u << 11))
+            writeValue(out, length, snapshot.phaseTarget);
+        if (fields & (1u << 12))
+            writeValue(out, length, snapshot.phaseProgress);
+        previous = snapshot;
+        hasPrevious = true;
+        return length;
+    }
+
+    // Forces the next frame to be a keyframe
+    void reset() { hasPrevious = false; }
+
+  private:
+    uint16_t changedFields(const StatusSnapshot &snapshot) const {
+        uint16_t fields = 0;
+        fields |= (snapshot.currentTemp != previous.currentTemp) << 0;
+        fields |= (snapshot.targetTemp != previous.targetTemp) << 1;
+        fields |= (snapshot.pressure != previous.pressure) << 2;
+        fields |= (snapshot.flow != previous.flow) << 3;
+        fields |= (snapshot.targetPressure != previous.targetPressure) << 4;
+        fields |= (snapshot.mode != previous.mode) << 5;
+        fields |= (snapshot.flags != previous.flags) << 6;
+        fields |= (strcmp(snapshot.profile, previous.profile) != 0) << 7;
+        fields |= (snapshot.processFlags != previous.processFlags) << 8;
+        fields |= (strcmp(snapshot.phase, previous.phase) != 0) << 9;
+        fields |= (snapshot.elapsed != previous.elapsed) << 10;
+        fields |= (memcmp(&snapshot.phaseTarget, &previous.phaseTarget, sizeof(float)) != 0) << 11;
+        fields |= (memcmp(&snapshot.phaseProgress, &previous.phaseProgress, sizeof(float)) != 0) << 12;
+        return fields;
+    }
+
+    template <typename T> static void writeValue(uint8_t *out, size_t &length, T value) {
+        memcpy(out + length, &value, sizeof(T)); // ESP32 and hosts are little-endian
+        length += sizeof(T);
+    }
+
+    static void writeString(uint8_t *out, size_t &length, const char *value) {
+        auto size = static_cast<uint8_t>(strlen(value));
+        out[length++] = size;
+        memcpy(out + length, value, size);
+        length += size;
+    }
+
+    StatusSnapshot previous;
+    bool hasPrevious = false;
+    uint8_t sequence = 0;
+};
+
+#endif // STATUS_FRAME_H
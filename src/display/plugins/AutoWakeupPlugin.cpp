@@ -65,7 +65,7 @@ void AutoWakeupPlugin::checkAutoWakeup() {
             controller->setMode(MODE_BREW);
             
             // Trigger plugin events
-            pluginManager->trigger("autowakeup:activated", "time", schedule.time);
+            pluginManager->trigger(EventId::AUTOWAKEUP_ACTIVATED, "time", schedule.time);
             
             return; // Only trigger once per minute
         }
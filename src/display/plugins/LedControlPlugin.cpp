@@ -28,7 +28,7 @@ void LedControlPlugin::updateControl() {
         sendControl(0, 0, 255, 20, 255);
         return;
     }
-    if (this->controller->getLastProcess() != nullptr && mode == MODE_BREW) {
+    if (this->controller->getProcessSnapshot().present && mode == MODE_BREW) {
         sendControl(0, 255, 0, 20, 255);
         return;
     }
@@ -1,5 +1,6 @@
 #include "MQTTPlugin.h"
 #include "../core/Controller.h"
+#include "RuntimeStatsPlugin.h"
 #include <ArduinoJson.h>
 #include <ctime>
 
@@ -117,6 +118,49 @@ void MQTTPlugin::publishBrewState(const char *state) {
     publish("controller/brew/state", json);
 }
 
+// Runtime stats of the display: diagnostics/system with heap and core load, diagnostics/tasks/<name> per task
+void MQTTPlugin::publishDiagnostics() {
+    if (!client.connected() || (lastDiagnostics != 0 && millis() - lastDiagnostics < MQTT_DIAGNOSTICS_INTERVAL))
+        return;
+    lastDiagnostics = millis();
+
+    RuntimeStatsSample sample;
+    std::array<TaskStats, RUNTIME_STATS_MAX_TASKS> tasks;
+    const size_t taskCount = RuntimeStats.copyLatest(sample, tasks);
+
+    char json[200];
+    JsonDocument system;
+    system["heap"] = sample.internal.free;
+    system["heapLargest"] = sample.internal.largest;
+    system["heapMin"] = sample.internal.minimum;
+    system["heapFrag"] = sample.internal.fragmentation;
+    system["psram"] = sample.psram.free;
+    system["psramLargest"] = sample.psram.largest;
+    auto cores = system["cores"].to<JsonArray>();
+    for (uint8_t load : sample.coreLoad) {
+        if (load == RUNTIME_STATS_CPU_UNKNOWN) {
+            cores.add(nullptr);
+        } else {
+            cores.add(load);
+        }
+    }
+    serializeJson(system, json, sizeof(json));
+    publish("diagnostics/system", json);
+
+    for (size_t i = 0; i < taskCount; i++) {
+        const TaskStats &task = tasks[i];
+        JsonDocument doc;
+        if (task.cpu != RUNTIME_STATS_CPU_UNKNOWN) {
+            doc["cpu"] = task.cpu;
+        }
+        doc["stack"] = task.stackFree;
+        doc["core"] = task.core;
+        doc["priority"] = task.priority;
+        serializeJson(doc, json, sizeof(json));
+        publish(std::string("diagnostics/tasks/") + task.name, json);
+    }
+}
+
 void MQTTPlugin::setup(Controller *controller, PluginManager *pluginManager) {
     pluginManager->on("controller:wifi:connect", [this, controller](const Event &) {
         if (!connect(controller))
@@ -173,4 +217,6 @@ void MQTTPlugin::setup(Controller *controller, PluginManager *pluginManager) {
     pluginManager->on("controller:brew:start", [this](Event const &) { publishBrewState("brewing"); });
 
     pluginManager->on("controller:brew:end", [this](Event const &) { publishBrewState("not brewing"); });
+
+    pluginManager->on("system:stats:sample", [this](Event const &) { publishDiagnostics(); });
 }
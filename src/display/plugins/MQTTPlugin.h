@@ -6,6 +6,8 @@
 
 constexpr int MQTT_CONNECTION_RETRIES = 5;
 constexpr int MQTT_CONNECTION_DELAY = 1000;
+constexpr int MQTT_BUFFER_SIZE = 512;
+constexpr unsigned long MQTT_DIAGNOSTICS_INTERVAL = 30000;
 
 class MQTTPlugin : public Plugin {
   public:
@@ -19,10 +21,12 @@ class MQTTPlugin : public Plugin {
     void publish(const std::string &topic, const std::string &message);
     void publishBrewState(const char *state);
     void publishDiscovery(Controller *controller);
-    MQTTClient client;
+    void publishDiagnostics();
+    MQTTClient client{MQTT_BUFFER_SIZE};
     WiFiClient net;
 
     float lastTemperature = 0;
+    unsigned long lastDiagnostics = 0;
 };
 
 #endif // MQTTPLUGIN_H
@@ -0,0 +1,229 @@
+#include "RuntimeStatsPlugin.h"
+#include <algorithm>
+#include <cstring>
+#include <display/core/Event.h>
+#include <display/core/PluginManager.h>
+#include <esp_heap_caps.h>
+
+RuntimeStatsPlugin RuntimeStats;
+
+void RuntimeStatsPlugin::setup(Controller *controller, PluginManager *pluginManager) {
+    this->pluginManager = pluginManager;
+    xTaskCreatePinnedToCore(loopTask, "RuntimeStats", configMINIMAL_STACK_SIZE * 4, this, 1, &taskHandle, 0);
+}
+
+void RuntimeStatsPlugin::sample() {
+    RuntimeStatsSample current;
+    current.time = millis();
+    readHeap(MALLOC_CAP_INTERNAL, current.internal);
+    readHeap(MALLOC_CAP_SPIRAM, current.psram);
+    current.coreLoad.fill(RUNTIME_STATS_CPU_UNKNOWN);
+    current.taskCpu.fill(RUNTIME_STATS_CPU_UNKNOWN);
+
+    uint32_t totalRuntime = 0;
+    UBaseType_t count = 0;
+#if configUSE_TRACE_FACILITY
+    count = uxTaskGetSystemState(statusBuffer.data(), statusBuffer.size(), &totalRuntime);
+    if (count == 0) {
+        ESP_LOGW("RuntimeStats", "More than %u tasks, not sampling them", static_cast<unsigned>(statusBuffer.size()));
+    }
+#endif
+    const uint32_t elapsed = totalRuntime - lastTotalRuntime;
+    lastTotalRuntime = totalRuntime;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    sampleCount++;
+    untrackedTasks = 0;
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t &status = statusBuffer[i];
+        TaskStats *task = findSlot(status.xHandle);
+        const bool fresh = task == nullptr;
+        if (fresh) {
+            task = claimSlot(status.xHandle);
+        }
+        if (task == nullptr) {
+            untrackedTasks++;
+            continue;
+        }
+        strncpy(task->name, status.pcTaskName, sizeof(task->name) - 1);
+        task->stackFree = status.usStackHighWaterMark; // StackType_t is a byte on ESP32
+        task->priority = status.uxCurrentPriority;
+        task->lastSeen = sampleCount;
+#if configTASKLIST_INCLUDE_COREID
+        task->core = status.xCoreID < portNUM_PROCESSORS ? static_cast<int8_t>(status.xCoreID) : -1;
+#endif
+#if configGENERATE_RUN_TIME_STATS
+        // Run time counters tick in microseconds of one core, the total is the time since boot
+        if (!fresh && elapsed > 0) {
+            const uint64_t used = static_cast<uint32_t>(status.ulRunTimeCounter - task->runtime);
+            task->cpu = static_cast<uint8_t>(std::min<uint64_t>(100, used * 100 / elapsed));
+            current.taskCpu[task - tasks.data()] = task->cpu;
+        }
+        task->runtime = status.ulRunTimeCounter;
+#endif
+    }
+#if configGENERATE_RUN_TIME_STATS
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+        const TaskStats *idle = findSlot(xTaskGetIdleTaskHandleForCPU(core));
+        if (idle != nullptr && idle->lastSeen == sampleCount && idle->cpu != RUNTIME_STATS_CPU_UNKNOWN) {
+            current.coreLoad[core] = 100 - idle->cpu;
+        }
+    }
+#endif
+    for (TaskStats &task : tasks) {
+        if (task.used && task.lastSeen != sampleCount) {
+            task.cpu = RUNTIME_STATS_CPU_UNKNOWN;
+        }
+    }
+
+    history[historyHead] = current;
+    historyHead = (historyHead + 1) % RUNTIME_STATS_HISTORY;
+    historyCount = std::min(historyCount + 1, RUNTIME_STATS_HISTORY);
+}
+
+TaskStats *RuntimeStatsPlugin::findSlot(TaskHandle_t handle) {
+    for (TaskStats &task : tasks) {
+        if (task.used && task.handle == handle) {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+TaskStats *RuntimeStatsPlugin::claimSlot(TaskHandle_t handle) {
+    // Slots of tasks gone for a full history are reused, none of their samples are left in the ring by then
+    for (TaskStats &task : tasks) {
+        if (!task.used || sampleCount - task.lastSeen > RUNTIME_STATS_HISTORY) {
+            task = TaskStats{};
+            task.handle = handle;
+            task.used = true;
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+const RuntimeStatsSample &RuntimeStatsPlugin::latest() const {
+    return history[(historyHead + RUNTIME_STATS_HISTORY - 1) % RUNTIME_STATS_HISTORY];
+}
+
+size_t RuntimeStatsPlugin::copyLatest(RuntimeStatsSample &sample, std::array<TaskStats, RUNTIME_STATS_MAX_TASKS> &out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    sample = latest();
+    size_t count = 0;
+    for (const TaskStats &task : tasks) {
+        if (task.used && task.lastSeen == sampleCount) {
+            out[count++] = task;
+        }
+    }
+    return count;
+}
+
+void RuntimeStatsPlugin::handleRequest(JsonDocument &request, JsonDocument &response) {
+    response["tp"] = "res:runtime-stats";
+    response["rid"] = request["rid"].as<String>();
+    response["period"] = RUNTIME_STATS_PERIOD_MS;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (historyCount == 0) {
+        return;
+    }
+    const RuntimeStatsSample &current = latest();
+    response["t"] = current.time;
+    writeHeap(response["heap"].to<JsonObject>(), current.internal);
+    writeHeap(response["psram"].to<JsonObject>(), current.psram);
+    auto cores = response["cores"].to<JsonArray>();
+    for (uint8_t load : current.coreLoad) {
+        addLoad(cores, load);
+    }
+    response["untracked"] = untrackedTasks;
+
+    // Short keys, the task list is sent every time a client polls
+    auto taskList = response["tasks"].to<JsonArray>();
+    for (const TaskStats &task : tasks) {
+        if (!task.used || task.lastSeen != sampleCount) {
+            continue;
+        }
+        auto entry = taskList.add<JsonObject>();
+        entry["n"] = task.name;
+        entry["c"] = task.core;
+        entry["p"] = task.priority;
+        entry["st"] = task.stackFree;
+        if (task.cpu != RUNTIME_STATS_CPU_UNKNOWN) {
+            entry["cpu"] = task.cpu;
+        }
+    }
+
+    if (!request["history"].as<bool>()) {
+        return;
+    }
+    // Oldest sample first, series per value, CPU of a task that did not run in a sample is null
+    auto h = response["history"].to<JsonObject>();
+    auto times = h["t"].to<JsonArray>();
+    auto heap = h["heap"].to<JsonArray>();
+    auto psram = h["psram"].to<JsonArray>();
+    auto coreSeries = h["cores"].to<JsonArray>();
+    std::array<JsonArray, portNUM_PROCESSORS> coreLoads;
+    for (size_t core = 0; core < portNUM_PROCESSORS; core++) {
+        coreLoads[core] = coreSeries.add<JsonArray>();
+    }
+    // Task names are not unique, series are listed with the name instead of keyed by it
+    auto taskSeries = h["tasks"].to<JsonArray>();
+    std::array<JsonArray, RUNTIME_STATS_MAX_TASKS> taskLoads;
+    for (size_t slot = 0; slot < RUNTIME_STATS_MAX_TASKS; slot++) {
+        if (tasks[slot].used) {
+            auto series = taskSeries.add<JsonObject>();
+            series["n"] = tasks[slot].name;
+            taskLoads[slot] = series["cpu"].to<JsonArray>();
+        }
+    }
+    const size_t first = (historyHead + RUNTIME_STATS_HISTORY - historyCount) % RUNTIME_STATS_HISTORY;
+    for (size_t i = 0; i < historyCount; i++) {
+        const RuntimeStatsSample &entry = history[(first + i) % RUNTIME_STATS_HISTORY];
+        times.add(entry.time);
+        heap.add(entry.internal.free);
+        psram.add(entry.psram.free);
+        for (size_t core = 0; core < portNUM_PROCESSORS; core++) {
+            addLoad(coreLoads[core], entry.coreLoad[core]);
+        }
+        for (size_t slot = 0; slot < RUNTIME_STATS_MAX_TASKS; slot++) {
+            if (!tasks[slot].used) {
+                continue;
+            }
+            addLoad(taskLoads[slot], entry.taskCpu[slot]);
+        }
+    }
+}
+
+void RuntimeStatsPlugin::readHeap(uint32_t caps, HeapStats &heap) {
+    heap.free = heap_caps_get_free_size(caps);
+    heap.largest = heap_caps_get_largest_free_block(caps);
+    heap.minimum = heap_caps_get_minimum_free_size(caps);
+    heap.fragmentation = heap.free > 0 ? static_cast<uint8_t>(100 - static_cast<uint64_t>(heap.largest) * 100 / heap.free) : 0;
+}
+
+void RuntimeStatsPlugin::writeHeap(JsonObject object, const HeapStats &heap) {
+    object["free"] = heap.free;
+    object["largest"] = heap.largest;
+    object["min"] = heap.minimum;
+    object["frag"] = heap.fragmentation;
+}
+
+void RuntimeStatsPlugin::addLoad(JsonArray array, uint8_t load) {
+    if (load == RUNTIME_STATS_CPU_UNKNOWN) {
+        array.add(nullptr);
+    } else {
+        array.add(load);
+    }
+}
+
+void RuntimeStatsPlugin::loopTask(void *arg) {
+    auto *plugin = static_cast<RuntimeStatsPlugin *>(arg);
+    TickType_t lastWake = xTaskGetTickCount();
+    while (true) {
+        plugin->sample();
+        plugin->pluginManager->post(EventId::SYSTEM_STATS_SAMPLE, "value", static_cast<int>(plugin->sampleCount),
+                                    EventPriority::TELEMETRY);
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(RUNTIME_STATS_PERIOD_MS));
+    }
+}
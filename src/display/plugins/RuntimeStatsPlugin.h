@@ -0,0 +1,86 @@
+#ifndef RUNTIMESTATSPLUGIN_H
+#define RUNTIMESTATSPLUGIN_H
+
+#include <ArduinoJson.h>
+#include <array>
+#include <display/core/Plugin.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <mutex>
+
+constexpr uint32_t RUNTIME_STATS_PERIOD_MS = 1000;
+constexpr size_t RUNTIME_STATS_HISTORY = 60;         // samples kept, a minute at the sample period
+constexpr size_t RUNTIME_STATS_MAX_TASKS = 24;       // tasks tracked at once
+constexpr size_t RUNTIME_STATS_STATUS_CAPACITY = 40; // tasks uxTaskGetSystemState can report
+constexpr uint8_t RUNTIME_STATS_CPU_UNKNOWN = 0xFF;  // first sample of a task or run time stats not compiled in
+
+struct HeapStats {
+    uint32_t free = 0;
+    uint32_t largest = 0;      // largest free block
+    uint32_t minimum = 0;      // lowest free size since boot
+    uint8_t fragmentation = 0; // percent of the free heap outside the largest block
+};
+
+struct TaskStats {
+    char name[configMAX_TASK_NAME_LEN] = {};
+    TaskHandle_t handle = nullptr;
+    uint32_t runtime = 0;   // run time counter at the last sample
+    uint32_t stackFree = 0; // bytes left at the stack high water mark
+    int8_t core = -1;       // -1 when not pinned
+    uint8_t priority = 0;
+    uint8_t cpu = RUNTIME_STATS_CPU_UNKNOWN; // percent of one core over the last period
+    uint32_t lastSeen = 0;                   // sample number
+    bool used = false;
+};
+
+struct RuntimeStatsSample {
+    uint32_t time = 0;
+    HeapStats internal;
+    HeapStats psram;
+    std::array<uint8_t, portNUM_PROCESSORS> coreLoad{};
+    std::array<uint8_t, RUNTIME_STATS_MAX_TASKS> taskCpu{}; // by task slot
+};
+
+// Samples FreeRTOS run time stats, stack high water marks and heap fragmentation of the display once per period and
+// keeps a ring of the last RUNTIME_STATS_HISTORY samples. Served over the websocket (req:runtime-stats) and published to
+// MQTT, every sample posts system:stats:sample.
+class RuntimeStatsPlugin : public Plugin {
+  public:
+    void setup(Controller *controller, PluginManager *pluginManager) override;
+    void loop() override {};
+
+    // {"history": true} adds the ring buffered history to the response
+    void handleRequest(JsonDocument &request, JsonDocument &response);
+
+    // Copies the latest sample and the tasks seen in it, returns the number of tasks
+    size_t copyLatest(RuntimeStatsSample &sample, std::array<TaskStats, RUNTIME_STATS_MAX_TASKS> &tasks);
+
+  private:
+    void sample();
+    TaskStats *findSlot(TaskHandle_t handle);
+    TaskStats *claimSlot(TaskHandle_t handle);
+    const RuntimeStatsSample &latest() const;
+    static void readHeap(uint32_t caps, HeapStats &heap);
+    static void writeHeap(JsonObject object, const HeapStats &heap);
+    static void addLoad(JsonArray array, uint8_t load);
+    [[noreturn]] static void loopTask(void *arg);
+
+    PluginManager *pluginManager = nullptr;
+    xTaskHandle taskHandle = nullptr;
+
+    std::mutex mutex;
+    std::array<TaskStats, RUNTIME_STATS_MAX_TASKS> tasks{};
+    std::array<RuntimeStatsSample, RUNTIME_STATS_HISTORY> history{};
+    size_t historyHead = 0; // next slot written
+    size_t historyCount = 0;
+    uint32_t sampleCount = 0;
+    uint32_t untrackedTasks = 0; // tasks seen in the last sample that found no free slot
+
+    // Sampling task only
+    std::array<TaskStatus_t, RUNTIME_STATS_STATUS_CAPACITY> statusBuffer{};
+    uint32_t lastTotalRuntime = 0;
+};
+
+extern RuntimeStatsPlugin RuntimeStats;
+
+#endif // RUNTIMESTATSPLUGIN_H
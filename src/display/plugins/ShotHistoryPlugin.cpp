@@ -5,6 +5,8 @@
 #include <display/core/Controller.h>
 #include <display/core/ProfileManager.h>
 #include <display/core/utils.h>
+#include <display/models/shot_analytics.h>
+#include <display/models/shot_log_codec.h>
 #include <display/models/shot_log_format.h>
 
 namespace {
@@ -21,6 +23,8 @@ constexpr uint16_t RESISTANCE_MAX_VALUE = 0xFFFF;
 constexpr int16_t FLOW_MIN_VALUE = -2000; // -20.00 ml/s
 constexpr int16_t FLOW_MAX_VALUE = 2000;  //  20.00 ml/s
 
+constexpr size_t SENSOR_READ_CHUNK = 16;
+
 uint16_t encodeUnsigned(float value, float scale, uint16_t maxValue) {
     if (!std::isfinite(value)) {
         return 0;
@@ -69,8 +73,7 @@ void ShotHistoryPlugin::setup(Controller *c, PluginManager *pm) {
            [this](Event const &event) { currentEstimatedWeight = event.getFloat("value"); });
     pm->on("controller:volumetric-measurement:bluetooth:change",
            [this](Event const &event) { currentBluetoothWeight = event.getFloat("value"); });
-    pm->on("boiler:currentTemperature:change", [this](Event const &event) { currentTemperature = event.getFloat("value"); });
-    pm->on("pump:puck-resistance:change", [this](Event const &event) { currentPuckResistance = event.getFloat("value"); });
+    loadIndex();
     xTaskCreatePinnedToCore(loopTask, "ShotHistoryPlugin::loop", configMINIMAL_STACK_SIZE * 4, this, 1, &taskHandle, 0);
 }
 
@@ -89,16 +92,19 @@ void ShotHistoryPlugin::record() {
                 header.version = SHOT_LOG_VERSION;
                 header.reserved0 = (uint8_t)SHOT_LOG_SAMPLE_SIZE; // record sample size actually used
                 header.headerSize = SHOT_LOG_HEADER_SIZE;
-                header.sampleInterval = SHOT_LOG_SAMPLE_INTERVAL_MS;
+                header.sampleInterval = SHOT_LOG_TICK_MS;
+                header.blockSamples = SHOT_LOG_BLOCK_SAMPLES;
                 header.fieldsMask = SHOT_LOG_FIELDS_MASK_ALL;
                 header.startEpoch = getTime();
-                Profile profile = controller->getProfileManager()->getSelectedProfile();
-                strncpy(header.profileId, profile.id.c_str(), sizeof(header.profileId) - 1);
+                ProfileRef profile = controller->getProfileManager()->getSelectedProfile();
+                strncpy(header.profileId, profile->id.c_str(), sizeof(header.profileId) - 1);
                 header.profileId[sizeof(header.profileId) - 1] = '\0';
-                strncpy(header.profileName, profile.label.c_str(), sizeof(header.profileName) - 1);
+                strncpy(header.profileName, profile->label.c_str(), sizeof(header.profileName) - 1);
                 header.profileName[sizeof(header.profileName) - 1] = '\0';
                 // Write header placeholder
                 currentFile.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
+                fileOffset = sizeof(header);
+                blockEncoder.setFieldsMask(header.fieldsMask);
             }
         }
         float btDiff = currentBluetoothWeight - lastBluetoothWeight;
@@ -106,28 +112,15 @@ void ShotHistoryPlugin::record() {
         currentBluetoothFlow = currentBluetoothFlow * 0.75f + btFlow * 0.25f;
         lastBluetoothWeight = currentBluetoothWeight;
 
-        ShotLogSample sample{};
-        uint32_t tick = sampleCount <= 0xFFFF ? sampleCount : 0xFFFF;
-        sample.t = static_cast<uint16_t>(tick);
-        sample.tt = encodeUnsigned(controller->getTargetTemp(), TEMP_SCALE, TEMP_MAX_VALUE);
-        sample.ct = encodeUnsigned(currentTemperature, TEMP_SCALE, TEMP_MAX_VALUE);
-        sample.tp = encodeUnsigned(controller->getTargetPressure(), PRESSURE_SCALE, PRESSURE_MAX_VALUE);
-        sample.cp = encodeUnsigned(controller->getCurrentPressure(), PRESSURE_SCALE, PRESSURE_MAX_VALUE);
-        sample.fl = encodeSigned(controller->getCurrentPumpFlow(), FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
-        sample.tf = encodeSigned(controller->getTargetFlow(), FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
-        sample.pf = encodeSigned(controller->getCurrentPuckFlow(), FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
-        sample.vf = encodeSigned(currentBluetoothFlow, FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
-        sample.v = encodeUnsigned(currentBluetoothWeight, WEIGHT_SCALE, WEIGHT_MAX_VALUE);
-        sample.ev = encodeUnsigned(currentEstimatedWeight, WEIGHT_SCALE, WEIGHT_MAX_VALUE);
-        sample.pr = encodeUnsigned(currentPuckResistance, RESISTANCE_SCALE, RESISTANCE_MAX_VALUE);
-
-        if (isFileOpen) {
-            if (ioBufferPos + sizeof(sample) > sizeof(ioBuffer)) {
-                flushBuffer();
+        trackPhase();
+
+        // Every sensor sample received since the last run, up to one per controller tick when streaming
+        SensorSample sensorSamples[SENSOR_READ_CHUNK];
+        size_t count;
+        while ((count = controller->getSensorSamples().read(sensorCursor, sensorSamples, SENSOR_READ_CHUNK)) > 0) {
+            for (size_t i = 0; i < count; i++) {
+                writeSample(sensorSamples[i]);
             }
-            memcpy(ioBuffer + ioBufferPos, &sample, sizeof(sample));
-            ioBufferPos += sizeof(sample);
-            sampleCount++;
         }
 
         // Check for early index insertion (once per shot after 7.5s)
@@ -137,8 +130,9 @@ void ShotHistoryPlugin::record() {
         }
     }
     if (!recording && isFileOpen) {
-        flushBuffer();
-        // Patch header with sampleCount and duration
+        flushBlock();
+        writeBlockIndex();
+        // Patch header with sampleCount, duration and block index location
         header.sampleCount = sampleCount;
         header.durationMs = millis() - shotStart;
         float finalWeight = currentBluetoothWeight;
@@ -149,8 +143,7 @@ void ShotHistoryPlugin::record() {
         isFileOpen = false;
         unsigned long duration = header.durationMs;
         if (duration <= 7500) { // Exclude failed shots and flushes
-            SPIFFS.remove("/h/" + currentId + ".slog");
-            SPIFFS.remove("/h/" + currentId + ".json");
+            removeShot(currentId);
 
             // If we created an early index entry, mark it as deleted
             if (indexEntryCreated) {
@@ -158,11 +151,13 @@ void ShotHistoryPlugin::record() {
             }
         } else {
             controller->getSettings().setHistoryIndex(controller->getSettings().getHistoryIndex() + 1);
+            analyzer.finish();
+            writeAnalytics();
             cleanupHistory();
 
             if (indexEntryCreated) {
                 // Update existing entry with final completion data
-                updateIndexCompletion(currentId.toInt(), header);
+                updateIndexCompletion(currentId.toInt(), header, analyzer.header().summary);
             } else {
                 // Create completed entry directly (edge case: shot ended right after 7.5s)
                 ShotIndexEntry indexEntry{};
@@ -176,6 +171,7 @@ void ShotHistoryPlugin::record() {
                 indexEntry.profileId[sizeof(indexEntry.profileId) - 1] = '\0';
                 strncpy(indexEntry.profileName, header.profileName, sizeof(indexEntry.profileName) - 1);
                 indexEntry.profileName[sizeof(indexEntry.profileName) - 1] = '\0';
+                indexEntry.analytics = analyzer.header().summary;
 
                 appendToIndex(indexEntry);
             }
@@ -183,21 +179,112 @@ void ShotHistoryPlugin::record() {
     }
 }
 
+void ShotHistoryPlugin::writeSample(const SensorSample &sensorSample) {
+    auto elapsed = static_cast<int32_t>(sensorSample.timestamp - shotStart);
+    if (!isFileOpen || elapsed < 0) {
+        return;
+    }
+    ShotLogSample sample{};
+    uint32_t tick = static_cast<uint32_t>(elapsed) / SHOT_LOG_TICK_MS;
+    sample.t = static_cast<uint16_t>(tick <= 0xFFFF ? tick : 0xFFFF);
+    sample.tt = encodeUnsigned(controller->getTargetTemp(), TEMP_SCALE, TEMP_MAX_VALUE);
+    sample.ct = encodeUnsigned(sensorSample.temperature, TEMP_SCALE, TEMP_MAX_VALUE);
+    sample.tp = encodeUnsigned(controller->getTargetPressure(), PRESSURE_SCALE, PRESSURE_MAX_VALUE);
+    sample.cp = encodeUnsigned(sensorSample.pressure, PRESSURE_SCALE, PRESSURE_MAX_VALUE);
+    sample.fl = encodeSigned(sensorSample.pumpFlow, FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
+    sample.tf = encodeSigned(controller->getTargetFlow(), FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
+    sample.pf = encodeSigned(sensorSample.puckFlow, FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
+    sample.vf = encodeSigned(currentBluetoothFlow, FLOW_SCALE, FLOW_MIN_VALUE, FLOW_MAX_VALUE);
+    sample.v = encodeUnsigned(currentBluetoothWeight, WEIGHT_SCALE, WEIGHT_MAX_VALUE);
+    sample.ev = encodeUnsigned(currentEstimatedWeight, WEIGHT_SCALE, WEIGHT_MAX_VALUE);
+    sample.pr = encodeUnsigned(sensorSample.puckResistance, RESISTANCE_SCALE, RESISTANCE_MAX_VALUE);
+
+    blockEncoder.append(sample);
+    analyzer.add(sample);
+    sampleCount++;
+    if (blockEncoder.full()) {
+        flushBlock();
+    }
+}
+
+void ShotHistoryPlugin::flushBlock() {
+    if (blockEncoder.empty()) {
+        return;
+    }
+    blockEncoder.finish();
+    ShotLogBlockIndexEntry entry{};
+    entry.offset = fileOffset;
+    entry.firstSample = sampleCount - blockEncoder.sampleCount();
+    entry.firstTick = blockEncoder.firstTick();
+    entry.sampleCount = blockEncoder.sampleCount();
+    blockIndex.push_back(entry);
+
+    if (ioBufferPos + blockEncoder.size() > sizeof(ioBuffer)) {
+        flushBuffer();
+    }
+    memcpy(ioBuffer + ioBufferPos, blockEncoder.data(), blockEncoder.size());
+    ioBufferPos += blockEncoder.size();
+    fileOffset += blockEncoder.size();
+    blockEncoder.reset();
+}
+
+void ShotHistoryPlugin::writeBlockIndex() {
+    flushBuffer();
+    header.indexOffset = fileOffset;
+    header.blockCount = static_cast<uint16_t>(blockIndex.size());
+    size_t indexSize = blockIndex.size() * sizeof(ShotLogBlockIndexEntry);
+    auto *entries = reinterpret_cast<const uint8_t *>(blockIndex.data());
+    uint32_t crc = shotLogCrc32(0, entries, indexSize);
+    currentFile.write(entries, indexSize);
+    currentFile.write(reinterpret_cast<const uint8_t *>(&crc), sizeof(crc));
+    fileOffset += indexSize + sizeof(crc);
+}
+
+void ShotHistoryPlugin::trackPhase() {
+    // A phase change shows in the process snapshot within a progress tick, samples read before that still count to the
+    // phase before it
+    const ProcessSnapshot process = controller->getProcessSnapshot();
+    if (!process.current || process.type != MODE_BREW || process.currentPhaseStarted == analyzedPhaseStarted) {
+        return;
+    }
+    analyzedPhaseStarted = process.currentPhaseStarted;
+    const auto elapsed = static_cast<int32_t>(process.currentPhaseStarted - shotStart);
+    const uint32_t tick = elapsed > 0 ? static_cast<uint32_t>(elapsed) / SHOT_LOG_TICK_MS : 0;
+    analyzer.beginPhase(static_cast<uint16_t>(tick <= 0xFFFF ? tick : 0xFFFF), process.phaseName);
+}
+
+void ShotHistoryPlugin::writeAnalytics() {
+    const ShotAnalyticsHeader &analytics = analyzer.header();
+    File file = SPIFFS.open("/h/" + currentId + ".sa", FILE_WRITE);
+    if (!file) {
+        ESP_LOGE("ShotHistoryPlugin", "Failed to write analytics for shot %s", currentId.c_str());
+        return;
+    }
+    file.write(reinterpret_cast<const uint8_t *>(&analytics), sizeof(analytics));
+    file.write(reinterpret_cast<const uint8_t *>(analyzer.phaseRecords()), analytics.phaseCount * sizeof(ShotPhaseAnalytics));
+    file.close();
+}
+
 void ShotHistoryPlugin::startRecording() {
     currentId = controller->getSettings().getHistoryIndex();
     while (currentId.length() < 6) {
         currentId = "0" + currentId;
     }
     shotStart = millis();
+    sensorCursor = controller->getSensorSamples().head();
     currentBluetoothWeight = 0.0f;
     lastBluetoothWeight = 0.0f;
     currentEstimatedWeight = 0.0f;
     currentBluetoothFlow = 0.0f;
-    currentProfileName = controller->getProfileManager()->getSelectedProfile().label;
+    currentProfileName = controller->getProfileManager()->getSelectedProfile()->label;
     recording = true;
     indexEntryCreated = false; // Reset flag for new shot
     sampleCount = 0;
     ioBufferPos = 0;
+    fileOffset = 0;
+    blockIndex.clear();
+    analyzer.reset();
+    analyzedPhaseStarted = 0;
 }
 
 unsigned long ShotHistoryPlugin::getTime() {
@@ -209,71 +296,44 @@ unsigned long ShotHistoryPlugin::getTime() {
 void ShotHistoryPlugin::endRecording() { recording = false; }
 
 void ShotHistoryPlugin::cleanupHistory() {
+    // Shots are counted by their log, notes and analytics are removed along with it
     File directory = SPIFFS.open("/h");
-    std::vector<String> entries;
+    std::vector<String> shots;
     String filename = directory.getNextFileName();
     while (filename != "") {
-        entries.push_back(filename);
+        if (filename.endsWith(".slog")) {
+            shots.push_back(filename.substring(filename.lastIndexOf('/') + 1, filename.lastIndexOf('.')));
+        }
         filename = directory.getNextFileName();
     }
-    sort(entries.begin(), entries.end(), [](String a, String b) { return a < b; });
-    if (entries.size() > MAX_HISTORY_ENTRIES) {
-        for (unsigned int i = 0; i < entries.size() - MAX_HISTORY_ENTRIES; i++) {
-            String name = entries[i];
-            SPIFFS.remove(name);
+    sort(shots.begin(), shots.end(), [](String a, String b) { return a < b; });
+    if (shots.size() > MAX_HISTORY_ENTRIES) {
+        for (unsigned int i = 0; i < shots.size() - MAX_HISTORY_ENTRIES; i++) {
+            removeShot(shots[i]);
+            markIndexDeleted(shots[i].toInt());
         }
     }
 }
 
+void ShotHistoryPlugin::removeShot(const String &id) {
+    SPIFFS.remove("/h/" + id + ".slog");
+    SPIFFS.remove("/h/" + id + ".json");
+    SPIFFS.remove("/h/" + id + ".sa");
+}
+
 void ShotHistoryPlugin::handleRequest(JsonDocument &request, JsonDocument &response) {
     String type = request["tp"].as<String>();
     response["tp"] = String("res:") + type.substring(4);
     response["rid"] = request["rid"].as<String>();
 
     if (type == "req:history:list") {
-        JsonArray arr = response["history"].to<JsonArray>();
-        File root = SPIFFS.open("/h");
-        if (root && root.isDirectory()) {
-            File file = root.openNextFile();
-            while (file) {
-                String fname = String(file.name());
-                if (fname.endsWith(".slog")) {
-                    // Read header only
-                    ShotLogHeader hdr{};
-                    if (file.read(reinterpret_cast<uint8_t *>(&hdr), sizeof(hdr)) == sizeof(hdr) && hdr.magic == SHOT_LOG_MAGIC) {
-                        float finalWeight = hdr.finalWeight > 0 ? static_cast<float>(hdr.finalWeight) / WEIGHT_SCALE : 0.0f;
-
-                        bool headerIncomplete = hdr.sampleCount == 0;
-
-                        auto o = arr.add<JsonObject>();
-                        int start = fname.lastIndexOf('/') + 1;
-                        int end = fname.lastIndexOf('.');
-                        String id = fname.substring(start, end);
-                        o["id"] = id;
-                        o["version"] = hdr.version;
-                        o["timestamp"] = hdr.startEpoch;
-                        o["profile"] = hdr.profileName;
-                        o["profileId"] = hdr.profileId;
-                        o["samples"] = hdr.sampleCount;
-                        o["duration"] = hdr.durationMs;
-                        if (finalWeight > 0.0f) {
-                            o["volume"] = finalWeight;
-                        }
-                        if (headerIncomplete) {
-                            o["incomplete"] = true; // flag partial shot
-                        }
-                    }
-                }
-                file = root.openNextFile();
-            }
-        }
+        listHistory(request, response);
     } else if (type == "req:history:get") {
         // Return error: binary must be fetched via HTTP endpoint
         response["error"] = "use HTTP /api/history?id=<id>";
     } else if (type == "req:history:delete") {
         auto id = request["id"].as<String>();
-        SPIFFS.remove("/h/" + id + ".slog");
-        SPIFFS.remove("/h/" + id + ".json");
+        removeShot(id);
 
         // Mark as deleted in index
         markIndexDeleted(id.toInt());
@@ -347,136 +407,131 @@ void ShotHistoryPlugin::flushBuffer() {
 }
 
 // Index management methods
+// The shots that are not deleted are kept in RAM as indexRecords, in the same order as the entries in /h/index.bin,
+// with indexSlots mapping shot ids to their position. Every change is written through to the matching entry in the file.
+// Deleted entries only stay in the file, which is rewritten without them once they make up more than half of it.
+void ShotHistoryPlugin::loadIndex() {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    indexRecords.clear();
+    indexPositions.clear();
+    indexSlots.clear();
+    indexLoaded = false;
+
+    File indexFile = SPIFFS.open("/h/index.bin", "r");
+    if (!indexFile) {
+        ESP_LOGI("ShotHistoryPlugin", "No index file, it will be created with the next shot");
+        return;
+    }
+
+    ShotIndexHeader fileHeader{};
+    if (indexFile.read(reinterpret_cast<uint8_t *>(&fileHeader), sizeof(fileHeader)) != sizeof(fileHeader) ||
+        fileHeader.magic != SHOT_INDEX_MAGIC || fileHeader.entrySize != SHOT_INDEX_ENTRY_SIZE) {
+        ESP_LOGE("ShotHistoryPlugin", "Invalid index file, it will be recreated with the next shot");
+        indexFile.close();
+        return;
+    }
+
+    ShotIndexEntry entry{};
+    uint32_t entriesRead = 0;
+    for (; entriesRead < fileHeader.entryCount; entriesRead++) {
+        if (indexFile.read(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) != sizeof(entry)) {
+            ESP_LOGW("ShotHistoryPlugin", "Index truncated after %u of %u entries", entriesRead, fileHeader.entryCount);
+            break;
+        }
+        addIndexRecord(entry, entriesRead);
+    }
+    indexFile.close();
+
+    indexHeader = fileHeader;
+    indexHeader.entryCount = entriesRead;
+    indexLoaded = true;
+    ESP_LOGI("ShotHistoryPlugin", "Loaded %zu index entries, %zu deleted", indexRecords.size(),
+             indexHeader.entryCount - indexRecords.size());
+    compactIndexIfSparse();
+}
+
 bool ShotHistoryPlugin::ensureIndexExists() {
-    if (SPIFFS.exists("/h/index.bin")) {
+    if (indexLoaded) {
         return true;
     }
 
     // Create new empty index
-    File indexFile = SPIFFS.open("/h/index.bin", FILE_WRITE);
-    if (!indexFile) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to create index file");
+    indexRecords.clear();
+    indexPositions.clear();
+    indexSlots.clear();
+    indexHeader = ShotIndexHeader{};
+    indexHeader.magic = SHOT_INDEX_MAGIC;
+    indexHeader.version = SHOT_INDEX_VERSION;
+    indexHeader.entrySize = SHOT_INDEX_ENTRY_SIZE;
+    indexHeader.entryCount = 0;
+    indexHeader.nextId = controller->getSettings().getHistoryIndex();
+
+    if (!writeIndexFile()) {
         return false;
     }
-
-    ShotIndexHeader header{};
-    header.magic = SHOT_INDEX_MAGIC;
-    header.version = SHOT_INDEX_VERSION;
-    header.entrySize = SHOT_INDEX_ENTRY_SIZE;
-    header.entryCount = 0;
-    header.nextId = controller->getSettings().getHistoryIndex();
-
-    indexFile.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
-    indexFile.close();
-
+    indexLoaded = true;
     ESP_LOGI("ShotHistoryPlugin", "Created new index file");
     return true;
 }
 
 void ShotHistoryPlugin::appendToIndex(const ShotIndexEntry &entry) {
+    std::lock_guard<std::mutex> lock(indexMutex);
     if (!ensureIndexExists()) {
         return;
     }
 
-    File indexFile = SPIFFS.open("/h/index.bin", "r+");
-    if (!indexFile) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to open index file for append");
-        return;
-    }
-
-    ShotIndexHeader header{};
-    if (!readIndexHeader(indexFile, header)) {
-        indexFile.close();
-        return;
+    addIndexRecord(entry, indexHeader.entryCount);
+    indexHeader.entryCount++;
+    indexHeader.nextId = entry.id + 1;
+    if (writeIndexEntry(indexRecords.size() - 1, true)) {
+        ESP_LOGD("ShotHistoryPlugin", "Appended shot %u to index", entry.id);
     }
-
-    // Append entry
-    indexFile.seek(0, SeekEnd);
-    indexFile.write(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry));
-
-    // Update header
-    header.entryCount++;
-    header.nextId = entry.id + 1;
-    indexFile.seek(0, SeekSet);
-    indexFile.write(reinterpret_cast<const uint8_t *>(&header), sizeof(header));
-
-    indexFile.close();
-    ESP_LOGD("ShotHistoryPlugin", "Appended shot %u to index", entry.id);
 }
 
 void ShotHistoryPlugin::updateIndexMetadata(uint32_t shotId, uint8_t rating, uint16_t volume) {
-    File indexFile = SPIFFS.open("/h/index.bin", "r+");
-    if (!indexFile) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to open index file for metadata update");
+    std::lock_guard<std::mutex> lock(indexMutex);
+    int slot = findIndexSlot(shotId);
+    if (slot < 0) {
+        ESP_LOGW("ShotHistoryPlugin", "Shot %u not found in index for metadata update", shotId);
         return;
     }
 
-    ShotIndexHeader header{};
-    if (!readIndexHeader(indexFile, header)) {
-        indexFile.close();
-        return;
+    ShotIndexRecord &record = indexRecords[slot];
+    record.rating = rating;
+    if (volume > 0) {
+        record.volume = volume;
     }
-
-    int entryPos = findEntryPosition(indexFile, header, shotId);
-    if (entryPos >= 0) {
-        ShotIndexEntry entry{};
-        if (readEntryAtPosition(indexFile, entryPos, entry)) {
-            entry.rating = rating;
-            if (volume > 0) {
-                entry.volume = volume;
-            }
-            if (rating > 0) {
-                entry.flags |= SHOT_FLAG_HAS_NOTES;
-            }
-
-            if (writeEntryAtPosition(indexFile, entryPos, entry)) {
-                ESP_LOGD("ShotHistoryPlugin", "Updated metadata for shot %u: rating=%u, volume=%u", shotId, rating, volume);
-            }
-        }
-    } else {
-        ESP_LOGW("ShotHistoryPlugin", "Shot %u not found in index for metadata update", shotId);
+    if (rating > 0) {
+        record.flags |= SHOT_FLAG_HAS_NOTES;
     }
 
-    indexFile.close();
+    if (writeIndexEntry(slot, false)) {
+        ESP_LOGD("ShotHistoryPlugin", "Updated metadata for shot %u: rating=%u, volume=%u", shotId, rating, volume);
+    }
 }
 
 void ShotHistoryPlugin::markIndexDeleted(uint32_t shotId) {
-    File indexFile = SPIFFS.open("/h/index.bin", "r+");
-    if (!indexFile) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to open index file for deletion marking");
-        return;
-    }
-
-    ShotIndexHeader header{};
-    if (!readIndexHeader(indexFile, header)) {
-        indexFile.close();
+    std::lock_guard<std::mutex> lock(indexMutex);
+    int slot = findIndexSlot(shotId);
+    if (slot < 0) {
+        ESP_LOGW("ShotHistoryPlugin", "Shot %u not found in index for deletion marking", shotId);
         return;
     }
 
-    int entryPos = findEntryPosition(indexFile, header, shotId);
-    if (entryPos >= 0) {
-        ShotIndexEntry entry{};
-        if (readEntryAtPosition(indexFile, entryPos, entry)) {
-            entry.flags |= SHOT_FLAG_DELETED;
-
-            if (writeEntryAtPosition(indexFile, entryPos, entry)) {
-                ESP_LOGD("ShotHistoryPlugin", "Marked shot %u as deleted in index", shotId);
-            }
-        }
-    } else {
-        ESP_LOGW("ShotHistoryPlugin", "Shot %u not found in index for deletion marking", shotId);
+    indexRecords[slot].flags |= SHOT_FLAG_DELETED;
+    if (writeIndexEntry(slot, false)) {
+        ESP_LOGD("ShotHistoryPlugin", "Marked shot %u as deleted in index", shotId);
     }
-
-    indexFile.close();
+    removeIndexRecord(slot);
+    compactIndexIfSparse();
 }
 
 void ShotHistoryPlugin::rebuildIndex() {
     ESP_LOGI("ShotHistoryPlugin", "Starting index rebuild...");
+    std::lock_guard<std::mutex> lock(indexMutex);
 
-    // Delete existing index
-    SPIFFS.remove("/h/index.bin");
-
-    // Create new empty index
+    // Start from an empty index, the file is written once all shots have been read
+    indexLoaded = false;
     if (!ensureIndexExists()) {
         ESP_LOGE("ShotHistoryPlugin", "Failed to create index during rebuild");
         return;
@@ -542,6 +597,17 @@ void ShotHistoryPlugin::rebuildIndex() {
             entry.flags &= ~SHOT_FLAG_COMPLETED;
         }
 
+        // Shots recorded before analytics have no sidecar and keep an empty summary
+        File analyticsFile = SPIFFS.open("/h/" + fileName.substring(start, end) + ".sa", "r");
+        if (analyticsFile) {
+            ShotAnalyticsHeader analytics{};
+            if (analyticsFile.read(reinterpret_cast<uint8_t *>(&analytics), sizeof(analytics)) == sizeof(analytics) &&
+                analytics.magic == SHOT_ANALYTICS_MAGIC) {
+                entry.analytics = analytics.summary;
+            }
+            analyticsFile.close();
+        }
+
         // Check for notes and extract rating and volume override
         String notesPath = "/h/" + String(shotId, 10) + ".json";
         if (SPIFFS.exists(notesPath)) {
@@ -569,64 +635,163 @@ void ShotHistoryPlugin::rebuildIndex() {
 
         shotFile.close();
 
-        // Append to index
-        appendToIndex(entry);
+        addIndexRecord(entry, indexRecords.size());
+        indexHeader.nextId = entry.id + 1;
     }
 
+    indexHeader.entryCount = indexRecords.size();
+    writeIndexFile();
     ESP_LOGI("ShotHistoryPlugin", "Index rebuild completed");
 }
 
-// Index helper functions
-bool ShotHistoryPlugin::readIndexHeader(File &indexFile, ShotIndexHeader &header) {
-    if (indexFile.read(reinterpret_cast<uint8_t *>(&header), sizeof(header)) != sizeof(header)) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to read index header");
-        return false;
-    }
-    if (header.magic != SHOT_INDEX_MAGIC) {
-        ESP_LOGE("ShotHistoryPlugin", "Invalid index magic: 0x%08X", header.magic);
-        return false;
+void ShotHistoryPlugin::listHistory(JsonDocument &request, JsonDocument &response) {
+    // Optional filters and pagination, results are ordered newest first
+    String profile = request["profile"].as<String>();
+    uint32_t from = request["from"].as<uint32_t>();
+    uint32_t to = request["to"].as<uint32_t>();
+    uint8_t minRating = request["minRating"].as<uint8_t>();
+    uint32_t offset = request["offset"].as<uint32_t>();
+    uint32_t limit = request["limit"].as<uint32_t>(); // 0 returns all matches
+
+    JsonArray arr = response["history"].to<JsonArray>();
+    uint32_t total = 0;
+    std::lock_guard<std::mutex> lock(indexMutex);
+    for (auto it = indexRecords.rbegin(); it != indexRecords.rend(); ++it) {
+        const ShotIndexRecord &record = *it;
+        if ((record.flags & SHOT_FLAG_DELETED) || record.rating < minRating || (from > 0 && record.timestamp < from) ||
+            (to > 0 && record.timestamp > to)) {
+            continue;
+        }
+        if (!profile.isEmpty() && profile != record.profileId && profile != record.profileName) {
+            continue;
+        }
+        total++;
+        if (total <= offset || (limit > 0 && total > offset + limit)) {
+            continue;
+        }
+
+        char id[12];
+        snprintf(id, sizeof(id), "%06u", record.id);
+        auto o = arr.add<JsonObject>();
+        o["id"] = id;
+        o["timestamp"] = record.timestamp;
+        o["profile"] = record.profileName;
+        o["profileId"] = record.profileId;
+        o["duration"] = record.duration;
+        if (record.volume > 0) {
+            o["volume"] = static_cast<float>(record.volume) / WEIGHT_SCALE;
+        }
+        if (record.rating > 0) {
+            o["rating"] = record.rating;
+        }
+        if (record.flags & SHOT_FLAG_HAS_NOTES) {
+            o["notes"] = true;
+        }
+        if (!(record.flags & SHOT_FLAG_COMPLETED)) {
+            o["incomplete"] = true; // flag partial shot
+        }
+        const ShotAnalyticsSummary &summary = record.analytics;
+        if (summary.flags & SHOT_ANALYTICS_FLAG_VALID) {
+            auto analytics = o["analytics"].to<JsonObject>();
+            if (summary.firstDripTick != SHOT_ANALYTICS_NO_DRIP) {
+                analytics["firstDrip"] = summary.firstDripTick * SHOT_LOG_TICK_MS;
+            }
+            analytics["avgPressure"] = summary.avgPressure / PRESSURE_SCALE;
+            analytics["peakPressure"] = summary.peakPressure / PRESSURE_SCALE;
+            analytics["avgFlow"] = summary.avgFlow / FLOW_SCALE;
+            analytics["peakFlow"] = summary.peakFlow / FLOW_SCALE;
+            analytics["tempStdDev"] = summary.tempStdDev / 100.0f;
+            analytics["resistanceTrend"] = summary.resistanceTrend / RESISTANCE_SCALE;
+            analytics["channeling"] = summary.channelEvents;
+        }
     }
-    return true;
+    response["total"] = total;
+    response["offset"] = offset;
+    response["limit"] = limit;
 }
 
-int ShotHistoryPlugin::findEntryPosition(File &indexFile, const ShotIndexHeader &header, uint32_t shotId) {
-    for (uint32_t i = 0; i < header.entryCount; i++) {
-        size_t entryPos = sizeof(ShotIndexHeader) + i * sizeof(ShotIndexEntry);
-        indexFile.seek(entryPos, SeekSet);
+// Index helper functions
+void ShotHistoryPlugin::addIndexRecord(const ShotIndexEntry &entry, uint32_t position) {
+    if (entry.flags & SHOT_FLAG_DELETED) {
+        return; // only the file keeps it, until the next compaction
+    }
+    ShotIndexRecord record{};
+    memcpy(&record, &entry, sizeof(record));
+    indexSlots[record.id] = indexRecords.size();
+    indexRecords.push_back(record);
+    indexPositions.push_back(position);
+}
 
-        ShotIndexEntry entry{};
-        if (!readEntryAtPosition(indexFile, entryPos, entry)) {
-            ESP_LOGW("ShotHistoryPlugin", "Failed to read entry at position %u", i);
-            break;
-        }
+void ShotHistoryPlugin::removeIndexRecord(size_t slot) {
+    indexSlots.erase(indexRecords[slot].id);
+    indexRecords.erase(indexRecords.begin() + slot);
+    indexPositions.erase(indexPositions.begin() + slot);
+    for (size_t i = slot; i < indexRecords.size(); i++) {
+        indexSlots[indexRecords[i].id] = i;
+    }
+}
 
-        if (entry.id == shotId) {
-            return entryPos;
-        }
+void ShotHistoryPlugin::compactIndexIfSparse() {
+    const size_t deletedEntries = indexHeader.entryCount - indexRecords.size();
+    if (deletedEntries <= indexRecords.size()) {
+        return;
+    }
+    if (writeIndexFile()) {
+        indexRecords.shrink_to_fit();
+        indexPositions.shrink_to_fit();
+        ESP_LOGI("ShotHistoryPlugin", "Compacted index, dropped %zu deleted entries", deletedEntries);
     }
-    return -1;
 }
 
-bool ShotHistoryPlugin::readEntryAtPosition(File &indexFile, size_t position, ShotIndexEntry &entry) {
-    indexFile.seek(position, SeekSet);
-    if (indexFile.read(reinterpret_cast<uint8_t *>(&entry), sizeof(entry)) != sizeof(entry)) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to read entry at position %zu", position);
+int ShotHistoryPlugin::findIndexSlot(uint32_t shotId) const {
+    auto it = indexSlots.find(shotId);
+    return it != indexSlots.end() ? static_cast<int>(it->second) : -1;
+}
+
+// Writes the records without the deleted entries, every record moves to its position in indexRecords
+bool ShotHistoryPlugin::writeIndexFile() {
+    File indexFile = SPIFFS.open("/h/index.bin", FILE_WRITE);
+    if (!indexFile) {
+        ESP_LOGE("ShotHistoryPlugin", "Failed to create index file");
         return false;
     }
+    indexHeader.entryCount = indexRecords.size();
+    indexFile.write(reinterpret_cast<const uint8_t *>(&indexHeader), sizeof(indexHeader));
+    ShotIndexEntry entry{};
+    for (size_t i = 0; i < indexRecords.size(); i++) {
+        memcpy(&entry, &indexRecords[i], sizeof(ShotIndexRecord));
+        indexFile.write(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry));
+        indexPositions[i] = i;
+    }
+    indexFile.close();
     return true;
 }
 
-bool ShotHistoryPlugin::writeEntryAtPosition(File &indexFile, size_t position, const ShotIndexEntry &entry) {
-    indexFile.seek(position, SeekSet);
-    if (indexFile.write(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry)) != sizeof(entry)) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to write entry at position %zu", position);
+bool ShotHistoryPlugin::writeIndexEntry(size_t slot, bool writeHeader) {
+    File indexFile = SPIFFS.open("/h/index.bin", "r+");
+    if (!indexFile) {
+        ESP_LOGE("ShotHistoryPlugin", "Failed to open index file for update");
         return false;
     }
-    return true;
+
+    ShotIndexEntry entry{};
+    memcpy(&entry, &indexRecords[slot], sizeof(ShotIndexRecord));
+    size_t position = sizeof(ShotIndexHeader) + indexPositions[slot] * sizeof(ShotIndexEntry);
+    indexFile.seek(position, SeekSet);
+    bool written = indexFile.write(reinterpret_cast<const uint8_t *>(&entry), sizeof(entry)) == sizeof(entry);
+    if (written && writeHeader) {
+        indexFile.seek(0, SeekSet);
+        written = indexFile.write(reinterpret_cast<const uint8_t *>(&indexHeader), sizeof(indexHeader)) == sizeof(indexHeader);
+    }
+    indexFile.close();
+    if (!written) {
+        ESP_LOGE("ShotHistoryPlugin", "Failed to write index entry at position %zu", position);
+    }
+    return written;
 }
 
 void ShotHistoryPlugin::createEarlyIndexEntry() {
-    Profile profile = controller->getProfileManager()->getSelectedProfile();
+    ProfileRef profile = controller->getProfileManager()->getSelectedProfile();
 
     ShotIndexEntry indexEntry{};
     indexEntry.id = currentId.toInt();
@@ -635,45 +800,33 @@ void ShotHistoryPlugin::createEarlyIndexEntry() {
     indexEntry.volume = 0;   // Will be updated on completion
     indexEntry.rating = 0;
     indexEntry.flags = 0; // No SHOT_FLAG_COMPLETED - indicates incomplete shot
-    strncpy(indexEntry.profileId, profile.id.c_str(), sizeof(indexEntry.profileId) - 1);
+    strncpy(indexEntry.profileId, profile->id.c_str(), sizeof(indexEntry.profileId) - 1);
     indexEntry.profileId[sizeof(indexEntry.profileId) - 1] = '\0';
-    strncpy(indexEntry.profileName, profile.label.c_str(), sizeof(indexEntry.profileName) - 1);
+    strncpy(indexEntry.profileName, profile->label.c_str(), sizeof(indexEntry.profileName) - 1);
     indexEntry.profileName[sizeof(indexEntry.profileName) - 1] = '\0';
 
     appendToIndex(indexEntry);
     ESP_LOGD("ShotHistoryPlugin", "Created early index entry for shot %u", indexEntry.id);
 }
 
-void ShotHistoryPlugin::updateIndexCompletion(uint32_t shotId, const ShotLogHeader &finalHeader) {
-    File indexFile = SPIFFS.open("/h/index.bin", "r+");
-    if (!indexFile) {
-        ESP_LOGE("ShotHistoryPlugin", "Failed to open index file for completion update");
+void ShotHistoryPlugin::updateIndexCompletion(uint32_t shotId, const ShotLogHeader &finalHeader,
+                                              const ShotAnalyticsSummary &analytics) {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    int slot = findIndexSlot(shotId);
+    if (slot < 0) {
+        ESP_LOGW("ShotHistoryPlugin", "Shot %u not found in index for completion update", shotId);
         return;
     }
 
-    ShotIndexHeader header{};
-    if (!readIndexHeader(indexFile, header)) {
-        indexFile.close();
-        return;
-    }
+    // Update with final shot data
+    ShotIndexRecord &record = indexRecords[slot];
+    record.duration = finalHeader.durationMs;
+    record.volume = finalHeader.finalWeight;
+    record.analytics = analytics;
+    record.flags |= SHOT_FLAG_COMPLETED; // Mark as completed
 
-    int entryPos = findEntryPosition(indexFile, header, shotId);
-    if (entryPos >= 0) {
-        ShotIndexEntry entry{};
-        if (readEntryAtPosition(indexFile, entryPos, entry)) {
-            // Update with final shot data
-            entry.duration = finalHeader.durationMs;
-            entry.volume = finalHeader.finalWeight;
-            entry.flags |= SHOT_FLAG_COMPLETED; // Mark as completed
-
-            if (writeEntryAtPosition(indexFile, entryPos, entry)) {
-                ESP_LOGD("ShotHistoryPlugin", "Updated shot %u completion: duration=%u, volume=%u", shotId, entry.duration,
-                         entry.volume);
-            }
-        }
-    } else {
-        ESP_LOGW("ShotHistoryPlugin", "Shot %u not found in index for completion update", shotId);
+    if (writeIndexEntry(slot, false)) {
+        ESP_LOGD("ShotHistoryPlugin", "Updated shot %u completion: duration=%u, volume=%u", shotId, record.duration,
+                 record.volume);
     }
-
-    indexFile.close();
 }
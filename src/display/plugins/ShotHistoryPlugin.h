@@ -2,10 +2,16 @@
 #define SHOTHISTORYPLUGIN_H
 
 #include <ArduinoJson.h>
+#include <BinaryProtocol.h>
 #include <SPIFFS.h>
 #include <display/core/Plugin.h>
 #include <display/core/utils.h>
+#include <display/models/shot_analytics.h>
+#include <display/models/shot_log_codec.h>
 #include <display/models/shot_log_format.h>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 constexpr size_t MAX_HISTORY_ENTRIES = 100; // Increased from 10
 
@@ -25,19 +31,29 @@ class ShotHistoryPlugin : public Plugin {
     void updateIndexMetadata(uint32_t shotId, uint8_t rating, uint16_t volume);
     void markIndexDeleted(uint32_t shotId);
     void rebuildIndex();
-    bool ensureIndexExists();
 
   private:
-    // Index helper functions
-    bool readIndexHeader(File &indexFile, ShotIndexHeader &header);
-    int findEntryPosition(File &indexFile, const ShotIndexHeader &header, uint32_t shotId);
-    bool readEntryAtPosition(File &indexFile, size_t position, ShotIndexEntry &entry);
-    bool writeEntryAtPosition(File &indexFile, size_t position, const ShotIndexEntry &entry);
+    void loadIndex();
+    void listHistory(JsonDocument &request, JsonDocument &response);
+    // Index helper functions, callers hold indexMutex
+    bool ensureIndexExists();
+    void addIndexRecord(const ShotIndexEntry &entry, uint32_t position);
+    void removeIndexRecord(size_t slot);
+    void compactIndexIfSparse();
+    int findIndexSlot(uint32_t shotId) const;
+    bool writeIndexFile();
+    bool writeIndexEntry(size_t slot, bool writeHeader);
     void createEarlyIndexEntry();
-    void updateIndexCompletion(uint32_t shotId, const ShotLogHeader &finalHeader);
+    void updateIndexCompletion(uint32_t shotId, const ShotLogHeader &finalHeader, const ShotAnalyticsSummary &analytics);
     void saveNotes(const String &id, const JsonDocument &notes);
     void loadNotes(const String &id, JsonDocument &notes);
     void startRecording();
+    void writeSample(const SensorSample &sensorSample);
+    void flushBlock();
+    void writeBlockIndex();
+    void trackPhase();
+    void writeAnalytics();
+    void removeShot(const String &id);
 
     unsigned long getTime();
 
@@ -53,18 +69,29 @@ class ShotHistoryPlugin : public Plugin {
     uint32_t sampleCount = 0;
     uint8_t ioBuffer[4096];
     size_t ioBufferPos = 0; // bytes used
+    uint32_t fileOffset = 0; // bytes written to currentFile, including ioBuffer
+    ShotLogBlockEncoder blockEncoder;
+    std::vector<ShotLogBlockIndexEntry> blockIndex;
+    ShotAnalyzer analyzer;
+    unsigned long analyzedPhaseStarted = 0; // currentPhaseStarted of the phase last passed to the analyzer
 
     bool recording = false;
     bool indexEntryCreated = false; // Track if early index entry was created
     unsigned long shotStart = 0;
-    float currentTemperature = 0.0f;
+    uint32_t sensorCursor = 0;
     float currentBluetoothWeight = 0.0f;
     float lastBluetoothWeight = 0.0f;
     float currentBluetoothFlow = 0.0f;
     float currentEstimatedWeight = 0.0f;
-    float currentPuckResistance = 0.0f;
     String currentProfileName;
 
+    std::mutex indexMutex;
+    bool indexLoaded = false;
+    ShotIndexHeader indexHeader{};                   // entryCount includes the deleted entries still in the file
+    std::vector<ShotIndexRecord> indexRecords;       // shots not deleted, in the order of /h/index.bin
+    std::vector<uint32_t> indexPositions;            // entry number in /h/index.bin of each record
+    std::unordered_map<uint32_t, size_t> indexSlots; // shot id -> position in indexRecords
+
     xTaskHandle taskHandle;
     void flushBuffer();
     static void loopTask(void *arg);
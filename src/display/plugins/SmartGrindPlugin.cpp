@@ -1,39 +1,204 @@
 #include "SmartGrindPlugin.h"
-#include <ESPmDNS.h>
-#include <HTTPClient.h>
 #include <WiFi.h>
+#include <algorithm>
 #include <display/core/Controller.h>
 #include <display/core/Event.h>
+#include <display/core/PluginManager.h>
+
+namespace {
+bool expired(unsigned long deadline) { return static_cast<long>(millis() - deadline) >= 0; }
+} // namespace
 
 void SmartGrindPlugin::setup(Controller *controller, PluginManager *pluginManager) {
     this->controller = controller;
+    this->pluginManager = pluginManager;
+    requests = xQueueCreate(SG_QUEUE_LENGTH, sizeof(RelayRequest));
+    xTaskCreatePinnedToCore(loopTask, "SmartGrindPlugin::loop", configMINIMAL_STACK_SIZE * 6, this, 2, &taskHandle, 0);
     pluginManager->on("controller:grind:start", [this](Event const &event) { start(); });
     pluginManager->on("controller:grind:end", [this](Event const &event) { stop(); });
 }
 
 void SmartGrindPlugin::start() {
-    Settings &settings = this->controller->getSettings();
-    if (settings.getSmartGrindMode() == SG_MODE_ON_OFF) {
-        controlRelay(COMMAND_ON);
+    // The connection is opened now in every mode, the off request at the target is the one that has to be fast
+    if (controller->getSettings().getSmartGrindMode() == SG_MODE_ON_OFF) {
+        enqueue(RelayCommand::ON, true);
+    } else {
+        enqueue(RelayCommand::CONNECT, true);
     }
 }
 
 void SmartGrindPlugin::stop() {
-    Settings &settings = controller->getSettings();
-    controlRelay(COMMAND_OFF);
-    if (settings.getSmartGrindMode() == SG_MODE_OFF_ON) {
-        delay(500);
-        controlRelay(COMMAND_ON);
-    }
-}
-
-void SmartGrindPlugin::controlRelay(String command) {
-    HTTPClient http;
-    Settings &settings = controller->getSettings();
-    String serverPath = "http://" + settings.getSmartGrindIp() + "/cm?cmnd=" + command;
-    http.begin(serverPath);
-    int responseCode = http.GET();
-    if (responseCode != 200) {
-        printf("Failed to switch Relay\n");
+    // Anything still queued belongs to the grind that just ended, switching off comes first
+    xQueueReset(requests);
+    const bool toggle = controller->getSettings().getSmartGrindMode() == SG_MODE_OFF_ON;
+    enqueue(RelayCommand::OFF, toggle);
+    if (toggle) {
+        enqueue(RelayCommand::ON, false, SG_TOGGLE_DELAY_MS);
+    }
+}
+
+void SmartGrindPlugin::enqueue(RelayCommand command, bool hold, uint32_t delayMs) const {
+    RelayRequest request;
+    request.command = command;
+    request.delayMs = delayMs;
+    request.hold = hold;
+    if (xQueueSend(requests, &request, 0) != pdTRUE) {
+        ESP_LOGW("SmartGrindPlugin", "Request queue full, dropping relay request");
+    }
+}
+
+void SmartGrindPlugin::process(const RelayRequest &request) {
+    if (request.delayMs > 0) {
+        vTaskDelay(pdMS_TO_TICKS(request.delayMs));
+    }
+    holdConnection = request.hold;
+    if (request.command == RelayCommand::CONNECT) {
+        if (!connect(getTimeout())) {
+            ESP_LOGW("SmartGrindPlugin", "Could not connect to relay at %s", host.c_str());
+        }
+    } else {
+        controlRelay(request.command == RelayCommand::ON);
+    }
+    if (!holdConnection) {
+        client.stop();
+    }
+}
+
+bool SmartGrindPlugin::connect(uint32_t timeout) {
+    const String ip = controller->getSettings().getSmartGrindIp();
+    if (client.connected() && ip == host) {
+        return true;
+    }
+    client.stop();
+    host = ip;
+    if (host.isEmpty() || !WiFi.isConnected()) {
+        return false;
+    }
+    return client.connect(host.c_str(), SG_RELAY_PORT, static_cast<int32_t>(timeout)) == 1;
+}
+
+void SmartGrindPlugin::controlRelay(bool on) {
+    const char *command = on ? COMMAND_ON : COMMAND_OFF;
+    const uint32_t timeout = getTimeout();
+    const unsigned long started = millis();
+    const bool reused = client.connected();
+    int status = sendCommand(command, timeout);
+    if (status == SG_STATUS_CONNECT_FAILED && reused) {
+        // The relay closed the held connection just as the request went out
+        status = sendCommand(command, timeout);
+    }
+    const unsigned long elapsed = millis() - started;
+    if (status == 200) {
+        ESP_LOGI("SmartGrindPlugin", "Switched relay %s in %lu ms", on ? "on" : "off", elapsed);
+    } else {
+        ESP_LOGW("SmartGrindPlugin", "Failed to switch relay %s (status %d) after %lu ms", on ? "on" : "off", status, elapsed);
+    }
+
+    Event event;
+    event.id = EventId::SMARTGRIND_RELAY_RESULT;
+    event.setInt("on", on ? 1 : 0);
+    event.setInt("status", status);
+    pluginManager->post(event, EventPriority::UI);
+}
+
+int SmartGrindPlugin::sendCommand(const char *command, uint32_t timeout) {
+    const unsigned long deadline = millis() + timeout;
+    if (!connect(timeout)) {
+        return SG_STATUS_CONNECT_FAILED;
+    }
+    while (client.available() > 0) {
+        client.read();
+    }
+
+    char line[SG_LINE_CAPACITY];
+    const int length = snprintf(line, sizeof(line), "GET /cm?cmnd=%s HTTP/1.1\r\nHost: %s\r\nConnection: keep-alive\r\n\r\n",
+                                command, host.c_str());
+    if (length <= 0 || length >= static_cast<int>(sizeof(line))) {
+        return SG_STATUS_CONNECT_FAILED;
+    }
+    if (client.write(reinterpret_cast<const uint8_t *>(line), length) != static_cast<size_t>(length)) {
+        client.stop();
+        return SG_STATUS_CONNECT_FAILED;
+    }
+
+    if (!readLine(line, deadline)) {
+        const int status = client.connected() ? SG_STATUS_TIMEOUT : SG_STATUS_CONNECT_FAILED;
+        client.stop();
+        return status;
+    }
+    int status = 0;
+    if (sscanf(line, "HTTP/%*d.%*d %d", &status) != 1) {
+        client.stop();
+        return SG_STATUS_INVALID_RESPONSE;
+    }
+
+    // Headers and body are read to the end so the connection can carry the next request
+    long contentLength = -1;
+    bool keepAlive = true;
+    while (true) {
+        if (!readLine(line, deadline)) {
+            keepAlive = false;
+            break;
+        }
+        if (line[0] == '\0') {
+            break;
+        }
+        if (strncasecmp(line, "Content-Length:", 15) == 0) {
+            contentLength = strtol(line + 15, nullptr, 10);
+        } else if (strncasecmp(line, "Connection:", 11) == 0 && strcasestr(line + 11, "close") != nullptr) {
+            keepAlive = false;
+        }
+    }
+    while (keepAlive && contentLength > 0) {
+        if (client.available() > 0) {
+            client.read();
+            contentLength--;
+        } else if (!client.connected() || expired(deadline)) {
+            keepAlive = false;
+        } else {
+            vTaskDelay(1);
+        }
+    }
+    if (!keepAlive || contentLength < 0) {
+        client.stop();
+    }
+    return status;
+}
+
+bool SmartGrindPlugin::readLine(char *line, unsigned long deadline) {
+    size_t length = 0;
+    while (true) {
+        if (client.available() > 0) {
+            const int c = client.read();
+            if (c == '\n') {
+                line[length] = '\0';
+                return true;
+            }
+            if (c != '\r' && length < SG_LINE_CAPACITY - 1) {
+                line[length++] = static_cast<char>(c);
+            }
+        } else if (!client.connected() || expired(deadline)) {
+            return false;
+        } else {
+            vTaskDelay(1);
+        }
+    }
+}
+
+uint32_t SmartGrindPlugin::getTimeout() const {
+    return std::max(SG_MIN_TIMEOUT_MS, static_cast<uint32_t>(std::max(0, controller->getSettings().getSmartGrindTimeout())));
+}
+
+void SmartGrindPlugin::loopTask(void *arg) {
+    auto *plugin = static_cast<SmartGrindPlugin *>(arg);
+    RelayRequest request;
+    while (true) {
+        const TickType_t wait = plugin->holdConnection ? pdMS_TO_TICKS(SG_WARM_INTERVAL_MS) : portMAX_DELAY;
+        if (xQueueReceive(plugin->requests, &request, wait) == pdTRUE) {
+            plugin->process(request);
+        } else {
+            // Relays drop idle connections after a few seconds, reopen it so the next request finds it ready
+            plugin->connect(plugin->getTimeout());
+        }
     }
 }
@@ -2,16 +2,42 @@
 #define SMARTGRINDPLUGIN_H
 #include "../core/Plugin.h"
 #include <Arduino.h>
+#include <WiFiClient.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
 
-const String COMMAND_ON = "Power%20On";
-const String COMMAND_OFF = "Power%20off";
+constexpr char COMMAND_ON[] = "Power%20On";
+constexpr char COMMAND_OFF[] = "Power%20off";
 
 constexpr int SG_MODE_OFF = 0;
 constexpr int SG_MODE_OFF_ON = 1;
 constexpr int SG_MODE_ON_OFF = 2;
 
+constexpr size_t SG_QUEUE_LENGTH = 4;
+constexpr uint32_t SG_TOGGLE_DELAY_MS = 500;   // relay off time before switching back on in SG_MODE_OFF_ON
+constexpr uint32_t SG_WARM_INTERVAL_MS = 1000; // how often a held connection is checked and reopened
+constexpr uint32_t SG_MIN_TIMEOUT_MS = 100;
+constexpr uint16_t SG_RELAY_PORT = 80;
+constexpr size_t SG_LINE_CAPACITY = 192; // request and response lines
+
+// Status reported in smartgrind:relay:result when no HTTP status was received
+constexpr int SG_STATUS_CONNECT_FAILED = -1;
+constexpr int SG_STATUS_TIMEOUT = -2;
+constexpr int SG_STATUS_INVALID_RESPONSE = -3;
+
+enum class RelayCommand : uint8_t { CONNECT, ON, OFF };
+
+struct RelayRequest {
+    RelayCommand command = RelayCommand::CONNECT;
+    uint32_t delayMs = 0; // waited out on the request task before sending
+    bool hold = false;    // another request follows, keep the connection open until it does
+};
+
 struct Event;
 
+// Switches a Tasmota relay for the grinder. Grind events only queue requests, a task of its own sends them over a
+// connection that is opened ahead of time, so the relay off request at the grind target does not wait for a TCP connect.
+// Every relay request ends with smartgrind:relay:result, carrying on (1 or 0) and status (HTTP status or SG_STATUS_*).
 class SmartGrindPlugin : public Plugin {
   public:
     void setup(Controller *controller, PluginManager *pluginManager) override;
@@ -20,9 +46,24 @@ class SmartGrindPlugin : public Plugin {
   private:
     void start();
     void stop();
-    void controlRelay(String command);
+    void enqueue(RelayCommand command, bool hold, uint32_t delayMs = 0) const;
+    void process(const RelayRequest &request);
+    bool connect(uint32_t timeout);
+    void controlRelay(bool on);
+    int sendCommand(const char *command, uint32_t timeout);
+    bool readLine(char *line, unsigned long deadline);
+    uint32_t getTimeout() const;
+    [[noreturn]] static void loopTask(void *arg);
 
     Controller *controller = nullptr;
+    PluginManager *pluginManager = nullptr;
+    QueueHandle_t requests = nullptr;
+    xTaskHandle taskHandle = nullptr;
+
+    // Owned by the request task
+    WiFiClient client;
+    String host;
+    bool holdConnection = false;
 };
 
 #endif // SMARTGRINDPLUGIN_H
@@ -4,6 +4,7 @@
 #include <display/core/Controller.h>
 #include <display/core/ProfileManager.h>
 #include <display/core/process/BrewProcess.h>
+#include <display/core/zones.h>
 #include <display/models/profile.h>
 #include <esp_core_dump.h>
 #include <esp_err.h>
@@ -12,6 +13,7 @@
 
 #include <algorithm>
 #include <display/plugins/BLEScalePlugin.h>
+#include <display/plugins/RuntimeStatsPlugin.h>
 #include <display/plugins/ShotHistoryPlugin.h>
 #include <string>
 #include <unordered_map>
@@ -31,11 +33,11 @@ void WebUIPlugin::setup(Controller *_controller, PluginManager *_pluginManager)
         BUILD_GIT_VERSION, controller->getSystemInfo().version,
         RELEASE_URL + (controller->getSettings().getOTAChannel() == "latest" ? "latest" : "tag/nightly"),
         [this](uint8_t phase) {
-            pluginManager->trigger("ota:update:phase", "phase", phase);
+            pluginManager->post(EventId::OTA_UPDATE_PHASE, "phase", phase, EventPriority::UI);
             updateOTAProgress(phase, 0);
         },
         [this](uint8_t phase, int progress) {
-            pluginManager->trigger("ota:update:progress", "progress", progress);
+            pluginManager->post(EventId::OTA_UPDATE_PROGRESS, "progress", progress, EventPriority::UI);
             updateOTAProgress(phase, progress);
         },
         "display-firmware.bin", "display-filesystem.bin", "board-firmware.bin");
@@ -48,15 +50,18 @@ void WebUIPlugin::setup(Controller *_controller, PluginManager *_pluginManager)
         ota->setControllerVersion(controller->getSystemInfo().version);
         ota->init(controller->getClientController()->getClient());
     });
-    pluginManager->on("controller:autotune:result", [this](Event const &event) { sendAutotuneResult(); });
+    pluginManager->on("controller:autotune:result", [this](Event const &event) { sendAutotuneResult(event.getInt("success")); });
+    pluginManager->on("controller:autotune:progress", [this](Event const &event) {
+        sendAutotuneProgress(event.getInt("state"), event.getFloat("temperature"));
+    });
     setupServer();
 }
 
 void WebUIPlugin::loop() {
     if (updating) {
-        pluginManager->trigger("ota:update:start");
+        pluginManager->trigger(EventId::OTA_UPDATE_START);
         ota->update(updateComponent != "display", updateComponent != "controller");
-        pluginManager->trigger("ota:update:end");
+        pluginManager->trigger(EventId::OTA_UPDATE_END);
         updating = false;
     }
     if (!serverRunning) {
@@ -65,55 +70,18 @@ void WebUIPlugin::loop() {
     const long now = millis();
     if ((lastUpdateCheck == 0 || now > lastUpdateCheck + UPDATE_CHECK_INTERVAL)) {
         ota->checkForUpdates();
-        pluginManager->trigger("ota:update:status", "value", ota->isUpdateAvailable());
+        pluginManager->trigger(EventId::OTA_UPDATE_STATUS, "value", ota->isUpdateAvailable());
         lastUpdateCheck = now;
         updateOTAStatus(ota->getCurrentVersion());
     }
     if (now > lastStatus + STATUS_PERIOD) {
         lastStatus = now;
-        JsonDocument doc;
-        doc["tp"] = "evt:status";
-        doc["ct"] = controller->getCurrentTemp();
-        doc["tt"] = controller->getTargetTemp();
-        doc["pr"] = controller->getCurrentPressure();
-        doc["fl"] = controller->getCurrentPumpFlow();
-        doc["pt"] = controller->getTargetPressure();
-        doc["m"] = controller->getMode();
-        doc["p"] = controller->getProfileManager()->getSelectedProfile().label;
-        doc["cp"] = controller->getSystemInfo().capabilities.pressure;
-        doc["cd"] = controller->getSystemInfo().capabilities.dimming;
-        doc["bta"] = controller->isVolumetricAvailable() ? 1 : 0;
-        doc["bt"] = controller->isVolumetricAvailable() && controller->getSettings().isVolumetricTarget() ? 1 : 0;
-        doc["led"] = controller->getSystemInfo().capabilities.ledControl;
-
-        Process *process = controller->getProcess();
-        if (process == nullptr) {
-            process = controller->getLastProcess();
-        }
-        if (process != nullptr) {
-            auto pObj = doc["process"].to<JsonObject>();
-            pObj["a"] = controller->isActive() ? 1 : 0;
-            if (process->getType() == MODE_BREW) {
-                auto *brew = static_cast<BrewProcess *>(process);
-                unsigned long ts = brew->isActive() && controller->isActive() ? millis() : brew->finished;
-                pObj["s"] = brew->currentPhase.phase == PhaseType::PHASE_TYPE_BREW ? "brew" : "infusion";
-                pObj["l"] = brew->isActive() ? brew->currentPhase.name.c_str() : "Finished";
-                pObj["e"] = ts - brew->processStarted;
-                const bool isVolumetric = brew->target == ProcessTarget::VOLUMETRIC && brew->currentPhase.hasVolumetricTarget() &&
-                                          controller->isVolumetricAvailable();
-                pObj["tt"] = isVolumetric ? "volumetric" : "time";
-                if (isVolumetric) {
-                    Target t = brew->currentPhase.getVolumetricTarget();
-                    pObj["pt"] = t.value;
-                    pObj["pp"] = brew->currentVolume;
-                } else {
-                    pObj["pt"] = brew->getPhaseDuration();
-                    pObj["pp"] = ts - brew->currentPhaseStarted;
-                }
-            }
-        }
-
-        ws.textAll(doc.as<String>());
+        sendStatus();
+    }
+    const long binaryPeriod = controller->isActive() ? static_cast<long>(binaryStatusPeriod) : static_cast<long>(STATUS_PERIOD);
+    if (now > lastBinaryStatus + binaryPeriod) {
+        lastBinaryStatus = now;
+        sendBinaryStatus(now);
     }
     if (now > lastCleanup + CLEANUP_PERIOD) {
         lastCleanup = now;
@@ -125,6 +93,156 @@ void WebUIPlugin::loop() {
     }
 }
 
+void WebUIPlugin::sendStatus() {
+    std::array<uint32_t, STATUS_MAX_CLIENTS> ids{};
+    const size_t count = copyStatusClients(false, ids);
+    if (count == 0) {
+        return;
+    }
+    JsonDocument doc;
+    doc["tp"] = "evt:status";
+    doc["ct"] = controller->getCurrentTemp();
+    doc["tt"] = controller->getTargetTemp();
+    doc["pr"] = controller->getCurrentPressure();
+    doc["fl"] = controller->getCurrentPumpFlow();
+    doc["pt"] = controller->getTargetPressure();
+    doc["m"] = controller->getMode();
+    doc["p"] = controller->getProfileManager()->getSelectedProfile()->label;
+    doc["cp"] = controller->getSystemInfo().capabilities.pressure;
+    doc["cd"] = controller->getSystemInfo().capabilities.dimming;
+    doc["bta"] = controller->isVolumetricAvailable() ? 1 : 0;
+    doc["bt"] = controller->isVolumetricAvailable() && controller->getSettings().isVolumetricTarget() ? 1 : 0;
+    doc["led"] = controller->getSystemInfo().capabilities.ledControl;
+
+    const ProcessSnapshot process = controller->getProcessSnapshot();
+    if (process.present) {
+        auto pObj = doc["process"].to<JsonObject>();
+        pObj["a"] = process.isRunning() ? 1 : 0;
+        if (process.type == MODE_BREW) {
+            unsigned long ts = process.isRunning() ? millis() : process.finished;
+            pObj["s"] = process.brewPhase ? "brew" : "infusion";
+            pObj["l"] = process.active ? process.phaseName : "Finished";
+            pObj["e"] = ts - process.processStarted;
+            const bool isVolumetric =
+                process.target == ProcessTarget::VOLUMETRIC && process.phaseVolumetric && controller->isVolumetricAvailable();
+            pObj["tt"] = isVolumetric ? "volumetric" : "time";
+            if (isVolumetric) {
+                pObj["pt"] = process.phaseVolumetricTarget;
+                pObj["pp"] = process.currentVolume;
+            } else {
+                pObj["pt"] = process.phaseDuration;
+                pObj["pp"] = ts - process.currentPhaseStarted;
+            }
+        }
+    }
+
+    const String message = doc.as<String>();
+    for (size_t i = 0; i < count; i++) {
+        ws.text(ids[i], message);
+    }
+}
+
+void WebUIPlugin::sendBinaryStatus(long now) {
+    // Take the keyframe request before the client list, a client subscribing in between gets a delta it ignores and
+    // its keyframe with the next frame
+    bool keyframe;
+    {
+        std::lock_guard<std::mutex> lock(statusClientsMutex);
+        keyframe = keyframePending || now > lastKeyframe + static_cast<long>(STATUS_KEYFRAME_PERIOD);
+        keyframePending = false;
+    }
+    std::array<uint32_t, STATUS_MAX_CLIENTS> ids{};
+    const size_t count = copyStatusClients(true, ids);
+    if (count == 0) {
+        return;
+    }
+    if (keyframe) {
+        lastKeyframe = now;
+    }
+    StatusSnapshot snapshot;
+    readStatus(snapshot);
+    const size_t length = statusEncoder.encode(snapshot, keyframe, statusFrame);
+    for (size_t i = 0; i < count; i++) {
+        ws.binary(ids[i], statusFrame, length);
+    }
+}
+
+// Same content as the evt:status JSON message, in the fixed point units of status_frame.h
+void WebUIPlugin::readStatus(StatusSnapshot &snapshot) {
+    snapshot.currentTemp = StatusSnapshot::fixed(controller->getCurrentTemp(), 10.0f);
+    snapshot.targetTemp = StatusSnapshot::fixed(controller->getTargetTemp(), 10.0f);
+    snapshot.pressure = StatusSnapshot::fixed(controller->getCurrentPressure(), 100.0f);
+    snapshot.flow = StatusSnapshot::fixed(controller->getCurrentPumpFlow(), 100.0f);
+    snapshot.targetPressure = StatusSnapshot::fixed(controller->getTargetPressure(), 100.0f);
+    snapshot.mode = static_cast<uint8_t>(controller->getMode());
+    snapshot.setProfile(controller->getProfileManager()->getSelectedProfile()->label.c_str());
+    const SystemCapabilities capabilities = controller->getSystemInfo().capabilities;
+    const bool volumetricAvailable = controller->isVolumetricAvailable();
+    snapshot.flags = (capabilities.pressure ? STATUS_FLAG_PRESSURE : 0) | (capabilities.dimming ? STATUS_FLAG_DIMMING : 0) |
+                     (volumetricAvailable ? STATUS_FLAG_VOLUMETRIC : 0) |
+                     (volumetricAvailable && controller->getSettings().isVolumetricTarget() ? STATUS_FLAG_BREW_TARGET : 0) |
+                     (capabilities.ledControl ? STATUS_FLAG_LED_CONTROL : 0);
+
+    const ProcessSnapshot process = controller->getProcessSnapshot();
+    if (!process.present) {
+        return;
+    }
+    snapshot.processFlags = STATUS_PROCESS_PRESENT | (process.isRunning() ? STATUS_PROCESS_ACTIVE : 0);
+    if (process.type != MODE_BREW) {
+        return;
+    }
+    unsigned long ts = process.isRunning() ? millis() : process.finished;
+    const bool isVolumetric = process.target == ProcessTarget::VOLUMETRIC && process.phaseVolumetric && volumetricAvailable;
+    snapshot.processFlags |= STATUS_PROCESS_BREW | (isVolumetric ? STATUS_PROCESS_VOLUMETRIC : 0) |
+                             (process.brewPhase ? STATUS_PROCESS_BREW_PHASE : 0);
+    snapshot.setPhase(process.active ? process.phaseName : "Finished");
+    snapshot.elapsed = ts - process.processStarted;
+    if (isVolumetric) {
+        snapshot.phaseTarget = process.phaseVolumetricTarget;
+        snapshot.phaseProgress = static_cast<float>(process.currentVolume);
+    } else {
+        snapshot.phaseTarget = static_cast<float>(process.phaseDuration);
+        snapshot.phaseProgress = static_cast<float>(ts - process.currentPhaseStarted);
+    }
+}
+
+void WebUIPlugin::addStatusClient(uint32_t clientId) {
+    std::lock_guard<std::mutex> lock(statusClientsMutex);
+    statusClients.push_back({clientId, false});
+}
+
+void WebUIPlugin::removeStatusClient(uint32_t clientId) {
+    std::lock_guard<std::mutex> lock(statusClientsMutex);
+    statusClients.erase(std::remove_if(statusClients.begin(), statusClients.end(),
+                                       [clientId](const StatusClient &client) { return client.id == clientId; }),
+                        statusClients.end());
+}
+
+size_t WebUIPlugin::copyStatusClients(bool binary, std::array<uint32_t, STATUS_MAX_CLIENTS> &ids) {
+    std::lock_guard<std::mutex> lock(statusClientsMutex);
+    size_t count = 0;
+    for (const StatusClient &client : statusClients) {
+        if (client.binary == binary && count < ids.size()) {
+            ids[count++] = client.id;
+        }
+    }
+    return count;
+}
+
+void WebUIPlugin::handleStatusSubscribe(uint32_t clientId, JsonDocument &request) {
+    std::lock_guard<std::mutex> lock(statusClientsMutex);
+    for (StatusClient &client : statusClients) {
+        if (client.id == clientId) {
+            client.binary = true;
+        }
+    }
+    if (request["interval"].is<uint32_t>()) {
+        const size_t interval = request["interval"].as<uint32_t>();
+        binaryStatusPeriod = std::max(STATUS_BINARY_PERIOD_MIN, std::min(interval, STATUS_PERIOD));
+    }
+    keyframePending = true;
+}
+
 void WebUIPlugin::setupServer() {
     server.on("/connecttest.txt", [](AsyncWebServerRequest *request) {
         request->redirect("http://logout.net");
@@ -171,10 +289,12 @@ void WebUIPlugin::setupServer() {
         [this](AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
             if (type == WS_EVT_CONNECT) {
                 client->setCloseClientOnQueueFull(true);
+                addStatusClient(client->id());
                 ESP_LOGI("WebUIPlugin", "WebSocket client connected (%d open connections)", server->getClients().size());
             } else if (type == WS_EVT_DISCONNECT) {
                 ESP_LOGI("WebUIPlugin", "WebSocket client disconnected (%d open connections)", server->getClients().size());
                 rxBuffers.erase(client->id());
+                removeStatusClient(client->id());
             } else if (type == WS_EVT_DATA) {
                 handleWebSocketData(server, client, type, arg, data, len);
             }
@@ -269,8 +389,17 @@ void WebUIPlugin::handleWebSocketData(AsyncWebSocket *server, AsyncWebSocketClie
                     auto *buffer = ws.makeBuffer(bufferSize);
                     serializeJson(resp, buffer->get(), bufferSize);
                     client->text(buffer);
+                } else if (msgType == "req:runtime-stats") {
+                    JsonDocument resp;
+                    RuntimeStats.handleRequest(doc, resp);
+                    size_t bufferSize = measureJson(resp);
+                    auto *buffer = ws.makeBuffer(bufferSize);
+                    serializeJson(resp, buffer->get(), bufferSize);
+                    client->text(buffer);
                 } else if (msgType == "req:flush:start") {
                     handleFlushStart(client->id(), doc);
+                } else if (msgType == "req:status:binary") {
+                    handleStatusSubscribe(client->id(), doc);
                 }
             }
         }
@@ -313,12 +442,19 @@ void WebUIPlugin::handleProfileRequest(uint32_t clientId, JsonDocument &request)
     response["rid"] = request["rid"].as<String>();
 
     if (type == "req:profiles:list") {
+        // Served from the profile cache, selected and favorite come from the settings
+        const String selectedId = controller->getSettings().getSelectedProfile();
+        const std::vector<String> favorites = controller->getSettings().getFavoritedProfiles();
         auto arr = response["profiles"].to<JsonArray>();
         for (auto const &id : profileManager->listProfiles()) {
-            Profile profile{};
-            profileManager->loadProfile(id, profile);
+            ProfileRef profile = profileManager->getProfile(id);
+            if (!profile) {
+                continue;
+            }
             auto p = arr.add<JsonObject>();
-            writeProfile(p, profile);
+            writeProfile(p, *profile);
+            p["selected"] = id == selectedId;
+            p["favorite"] = std::find(favorites.begin(), favorites.end(), id) != favorites.end();
         }
     } else if (type == "req:profiles:load") {
         auto id = request["id"].as<String>();
@@ -408,6 +544,8 @@ void WebUIPlugin::handleSettings(AsyncWebServerRequest *request) const {
                 settings->setSmartGrindIp(request->arg("smartGrindIp"));
             if (request->hasArg("smartGrindMode"))
                 settings->setSmartGrindMode(request->arg("smartGrindMode").toInt());
+            if (request->hasArg("smartGrindTimeout"))
+                settings->setSmartGrindTimeout(request->arg("smartGrindTimeout").toInt());
             settings->setHomeAssistant(request->hasArg("homeAssistant"));
             if (request->hasArg("haUser"))
                 settings->setHomeAssistantUser(request->arg("haUser"));
@@ -425,8 +563,16 @@ void WebUIPlugin::handleSettings(AsyncWebServerRequest *request) const {
                 settings->setBrewDelay(request->arg("brewDelay").toDouble());
             if (request->hasArg("grindDelay"))
                 settings->setGrindDelay(request->arg("grindDelay").toDouble());
-            if (request->hasArg("timezone"))
-                settings->setTimezone(request->arg("timezone"));
+            if (request->hasArg("timezone")) {
+                // Zone names are kept as sent, a POSIX TZ string maps back to the first zone using it, anything else is
+                // ignored so the clock never falls back to GMT because of a typo
+                const String label = request->arg("timezone");
+                int zone = find_timezone(label.c_str());
+                if (zone < 0)
+                    zone = find_timezone_by_posix(label.c_str());
+                if (zone >= 0)
+                    settings->setTimezone(timezone_name(zone));
+            }
             settings->setClockFormat(request->hasArg("clock24hFormat"));
             if (request->hasArg("standbyTimeout"))
                 settings->setStandbyTimeout(request->arg("standbyTimeout").toInt() * 1000);
@@ -500,7 +646,7 @@ void WebUIPlugin::handleSettings(AsyncWebServerRequest *request) const {
             }
             settings->save(true);
         });
-        pluginManager->trigger("settings:changed");
+        pluginManager->trigger(EventId::SETTINGS_CHANGED);
         controller->setTargetTemp(controller->getTargetTemp());
         controller->setPumpModelCoeffs();
     }
@@ -531,6 +677,7 @@ void WebUIPlugin::handleSettings(AsyncWebServerRequest *request) const {
     doc["smartGrindActive"] = settings.isSmartGrindActive();
     doc["smartGrindIp"] = settings.getSmartGrindIp();
     doc["smartGrindMode"] = settings.getSmartGrindMode();
+    doc["smartGrindTimeout"] = settings.getSmartGrindTimeout();
     doc["momentaryButtons"] = settings.isMomentaryButtons();
     doc["brewDelay"] = settings.getBrewDelay();
     doc["grindDelay"] = settings.getGrindDelay();
@@ -651,6 +798,15 @@ void WebUIPlugin::updateOTAStatus(const String &version) {
             doc["spiffsUsedPct"] = static_cast<uint8_t>((used * 100) / total);
         }
     }
+    // Settings persistence metrics
+    {
+        SettingsStats stats = settings.getStats();
+        doc["settingsCommits"] = stats.commits;
+        doc["settingsKeysWritten"] = stats.keysWritten;
+        doc["settingsFailedWrites"] = stats.failedWrites;
+        doc["settingsLastCommitKeys"] = stats.lastCommitKeys;
+        doc["settingsLastCommitUs"] = stats.lastCommitMicros;
+    }
     ws.textAll(doc.as<String>());
 }
 
@@ -663,14 +819,24 @@ void WebUIPlugin::updateOTAProgress(uint8_t phase, int progress) {
     ws.textAll(message);
 }
 
-void WebUIPlugin::sendAutotuneResult() {
+void WebUIPlugin::sendAutotuneResult(bool success) {
     JsonDocument doc;
     doc["tp"] = "evt:autotune-result";
+    doc["success"] = success;
     doc["pid"] = controller->getSettings().getPid();
     String message = doc.as<String>();
     ws.textAll(message);
 }
 
+void WebUIPlugin::sendAutotuneProgress(int state, float temperature) {
+    JsonDocument doc;
+    doc["tp"] = "evt:autotune-progress";
+    doc["state"] = state;
+    doc["temperature"] = temperature;
+    String message = doc.as<String>();
+    ws.textAll(message);
+}
+
 void WebUIPlugin::handleFlushStart(uint32_t clientId, JsonDocument &request) {
     controller->onFlush();
 
@@ -8,11 +8,19 @@
 #include "GitHubOTA.h"
 #include <ArduinoJson.h>
 #include <ESPAsyncWebServer.h>
+#include <array>
 #include <display/core/Plugin.h>
+#include <display/models/status_frame.h>
+#include <mutex>
+#include <vector>
 
 constexpr size_t UPDATE_CHECK_INTERVAL = 5 * 60 * 1000;
 constexpr size_t CLEANUP_PERIOD = 5 * 1000;
 constexpr size_t STATUS_PERIOD = 500;
+constexpr size_t STATUS_BINARY_PERIOD_ACTIVE = 100; // binary status rate while a process runs, clients may request another
+constexpr size_t STATUS_BINARY_PERIOD_MIN = 50;
+constexpr size_t STATUS_KEYFRAME_PERIOD = 5000;
+constexpr size_t STATUS_MAX_CLIENTS = 8;
 constexpr size_t DNS_PERIOD = 10;
 
 const String LOCAL_URL = "http://4.4.4.1/";
@@ -39,6 +47,15 @@ class WebUIPlugin : public Plugin {
     void handleAutotuneStart(uint32_t clientId, JsonDocument &request);
     void handleProfileRequest(uint32_t clientId, JsonDocument &request);
     void handleFlushStart(uint32_t clientId, JsonDocument &request);
+    void handleStatusSubscribe(uint32_t clientId, JsonDocument &request);
+
+    // Status broadcast, JSON clients get evt:status, clients that subscribed to binary status get status_frame.h frames
+    void sendStatus();
+    void sendBinaryStatus(long now);
+    void readStatus(StatusSnapshot &snapshot);
+    void addStatusClient(uint32_t clientId);
+    void removeStatusClient(uint32_t clientId);
+    size_t copyStatusClients(bool binary, std::array<uint32_t, STATUS_MAX_CLIENTS> &ids);
 
     // HTTP handlers
     void handleSettings(AsyncWebServerRequest *request) const;
@@ -48,7 +65,8 @@ class WebUIPlugin : public Plugin {
     void handleBLEScaleInfo(AsyncWebServerRequest *request);
     void updateOTAStatus(const String &version);
     void updateOTAProgress(uint8_t phase, int progress);
-    void sendAutotuneResult();
+    void sendAutotuneResult(bool success);
+    void sendAutotuneProgress(int state, float temperature);
 
     // Core dump download
     void handleCoreDumpDownload(AsyncWebServerRequest *request);
@@ -63,12 +81,27 @@ class WebUIPlugin : public Plugin {
 
     long lastUpdateCheck = 0;
     long lastStatus = 0;
+    long lastBinaryStatus = 0;
+    long lastKeyframe = 0;
     long lastCleanup = 0;
     long lastDns = 0;
     bool updating = false;
     bool apMode = false;
     bool serverRunning = false;
     String updateComponent = "";
+
+    struct StatusClient {
+        uint32_t id;
+        bool binary;
+    };
+    // Written from the AsyncTCP task, read from loop
+    std::mutex statusClientsMutex;
+    std::vector<StatusClient> statusClients;
+    bool keyframePending = false;
+    size_t binaryStatusPeriod = STATUS_BINARY_PERIOD_ACTIVE;
+
+    StatusFrameEncoder statusEncoder;
+    uint8_t statusFrame[STATUS_FRAME_MAX_SIZE];
 };
 
 #endif // WEBUIPLUGIN_H
@@ -150,8 +150,9 @@ void DefaultUI::init() {
         pressureAvailable = controller->getSystemInfo().capabilities.pressure;
     });
     pluginManager->on("controller:wifi:connect", [this](Event const &event) {
-        configTzTime(resolve_timezone(controller->getSettings().getTimezone()), NTP_SERVER);
-        setenv("TZ", resolve_timezone(controller->getSettings().getTimezone()), 1);
+        const char *tz = resolve_timezone(controller->getSettings().getTimezone());
+        configTzTime(tz, NTP_SERVER);
+        setenv("TZ", tz, 1);
         tzset();
         sntp_set_sync_mode(SNTP_SYNC_MODE_SMOOTH);
         sntp_setservername(0, NTP_SERVER);
@@ -651,60 +652,21 @@ void DefaultUI::updateStandbyScreen() {
 }
 
 void DefaultUI::updateStatusScreen() const {
-    // Copy process pointers to avoid race conditions with controller thread
-    Process *process = controller->getProcess();
-    Process *lastProcess = controller->getLastProcess();
-
-    if (process == nullptr) {
-        process = lastProcess;
-    }
-    if (process == nullptr || process->getType() != MODE_BREW) {
-        return;
-    }
-
-    // Additional safety: Validate that the process pointer is still valid
-    // by checking if it matches either current or last process
-    if (process != controller->getProcess() && process != controller->getLastProcess()) {
-        ESP_LOGW("DefaultUI", "Process pointer became invalid during access, skipping update");
-        return;
-    }
-
-    auto *brewProcess = static_cast<BrewProcess *>(process);
-    if (brewProcess == nullptr) {
-        ESP_LOGE("DefaultUI", "brewProcess is null after cast");
-        return;
-    }
-
-    // Validate the brewProcess object before accessing its members
-    // Check if the object is in a reasonable state by validating key fields
-    if (brewProcess->profile.phases.empty() || brewProcess->phaseIndex >= brewProcess->profile.phases.size()) {
-        ESP_LOGE("DefaultUI", "brewProcess phaseIndex out of bounds: %u >= %zu", brewProcess->phaseIndex,
-                 brewProcess->profile.phases.size());
+    const ProcessSnapshot process = controller->getProcessSnapshot();
+    if (!process.present || process.type != MODE_BREW) {
         return;
     }
 
-    // Final safety check before accessing brewProcess members
-    if (!brewProcess) {
-        ESP_LOGE("DefaultUI", "brewProcess became null after validation");
-        return;
-    }
-
-    const auto phase = brewProcess->currentPhase;
-
     unsigned long now = millis();
-    if (!process->isActive()) {
-        // Add bounds check for finished timestamp
-        if (brewProcess && brewProcess->finished > 0) {
-            now = brewProcess->finished;
-        }
+    if (!process.active && process.finished > 0) {
+        now = process.finished;
     }
 
-    lv_label_set_text(ui_StatusScreen_stepLabel, phase.phase == PhaseType::PHASE_TYPE_BREW ? "BREW" : "INFUSION");
-    lv_label_set_text(ui_StatusScreen_phaseLabel, brewProcess && brewProcess->isActive() ? phase.name.c_str() : "Finished");
+    lv_label_set_text(ui_StatusScreen_stepLabel, process.brewPhase ? "BREW" : "INFUSION");
+    lv_label_set_text(ui_StatusScreen_phaseLabel, process.active ? process.phaseName : "Finished");
 
-    // Add bounds check for processStarted timestamp
-    if (brewProcess && brewProcess->processStarted > 0 && now >= brewProcess->processStarted) {
-        const unsigned long processDuration = now - brewProcess->processStarted;
+    if (process.processStarted > 0 && now >= process.processStarted) {
+        const unsigned long processDuration = now - process.processStarted;
         const double processSecondsDouble = processDuration / 1000.0;
         const auto processMinutes = static_cast<int>(processSecondsDouble / 60.0);
         const auto processSeconds = static_cast<int>(processSecondsDouble) % 60;
@@ -713,42 +675,33 @@ void DefaultUI::updateStatusScreen() const {
         lv_label_set_text_fmt(ui_StatusScreen_currentDuration, "00:00");
     }
 
-    if (brewProcess && brewProcess->target == ProcessTarget::VOLUMETRIC && phase.hasVolumetricTarget()) {
-        Target target = phase.getVolumetricTarget();
-        lv_bar_set_value(ui_StatusScreen_brewBar, brewProcess->currentVolume, LV_ANIM_OFF);
-        lv_bar_set_range(ui_StatusScreen_brewBar, 0, target.value + 1);
-        lv_label_set_text_fmt(ui_StatusScreen_brewLabel, "%.1fg", target.value);
-    } else if (brewProcess) {
-        // Add bounds check for currentPhaseStarted timestamp
-        if (brewProcess->currentPhaseStarted > 0 && now >= brewProcess->currentPhaseStarted) {
-            const unsigned long progress = now - brewProcess->currentPhaseStarted;
-            lv_bar_set_value(ui_StatusScreen_brewBar, progress, LV_ANIM_OFF);
-            lv_bar_set_range(ui_StatusScreen_brewBar, 0, std::max(static_cast<int>(brewProcess->getPhaseDuration()), 1));
-            lv_label_set_text_fmt(ui_StatusScreen_brewLabel, "%ds", brewProcess->getPhaseDuration() / 1000);
-        } else {
-            lv_bar_set_value(ui_StatusScreen_brewBar, 0, LV_ANIM_OFF);
-            lv_bar_set_range(ui_StatusScreen_brewBar, 0, 1);
-            lv_label_set_text(ui_StatusScreen_brewLabel, "0s");
-        }
+    if (process.target == ProcessTarget::VOLUMETRIC && process.phaseVolumetric) {
+        lv_bar_set_value(ui_StatusScreen_brewBar, process.currentVolume, LV_ANIM_OFF);
+        lv_bar_set_range(ui_StatusScreen_brewBar, 0, process.phaseVolumetricTarget + 1);
+        lv_label_set_text_fmt(ui_StatusScreen_brewLabel, "%.1fg", process.phaseVolumetricTarget);
+    } else if (process.currentPhaseStarted > 0 && now >= process.currentPhaseStarted) {
+        const unsigned long progress = now - process.currentPhaseStarted;
+        lv_bar_set_value(ui_StatusScreen_brewBar, progress, LV_ANIM_OFF);
+        lv_bar_set_range(ui_StatusScreen_brewBar, 0, std::max(static_cast<int>(process.phaseDuration), 1));
+        lv_label_set_text_fmt(ui_StatusScreen_brewLabel, "%lus", process.phaseDuration / 1000);
+    } else {
+        lv_bar_set_value(ui_StatusScreen_brewBar, 0, LV_ANIM_OFF);
+        lv_bar_set_range(ui_StatusScreen_brewBar, 0, 1);
+        lv_label_set_text(ui_StatusScreen_brewLabel, "0s");
     }
 
-    if (brewProcess && brewProcess->target == ProcessTarget::TIME) {
-        const unsigned long targetDuration = brewProcess->getTotalDuration();
-        const double targetSecondsDouble = targetDuration / 1000.0;
+    if (process.target == ProcessTarget::TIME) {
+        const double targetSecondsDouble = process.totalDuration / 1000.0;
         const auto targetMinutes = static_cast<int>(targetSecondsDouble / 60.0);
         const auto targetSeconds = static_cast<int>(targetSecondsDouble) % 60;
         lv_label_set_text_fmt(ui_StatusScreen_targetDuration, "%2d:%02d", targetMinutes, targetSeconds);
-    } else if (brewProcess) {
-        lv_label_set_text_fmt(ui_StatusScreen_targetDuration, "%.1fg", brewProcess->getBrewVolume());
-    }
-    if (brewProcess) {
-        lv_img_set_src(ui_StatusScreen_Image8,
-                       brewProcess->target == ProcessTarget::TIME ? &ui_img_360122106 : &ui_img_1424216268);
+    } else {
+        lv_label_set_text_fmt(ui_StatusScreen_targetDuration, "%.1fg", process.brewVolume);
     }
+    lv_img_set_src(ui_StatusScreen_Image8, process.target == ProcessTarget::TIME ? &ui_img_360122106 : &ui_img_1424216268);
 
-    if (brewProcess && brewProcess->isAdvancedPump()) {
-        float pressure = brewProcess->getPumpPressure();
-        const double percentage = 1.0 - static_cast<double>(pressure) / static_cast<double>(pressureScaling);
+    if (process.advancedPump) {
+        const double percentage = 1.0 - static_cast<double>(process.pumpPressure) / static_cast<double>(pressureScaling);
         adjustTarget(uic_StatusScreen_dials_pressureTarget, percentage, -62.0, 124.0);
     } else {
         const double percentage = 1.0 - 0.5;
@@ -756,18 +709,15 @@ void DefaultUI::updateStatusScreen() const {
     }
 
     // Brew finished adjustments
-    if (process->isActive()) {
+    if (process.active) {
         lv_obj_add_flag(ui_StatusScreen_brewVolume, LV_OBJ_FLAG_HIDDEN);
     } else {
-        // Re-validate brewProcess pointer before accessing members
-        if (brewProcess && brewProcess->target == ProcessTarget::VOLUMETRIC) {
+        if (process.target == ProcessTarget::VOLUMETRIC) {
             lv_obj_clear_flag(ui_StatusScreen_brewVolume, LV_OBJ_FLAG_HIDDEN);
         }
         lv_obj_add_flag(ui_StatusScreen_barContainer, LV_OBJ_FLAG_HIDDEN);
         lv_obj_add_flag(ui_StatusScreen_labelContainer, LV_OBJ_FLAG_HIDDEN);
-        if (brewProcess) {
-            lv_label_set_text_fmt(ui_StatusScreen_brewVolume, "%.1lfg", brewProcess->currentVolume);
-        }
+        lv_label_set_text_fmt(ui_StatusScreen_brewVolume, "%.1lfg", process.currentVolume);
         lv_imgbtn_set_src(ui_StatusScreen_pauseButton, LV_IMGBTN_STATE_RELEASED, nullptr, &ui_img_631115820, nullptr);
     }
 }
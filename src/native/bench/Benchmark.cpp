@@ -0,0 +1,144 @@
+#include "Benchmark.h"
+
+#include <ArduinoStub.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+
+benchmark::AllocationCounter allocationCounter;
+
+std::vector<benchmark::Benchmark *> &registry() {
+    static std::vector<benchmark::Benchmark *> benchmarks;
+    return benchmarks;
+}
+
+int64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void *countedAlloc(size_t size) {
+    allocationCounter.count++;
+    allocationCounter.bytes += size;
+    void *ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+} // namespace
+
+void *operator new(size_t size) { return countedAlloc(size); }
+void *operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { std::free(ptr); }
+
+namespace benchmark {
+
+const AllocationCounter &allocations() { return allocationCounter; }
+
+State::Iterator State::begin() {
+    startTiming();
+    return {this, maxIterations};
+}
+
+void State::PauseTiming() {
+    if (!running) {
+        return;
+    }
+    int64_t now = nowNanos();
+    elapsed += static_cast<double>(now - startNanos);
+    allocCount += allocationCounter.count - startAllocCount;
+    allocBytes += allocationCounter.bytes - startAllocBytes;
+    running = false;
+}
+
+void State::ResumeTiming() { startTiming(); }
+
+void State::startTiming() {
+    if (running) {
+        return;
+    }
+    startAllocCount = allocationCounter.count;
+    startAllocBytes = allocationCounter.bytes;
+    running = true;
+    startNanos = nowNanos();
+}
+
+void State::finishTiming() { PauseTiming(); }
+
+Benchmark *registerBenchmark(const char *name, Function function) {
+    auto *benchmark = new Benchmark(name, function);
+    registry().push_back(benchmark);
+    return benchmark;
+}
+
+} // namespace benchmark
+
+namespace {
+
+constexpr uint64_t MAX_ITERATIONS = 1000000000ULL;
+
+void runBenchmark(const benchmark::Benchmark &bm, const std::vector<int64_t> &args, double minTimeNanos) {
+    std::string name = bm.name;
+    for (int64_t arg : args) {
+        name += "/" + std::to_string(arg);
+    }
+
+    uint64_t iterations = 1;
+    while (true) {
+        arduino_stub::setMicros(0);
+        benchmark::State state(iterations, args);
+        bm.function(state);
+
+        double elapsed = state.elapsedNanos();
+        if (elapsed >= minTimeNanos || iterations >= MAX_ITERATIONS) {
+            double iters = static_cast<double>(iterations);
+            printf("%-52s %12.1f %12llu %12.2f %12.1f  %s\n", name.c_str(), elapsed / iters, (unsigned long long)iterations,
+                   static_cast<double>(state.allocationCount()) / iters, static_cast<double>(state.allocationBytes()) / iters,
+                   state.getLabel().c_str());
+            return;
+        }
+
+        double multiplier = elapsed > 0.0 ? minTimeNanos * 1.4 / elapsed : 10.0;
+        multiplier = std::clamp(multiplier, 2.0, 10.0);
+        iterations = std::min(MAX_ITERATIONS, static_cast<uint64_t>(static_cast<double>(iterations) * multiplier));
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char *filter = nullptr;
+    double minTimeSeconds = 0.2;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--benchmark_filter=", 19) == 0) {
+            filter = argv[i] + 19;
+        } else if (strncmp(argv[i], "--benchmark_min_time=", 21) == 0) {
+            minTimeSeconds = atof(argv[i] + 21);
+        }
+    }
+
+    arduino_stub::setSerialOutput(false);
+
+    printf("%-52s %12s %12s %12s %12s\n", "Benchmark", "Time (ns)", "Iterations", "Allocs/iter", "Bytes/iter");
+    printf("%s\n", std::string(106, '-').c_str());
+    for (const auto *bm : registry()) {
+        if (filter != nullptr && bm->name.find(filter) == std::string::npos) {
+            continue;
+        }
+        if (bm->argSets.empty()) {
+            runBenchmark(*bm, {}, minTimeSeconds * 1e9);
+        }
+        for (const auto &args : bm->argSets) {
+            runBenchmark(*bm, args, minTimeSeconds * 1e9);
+        }
+    }
+    return 0;
+}
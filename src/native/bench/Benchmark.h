@@ -0,0 +1,114 @@
+#ifndef NATIVE_BENCHMARK_H
+#define NATIVE_BENCHMARK_H
+
+// Small Google-Benchmark style harness for the native environment.
+// Benchmarks are plain functions taking a State and looping with `for (auto _ : state)`.
+// Besides the time per iteration, every heap allocation made inside the loop is counted.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace benchmark {
+
+struct AllocationCounter {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+const AllocationCounter &allocations();
+
+class State {
+  public:
+    class Iterator {
+      public:
+        // Non-trivial so `for (auto _ : state)` does not trigger unused variable warnings
+        struct Value {
+            ~Value() {}
+        };
+
+        Iterator(State *state, uint64_t remaining) : state(state), remaining(remaining) {}
+        bool operator!=(const Iterator &) const {
+            if (remaining != 0) {
+                return true;
+            }
+            state->finishTiming();
+            return false;
+        }
+        Iterator &operator++() {
+            --remaining;
+            return *this;
+        }
+        Value operator*() const { return {}; }
+
+      private:
+        State *state;
+        uint64_t remaining;
+    };
+
+    State(uint64_t iterations, std::vector<int64_t> args) : maxIterations(iterations), args(std::move(args)) {}
+
+    Iterator begin();
+    Iterator end() { return {this, 0}; }
+
+    int64_t range(size_t index = 0) const { return index < args.size() ? args[index] : 0; }
+    uint64_t iterations() const { return maxIterations; }
+
+    // Excludes per-iteration setup from the measurement, allocations included.
+    void PauseTiming();
+    void ResumeTiming();
+
+    void SetLabel(const std::string &text) { label = text; }
+
+    double elapsedNanos() const { return elapsed; }
+    uint64_t allocationCount() const { return allocCount; }
+    uint64_t allocationBytes() const { return allocBytes; }
+    const std::string &getLabel() const { return label; }
+
+  private:
+    void startTiming();
+    void finishTiming();
+
+    uint64_t maxIterations;
+    std::vector<int64_t> args;
+    std::string label;
+    bool running = false;
+    int64_t startNanos = 0;
+    double elapsed = 0.0;
+    uint64_t startAllocCount = 0;
+    uint64_t startAllocBytes = 0;
+    uint64_t allocCount = 0;
+    uint64_t allocBytes = 0;
+};
+
+using Function = void (*)(State &);
+
+class Benchmark {
+  public:
+    Benchmark(const char *name, Function function) : name(name), function(function) {}
+
+    Benchmark *Arg(int64_t arg) {
+        argSets.push_back({arg});
+        return this;
+    }
+
+    const std::string name;
+    const Function function;
+    std::vector<std::vector<int64_t>> argSets;
+};
+
+Benchmark *registerBenchmark(const char *name, Function function);
+
+template <typename T> inline void DoNotOptimize(T const &value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+} // namespace benchmark
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+#define BENCHMARK(fn)                                                                                                            \
+    static ::benchmark::Benchmark *BENCHMARK_CONCAT(benchmark_registration_, __LINE__) = ::benchmark::registerBenchmark(#fn, fn)
+
+#endif // NATIVE_BENCHMARK_H
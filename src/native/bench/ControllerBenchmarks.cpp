@@ -0,0 +1,121 @@
+// Per-update cost of the NayrodPID controllers as they are driven on the controller board.
+// DimmedPump calls PressureController::update every 30 ms, Heater calls SimplePID::update once per second.
+
+#include "Benchmark.h"
+
+#include <Autotune/Autotune.h>
+#include <HydraulicParameterEstimator/HydraulicParameterEstimator.h>
+#include <PressureController/PressureController.h>
+#include <SimpleKalmanFilter/SimpleKalmanFilter.h>
+#include <SimplePID/SimplePID.h>
+
+namespace {
+
+constexpr float PUMP_DT = 0.03f;
+
+// Crude first order pressure response so the controller runs through realistic branches
+float nextPressure(float pressure, float dutyCycle) {
+    float target = dutyCycle / 100.0f * 11.0f;
+    return pressure + (target - pressure) * 0.08f;
+}
+
+} // namespace
+
+static void BM_PressureController_Pressure(benchmark::State &state) {
+    float pressureSetpoint = 9.0f;
+    float flowSetpoint = 0.0f;
+    float pressure = 0.0f;
+    float output = 0.0f;
+    int valve = 1;
+    PressureController controller(PUMP_DT, &pressureSetpoint, &flowSetpoint, &pressure, &output, &valve);
+    controller.tare();
+    for (auto _ : state) {
+        controller.update(PressureController::ControlMode::PRESSURE);
+        pressure = nextPressure(pressure, output);
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK(BM_PressureController_Pressure);
+
+static void BM_PressureController_FlowWithPressureLimit(benchmark::State &state) {
+    float pressureSetpoint = 9.0f;
+    float flowSetpoint = 2.0f;
+    float pressure = 0.0f;
+    float output = 0.0f;
+    int valve = 1;
+    PressureController controller(PUMP_DT, &pressureSetpoint, &flowSetpoint, &pressure, &output, &valve);
+    controller.tare();
+    for (auto _ : state) {
+        controller.update(PressureController::ControlMode::FLOW);
+        pressure = nextPressure(pressure, output);
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK(BM_PressureController_FlowWithPressureLimit);
+
+static void BM_SimplePID_Update(benchmark::State &state) {
+    float output = 0.0f;
+    float temperature = 20.0f;
+    float setpoint = 93.0f;
+    SimplePID pid(&output, &temperature, &setpoint);
+    pid.setSamplingFrequency(1.0f);
+    pid.setCtrlOutputLimits(0.0f, 1000.0f);
+    pid.setControllerPIDGains(58.397f, 1.027f, 249.055f, 0.0f);
+    pid.setMode(SimplePID::Control::automatic);
+    for (auto _ : state) {
+        // Heater only computes once per sampling period, so every iteration is one full PID cycle
+        arduino_stub::advanceMicros(1000000);
+        pid.update();
+        temperature += (output / 1000.0f - 0.3f) * 0.5f;
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK(BM_SimplePID_Update);
+
+static void BM_HydraulicParameterEstimator_Update(benchmark::State &state) {
+    HydraulicParameterEstimator estimator(PUMP_DT);
+    estimator.reset();
+    float pressure = 0.0f;
+    for (auto _ : state) {
+        pressure = nextPressure(pressure, 80.0f);
+        estimator.update(4.0f, pressure);
+        benchmark::DoNotOptimize(estimator.X_state);
+    }
+}
+BENCHMARK(BM_HydraulicParameterEstimator_Update);
+
+static void BM_SimpleKalmanFilter_UpdateEstimate(benchmark::State &state) {
+    SimpleKalmanFilter filter(0.1f, 10.0f, powf(4 * PUMP_DT, 2));
+    float measurement = 0.0f;
+    for (auto _ : state) {
+        measurement = measurement > 12.0f ? 0.0f : measurement + 0.01f;
+        benchmark::DoNotOptimize(filter.updateEstimate(measurement));
+    }
+}
+BENCHMARK(BM_SimpleKalmanFilter_UpdateEstimate);
+
+static void BM_Autotune_Update(benchmark::State &state) {
+    Autotune autotune;
+    autotune.setWindowsize(static_cast<unsigned int>(state.range(0)));
+    autotune.setEpsilon(0.1f);
+    autotune.setRequiredConfirmations(3);
+    autotune.setTuningGoal(50);
+    autotune.reset();
+    float time = 0.0f;
+    float temperature = 20.0f;
+    for (auto _ : state) {
+        autotune.update(temperature, time);
+        time += 1.0f;
+        if (autotune.maxPowerOn) {
+            temperature += 0.4f;
+        }
+        if (autotune.isFinished()) {
+            state.PauseTiming();
+            autotune.reset();
+            time = 0.0f;
+            temperature = 20.0f;
+            state.ResumeTiming();
+        }
+    }
+}
+BENCHMARK(BM_Autotune_Update)->Arg(4)->Arg(16);
@@ -0,0 +1,50 @@
+// Display core: the predictive stop calculation BrewProcess and GrindProcess run on every progress() tick.
+
+#include "Benchmark.h"
+
+#include <display/core/predictive.h>
+#include <display/core/process/Process.h>
+
+static void BM_VolumetricRateCalculator_GetRate(benchmark::State &state) {
+    // Arg is the shot length in seconds, with a scale reporting every 100 ms
+    VolumetricRateCalculator calculator(PREDICTIVE_TIME);
+    const int64_t samples = state.range(0) * 10;
+    double volume = 0.0;
+    for (int64_t i = 0; i < samples; i++) {
+        arduino_stub::advanceMicros(100000);
+        volume += 0.2;
+        calculator.addMeasurement(volume);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculator.getRate());
+    }
+}
+BENCHMARK(BM_VolumetricRateCalculator_GetRate)->Arg(30)->Arg(120);
+
+static void BM_VolumetricRateCalculator_AddMeasurement(benchmark::State &state) {
+    // The window is a fixed ring, the measurement history stays bounded however long the run
+    VolumetricRateCalculator calculator(PREDICTIVE_TIME);
+    calculator.setOutlierRejection(PREDICTIVE_OUTLIER_RESIDUAL);
+    double volume = 0.0;
+    for (auto _ : state) {
+        arduino_stub::advanceMicros(100000);
+        volume += 0.2;
+        calculator.addMeasurement(volume);
+    }
+}
+BENCHMARK(BM_VolumetricRateCalculator_AddMeasurement);
+
+static void BM_VolumetricRateCalculator_GetEstimate(benchmark::State &state) {
+    // Estimated volume at the 30 ms sensor rate fills the whole ring
+    VolumetricRateCalculator calculator(PREDICTIVE_TIME);
+    double volume = 0.0;
+    for (int i = 0; i < 1000; i++) {
+        arduino_stub::advanceMicros(30000);
+        volume += 0.06;
+        calculator.addMeasurement(volume);
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculator.getEstimate());
+    }
+}
+BENCHMARK(BM_VolumetricRateCalculator_GetEstimate);
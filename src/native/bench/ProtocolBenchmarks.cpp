@@ -0,0 +1,59 @@
+// BLE framing: sensor notifications as CSV text versus the fixed layout binary frames from BinaryProtocol.h.
+
+#include "Benchmark.h"
+
+#include <BinaryProtocol.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+static void BM_SensorData_EncodeCsv(benchmark::State &state) {
+    char str[30];
+    float temperature = 93.0f;
+    for (auto _ : state) {
+        temperature += 0.001f;
+        int length = snprintf(str, sizeof(str), "%.3f,%.3f,%.3f,%.3f,%.3f", temperature, 9.012f, 1.934f, 2.048f, 4.521f);
+        benchmark::DoNotOptimize(length);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_SensorData_EncodeCsv);
+
+static void BM_SensorData_DecodeCsv(benchmark::State &state) {
+    char str[64];
+    snprintf(str, sizeof(str), "%.3f,%.3f,%.3f,%.3f,%.3f", 93.25f, 9.012f, 1.934f, 2.048f, 4.521f);
+    for (auto _ : state) {
+        float values[5];
+        const char *cursor = str;
+        for (float &value : values) {
+            char *end = nullptr;
+            value = std::strtof(cursor, &end);
+            cursor = *end == ',' ? end + 1 : end;
+        }
+        benchmark::DoNotOptimize(values);
+    }
+}
+BENCHMARK(BM_SensorData_DecodeCsv);
+
+static void BM_SensorData_EncodeBinary(benchmark::State &state) {
+    uint8_t frame[BINARY_SENSOR_FRAME_SIZE];
+    SensorFrame sample{0, 93.0f, 9.012f, 1.934f, 2.048f, 4.521f};
+    for (auto _ : state) {
+        sample.sequence++;
+        sample.temperature += 0.001f;
+        benchmark::DoNotOptimize(binary_protocol::encodeSensorFrame(frame, sample));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_SensorData_EncodeBinary);
+
+static void BM_SensorData_DecodeBinary(benchmark::State &state) {
+    uint8_t frame[BINARY_SENSOR_FRAME_SIZE];
+    binary_protocol::encodeSensorFrame(frame, SensorFrame{1, 93.25f, 9.012f, 1.934f, 2.048f, 4.521f});
+    for (auto _ : state) {
+        SensorFrame decoded{};
+        benchmark::DoNotOptimize(binary_protocol::decodeSensorFrame(frame, sizeof(frame), decoded));
+        benchmark::DoNotOptimize(decoded);
+    }
+}
+BENCHMARK(BM_SensorData_DecodeBinary);
@@ -0,0 +1,135 @@
+// Shot history: writing a shot as raw v1 records versus v2 delta encoded blocks, and reading the blocks back.
+
+#include "Benchmark.h"
+
+#include <display/models/shot_log_codec.h>
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+// A 30 s shot at the 30 ms controller sample rate: preinfusion, ramp to 9 bar, then a declining profile
+std::vector<ShotLogSample> makeShot() {
+    std::vector<ShotLogSample> samples;
+    uint32_t seed = 0x12345678;
+    auto noise = [&seed](int amplitude) {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return static_cast<int>(seed % (2 * amplitude + 1)) - amplitude;
+    };
+    for (uint32_t ms = 0; ms < 30000; ms += 30) {
+        float t = ms / 1000.0f;
+        float pressure = t < 8.0f ? 3.0f : std::fmin(9.0f, 3.0f + (t - 8.0f) * 3.0f) - std::fmax(0.0f, t - 20.0f) * 0.3f;
+        float weight = t < 8.0f ? 0.0f : (t - 8.0f) * 1.6f;
+        ShotLogSample sample{};
+        sample.t = static_cast<uint16_t>(ms / SHOT_LOG_TICK_MS);
+        sample.tt = 930;
+        sample.ct = static_cast<uint16_t>(930 + noise(2));
+        sample.tp = t < 8.0f ? 30 : 90;
+        sample.cp = static_cast<uint16_t>(pressure * 10.0f + noise(1));
+        sample.fl = static_cast<int16_t>(200 + noise(8));
+        sample.tf = 0;
+        sample.pf = static_cast<int16_t>(150 + noise(8));
+        sample.vf = static_cast<int16_t>(weight > 0.0f ? 160 + noise(4) : 0);
+        sample.v = static_cast<uint16_t>(weight * 10.0f);
+        sample.ev = static_cast<uint16_t>(weight * 10.0f + noise(1));
+        sample.pr = static_cast<uint16_t>(400 + noise(20));
+        samples.push_back(sample);
+    }
+    return samples;
+}
+
+std::vector<uint8_t> encodeBlocks(const std::vector<ShotLogSample> &samples) {
+    std::vector<uint8_t> out;
+    ShotLogBlockEncoder encoder;
+    auto flush = [&]() {
+        encoder.finish();
+        out.insert(out.end(), encoder.data(), encoder.data() + encoder.size());
+        encoder.reset();
+    };
+    for (const ShotLogSample &sample : samples) {
+        encoder.append(sample);
+        if (encoder.full()) {
+            flush();
+        }
+    }
+    if (!encoder.empty()) {
+        flush();
+    }
+    return out;
+}
+
+std::string bytesLabel(size_t bytes, size_t samples) {
+    char label[64];
+    snprintf(label, sizeof(label), "%zu B, %.1f B/sample", bytes, static_cast<double>(bytes) / samples);
+    return label;
+}
+} // namespace
+
+static void BM_ShotLog_WriteRaw(benchmark::State &state) {
+    const std::vector<ShotLogSample> samples = makeShot();
+    std::vector<uint8_t> out(samples.size() * sizeof(ShotLogSample));
+    for (auto _ : state) {
+        size_t position = 0;
+        for (const ShotLogSample &sample : samples) {
+            memcpy(out.data() + position, &sample, sizeof(sample));
+            position += sizeof(sample);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(bytesLabel(out.size(), samples.size()));
+}
+BENCHMARK(BM_ShotLog_WriteRaw);
+
+static void BM_ShotLog_EncodeBlocks(benchmark::State &state) {
+    const std::vector<ShotLogSample> samples = makeShot();
+    ShotLogBlockEncoder encoder;
+    size_t bytes = 0;
+    for (auto _ : state) {
+        bytes = 0;
+        for (const ShotLogSample &sample : samples) {
+            encoder.append(sample);
+            if (encoder.full()) {
+                encoder.finish();
+                bytes += encoder.size();
+                encoder.reset();
+            }
+        }
+        if (!encoder.empty()) {
+            encoder.finish();
+            bytes += encoder.size();
+            encoder.reset();
+        }
+        benchmark::DoNotOptimize(bytes);
+    }
+    state.SetLabel(bytesLabel(bytes, samples.size()));
+}
+BENCHMARK(BM_ShotLog_EncodeBlocks);
+
+static void BM_ShotLog_DecodeBlocks(benchmark::State &state) {
+    const std::vector<ShotLogSample> samples = makeShot();
+    const std::vector<uint8_t> encoded = encodeBlocks(samples);
+    ShotLogSample decoded[SHOT_LOG_BLOCK_SAMPLES];
+    for (auto _ : state) {
+        size_t position = 0;
+        size_t total = 0;
+        while (position + SHOT_LOG_BLOCK_HEADER_SIZE <= encoded.size()) {
+            ShotLogBlockHeader header{};
+            memcpy(&header, encoded.data() + position, sizeof(header));
+            position += sizeof(header);
+            int count = decodeShotLogBlock(header, encoded.data() + position, SHOT_LOG_FIELDS_MASK_ALL, decoded,
+                                           SHOT_LOG_BLOCK_SAMPLES);
+            if (count < 0 || memcmp(decoded, &samples[total], count * sizeof(ShotLogSample)) != 0) {
+                state.SetLabel("decode mismatch");
+                return;
+            }
+            position += header.payloadSize;
+            total += count;
+        }
+        benchmark::DoNotOptimize(total);
+    }
+}
+BENCHMARK(BM_ShotLog_DecodeBlocks);
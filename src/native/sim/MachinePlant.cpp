@@ -0,0 +1,89 @@
+#include "MachinePlant.h"
+
+#include <algorithm>
+#include <cmath>
+
+constexpr float WATER_HEAT_CAPACITY = 4.186f; // J/(g·K), 1 ml ≈ 1 g
+
+MachinePlant::MachinePlant(const PlantParameters &parameters) : parameters(parameters), rngState(parameters.seed | 1u) {
+    reset(parameters.ambientTemperature);
+}
+
+void MachinePlant::reset(float boilerTemperature) {
+    state = PlantState{};
+    state.boilerTemperature = boilerTemperature;
+    state.thermocoupleTemperature = boilerTemperature;
+    // Holding temperature needs the element to cover the losses already
+    state.heaterFlux = parameters.boilerLossCoefficient * (boilerTemperature - parameters.ambientTemperature);
+    state.puckConductance = parameters.puckConductance;
+    rngState = parameters.seed | 1u;
+    valveWasOpen = false;
+}
+
+void MachinePlant::step(float dt, bool heaterOn, float pumpDuty, bool valveOpen) {
+    // Thermal: element heats the boiler body with a lag, losses to ambient and to the cold water drawn in
+    float heaterInput = heaterOn ? parameters.heaterPower : 0.0f;
+    state.heaterFlux += (heaterInput - state.heaterFlux) * dt / parameters.heaterLag;
+    float ambientLoss = parameters.boilerLossCoefficient * (state.boilerTemperature - parameters.ambientTemperature);
+    float waterLoss = state.pumpFlow * WATER_HEAT_CAPACITY * (state.boilerTemperature - parameters.inletTemperature);
+    state.boilerTemperature += (state.heaterFlux - ambientLoss - waterLoss) * dt / parameters.boilerThermalMass;
+    state.thermocoupleTemperature +=
+        (state.boilerTemperature - state.thermocoupleTemperature) * dt / parameters.thermocoupleLag;
+
+    // Hydraulics
+    if (valveWasOpen && !valveOpen) {
+        // Closing the 3-way valve vents the group, the next shot starts with an empty headspace
+        state.headspaceFilled = 0.0f;
+    }
+    valveWasOpen = valveOpen;
+
+    state.pumpFlow = std::clamp(pumpDuty, 0.0f, 1.0f) * availablePumpFlow(state.pressure);
+    float opvFlow = std::max(0.0f, state.pressure - parameters.opvPressure) * parameters.opvConductance;
+    state.puckFlow = 0.0f;
+    float pressureRate = 0.0f;
+    if (valveOpen && state.headspaceFilled < parameters.headspaceVolume) {
+        state.headspaceFilled += state.pumpFlow * dt;
+        pressureRate = -state.pressure / parameters.ventTimeConstant;
+    } else if (valveOpen) {
+        state.puckFlow = state.puckConductance * std::sqrt(std::max(0.0f, state.pressure));
+        pressureRate = (state.pumpFlow - state.puckFlow - opvFlow) / parameters.systemCompliance;
+    } else if (state.pumpFlow > 0.0f) {
+        pressureRate = (state.pumpFlow - opvFlow) / parameters.systemCompliance;
+    } else {
+        pressureRate = -state.pressure / parameters.ventTimeConstant;
+    }
+    state.pressure = std::max(0.0f, state.pressure + pressureRate * dt);
+    state.sensedPressure += (state.pressure - state.sensedPressure) * dt / parameters.pressureSensorLag;
+
+    state.pumpedVolume += state.pumpFlow * dt;
+    state.coffeeVolume += state.puckFlow * dt;
+    state.puckConductance += parameters.puckErosion * state.puckFlow * dt;
+}
+
+float MachinePlant::readThermocouple() const {
+    float resolution = parameters.thermocoupleResolution;
+    if (resolution <= 0.0f) {
+        return state.thermocoupleTemperature;
+    }
+    return std::round(state.thermocoupleTemperature / resolution) * resolution;
+}
+
+float MachinePlant::readPressure() { return state.sensedPressure + gaussianNoise() * parameters.pressureNoise; }
+
+float MachinePlant::availablePumpFlow(float pressure) const {
+    float slope = (parameters.pumpNineBarFlow - parameters.pumpOneBarFlow) / 8.0f;
+    return std::max(0.0f, parameters.pumpOneBarFlow + slope * (pressure - 1.0f));
+}
+
+float MachinePlant::gaussianNoise() {
+    // xorshift32 and Box-Muller, so runs are identical across standard libraries
+    auto next = [this]() {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return (static_cast<float>(rngState) + 1.0f) / 4294967296.0f;
+    };
+    float u1 = next();
+    float u2 = next();
+    return std::sqrt(-2.0f * std::log(u1)) * std::cos(2.0f * static_cast<float>(M_PI) * u2);
+}
@@ -0,0 +1,78 @@
+#ifndef NATIVE_MACHINEPLANT_H
+#define NATIVE_MACHINEPLANT_H
+
+#include <cstdint>
+
+// Lumped physical model of a single boiler espresso machine, stepped at a fixed rate by the Simulator.
+// Heater and pump inputs come from the real peripheral code through the simulated GPIO and PSM stand-ins.
+
+struct PlantParameters {
+    // Boiler
+    float ambientTemperature = 20.0f;     // °C
+    float inletTemperature = 20.0f;       // °C, reservoir water entering the boiler
+    float heaterPower = 1370.0f;          // W
+    float heaterLag = 4.0f;               // s, element to boiler body time constant
+    float boilerThermalMass = 870.0f;     // J/K, aluminium body plus water
+    float boilerLossCoefficient = 1.1f;   // W/K, losses to ambient
+    float thermocoupleLag = 1.5f;         // s, boiler body to thermocouple time constant
+    float thermocoupleResolution = 0.25f; // °C, MAX31855 resolution
+
+    // Pump, flow at full duty follows a line through the 1 bar and 9 bar points
+    float pumpOneBarFlow = 10.205f; // ml/s
+    float pumpNineBarFlow = 5.521f; // ml/s
+    float opvPressure = 12.0f;      // bar, over pressure valve opening point
+    float opvConductance = 3.0f;    // ml/s per bar above the OPV opening point
+    float ventTimeConstant = 0.3f;  // s, pressure release through the 3-way valve when closed
+
+    // Hydraulics
+    float systemCompliance = 1.4f; // ml/bar once the headspace is filled
+    float headspaceVolume = 8.0f;  // ml pumped before pressure starts building on the puck
+    float puckConductance = 0.67f; // ml/s/sqrt(bar), puck flow Q = K * sqrt(P)
+    float puckErosion = 0.002f;    // conductance gained per ml through the puck
+
+    // Pressure transducer
+    float pressureSensorLag = 0.015f; // s
+    float pressureNoise = 0.02f;      // bar RMS
+
+    uint32_t seed = 1;
+};
+
+struct PlantState {
+    float heaterFlux = 0.0f;               // W reaching the boiler body
+    float boilerTemperature = 20.0f;       // °C
+    float thermocoupleTemperature = 20.0f; // °C, before quantisation
+    float pressure = 0.0f;                 // bar at the group
+    float sensedPressure = 0.0f;           // bar at the transducer, lagged
+    float headspaceFilled = 0.0f;          // ml
+    float puckConductance = 0.0f;          // ml/s/sqrt(bar)
+    float pumpFlow = 0.0f;                 // ml/s
+    float puckFlow = 0.0f;                 // ml/s
+    float pumpedVolume = 0.0f;             // ml
+    float coffeeVolume = 0.0f;             // ml
+};
+
+class MachinePlant {
+  public:
+    explicit MachinePlant(const PlantParameters &parameters);
+
+    void reset(float boilerTemperature);
+    void step(float dt, bool heaterOn, float pumpDuty, bool valveOpen);
+
+    // Sensor outputs as the peripherals see them
+    float readThermocouple() const;
+    float readPressure();
+
+    const PlantState &getState() const { return state; }
+    const PlantParameters &getParameters() const { return parameters; }
+
+  private:
+    float availablePumpFlow(float pressure) const;
+    float gaussianNoise();
+
+    PlantParameters parameters;
+    PlantState state;
+    uint32_t rngState;
+    bool valveWasOpen = false;
+};
+
+#endif // NATIVE_MACHINEPLANT_H
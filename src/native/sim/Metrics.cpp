@@ -0,0 +1,54 @@
+#include "Metrics.h"
+
+#include <cmath>
+
+StepResponse analyzeStep(const std::vector<float> &signal, const std::vector<float> &actuator, float initial, float target,
+                         float band, float sampleInterval) {
+    StepResponse response;
+    if (signal.empty()) {
+        return response;
+    }
+    const float step = target - initial;
+    const float direction = step >= 0.0f ? 1.0f : -1.0f;
+
+    int tenPercent = -1;
+    int ninetyPercent = -1;
+    int reached = -1;
+    int lastOutside = -1;
+    for (size_t i = 0; i < signal.size(); i++) {
+        float progress = step != 0.0f ? (signal[i] - initial) / step : 1.0f;
+        if (tenPercent < 0 && progress >= 0.1f)
+            tenPercent = static_cast<int>(i);
+        if (ninetyPercent < 0 && progress >= 0.9f)
+            ninetyPercent = static_cast<int>(i);
+        if (reached < 0 && progress >= 1.0f)
+            reached = static_cast<int>(i);
+        if (reached >= 0)
+            response.overshoot = std::fmax(response.overshoot, (signal[i] - target) * direction);
+        if (std::fabs(signal[i] - target) > band)
+            lastOutside = static_cast<int>(i);
+    }
+    if (tenPercent >= 0 && ninetyPercent >= 0)
+        response.riseTime = static_cast<float>(ninetyPercent - tenPercent) * sampleInterval;
+    if (lastOutside + 1 < static_cast<int>(signal.size()))
+        response.settlingTime = static_cast<float>(lastOutside + 1) * sampleInterval;
+
+    size_t tailStart = signal.size() - signal.size() / 5;
+    double errorSum = 0.0;
+    for (size_t i = tailStart; i < signal.size(); i++) {
+        errorSum += signal[i] - target;
+    }
+    response.steadyStateError = static_cast<float>(errorSum / static_cast<double>(signal.size() - tailStart));
+
+    if (actuator.size() > 2) {
+        double jitterSum = 0.0;
+        size_t count = 0;
+        for (size_t i = actuator.size() / 2 + 1; i < actuator.size(); i++) {
+            double delta = actuator[i] - actuator[i - 1];
+            jitterSum += delta * delta;
+            count++;
+        }
+        response.controlJitter = count > 0 ? static_cast<float>(std::sqrt(jitterSum / static_cast<double>(count))) : 0.0f;
+    }
+    return response;
+}
@@ -0,0 +1,18 @@
+#ifndef NATIVE_METRICS_H
+#define NATIVE_METRICS_H
+
+#include <vector>
+
+// Step response figures for one controlled signal sampled at a fixed interval.
+struct StepResponse {
+    float riseTime = -1.0f;        // s from 10% to 90% of the step, -1 if never reached
+    float overshoot = 0.0f;        // signal units above the target after first reaching it
+    float settlingTime = -1.0f;    // s until the signal stays within the band, -1 if it never settles
+    float steadyStateError = 0.0f; // mean signed error over the last fifth of the run
+    float controlJitter = 0.0f;    // RMS of successive actuator changes over the second half of the run
+};
+
+StepResponse analyzeStep(const std::vector<float> &signal, const std::vector<float> &actuator, float initial, float target,
+                         float band, float sampleInterval);
+
+#endif // NATIVE_METRICS_H
@@ -0,0 +1,282 @@
+#include "Simulator.h"
+
+#include <ArduinoStub.h>
+#include <ControllerConfig.h>
+#include <peripherals/DimmedPump.h>
+#include <peripherals/Heater.h>
+#include <peripherals/Max31855Thermocouple.h>
+#include <peripherals/PressureSensor.h>
+#include <peripherals/SimpleRelay.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t PLANT_STEP_US = 1000;
+constexpr uint32_t HEATER_PERIOD_MS = HEATER_LOOP_INTERVAL_MS; // Heater::loopTask
+constexpr uint32_t PUMP_PERIOD_MS = 30;                        // DimmedPump::loopTask
+constexpr uint32_t CONTROL_PERIOD_MS = 100;                    // Controller::loopTask on the display
+constexpr float NOMINAL_FLOW = 2.0f;                           // BREW_NOMINAL_FLOW
+constexpr uint32_t HEATER_WINDOW_MS = static_cast<uint32_t>(TUNER_OUTPUT_SPAN);
+constexpr float PREROLL_SECONDS = 180.0f; // Lets the heater PID and thermocouple filter settle before hot scenarios
+
+// Same board the simulated peripherals are wired to
+const ControllerConfig &BOARD = GM_PRO_REV_1x;
+
+struct PeriodicTask {
+    uint32_t periodMs;
+    uint64_t nominalUs;
+    uint64_t dueUs;
+    std::function<void()> loop;
+};
+
+class Scheduler {
+  public:
+    Scheduler(uint32_t jitterMs, uint32_t seed) : jitterUs(static_cast<uint64_t>(jitterMs) * 1000ULL), rngState(seed | 1u) {}
+
+    void add(uint32_t periodMs, uint32_t offsetMs, const std::function<void()> &loop) {
+        uint64_t start = arduino_stub::nowMicros() + static_cast<uint64_t>(offsetMs) * 1000ULL;
+        tasks.push_back({periodMs, start, start, loop});
+    }
+
+    void runDue() {
+        uint64_t now = arduino_stub::nowMicros();
+        for (auto &task : tasks) {
+            if (task.dueUs > now) {
+                continue;
+            }
+            task.loop();
+            // xTaskDelayUntil keeps the nominal cadence, jitter only delays the individual wakeup
+            task.nominalUs += static_cast<uint64_t>(task.periodMs) * 1000ULL;
+            task.dueUs = task.nominalUs + nextJitter();
+        }
+    }
+
+  private:
+    uint64_t nextJitter() {
+        if (jitterUs == 0) {
+            return 0;
+        }
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return (rngState % (jitterUs / PLANT_STEP_US + 1)) * PLANT_STEP_US;
+    }
+
+    std::vector<PeriodicTask> tasks;
+    uint64_t jitterUs;
+    uint32_t rngState;
+};
+
+int16_t pressureToAdc(float pressure, float pressureScale) {
+    // PressureSensor defaults: 0.5 V at 0 bar, 4.5 V at full scale
+    float voltage = 0.5f + std::clamp(pressure, 0.0f, pressureScale) / pressureScale * 4.0f;
+    return static_cast<int16_t>(std::clamp(voltage / ADC_STEP, -32768.0f, 32767.0f));
+}
+
+bool startsHot(Scenario scenario) { return scenario != Scenario::TEMPERATURE_STEP; }
+
+} // namespace
+
+SimulationResult Simulator::run(const SimulationConfig &config, const sample_callback_t &onSample) {
+    arduino_stub::setMicros(0);
+    arduino_stub::setLogLevel(ARDUHAL_LOG_LEVEL_ERROR);
+    arduino_stub::setSerialOutput(false);
+
+    MachinePlant plant(config.plant);
+    plant.reset(startsHot(config.scenario) ? config.targetTemperature : config.plant.ambientTemperature);
+    arduino_stub::setThermocoupleTemperature(plant.readThermocouple());
+    arduino_stub::setAdcReading(0, pressureToAdc(plant.readPressure(), 16.0f));
+
+    Max31855Thermocouple thermocouple(
+        BOARD.maxCsPin, BOARD.maxMisoPin, BOARD.maxSckPin, [](float) {}, []() {});
+    Heater heater(
+        &thermocouple, BOARD.heaterPin, []() {}, [](bool, float, float, float) {});
+    SimpleRelay valve(BOARD.valvePin, BOARD.valveOn);
+    PressureSensor pressureSensor(BOARD.pressureSda, BOARD.pressureScl, [](float) {});
+    DimmedPump pump(BOARD.pumpPin, BOARD.pumpSensePin, &pressureSensor);
+
+    thermocouple.setup();
+    heater.setup();
+    valve.setup();
+    pump.setup();
+    pressureSensor.setup();
+    arduino_stub::setMicros(0);
+
+    heater.setTunings(config.pid[0], config.pid[1], config.pid[2]);
+    heater.setSetpoint(config.targetTemperature);
+    pump.setPumpFlowCoeff(config.pumpModel[0], config.pumpModel[1]);
+
+    Scheduler scheduler(config.taskJitterMs, config.plant.seed + 1);
+    scheduler.add(MAX31855_UPDATE_INTERVAL, 0, [&thermocouple]() { thermocouple.loop(); });
+    scheduler.add(PRESSURE_SAMPLE_INTERVAL_MS, 0, [&pressureSensor]() { pressureSensor.loop(); });
+    scheduler.add(PUMP_PERIOD_MS, config.pumpPhaseOffsetMs, [&pump]() { pump.loop(); });
+    scheduler.add(HEATER_PERIOD_MS, 0, [&heater]() { heater.loop(); });
+
+    std::vector<uint8_t> heaterWindow(HEATER_WINDOW_MS, 0);
+    uint32_t heaterWindowIndex = 0;
+    uint32_t heaterOnCount = 0;
+
+    // The thermocouple reports 0 until its filter has seen a valid reading, fall back to the plant for the metrics
+    auto measuredTemperature = [&]() {
+        return thermocouple.isErrorState() ? plant.readThermocouple() : thermocouple.read();
+    };
+
+    auto stepPlant = [&]() {
+        bool heaterOn = arduino_stub::getPinLevel(BOARD.heaterPin) == HIGH;
+        bool valveOpen = arduino_stub::getPinLevel(BOARD.valvePin) == BOARD.valveOn;
+        plant.step(static_cast<float>(PLANT_STEP_US) / 1e6f, heaterOn, arduino_stub::getPumpDuty(), valveOpen);
+        arduino_stub::advanceMicros(PLANT_STEP_US);
+        arduino_stub::setThermocoupleTemperature(plant.readThermocouple());
+        arduino_stub::setAdcReading(0, pressureToAdc(plant.readPressure(), 16.0f));
+
+        heaterOnCount -= heaterWindow[heaterWindowIndex];
+        heaterWindow[heaterWindowIndex] = heaterOn ? 1 : 0;
+        heaterOnCount += heaterWindow[heaterWindowIndex];
+        heaterWindowIndex = (heaterWindowIndex + 1) % HEATER_WINDOW_MS;
+
+        scheduler.runDue();
+    };
+
+    SimulationResult result;
+    if (startsHot(config.scenario)) {
+        auto prerollSteps = static_cast<uint64_t>(PREROLL_SECONDS * 1e6f / PLANT_STEP_US);
+        for (uint64_t i = 0; i < prerollSteps; i++) {
+            stepPlant();
+        }
+        result.steps += prerollSteps;
+    }
+
+    // Start of the recorded run, equivalent to the display activating a process
+    uint64_t startUs = arduino_stub::nowMicros();
+    float targetPressure = 0.0f;
+    float targetFlow = 0.0f;
+    switch (config.scenario) {
+    case Scenario::TEMPERATURE_STEP:
+        break;
+    case Scenario::PRESSURE_PROFILE:
+    case Scenario::BREW:
+        targetPressure = config.targetPressure;
+        targetFlow = config.flowLimit ? config.targetFlow : 0.0f;
+        pump.tare();
+        valve.set(true);
+        pump.setPressureTarget(targetPressure, targetFlow);
+        pump.setValveState(true);
+        break;
+    case Scenario::FLOW_PROFILE:
+        targetPressure = config.targetPressure;
+        targetFlow = config.targetFlow;
+        pump.tare();
+        valve.set(true);
+        pump.setFlowTarget(targetFlow, targetPressure);
+        pump.setValveState(true);
+        break;
+    }
+
+    // Heat load the display sends with every output control message, see BrewProcess::getPlannedFlow()
+    if (config.heatLoad && config.scenario != Scenario::TEMPERATURE_STEP) {
+        scheduler.add(CONTROL_PERIOD_MS, 0, [&]() {
+            float plannedFlow = config.scenario == Scenario::FLOW_PROFILE ? targetFlow : pump.getPumpFlow();
+            heater.setHeatLoad(plannedFlow > 0.0f ? plannedFlow : NOMINAL_FLOW);
+        });
+    }
+
+    float duration = config.duration > 0.0f ? config.duration : defaultDuration(config.scenario);
+    auto steps = static_cast<uint64_t>(duration * 1e6f / PLANT_STEP_US);
+    uint64_t sampleIntervalUs = std::max<uint64_t>(1, config.sampleIntervalMs) * 1000ULL;
+
+    std::vector<float> temperatures, heaterDuties, pressures, flows, pumpDuties;
+    float initialTemperature = measuredTemperature();
+    result.minTemperature = plant.getState().thermocoupleTemperature;
+    result.maxTemperature = plant.getState().thermocoupleTemperature;
+
+    for (uint64_t i = 0; i < steps; i++) {
+        stepPlant();
+        uint64_t elapsedUs = arduino_stub::nowMicros() - startUs;
+        if (elapsedUs % sampleIntervalUs != 0) {
+            continue;
+        }
+        const PlantState &state = plant.getState();
+        SimulationSample sample{};
+        sample.time = static_cast<float>(elapsedUs) / 1e6f;
+        sample.boilerTemperature = state.boilerTemperature;
+        sample.measuredTemperature = measuredTemperature();
+        sample.targetTemperature = config.targetTemperature;
+        sample.heaterDuty = static_cast<float>(heaterOnCount) / static_cast<float>(HEATER_WINDOW_MS);
+        sample.pressure = state.pressure;
+        sample.measuredPressure = pressureSensor.getRawPressure();
+        sample.targetPressure = targetPressure;
+        sample.targetFlow = targetFlow;
+        sample.pumpDuty = arduino_stub::getPumpDuty();
+        sample.pumpFlow = state.pumpFlow;
+        sample.puckFlow = state.puckFlow;
+        sample.estimatedPumpFlow = pump.getPumpFlow();
+        sample.estimatedPuckFlow = pump.getPuckFlow();
+        sample.coffeeVolume = state.coffeeVolume;
+        sample.estimatedCoffeeVolume = pump.getCoffeeVolume();
+
+        temperatures.push_back(sample.measuredTemperature);
+        heaterDuties.push_back(sample.heaterDuty);
+        pressures.push_back(sample.pressure);
+        flows.push_back(sample.pumpFlow);
+        pumpDuties.push_back(sample.pumpDuty * 100.0f);
+        result.minTemperature = std::min(result.minTemperature, state.thermocoupleTemperature);
+        result.maxTemperature = std::max(result.maxTemperature, state.thermocoupleTemperature);
+
+        if (onSample) {
+            onSample(sample);
+        }
+    }
+    result.steps += steps;
+
+    float sampleInterval = static_cast<float>(sampleIntervalUs) / 1e6f;
+    result.temperature =
+        analyzeStep(temperatures, heaterDuties, initialTemperature, config.targetTemperature, 1.0f, sampleInterval);
+    if (targetPressure > 0.0f && config.scenario != Scenario::FLOW_PROFILE) {
+        result.pressure = analyzeStep(pressures, pumpDuties, 0.0f, targetPressure, 0.2f, sampleInterval);
+    }
+    if (config.scenario == Scenario::FLOW_PROFILE) {
+        result.flow = analyzeStep(flows, pumpDuties, 0.0f, targetFlow, 0.1f, sampleInterval);
+    }
+    result.coffeeVolume = plant.getState().coffeeVolume;
+    result.estimatedCoffeeVolume = pump.getCoffeeVolume();
+    return result;
+}
+
+float Simulator::defaultDuration(Scenario scenario) {
+    switch (scenario) {
+    case Scenario::TEMPERATURE_STEP:
+        return 900.0f;
+    case Scenario::BREW:
+        return 40.0f;
+    case Scenario::PRESSURE_PROFILE:
+    case Scenario::FLOW_PROFILE:
+    default:
+        return 30.0f;
+    }
+}
+
+bool Simulator::parseScenario(const std::string &name, Scenario &scenario) {
+    for (Scenario candidate : {Scenario::TEMPERATURE_STEP, Scenario::PRESSURE_PROFILE, Scenario::FLOW_PROFILE, Scenario::BREW}) {
+        if (name == scenarioName(candidate)) {
+            scenario = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *Simulator::scenarioName(Scenario scenario) {
+    switch (scenario) {
+    case Scenario::TEMPERATURE_STEP:
+        return "temperature";
+    case Scenario::PRESSURE_PROFILE:
+        return "pressure";
+    case Scenario::FLOW_PROFILE:
+        return "flow";
+    case Scenario::BREW:
+    default:
+        return "brew";
+    }
+}
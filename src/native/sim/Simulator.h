@@ -0,0 +1,77 @@
+#ifndef NATIVE_SIMULATOR_H
+#define NATIVE_SIMULATOR_H
+
+#include "MachinePlant.h"
+#include "Metrics.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+enum class Scenario { TEMPERATURE_STEP, PRESSURE_PROFILE, FLOW_PROFILE, BREW };
+
+struct SimulationConfig {
+    Scenario scenario = Scenario::BREW;
+    float duration = 0.0f; // s, 0 picks the scenario default
+
+    // Sent by the display the same way as DEFAULT_PID and DEFAULT_PUMP_MODEL_COEFFS
+    float pid[3] = {58.397f, 1.027f, 249.055f};
+    float pumpModel[2] = {10.205f, 5.521f};
+
+    float targetTemperature = 93.0f; // °C
+    float targetPressure = 9.0f;     // bar
+    float targetFlow = 2.0f;         // ml/s, also the flow limit in pressure scenarios when > 0 and flowLimit is set
+    bool flowLimit = false;
+    bool heatLoad = true; // send the planned brew flow to the heater like the display does
+
+    // Scheduling
+    uint32_t taskJitterMs = 0;       // max random delay added to every task wakeup
+    uint32_t pumpPhaseOffsetMs = 15; // DimmedPump wakeup relative to the PressureSensor task
+    uint32_t sampleIntervalMs = 30;  // time series resolution
+
+    PlantParameters plant;
+};
+
+struct SimulationSample {
+    float time;
+    float boilerTemperature;
+    float measuredTemperature;
+    float targetTemperature;
+    float heaterDuty;
+    float pressure;
+    float measuredPressure;
+    float targetPressure;
+    float targetFlow;
+    float pumpDuty;
+    float pumpFlow;
+    float puckFlow;
+    float estimatedPumpFlow;
+    float estimatedPuckFlow;
+    float coffeeVolume;
+    float estimatedCoffeeVolume;
+};
+
+struct SimulationResult {
+    StepResponse temperature;
+    StepResponse pressure;
+    StepResponse flow;
+    float minTemperature = 0.0f; // °C at the thermocouple, before the firmware filter
+    float maxTemperature = 0.0f;
+    float coffeeVolume = 0.0f;
+    float estimatedCoffeeVolume = 0.0f;
+    uint64_t steps = 0;
+};
+
+using sample_callback_t = std::function<void(const SimulationSample &sample)>;
+
+class Simulator {
+  public:
+    // Runs one scenario from a clean state. Samples are reported every sampleIntervalMs when a callback is given.
+    static SimulationResult run(const SimulationConfig &config, const sample_callback_t &onSample = nullptr);
+
+    static float defaultDuration(Scenario scenario);
+    static bool parseScenario(const std::string &name, Scenario &scenario);
+    static const char *scenarioName(Scenario scenario);
+};
+
+#endif // NATIVE_SIMULATOR_H
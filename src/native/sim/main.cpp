@@ -0,0 +1,264 @@
+// Closed-loop machine simulator
+//
+// Runs the controller peripherals (Heater, DimmedPump, PressureSensor, Max31855Thermocouple) against MachinePlant on a
+// simulated clock and reports step response figures. Useful to evaluate PID gains and pump model coefficients before
+// flashing them.
+//
+//   platformio run -e native-sim -t exec -a "--scenario=brew --csv=shot.csv"
+//   .pio/build/native-sim/program --scenario=temperature --pid=58.397,1.027,249.055
+//   .pio/build/native-sim/program --batch=sweep.txt > sweep.csv
+//
+// A batch file holds one run per line with the same options, results are printed as one CSV row per run.
+
+#include "Simulator.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    std::printf("Usage: program [options]\n"
+                "  --scenario=NAME          temperature, pressure, flow or brew (default brew)\n"
+                "  --duration=SECONDS       run length, defaults depend on the scenario\n"
+                "  --pid=KP,KI,KD           heater PID gains (default DEFAULT_PID)\n"
+                "  --pump=ONE,NINE          pump flow at 1 and 9 bar (default DEFAULT_PUMP_MODEL_COEFFS)\n"
+                "  --temperature=C          target temperature\n"
+                "  --pressure=BAR           target pressure, pressure limit in flow mode\n"
+                "  --flow=MLS               target flow, flow limit in pressure mode with --flow-limit\n"
+                "  --flow-limit             apply --flow as flow limit in pressure scenarios\n"
+                "  --no-heat-load           do not send the planned brew flow to the heater\n"
+                "  --jitter=MS              max random task wakeup delay\n"
+                "  --phase=MS               pump task offset against the pressure sensor task\n"
+                "  --interval=MS            sample interval for the time series and metrics\n"
+                "  --plant-pump=ONE,NINE    actual pump flow at 1 and 9 bar\n"
+                "  --plant-puck=K           puck conductance in ml/s/sqrt(bar)\n"
+                "  --plant-heater=W         heater power\n"
+                "  --plant-noise=BAR        pressure sensor noise\n"
+                "  --seed=N                 noise seed\n"
+                "  --csv=FILE               write the time series to FILE\n"
+                "  --batch=FILE             run one configuration per line of FILE, print a summary row each\n");
+}
+
+bool parseFloats(const char *value, float *out, size_t count) {
+    std::string text(value);
+    std::stringstream stream(text);
+    std::string item;
+    size_t index = 0;
+    while (std::getline(stream, item, ',')) {
+        if (index >= count) {
+            return false;
+        }
+        char *end = nullptr;
+        out[index++] = std::strtof(item.c_str(), &end);
+        if (end == item.c_str()) {
+            return false;
+        }
+    }
+    return index == count;
+}
+
+struct Options {
+    SimulationConfig config;
+    std::string csvPath;
+    std::string batchPath;
+};
+
+bool parseOption(const std::string &arg, Options &options) {
+    auto eq = arg.find('=');
+    std::string key = arg.substr(0, eq);
+    const char *value = eq == std::string::npos ? "" : arg.c_str() + eq + 1;
+    SimulationConfig &config = options.config;
+
+    if (key == "--scenario")
+        return Simulator::parseScenario(value, config.scenario);
+    if (key == "--duration")
+        return parseFloats(value, &config.duration, 1);
+    if (key == "--pid")
+        return parseFloats(value, config.pid, 3);
+    if (key == "--pump")
+        return parseFloats(value, config.pumpModel, 2);
+    if (key == "--temperature")
+        return parseFloats(value, &config.targetTemperature, 1);
+    if (key == "--pressure")
+        return parseFloats(value, &config.targetPressure, 1);
+    if (key == "--flow")
+        return parseFloats(value, &config.targetFlow, 1);
+    if (key == "--flow-limit") {
+        config.flowLimit = true;
+        return true;
+    }
+    if (key == "--no-heat-load") {
+        config.heatLoad = false;
+        return true;
+    }
+    if (key == "--jitter") {
+        config.taskJitterMs = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        return true;
+    }
+    if (key == "--phase") {
+        config.pumpPhaseOffsetMs = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        return true;
+    }
+    if (key == "--interval") {
+        config.sampleIntervalMs = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        return config.sampleIntervalMs > 0;
+    }
+    if (key == "--plant-pump") {
+        float flows[2];
+        if (!parseFloats(value, flows, 2))
+            return false;
+        config.plant.pumpOneBarFlow = flows[0];
+        config.plant.pumpNineBarFlow = flows[1];
+        return true;
+    }
+    if (key == "--plant-puck")
+        return parseFloats(value, &config.plant.puckConductance, 1);
+    if (key == "--plant-heater")
+        return parseFloats(value, &config.plant.heaterPower, 1);
+    if (key == "--plant-noise")
+        return parseFloats(value, &config.plant.pressureNoise, 1);
+    if (key == "--seed") {
+        config.plant.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        return true;
+    }
+    if (key == "--csv") {
+        options.csvPath = value;
+        return true;
+    }
+    if (key == "--batch") {
+        options.batchPath = value;
+        return true;
+    }
+    return false;
+}
+
+void printSummaryHeader() {
+    std::printf("scenario,kp,ki,kd,pump_one_bar,pump_nine_bar,jitter_ms,"
+                "temp_rise_s,temp_overshoot,temp_settling_s,temp_error,temp_min,temp_max,heater_jitter,"
+                "pressure_rise_s,pressure_overshoot,pressure_settling_s,pressure_error,"
+                "flow_rise_s,flow_overshoot,flow_settling_s,flow_error,pump_jitter,"
+                "coffee_ml,coffee_estimate_ml\n");
+}
+
+void printSummaryRow(const SimulationConfig &config, const SimulationResult &result) {
+    const StepResponse &hydraulic = config.scenario == Scenario::FLOW_PROFILE ? result.flow : result.pressure;
+    std::printf("%s,%.3f,%.3f,%.3f,%.3f,%.3f,%u,"
+                "%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.4f,"
+                "%.3f,%.3f,%.3f,%.3f,"
+                "%.3f,%.3f,%.3f,%.3f,%.3f,"
+                "%.1f,%.1f\n",
+                Simulator::scenarioName(config.scenario), config.pid[0], config.pid[1], config.pid[2], config.pumpModel[0],
+                config.pumpModel[1], config.taskJitterMs, result.temperature.riseTime, result.temperature.overshoot,
+                result.temperature.settlingTime, result.temperature.steadyStateError, result.minTemperature,
+                result.maxTemperature, result.temperature.controlJitter, result.pressure.riseTime, result.pressure.overshoot,
+                result.pressure.settlingTime, result.pressure.steadyStateError, result.flow.riseTime, result.flow.overshoot,
+                result.flow.settlingTime, result.flow.steadyStateError, hydraulic.controlJitter, result.coffeeVolume,
+                result.estimatedCoffeeVolume);
+}
+
+void printReport(const SimulationConfig &config, const SimulationResult &result) {
+    auto printResponse = [](const char *name, const char *unit, const StepResponse &response) {
+        std::printf("%-12s rise %7.2f s  overshoot %6.2f %-4s settling %7.2f s  error %6.2f %-4s jitter %.4f\n", name,
+                    response.riseTime, response.overshoot, unit, response.settlingTime, response.steadyStateError, unit,
+                    response.controlJitter);
+    };
+    std::printf("Scenario %s, PID %.3f/%.3f/%.3f, pump model %.3f/%.3f, %llu plant steps\n",
+                Simulator::scenarioName(config.scenario), config.pid[0], config.pid[1], config.pid[2], config.pumpModel[0],
+                config.pumpModel[1], static_cast<unsigned long long>(result.steps));
+    printResponse("Temperature", "°C", result.temperature);
+    std::printf("%-12s min %.2f °C  max %.2f °C\n", "", result.minTemperature, result.maxTemperature);
+    if (config.scenario == Scenario::FLOW_PROFILE) {
+        printResponse("Flow", "ml/s", result.flow);
+    } else if (config.scenario != Scenario::TEMPERATURE_STEP) {
+        printResponse("Pressure", "bar", result.pressure);
+    }
+    if (config.scenario != Scenario::TEMPERATURE_STEP) {
+        std::printf("%-12s %.1f ml in cup, %.1f ml estimated\n", "Volume", result.coffeeVolume, result.estimatedCoffeeVolume);
+    }
+}
+
+int runSingle(const Options &options) {
+    FILE *csv = nullptr;
+    if (!options.csvPath.empty()) {
+        csv = std::fopen(options.csvPath.c_str(), "w");
+        if (csv == nullptr) {
+            std::fprintf(stderr, "Cannot open %s\n", options.csvPath.c_str());
+            return 1;
+        }
+        std::fprintf(csv, "time,boiler_temp,measured_temp,target_temp,heater_duty,pressure,measured_pressure,target_pressure,"
+                          "target_flow,pump_duty,pump_flow,puck_flow,est_pump_flow,est_puck_flow,coffee_ml,est_coffee_ml\n");
+    }
+    SimulationResult result = Simulator::run(options.config, [csv](const SimulationSample &s) {
+        if (csv == nullptr)
+            return;
+        std::fprintf(csv, "%.3f,%.3f,%.2f,%.1f,%.3f,%.3f,%.3f,%.2f,%.2f,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%.2f\n", s.time,
+                     s.boilerTemperature, s.measuredTemperature, s.targetTemperature, s.heaterDuty, s.pressure,
+                     s.measuredPressure, s.targetPressure, s.targetFlow, s.pumpDuty, s.pumpFlow, s.puckFlow,
+                     s.estimatedPumpFlow, s.estimatedPuckFlow, s.coffeeVolume, s.estimatedCoffeeVolume);
+    });
+    if (csv != nullptr) {
+        std::fclose(csv);
+    }
+    printReport(options.config, result);
+    return 0;
+}
+
+int runBatch(const Options &defaults) {
+    std::ifstream file(defaults.batchPath);
+    if (!file) {
+        std::fprintf(stderr, "Cannot open %s\n", defaults.batchPath.c_str());
+        return 1;
+    }
+    printSummaryHeader();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        Options options = defaults;
+        std::stringstream stream(line);
+        std::string arg;
+        bool valid = true;
+        while (stream >> arg) {
+            if (!parseOption(arg, options)) {
+                std::fprintf(stderr, "Line %d: invalid option %s\n", lineNumber, arg.c_str());
+                valid = false;
+                break;
+            }
+        }
+        if (valid) {
+            printSummaryRow(options.config, Simulator::run(options.config));
+            std::fflush(stdout);
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--help") == 0 || std::strcmp(argv[i], "-h") == 0) {
+            printUsage();
+            return 0;
+        }
+        if (!parseOption(argv[i], options)) {
+            std::fprintf(stderr, "Invalid option %s\n", argv[i]);
+            printUsage();
+            return 1;
+        }
+    }
+    if (!options.batchPath.empty()) {
+        return runBatch(options);
+    }
+    return runSingle(options);
+}
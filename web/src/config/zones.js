@@ -1,3 +1,4 @@
+// Generated by scripts/generate_zones.py from scripts/zones.txt, do not edit.
 export const timezones = [
   'Africa/Abidjan',
   'Africa/Accra',
@@ -4,10 +4,21 @@ import { OverviewChart } from '../../components/OverviewChart.jsx';
 import { Spinner } from '../../components/Spinner.jsx';
 import Card from '../../components/Card.jsx';
 
+// AutotuneState on the controller
+const STEPS = [
+  'Measuring the resting temperature',
+  'Heating, waiting for the boiler to react',
+  'Heating, measuring the heating rate',
+  'Done',
+  'Failed',
+];
+
 export function Autotune() {
   const apiService = useContext(ApiServiceContext);
   const [active, setActive] = useState(false);
   const [result, setResult] = useState(null);
+  const [failed, setFailed] = useState(false);
+  const [progress, setProgress] = useState(null);
   const [time, setTime] = useState(60);
   const [samples, setSamples] = useState(4);
 
@@ -18,15 +29,26 @@ export function Autotune() {
       samples,
     });
     setActive(true);
+    setFailed(false);
+    setProgress(null);
   }, [time, samples, apiService]);
 
   useEffect(() => {
     const listenerId = apiService.on('evt:autotune-result', msg => {
       setActive(false);
-      setResult(msg.pid);
+      // Displays without the flag only report successful runs
+      if (msg.success === false) {
+        setFailed(true);
+      } else {
+        setResult(msg.pid);
+      }
+    });
+    const progressListenerId = apiService.on('evt:autotune-progress', msg => {
+      setProgress(msg);
     });
     return () => {
       apiService.off('evt:autotune-result', listenerId);
+      apiService.off('evt:autotune-progress', progressListenerId);
     };
   }, [apiService]);
 
@@ -48,6 +70,12 @@ export function Autotune() {
                   <Spinner size={8} />
                   <span className='text-lg font-medium'>Autotune in Progress</span>
                 </div>
+                {progress && (
+                  <div className='text-sm opacity-70'>
+                    {STEPS[progress.state] ?? `Step ${progress.state}`} ·{' '}
+                    {progress.temperature.toFixed(1)}°C
+                  </div>
+                )}
                 <div className='alert alert-warning max-w-md'>
                   <span>
                     Please wait while the system optimizes your PID settings. This may take up to 30
@@ -74,7 +102,20 @@ export function Autotune() {
             </div>
           )}
 
-          {!active && !result && (
+          {failed && (
+            <div className='space-y-4 text-center'>
+              <div className='alert alert-error mx-auto max-w-md'>
+                <div>
+                  <h3 className='font-bold'>Autotune Failed</h3>
+                  <div className='text-sm'>
+                    The run stopped before new values were found. Your PID values were not changed.
+                  </div>
+                </div>
+              </div>
+            </div>
+          )}
+
+          {!active && !result && !failed && (
             <div className='space-y-4'>
               <div className='alert alert-warning'>
                 <span>
@@ -130,7 +171,7 @@ export function Autotune() {
 
       <div className='pt-4 lg:col-span-12'>
         <div className='flex flex-col gap-2 sm:flex-row'>
-          {!active && !result && (
+          {!active && !result && !failed && (
             <button
               className='btn btn-primary'
               onClick={onStart}
@@ -140,8 +181,14 @@ export function Autotune() {
             </button>
           )}
 
-          {result && (
-            <button className='btn btn-outline' onClick={() => setResult(null)}>
+          {(result || failed) && (
+            <button
+              className='btn btn-outline'
+              onClick={() => {
+                setResult(null);
+                setFailed(false);
+              }}
+            >
               Back to Settings
             </button>
           )}
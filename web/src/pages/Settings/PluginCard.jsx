@@ -226,6 +226,20 @@ export function PluginCard({
                 </option>
               </select>
             </div>
+            <div className='form-control'>
+              <label htmlFor='smartGrindTimeout' className='mb-2 block text-sm font-medium'>
+                Request Timeout (ms)
+              </label>
+              <input
+                id='smartGrindTimeout'
+                name='smartGrindTimeout'
+                type='number'
+                className='input input-bordered w-full'
+                placeholder='1000'
+                value={formData.smartGrindTimeout}
+                onChange={onChange('smartGrindTimeout')}
+              />
+            </div>
           </div>
         )}
       </div>
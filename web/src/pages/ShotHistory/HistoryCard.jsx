@@ -10,7 +10,10 @@ import { faClock } from '@fortawesome/free-solid-svg-icons/faClock';
 import { faStar } from '@fortawesome/free-solid-svg-icons/faStar';
 import { faPlus } from '@fortawesome/free-solid-svg-icons/faPlus';
 import { faMinus } from '@fortawesome/free-solid-svg-icons/faMinus';
+import { faTint } from '@fortawesome/free-solid-svg-icons/faTint';
+import { faGauge } from '@fortawesome/free-solid-svg-icons/faGauge';
 import ShotNotesCard from './ShotNotesCard.jsx';
+import ShotAnalyticsCard from './ShotAnalyticsCard.jsx';
 
 
 function round2(v) {
@@ -142,6 +145,20 @@ export default function HistoryCard({ shot, onDelete, onLoad, onNotesChanged })
                 </div>
               )}
 
+              {shot.analytics?.firstDrip != null && (
+                <div className='tooltip flex items-center gap-1' data-tip='First drip'>
+                  <FontAwesomeIcon icon={faTint} className='w-4 h-4' />
+                  <span>{(shot.analytics.firstDrip / 1000).toFixed(1)}s</span>
+                </div>
+              )}
+
+              {shot.analytics && (
+                <div className='tooltip flex items-center gap-1' data-tip='Peak pressure'>
+                  <FontAwesomeIcon icon={faGauge} className='w-4 h-4' />
+                  <span>{shot.analytics.peakPressure.toFixed(1)} bar</span>
+                </div>
+              )}
+
               {shot.rating && shot.rating > 0 ? (
                 <div className='flex items-center gap-1'>
                   <FontAwesomeIcon icon={faStar} className='w-4 h-4 text-yellow-500' />
@@ -163,6 +180,7 @@ export default function HistoryCard({ shot, onDelete, onLoad, onNotesChanged })
                   </div>
                 )}
                 {shot.loaded && <HistoryChart shot={shot} />}
+                <ShotAnalyticsCard shot={shot} />
                 {shot.loaded && (
                   <ShotNotesCard
                     shot={shot}
@@ -0,0 +1,82 @@
+import { useEffect, useState } from 'preact/hooks';
+import { parseShotAnalytics } from './parseShotAnalytics.js';
+
+function seconds(ms) {
+  return (ms / 1000).toFixed(1) + 's';
+}
+
+// Per phase analytics computed by the controller when the shot finished, a few hundred bytes
+// instead of the whole shot log
+export default function ShotAnalyticsCard({ shot }) {
+  const [analytics, setAnalytics] = useState(null);
+
+  useEffect(() => {
+    if (!shot.analytics) return;
+    let cancelled = false;
+    const loadAnalytics = async () => {
+      try {
+        const resp = await fetch(`/api/history/${shot.id.padStart(6, '0')}.sa`);
+        if (!resp.ok) throw new Error(`HTTP ${resp.status}`);
+        const parsed = parseShotAnalytics(await resp.arrayBuffer());
+        if (!cancelled) setAnalytics(parsed);
+      } catch (e) {
+        console.error('Failed loading shot analytics', e);
+      }
+    };
+    loadAnalytics();
+    return () => {
+      cancelled = true;
+    };
+  }, [shot.id, shot.analytics]);
+
+  if (!analytics || analytics.phases.length === 0) return null;
+
+  return (
+    <div className='border-t-base-content/10 mt-6 border-t-2 pt-6'>
+      <h3 className='mb-4 text-lg font-semibold'>Phases</h3>
+      <div className='overflow-x-auto'>
+        <table className='table-sm table'>
+          <thead>
+            <tr>
+              <th>Phase</th>
+              <th>Time</th>
+              <th>Pressure avg / peak</th>
+              <th>Puck flow avg / peak</th>
+              <th>Resistance</th>
+              <th>Temp ±</th>
+              <th>Weight</th>
+              <th>Channeling</th>
+            </tr>
+          </thead>
+          <tbody>
+            {analytics.phases.map((phase, i) => (
+              <tr key={i}>
+                <td>{phase.name || '-'}</td>
+                <td>
+                  {seconds(phase.start)} + {seconds(phase.duration)}
+                </td>
+                <td>
+                  {phase.avgPressure.toFixed(1)} / {phase.peakPressure.toFixed(1)} bar
+                </td>
+                <td>
+                  {phase.avgPuckFlow.toFixed(2)} / {phase.peakPuckFlow.toFixed(2)} ml/s
+                </td>
+                <td>
+                  {phase.avgResistance.toFixed(2)} ({phase.resistanceTrend >= 0 ? '+' : ''}
+                  {phase.resistanceTrend.toFixed(2)}/s)
+                </td>
+                <td>{phase.tempStdDev.toFixed(2)} °C</td>
+                <td>{phase.weight.toFixed(1)}g</td>
+                <td className={phase.channeling > 0 ? 'text-warning' : ''}>
+                  {phase.channeling > 0
+                    ? `${phase.channeling} (-${phase.maxResistanceDrop}%)`
+                    : 'None'}
+                </td>
+              </tr>
+            ))}
+          </tbody>
+        </table>
+      </div>
+    </div>
+  );
+}
@@ -1,6 +1,8 @@
 // Parser for index.bin binary shot index files
 // Mirrors shot_log_format.h ShotIndexHeader and ShotIndexEntry (keep in sync)
 
+import { parseAnalyticsSummary } from './parseShotAnalytics.js';
+
 const INDEX_HEADER_SIZE = 32;
 const INDEX_ENTRY_SIZE = 128;
 const INDEX_MAGIC = 0x58444953; // 'SIDX'
@@ -75,6 +77,7 @@ export function parseBinaryIndex(arrayBuffer) {
     
     const profileId = decodeCString(profileIdBytes);
     const profileName = decodeCString(profileNameBytes);
+    const analytics = parseAnalyticsSummary(view, base + 96);
     
     // Convert volume from scaled integer to float
     const volumeFloat = volume > 0 ? volume / WEIGHT_SCALE : null;
@@ -88,6 +91,7 @@ export function parseBinaryIndex(arrayBuffer) {
       flags,
       profileId,
       profileName,
+      analytics,
       // Computed flags
       completed: !!(flags & SHOT_FLAG_COMPLETED),
       deleted: !!(flags & SHOT_FLAG_DELETED),
@@ -126,6 +130,7 @@ export function indexToShotList(indexData) {
       volume: entry.volume,
       rating: entry.rating > 0 ? entry.rating : null, // Only include rating if > 0
       incomplete: entry.incomplete,
+      analytics: entry.analytics,
       notes: null,
       loaded: false,
       data: null,
@@ -1,11 +1,20 @@
 // Parser for .slog binary shot files
-// Mirrors shot_log_format.h (keep in sync)
+// Mirrors shot_log_format.h and shot_log_codec.h (keep in sync)
 // Header: 128 bytes
-// Strict single format (no backward compatibility)
+// v1: raw 24 byte samples, v2: delta encoded blocks with crc32 and a block index
 
 const HEADER_SIZE = 128;
 const SAMPLE_SIZE = 24; // 12 packed 16-bit values
 const MAGIC = 0x544F4853; // 'SHOT' - matches backend SHOT_LOG_MAGIC
+const VERSION_RAW = 1;
+const VERSION_BLOCKS = 2;
+const FIELD_COUNT = 12;
+const BLOCK_HEADER_SIZE = 8;
+const BLOCK_INDEX_ENTRY_SIZE = 12;
+
+// Field order of ShotLogSample, bit n of the fields mask is field n
+const FIELDS = ['t', 'tt', 'ct', 'tp', 'cp', 'fl', 'tf', 'pf', 'vf', 'v', 'ev', 'pr'];
+const SIGNED_FIELDS = new Set(['fl', 'tf', 'pf', 'vf']);
 
 const TEMP_SCALE = 10;
 const PRESSURE_SCALE = 10;
@@ -13,6 +22,40 @@ const FLOW_SCALE = 100;
 const WEIGHT_SCALE = 10;
 const RESISTANCE_SCALE = 100;
 
+const SCALES = {
+  tt: TEMP_SCALE,
+  ct: TEMP_SCALE,
+  tp: PRESSURE_SCALE,
+  cp: PRESSURE_SCALE,
+  fl: FLOW_SCALE,
+  tf: FLOW_SCALE,
+  pf: FLOW_SCALE,
+  vf: FLOW_SCALE,
+  v: WEIGHT_SCALE,
+  ev: WEIGHT_SCALE,
+  pr: RESISTANCE_SCALE,
+};
+
+const CRC_TABLE = (() => {
+  const table = new Uint32Array(256);
+  for (let n = 0; n < 256; n++) {
+    let c = n;
+    for (let k = 0; k < 8; k++) {
+      c = c & 1 ? 0xedb88320 ^ (c >>> 1) : c >>> 1;
+    }
+    table[n] = c >>> 0;
+  }
+  return table;
+})();
+
+function crc32(bytes) {
+  let crc = 0xffffffff;
+  for (let i = 0; i < bytes.length; i++) {
+    crc = CRC_TABLE[(crc ^ bytes[i]) & 0xff] ^ (crc >>> 8);
+  }
+  return (crc ^ 0xffffffff) >>> 0;
+}
+
 function decodeCString(bytes) {
   // Find null terminator
   let length = bytes.length;
@@ -26,6 +69,124 @@ function decodeCString(bytes) {
   return decoder.decode(bytes.subarray(0, length));
 }
 
+function toSample(raw, sampleInterval) {
+  const sample = { t: raw[0] * sampleInterval };
+  for (let i = 1; i < FIELD_COUNT; i++) {
+    const name = FIELDS[i];
+    const value = SIGNED_FIELDS.has(name) ? (raw[i] << 16) >> 16 : raw[i];
+    sample[name] = value / SCALES[name];
+  }
+  return sample;
+}
+
+function parseRawSamples(view, headerSize, sampleCountHeader, sampleInterval) {
+  const samples = [];
+  const dataBytes = view.byteLength - headerSize;
+  if (dataBytes < 0) {
+    throw new Error('Data size misaligned');
+  }
+  const fullSampleBytes = Math.floor(dataBytes / SAMPLE_SIZE) * SAMPLE_SIZE;
+  const trailingBytes = dataBytes - fullSampleBytes;
+  const inferredSamples = fullSampleBytes / SAMPLE_SIZE;
+  const maxSamples = sampleCountHeader
+    ? Math.min(sampleCountHeader, inferredSamples)
+    : inferredSamples;
+  const raw = new Uint16Array(FIELD_COUNT);
+  for (let i = 0; i < maxSamples; i++) {
+    const base = headerSize + i * SAMPLE_SIZE;
+    for (let f = 0; f < FIELD_COUNT; f++) {
+      raw[f] = view.getUint16(base + f * 2, true);
+    }
+    samples.push(toSample(raw, sampleInterval));
+  }
+  const inferredIncomplete =
+    trailingBytes !== 0 || (sampleCountHeader && sampleCountHeader > inferredSamples);
+  return { samples, trailingBytes, inferredIncomplete };
+}
+
+// Decodes one v2 block into samples, returns the offset after the block or null when it is corrupt
+function decodeBlock(bytes, offset, fieldsMask, sampleInterval, samples) {
+  if (offset + BLOCK_HEADER_SIZE > bytes.length) return null;
+  const view = new DataView(bytes.buffer, bytes.byteOffset + offset, BLOCK_HEADER_SIZE);
+  const sampleCount = view.getUint16(0, true);
+  const payloadSize = view.getUint16(2, true);
+  const crc = view.getUint32(4, true);
+  const start = offset + BLOCK_HEADER_SIZE;
+  const end = start + payloadSize;
+  if (end > bytes.length || crc32(bytes.subarray(start, end)) !== crc) return null;
+
+  let position = start;
+  const readVarint = () => {
+    let result = 0;
+    for (let shift = 0; shift < 21; shift += 7) {
+      if (position >= end) return -1;
+      const byte = bytes[position++];
+      result |= (byte & 0x7f) << shift;
+      if (!(byte & 0x80)) return result <= 0xffff ? result : -1;
+    }
+    return -1;
+  };
+
+  const raw = new Uint16Array(FIELD_COUNT);
+  const decoded = [];
+  for (let s = 0; s < sampleCount; s++) {
+    const changed = readVarint();
+    if (changed < 0 || changed & ~fieldsMask) return null;
+    for (let i = 0; i < FIELD_COUNT; i++) {
+      if (changed & (1 << i)) {
+        const zigzag = readVarint();
+        if (zigzag < 0) return null;
+        raw[i] += (zigzag >>> 1) ^ -(zigzag & 1);
+      }
+    }
+    decoded.push(toSample(raw, sampleInterval));
+  }
+  if (position !== end) return null;
+  samples.push(...decoded);
+  return end;
+}
+
+function readBlockIndex(view, bytes, indexOffset, blockCount) {
+  if (!indexOffset || !blockCount) return null;
+  const indexSize = blockCount * BLOCK_INDEX_ENTRY_SIZE;
+  if (indexOffset + indexSize + 4 > view.byteLength) return null;
+  const crc = view.getUint32(indexOffset + indexSize, true);
+  if (crc32(bytes.subarray(indexOffset, indexOffset + indexSize)) !== crc) return null;
+  const offsets = [];
+  for (let i = 0; i < blockCount; i++) {
+    offsets.push(view.getUint32(indexOffset + i * BLOCK_INDEX_ENTRY_SIZE, true));
+  }
+  return offsets;
+}
+
+function parseBlockSamples(view, headerSize, fieldsMask, sampleInterval) {
+  const bytes = new Uint8Array(view.buffer, view.byteOffset, view.byteLength);
+  const indexOffset = view.getUint32(110, true);
+  const blockCount = view.getUint16(114, true);
+  const samples = [];
+  let corruptBlocks = 0;
+
+  const offsets = readBlockIndex(view, bytes, indexOffset, blockCount);
+  if (offsets) {
+    for (const offset of offsets) {
+      if (decodeBlock(bytes, offset, fieldsMask, sampleInterval, samples) === null) {
+        corruptBlocks++;
+      }
+    }
+    return { samples, trailingBytes: 0, inferredIncomplete: corruptBlocks > 0, corruptBlocks };
+  }
+
+  // No usable index (recording cut short), walk the blocks until the first one that does not decode
+  const dataEnd = indexOffset && indexOffset <= bytes.length ? indexOffset : bytes.length;
+  let offset = headerSize;
+  while (offset < dataEnd) {
+    const next = decodeBlock(bytes.subarray(0, dataEnd), offset, fieldsMask, sampleInterval, samples);
+    if (next === null) break;
+    offset = next;
+  }
+  return { samples, trailingBytes: dataEnd - offset, inferredIncomplete: true, corruptBlocks };
+}
+
 export function parseBinaryShot(arrayBuffer, id) {
   const view = new DataView(arrayBuffer);
   if (view.byteLength < HEADER_SIZE) throw new Error('File too small');
@@ -50,39 +211,18 @@ export function parseBinaryShot(arrayBuffer, id) {
   }
   if (headerSize !== HEADER_SIZE) throw new Error('Unexpected header size');
 
-  const samples = [];
-  const dataBytes = view.byteLength - headerSize;
-  if (dataBytes < 0) {
-    throw new Error('Data size misaligned');
-  }
-  const fullSampleBytes = Math.floor(dataBytes / SAMPLE_SIZE) * SAMPLE_SIZE;
-  const trailingBytes = dataBytes - fullSampleBytes;
-  const inferredSamples = fullSampleBytes / SAMPLE_SIZE;
-  const maxSamples = sampleCountHeader
-    ? Math.min(sampleCountHeader, inferredSamples)
-    : inferredSamples;
-  for (let i = 0; i < maxSamples; i++) {
-    const base = headerSize + i * SAMPLE_SIZE;
-    const tick = view.getUint16(base + 0, true);
-    const t = tick * sampleInterval;
-    const tt = view.getUint16(base + 2, true) / TEMP_SCALE;
-    const ct = view.getUint16(base + 4, true) / TEMP_SCALE;
-    const tp = view.getUint16(base + 6, true) / PRESSURE_SCALE;
-    const cp = view.getUint16(base + 8, true) / PRESSURE_SCALE;
-    const fl = view.getInt16(base + 10, true) / FLOW_SCALE;
-    const tf = view.getInt16(base + 12, true) / FLOW_SCALE;
-    const pf = view.getInt16(base + 14, true) / FLOW_SCALE;
-    const vf = view.getInt16(base + 16, true) / FLOW_SCALE;
-    const v = view.getUint16(base + 18, true) / WEIGHT_SCALE;
-    const ev = view.getUint16(base + 20, true) / WEIGHT_SCALE;
-    const pr = view.getUint16(base + 22, true) / RESISTANCE_SCALE;
-    samples.push({ t, tt, ct, tp, cp, fl, tf, pf, vf, v, ev, pr });
+  let parsed;
+  if (version === VERSION_RAW) {
+    parsed = parseRawSamples(view, headerSize, sampleCountHeader, sampleInterval);
+  } else if (version === VERSION_BLOCKS) {
+    parsed = parseBlockSamples(view, headerSize, fieldsMask, sampleInterval);
+  } else {
+    throw new Error(`Unsupported shot log version ${version}`);
   }
+  const { samples, trailingBytes, inferredIncomplete, corruptBlocks = 0 } = parsed;
 
   const lastT = samples.length ? samples[samples.length - 1].t : 0;
   const headerIncomplete = sampleCountHeader === 0;
-  const inferredIncomplete =
-    trailingBytes !== 0 || (sampleCountHeader && sampleCountHeader > inferredSamples);
   const incomplete = headerIncomplete || inferredIncomplete;
   const effectiveDuration = !incomplete && durationHeader ? durationHeader : lastT;
 
@@ -103,6 +243,7 @@ export function parseBinaryShot(arrayBuffer, id) {
     sampleInterval,
     fieldsMask,
     trailingBytes,
+    corruptBlocks,
     samplesExpected: sampleCountHeader,
   };
 }
@@ -0,0 +1,91 @@
+// Parser for the shot analytics written by the controller when a shot completes
+// Mirrors shot_log_format.h ShotAnalyticsSummary, ShotAnalyticsHeader and ShotPhaseAnalytics (keep in sync)
+
+const ANALYTICS_MAGIC = 0x4c4e4153; // 'SANL'
+const HEADER_SIZE = 24;
+const SUMMARY_SIZE = 16;
+const PHASE_NAME_SIZE = 24;
+
+const FLAG_VALID = 0x01;
+const FLAG_SCALE_DRIP = 0x02;
+const NO_DRIP = 0xffff;
+
+const TICK_MS = 10;
+const PRESSURE_SCALE = 10;
+const FLOW_SCALE = 100;
+const WEIGHT_SCALE = 10;
+const RESISTANCE_SCALE = 100;
+const TEMP_ERROR_SCALE = 100;
+const TEMP_SCALE = 10;
+
+function decodeCString(bytes) {
+  const end = bytes.indexOf(0);
+  return new TextDecoder('utf-8').decode(end >= 0 ? bytes.subarray(0, end) : bytes);
+}
+
+/**
+ * Parse a ShotAnalyticsSummary, stored in every index entry and in the sidecar header
+ * @param {DataView} view - View over the data holding the summary
+ * @param {number} offset - Byte offset of the summary
+ * @returns {Object|null} Summary in real units, null for shots recorded without analytics
+ */
+export function parseAnalyticsSummary(view, offset) {
+  if (view.byteLength < offset + SUMMARY_SIZE) return null;
+  const flags = view.getUint8(offset);
+  if (!(flags & FLAG_VALID)) return null;
+  const firstDripTick = view.getUint16(offset + 2, true);
+  return {
+    channeling: view.getUint8(offset + 1),
+    firstDrip: firstDripTick !== NO_DRIP ? firstDripTick * TICK_MS : null,
+    firstDripFromScale: !!(flags & FLAG_SCALE_DRIP),
+    avgPressure: view.getUint16(offset + 4, true) / PRESSURE_SCALE,
+    peakPressure: view.getUint16(offset + 6, true) / PRESSURE_SCALE,
+    avgFlow: view.getInt16(offset + 8, true) / FLOW_SCALE,
+    peakFlow: view.getInt16(offset + 10, true) / FLOW_SCALE,
+    tempStdDev: view.getUint16(offset + 12, true) / TEMP_ERROR_SCALE,
+    resistanceTrend: view.getInt16(offset + 14, true) / RESISTANCE_SCALE,
+  };
+}
+
+/**
+ * Parse a .sa shot analytics sidecar
+ * @param {ArrayBuffer} arrayBuffer - The sidecar file data
+ * @returns {Object} Shot summary and per phase analytics
+ */
+export function parseShotAnalytics(arrayBuffer) {
+  const view = new DataView(arrayBuffer);
+  if (view.byteLength < HEADER_SIZE) {
+    throw new Error('Analytics file too small');
+  }
+  const magic = view.getUint32(0, true);
+  if (magic !== ANALYTICS_MAGIC) {
+    throw new Error(`Invalid analytics magic: 0x${magic.toString(16)}`);
+  }
+  const phaseCount = view.getUint8(5);
+  const phaseSize = view.getUint16(6, true);
+  const phases = [];
+  for (let i = 0; i < phaseCount; i++) {
+    const base = HEADER_SIZE + i * phaseSize;
+    if (base + phaseSize > view.byteLength) break;
+    phases.push({
+      name: decodeCString(new Uint8Array(arrayBuffer, base, PHASE_NAME_SIZE)),
+      start: view.getUint16(base + 24, true) * TICK_MS,
+      duration: view.getUint16(base + 26, true) * TICK_MS,
+      samples: view.getUint16(base + 28, true),
+      avgPressure: view.getUint16(base + 30, true) / PRESSURE_SCALE,
+      peakPressure: view.getUint16(base + 32, true) / PRESSURE_SCALE,
+      avgPumpFlow: view.getInt16(base + 34, true) / FLOW_SCALE,
+      avgPuckFlow: view.getInt16(base + 36, true) / FLOW_SCALE,
+      peakPuckFlow: view.getInt16(base + 38, true) / FLOW_SCALE,
+      avgResistance: view.getUint16(base + 40, true) / RESISTANCE_SCALE,
+      resistanceTrend: view.getInt16(base + 42, true) / RESISTANCE_SCALE,
+      avgTempError: view.getInt16(base + 44, true) / TEMP_ERROR_SCALE,
+      tempStdDev: view.getUint16(base + 46, true) / TEMP_ERROR_SCALE,
+      maxTempDeviation: view.getUint16(base + 48, true) / TEMP_SCALE,
+      weight: view.getUint16(base + 50, true) / WEIGHT_SCALE,
+      channeling: view.getUint8(base + 52),
+      maxResistanceDrop: view.getUint8(base + 53),
+    });
+  }
+  return { summary: parseAnalyticsSummary(view, 8), phases };
+}
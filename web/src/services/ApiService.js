@@ -2,6 +2,90 @@ import { createContext } from 'preact';
 import { signal } from '@preact/signals';
 import uuidv4 from '../utils/uuid.js';
 
+// Binary status frames, mirrors src/display/models/status_frame.h (keep in sync)
+const STATUS_FRAME_KEY = 0x01;
+const STATUS_BINARY_INTERVAL = 100; // ms between frames while a process runs
+
+const STATUS_FLAGS = { cp: 0x01, cd: 0x02, bta: 0x04, bt: 0x08, led: 0x10 };
+const PROCESS_PRESENT = 0x01;
+const PROCESS_ACTIVE = 0x02;
+const PROCESS_BREW = 0x04;
+const PROCESS_BREW_PHASE = 0x08;
+const PROCESS_VOLUMETRIC = 0x10;
+
+const textDecoder = new TextDecoder('utf-8');
+
+// Applies a binary status frame to state (the raw field values of the previous frames).
+// Returns false when the frame cannot be applied and a new keyframe is needed.
+export function applyStatusFrame(state, buffer) {
+  const view = new DataView(buffer);
+  if (view.byteLength < 4) return false;
+  const type = view.getUint8(0);
+  const seq = view.getUint8(1);
+  const fields = view.getUint16(2, true);
+  if (type !== STATUS_FRAME_KEY && (state.seq === undefined || seq !== ((state.seq + 1) & 0xff))) {
+    return false;
+  }
+  let position = 4;
+  const readString = () => {
+    const length = view.getUint8(position);
+    const bytes = new Uint8Array(buffer, position + 1, length);
+    position += 1 + length;
+    return textDecoder.decode(bytes);
+  };
+  const readers = [
+    () => view.getInt16(position, true) / 10,
+    () => view.getInt16(position, true) / 10,
+    () => view.getInt16(position, true) / 100,
+    () => view.getInt16(position, true) / 100,
+    () => view.getInt16(position, true) / 100,
+    () => view.getUint8(position),
+    () => view.getUint8(position),
+    readString,
+    () => view.getUint8(position),
+    readString,
+    () => view.getUint32(position, true),
+    () => view.getFloat32(position, true),
+    () => view.getFloat32(position, true),
+  ];
+  const sizes = [2, 2, 2, 2, 2, 1, 1, 0, 1, 0, 4, 4, 4];
+  try {
+    for (let i = 0; i < readers.length; i++) {
+      if (fields & (1 << i)) {
+        state.values[i] = readers[i]();
+        position += sizes[i];
+      }
+    }
+  } catch {
+    return false; // truncated frame
+  }
+  state.seq = seq;
+  return true;
+}
+
+// Builds the evt:status message the JSON channel would have sent
+export function statusMessage(values) {
+  const [ct, tt, pr, fl, pt, m, flags, p, processFlags, l, e, phaseTarget, phaseProgress] = values;
+  const message = { tp: 'evt:status', ct, tt, pr, fl, pt, m, p };
+  for (const [key, mask] of Object.entries(STATUS_FLAGS)) {
+    message[key] = key === 'bta' || key === 'bt' ? (flags & mask ? 1 : 0) : !!(flags & mask);
+  }
+  if (processFlags & PROCESS_PRESENT) {
+    message.process = { a: processFlags & PROCESS_ACTIVE ? 1 : 0 };
+    if (processFlags & PROCESS_BREW) {
+      Object.assign(message.process, {
+        s: processFlags & PROCESS_BREW_PHASE ? 'brew' : 'infusion',
+        l,
+        e,
+        tt: processFlags & PROCESS_VOLUMETRIC ? 'volumetric' : 'time',
+        pt: phaseTarget,
+        pp: phaseProgress,
+      });
+    }
+  }
+  return message;
+}
+
 function randomId() {
   return Math.random()
     .toString(36)
@@ -17,6 +101,7 @@ export default class ApiService {
   baseReconnectDelay = 1000; // Start with 1 second delay
   reconnectTimeout = null;
   isConnecting = false;
+  binaryStatus = { seq: undefined, values: [] };
 
   constructor() {
     console.log('Established websocket connection');
@@ -35,6 +120,7 @@ export default class ApiService {
       const apiHost = window.location.host;
       const wsProtocol = window.location.protocol === 'https:' ? 'wss://' : 'ws://';
       this.socket = new WebSocket(`${wsProtocol}${apiHost}/ws`);
+      this.socket.binaryType = 'arraybuffer';
 
       this.socket.addEventListener('message', this._onMessage.bind(this));
       this.socket.addEventListener('close', this._onClose.bind(this));
@@ -51,6 +137,7 @@ export default class ApiService {
   _onOpen() {
     console.log('WebSocket connected successfully');
     this.reconnectAttempts = 0;
+    this._subscribeBinaryStatus();
     machine.value = {
       ...machine.value,
       connected: true,
@@ -92,8 +179,28 @@ export default class ApiService {
     }, delay);
   }
 
+  _subscribeBinaryStatus() {
+    this.binaryStatus = { seq: undefined, values: [] };
+    this.send({ tp: 'req:status:binary', interval: STATUS_BINARY_INTERVAL });
+  }
+
+  _onBinaryMessage(buffer) {
+    if (!applyStatusFrame(this.binaryStatus, buffer)) {
+      // Missed a frame or joined mid stream, ask for a fresh keyframe
+      if (this.binaryStatus.seq !== undefined) {
+        this._subscribeBinaryStatus();
+      }
+      return;
+    }
+    return statusMessage(this.binaryStatus.values);
+  }
+
   _onMessage(event) {
-    const message = JSON.parse(event.data);
+    const message =
+      event.data instanceof ArrayBuffer
+        ? this._onBinaryMessage(event.data)
+        : JSON.parse(event.data);
+    if (!message) return;
     const listeners = Object.values(this.listeners[message.tp] || {});
     if (message.tp === 'evt:status') {
       this._onStatus(message);